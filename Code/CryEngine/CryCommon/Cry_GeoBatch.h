@@ -0,0 +1,243 @@
+//////////////////////////////////////////////////////////////////////
+// Crytek Source File.
+// Copyright (C) Crytek GmbH, 2001-2008.
+//
+//	File:Cry_GeoBatch.h
+//	Description: Distance and visibility tests of one shape against many
+//
+//	History:
+//	-Oct 19,2026: Created by CryFire
+//
+//////////////////////////////////////////////////////////////////////
+
+#ifndef CRYGEOBATCH_H
+#define CRYGEOBATCH_H
+
+#if _MSC_VER > 1000
+# pragma once
+#endif
+
+#include <Cry_Geo.h>
+#include <Cry_Camera.h>
+#include <vector>
+
+// Cry_Math.h already uses SSE unconditionally on these targets (cry_sqrtf),
+// Linux_Win32Wrapper.h clashes with the intrinsics headers, so gcc builds use the plain loop
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#define GEOBATCH_SSE
+#include <xmmintrin.h>
+#endif
+
+
+//----------------------------------------------------------------------------------
+// The shapes are stored as structure of arrays, so that one SSE instruction works
+// on the same coordinate of 4 shapes. The kernels process 4 shapes at once and the
+// rest in a scalar loop, which does the same operations in the same order.
+// The output arrays must have room for Count() elements.
+//----------------------------------------------------------------------------------
+
+struct SBatchPoints
+{
+	std::vector<float> x, y, z;
+
+	void Clear() { x.clear(); y.clear(); z.clear(); }
+	void Reserve( size_t n ) { x.reserve(n); y.reserve(n); z.reserve(n); }
+	void Add( const Vec3 &p ) { x.push_back(p.x); y.push_back(p.y); z.push_back(p.z); }
+	int Count() const { return (int)x.size(); }
+	Vec3 Get( int i ) const { return Vec3(x[i], y[i], z[i]); }
+};
+
+struct SBatchSpheres
+{
+	std::vector<float> x, y, z, r;
+
+	void Clear() { x.clear(); y.clear(); z.clear(); r.clear(); }
+	void Reserve( size_t n ) { x.reserve(n); y.reserve(n); z.reserve(n); r.reserve(n); }
+	void Add( const Vec3 &center, float radius ) { x.push_back(center.x); y.push_back(center.y); z.push_back(center.z); r.push_back(radius); }
+	void Add( const Sphere &s ) { Add(s.center, s.radius); }
+	int Count() const { return (int)x.size(); }
+};
+
+struct SBatchAABBs
+{
+	std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+	void Clear() { minX.clear(); minY.clear(); minZ.clear(); maxX.clear(); maxY.clear(); maxZ.clear(); }
+	void Reserve( size_t n ) { minX.reserve(n); minY.reserve(n); minZ.reserve(n); maxX.reserve(n); maxY.reserve(n); maxZ.reserve(n); }
+	void Add( const AABB &b )
+	{
+		minX.push_back(b.min.x); minY.push_back(b.min.y); minZ.push_back(b.min.z);
+		maxX.push_back(b.max.x); maxY.push_back(b.max.y); maxZ.push_back(b.max.z);
+	}
+	int Count() const { return (int)minX.size(); }
+};
+
+
+//----------------------------------------------------------------------------------
+/// Squared distances from one point to every point of the batch
+//----------------------------------------------------------------------------------
+inline void BatchPointPointDistSq( const Vec3 &p, const SBatchPoints &points, float *pDistSq )
+{
+	const int n = points.Count();
+	if (n == 0)
+		return;
+	const float *px = &points.x[0], *py = &points.y[0], *pz = &points.z[0];
+	int i = 0;
+
+#if defined(GEOBATCH_SSE)
+	const __m128 cx = _mm_set1_ps(p.x), cy = _mm_set1_ps(p.y), cz = _mm_set1_ps(p.z);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), cx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), cy);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(pz + i), cz);
+		_mm_storeu_ps(pDistSq + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+	}
+#endif
+
+	for (; i < n; ++i)
+	{
+		float dx = px[i] - p.x, dy = py[i] - p.y, dz = pz[i] - p.z;
+		pDistSq[i] = (dx*dx + dy*dy) + dz*dz;
+	}
+}
+
+//----------------------------------------------------------------------------------
+/// Squared distances from one point to every box of the batch, 0 if the point is
+/// inside, the same as AABB::GetDistanceSqr
+//----------------------------------------------------------------------------------
+inline void BatchPointAABBDistSq( const Vec3 &p, const SBatchAABBs &boxes, float *pDistSq )
+{
+	const int n = boxes.Count();
+	if (n == 0)
+		return;
+	const float *minX = &boxes.minX[0], *minY = &boxes.minY[0], *minZ = &boxes.minZ[0];
+	const float *maxX = &boxes.maxX[0], *maxY = &boxes.maxY[0], *maxZ = &boxes.maxZ[0];
+	int i = 0;
+
+#if defined(GEOBATCH_SSE)
+	const __m128 cx = _mm_set1_ps(p.x), cy = _mm_set1_ps(p.y), cz = _mm_set1_ps(p.z);
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= n; i += 4)
+	{
+		// only one of (min - p) and (p - max) can be positive
+		__m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), cx), _mm_sub_ps(cx, _mm_loadu_ps(maxX + i))), zero);
+		__m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), cy), _mm_sub_ps(cy, _mm_loadu_ps(maxY + i))), zero);
+		__m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minZ + i), cz), _mm_sub_ps(cz, _mm_loadu_ps(maxZ + i))), zero);
+		_mm_storeu_ps(pDistSq + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+	}
+#endif
+
+	for (; i < n; ++i)
+	{
+		float dx = max(max(minX[i] - p.x, p.x - maxX[i]), 0.0f);
+		float dy = max(max(minY[i] - p.y, p.y - maxY[i]), 0.0f);
+		float dz = max(max(minZ[i] - p.z, p.z - maxZ[i]), 0.0f);
+		pDistSq[i] = (dx*dx + dy*dy) + dz*dz;
+	}
+}
+
+//----------------------------------------------------------------------------------
+/// Squared distances from every point of the batch to a line segment, the same as
+/// Distance::Point_LinesegSq up to float rounding. If pT is given, it receives the
+/// position of the closest point on the segment (0 = start, 1 = end).
+//----------------------------------------------------------------------------------
+inline void BatchPointSegmentDistSq( const SBatchPoints &points, const Lineseg &lineseg, float *pDistSq, float *pT = 0 )
+{
+	const int n = points.Count();
+	if (n == 0)
+		return;
+	const float *px = &points.x[0], *py = &points.y[0], *pz = &points.z[0];
+	const Vec3 start = lineseg.start;
+	const Vec3 dir = lineseg.end - lineseg.start;
+	const float lenSq = dir.GetLengthSquared();
+	const float invLenSq = lenSq > 0.0f ? 1.0f / lenSq : 0.0f;   // degenerate segment is its start point
+	int i = 0;
+
+#if defined(GEOBATCH_SSE)
+	const __m128 sx = _mm_set1_ps(start.x), sy = _mm_set1_ps(start.y), sz = _mm_set1_ps(start.z);
+	const __m128 vx = _mm_set1_ps(dir.x), vy = _mm_set1_ps(dir.y), vz = _mm_set1_ps(dir.z);
+	const __m128 inv = _mm_set1_ps(invLenSq);
+	const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), sx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), sy);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(pz + i), sz);
+		__m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, vx), _mm_mul_ps(dy, vy)), _mm_mul_ps(dz, vz));
+		t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(t, inv), zero), one);
+		dx = _mm_sub_ps(dx, _mm_mul_ps(t, vx));
+		dy = _mm_sub_ps(dy, _mm_mul_ps(t, vy));
+		dz = _mm_sub_ps(dz, _mm_mul_ps(t, vz));
+		_mm_storeu_ps(pDistSq + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		if (pT)
+			_mm_storeu_ps(pT + i, t);
+	}
+#endif
+
+	for (; i < n; ++i)
+	{
+		float dx = px[i] - start.x, dy = py[i] - start.y, dz = pz[i] - start.z;
+		float t = ((dx*dir.x + dy*dir.y) + dz*dir.z) * invLenSq;
+		t = min(max(t, 0.0f), 1.0f);
+		dx -= t*dir.x;
+		dy -= t*dir.y;
+		dz -= t*dir.z;
+		pDistSq[i] = (dx*dx + dy*dy) + dz*dz;
+		if (pT)
+			pT[i] = t;
+	}
+}
+
+//----------------------------------------------------------------------------------
+/// Culls every sphere of the batch against the camera frustum, the same test as
+/// CCamera::IsSphereVisible_F. pVisible[i] is set to 1 for spheres which overlap
+/// the frustum and to 0 for the others, returns the number of visible spheres.
+//----------------------------------------------------------------------------------
+inline int BatchSphereFrustum( const CCamera &camera, const SBatchSpheres &spheres, uint8 *pVisible )
+{
+	const int n = spheres.Count();
+	if (n == 0)
+		return 0;
+	const float *px = &spheres.x[0], *py = &spheres.y[0], *pz = &spheres.z[0], *pr = &spheres.r[0];
+	int numVisible = 0;
+	int i = 0;
+
+#if defined(GEOBATCH_SSE)
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(px + i), y = _mm_loadu_ps(py + i), z = _mm_loadu_ps(pz + i), r = _mm_loadu_ps(pr + i);
+		__m128 outside = _mm_setzero_ps();
+		for (int p = 0; p < FRUSTUM_PLANES; ++p)
+		{
+			const Plane &plane = *camera.GetFrustumPlane(p);
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.n.x)), _mm_mul_ps(y, _mm_set1_ps(plane.n.y))), _mm_mul_ps(z, _mm_set1_ps(plane.n.z)));
+			d = _mm_add_ps(d, _mm_set1_ps(plane.d));
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(d, r));
+		}
+		int mask = _mm_movemask_ps(outside);
+		for (int k = 0; k < 4; ++k)
+		{
+			pVisible[i + k] = (mask >> k) & 1 ? 0 : 1;
+			numVisible += pVisible[i + k];
+		}
+	}
+#endif
+
+	for (; i < n; ++i)
+	{
+		bool outside = false;
+		for (int p = 0; p < FRUSTUM_PLANES; ++p)
+		{
+			const Plane &plane = *camera.GetFrustumPlane(p);
+			float d = ((px[i]*plane.n.x + py[i]*plane.n.y) + pz[i]*plane.n.z) + plane.d;
+			outside |= d > pr[i];
+		}
+		pVisible[i] = outside ? 0 : 1;
+		numVisible += pVisible[i];
+	}
+
+	return numVisible;
+}
+
+#endif //CRYGEOBATCH_H
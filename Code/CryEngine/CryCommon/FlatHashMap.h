@@ -0,0 +1,693 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Crytek Engine Source File.
+//  Copyright (C), Crytek Studios, 2001-2006.
+// -------------------------------------------------------------------------
+//  File name:   FlatHashMap.h
+//  Version:     v1.00
+//  Created:     19/10/2026 by CryFire.
+//  Compilers:   Visual Studio.NET 2005
+//  Description: std::map/std::set replacement implemented as open addressing
+//               hash table with control bytes matched 16 at once.
+// -------------------------------------------------------------------------
+//  History:
+//
+////////////////////////////////////////////////////////////////////////////
+#ifndef __FLATHASHMAP_H__
+#define __FLATHASHMAP_H__
+
+#include <functional>
+#include <utility>
+#include <new>
+#include <string.h>
+#include "StlUtils.h"
+#include "CryMemoryAllocator.h"
+
+// Linux_Win32Wrapper.h clashes with the intrinsics headers, so gcc builds use the plain loop
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLATHASH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+class ICrySizer;
+
+//--------------------------------------------------------------------------
+// FlatHashMap, FlatHashSet
+//
+// Usage Notes:
+// Drop-in replacement for std::map/std::set where the order of the
+// elements doesn't matter. Elements are stored directly in one array of
+// slots, next to it is an array of control bytes, one per slot, holding
+// 7 bits of the hash of a full slot or a marker of an empty/deleted slot.
+// Lookup hashes the key once, then compares 16 control bytes at once (one
+// SSE2 instruction where available) and touches only the slots whose 7
+// bits match, so a lookup is usually a single cache miss.
+//
+// *************************************************************************
+// PLEASE NOTE: Unlike std::map, an insertion can rehash the table, which
+// invalidates ALL iterators and pointers to elements. Erasing never
+// rehashes, so it's safe to erase the current element while iterating,
+// if the iterator is advanced before the erase (the usual std::map way).
+// Iteration order is unspecified and changes with rehashing.
+// *************************************************************************
+//
+// Memory is allocated through Node_Allocator from CryMemoryAllocator.h,
+// by default from the module heap (CryModuleMalloc).
+//--------------------------------------------------------------------------
+
+namespace stl
+{
+	// default hash of integer, enum and pointer keys (EntityId, IEntityClass *, ...),
+	// they are often sequential, so the bits have to be mixed (murmur3 finalizer)
+	template <class Key>
+	struct flat_hash
+	{
+		ILINE size_t operator()( const Key& key ) const
+		{
+			return flat_hash_mix( (size_t)key );
+		}
+
+		static ILINE size_t flat_hash_mix( size_t h )
+		{
+#if defined(_WIN64) || defined(__x86_64__) || defined(LINUX64)
+			uint64 k = h;
+			k ^= k >> 33;
+			k *= 0xff51afd7ed558ccdULL;
+			k ^= k >> 33;
+			k *= 0xc4ceb9fe1a85ec53ULL;
+			k ^= k >> 33;
+			return (size_t)k;
+#else
+			uint32 k = (uint32)h;
+			k ^= k >> 16;
+			k *= 0x85ebca6b;
+			k ^= k >> 13;
+			k *= 0xc2b2ae35;
+			k ^= k >> 16;
+			return (size_t)k;
+#endif
+		}
+	};
+
+	// case sensitive hash of string content, for string and const char * keys (FNV-1a)
+	template <class Key>
+	struct flat_hash_strcmp
+	{
+		ILINE size_t operator()( const Key& key ) const
+		{
+			uint32 h = 2166136261u;
+			for (const char *s = stl::constchar_cast(key); *s; ++s)
+				h = (h ^ (unsigned char)*s) * 16777619u;
+			return flat_hash<uint32>::flat_hash_mix( h );
+		}
+	};
+
+	// CCryName strings are unique in the name table, so the pointer identifies the name
+	template <class Key>
+	struct flat_hash_cryname
+	{
+		ILINE size_t operator()( const Key& key ) const
+		{
+			return flat_hash<const char *>::flat_hash_mix( (size_t)key.c_str() );
+		}
+	};
+}
+
+namespace FlatHashDetail
+{
+	enum
+	{
+		GROUP_WIDTH = 16,
+		MIN_CAPACITY = GROUP_WIDTH,
+	};
+
+	// control byte values, full slots hold 7 bits of the hash (0..127)
+	enum
+	{
+		CTRL_EMPTY = -128,
+		CTRL_DELETED = -2,
+		CTRL_SENTINEL = -1,  // after the last slot, stops iteration
+	};
+
+	ILINE uint32 LowestBit( uint32 mask )
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward( &index, mask );
+		return index;
+#else
+		return __builtin_ctz( mask );
+#endif
+	}
+
+	// 16 control bytes compared at once, results are bit masks with bit i set for slot i
+	struct Group
+	{
+#if defined(FLATHASH_SSE2)
+		explicit Group( const signed char *pCtrl ) : m_ctrl( _mm_loadu_si128( (const __m128i *)pCtrl ) ) {}
+
+		ILINE uint32 Match( signed char h2 ) const
+		{
+			return (uint32)_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( h2 ), m_ctrl ) );
+		}
+		ILINE uint32 MatchEmpty() const
+		{
+			return Match( (signed char)CTRL_EMPTY );
+		}
+		ILINE uint32 MatchEmptyOrDeleted() const
+		{
+			return (uint32)_mm_movemask_epi8( _mm_cmpgt_epi8( _mm_set1_epi8( CTRL_SENTINEL ), m_ctrl ) );
+		}
+
+		__m128i m_ctrl;
+#else
+		explicit Group( const signed char *pCtrl ) : m_pCtrl( pCtrl ) {}
+
+		ILINE uint32 Match( signed char h2 ) const
+		{
+			uint32 mask = 0;
+			for (int i = 0; i < GROUP_WIDTH; ++i)
+				mask |= uint32(m_pCtrl[i] == h2) << i;
+			return mask;
+		}
+		ILINE uint32 MatchEmpty() const
+		{
+			return Match( (signed char)CTRL_EMPTY );
+		}
+		ILINE uint32 MatchEmptyOrDeleted() const
+		{
+			uint32 mask = 0;
+			for (int i = 0; i < GROUP_WIDTH; ++i)
+				mask |= uint32(m_pCtrl[i] < CTRL_SENTINEL) << i;
+			return mask;
+		}
+
+		const signed char *m_pCtrl;
+#endif
+	};
+
+	// control bytes of a table without any slots, only the sentinel
+	ILINE signed char *EmptyCtrl()
+	{
+		static signed char s_sentinel = CTRL_SENTINEL;
+		return &s_sentinel;
+	}
+
+	template <class Pair>
+	struct SelectFirst
+	{
+		typedef typename Pair::first_type result_type;
+		ILINE const result_type& operator()( const Pair& value ) const { return value.first; }
+	};
+
+	template <class T>
+	struct Identity
+	{
+		typedef T result_type;
+		ILINE const T& operator()( const T& value ) const { return value; }
+	};
+}
+
+//--------------------------------------------------------------------------
+// common implementation of FlatHashMap and FlatHashSet
+template <typename V, typename K, typename KeyOf, typename H, typename E, EAllocFreeType A>
+class FlatHashTable : private H, private E // Empty base optimization
+{
+public:
+	typedef K key_type;
+	typedef V value_type;
+	typedef H hasher;
+	typedef E key_equal;
+	typedef size_t size_type;
+	typedef value_type& reference;
+	typedef const value_type& const_reference;
+	typedef value_type* pointer;
+	typedef const value_type* const_pointer;
+
+	template <typename Ptr, typename Ref>
+	class Iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef typename FlatHashTable::value_type value_type;
+		typedef ptrdiff_t difference_type;
+		typedef Ptr pointer;
+		typedef Ref reference;
+
+		Iterator() : m_pCtrl(0), m_pSlot(0) {}
+		Iterator( const signed char *pCtrl, Ptr pSlot ) : m_pCtrl(pCtrl), m_pSlot(pSlot) {}
+		// iterator -> const_iterator
+		template <typename P2, typename R2>
+		Iterator( const Iterator<P2, R2>& other ) : m_pCtrl(other.m_pCtrl), m_pSlot(other.m_pSlot) {}
+
+		ILINE Ref operator*() const { return *m_pSlot; }
+		ILINE Ptr operator->() const { return m_pSlot; }
+		ILINE Iterator& operator++() { ++m_pCtrl; ++m_pSlot; SkipFree(); return *this; }
+		ILINE Iterator operator++(int) { Iterator old(*this); ++*this; return old; }
+
+		template <typename P2, typename R2>
+		ILINE bool operator==( const Iterator<P2, R2>& other ) const { return m_pCtrl == other.m_pCtrl; }
+		template <typename P2, typename R2>
+		ILINE bool operator!=( const Iterator<P2, R2>& other ) const { return m_pCtrl != other.m_pCtrl; }
+
+		// moves to the next full slot or to the sentinel
+		ILINE void SkipFree()
+		{
+			while (*m_pCtrl < FlatHashDetail::CTRL_SENTINEL)
+			{
+				++m_pCtrl;
+				++m_pSlot;
+			}
+		}
+
+		const signed char *m_pCtrl;
+		Ptr m_pSlot;
+	};
+
+	typedef Iterator<value_type*, value_type&> iterator;
+	typedef Iterator<const value_type*, const value_type&> const_iterator;
+
+	FlatHashTable();
+	explicit FlatHashTable( const hasher& hash, const key_equal& equal = key_equal() );
+	FlatHashTable( const FlatHashTable& right );
+	~FlatHashTable();
+	FlatHashTable& operator=( const FlatHashTable& right );
+
+	iterator begin();
+	const_iterator begin() const;
+	iterator end();
+	const_iterator end() const;
+	bool empty() const { return m_size == 0; }
+	size_type size() const { return m_size; }
+	size_type capacity() const { return m_capacity; }
+	void clear();
+	void reserve( size_type count );
+	void swap( FlatHashTable& other );
+
+	iterator find( const key_type& key );
+	const_iterator find( const key_type& key ) const;
+	size_type count( const key_type& key ) const { return FindIndex( key ) != m_capacity ? 1 : 0; }
+
+	std::pair<iterator, bool> insert( const value_type& val );
+	template <class InputIterator> void insert( InputIterator first, InputIterator last );
+
+	void erase( iterator where );
+	size_type erase( const key_type& key );
+
+	hasher hash_function() const { return static_cast<const hasher&>(*this); }
+	key_equal key_eq() const { return static_cast<const key_equal&>(*this); }
+
+	// number of bytes allocated for slots and control bytes
+	size_type get_alloc_size() const;
+	void GetMemoryUsage( ICrySizer *pSizer ) const;
+
+protected:
+	// returns index of the slot holding the key, or m_capacity
+	size_type FindIndex( const key_type& key ) const;
+	// returns index of a free slot for a key, which isn't in the table
+	size_type FindFreeIndex( size_t hash ) const;
+	void SetCtrl( size_type index, signed char ctrl ) { m_pCtrl[index] = ctrl; }
+	void Rehash( size_type newCapacity );
+	void Allocate( size_type capacity );
+	void Deallocate();
+	void DestroyAll();
+	size_type MaxLoad() const { return m_capacity - m_capacity / 8; }
+
+	static signed char H2( size_t hash ) { return (signed char)(hash & 0x7F); }
+	static size_t H1( size_t hash ) { return hash >> 7; }
+
+	signed char *m_pCtrl;       // m_capacity control bytes followed by the sentinel
+	value_type *m_pSlots;
+	size_type m_capacity;       // 0 or a power of two >= GROUP_WIDTH
+	size_type m_size;
+	size_type m_growthLeft;     // insertions into empty slots left before rehashing
+};
+
+//--------------------------------------------------------------------------
+template <typename K, typename V, typename H = stl::flat_hash<K>, typename E = std::equal_to<K>, EAllocFreeType A = eCryMallocCryFreeAll>
+class FlatHashMap : public FlatHashTable<std::pair<const K, V>, K, FlatHashDetail::SelectFirst< std::pair<const K, V> >, H, E, A>
+{
+	typedef FlatHashTable<std::pair<const K, V>, K, FlatHashDetail::SelectFirst< std::pair<const K, V> >, H, E, A> TTable;
+
+public:
+	typedef V mapped_type;
+
+	FlatHashMap() {}
+	explicit FlatHashMap( const H& hash, const E& equal = E() ) : TTable( hash, equal ) {}
+	template <class InputIterator> FlatHashMap( InputIterator first, InputIterator last ) { this->insert( first, last ); }
+
+	mapped_type& operator[]( const K& key )
+	{
+		return this->insert( typename TTable::value_type( key, mapped_type() ) ).first->second;
+	}
+};
+
+//--------------------------------------------------------------------------
+template <typename K, typename H = stl::flat_hash<K>, typename E = std::equal_to<K>, EAllocFreeType A = eCryMallocCryFreeAll>
+class FlatHashSet : public FlatHashTable<K, K, FlatHashDetail::Identity<K>, H, E, A>
+{
+	typedef FlatHashTable<K, K, FlatHashDetail::Identity<K>, H, E, A> TTable;
+
+public:
+	FlatHashSet() {}
+	explicit FlatHashSet( const H& hash, const E& equal = E() ) : TTable( hash, equal ) {}
+	template <class InputIterator> FlatHashSet( InputIterator first, InputIterator last ) { this->insert( first, last ); }
+};
+
+//--------------------------------------------------------------------------
+#define FLATHASH_TEMPLATE template <typename V, typename K, typename KeyOf, typename H, typename E, EAllocFreeType A>
+#define FLATHASH_CLASS FlatHashTable<V, K, KeyOf, H, E, A>
+
+FLATHASH_TEMPLATE
+FLATHASH_CLASS::FlatHashTable()
+:	m_pCtrl(FlatHashDetail::EmptyCtrl()),
+	m_pSlots(0),
+	m_capacity(0),
+	m_size(0),
+	m_growthLeft(0)
+{
+}
+
+FLATHASH_TEMPLATE
+FLATHASH_CLASS::FlatHashTable( const hasher& hash, const key_equal& equal )
+:	hasher(hash),
+	key_equal(equal),
+	m_pCtrl(FlatHashDetail::EmptyCtrl()),
+	m_pSlots(0),
+	m_capacity(0),
+	m_size(0),
+	m_growthLeft(0)
+{
+}
+
+FLATHASH_TEMPLATE
+FLATHASH_CLASS::FlatHashTable( const FlatHashTable& right )
+:	hasher(right),
+	key_equal(right),
+	m_pCtrl(FlatHashDetail::EmptyCtrl()),
+	m_pSlots(0),
+	m_capacity(0),
+	m_size(0),
+	m_growthLeft(0)
+{
+	if (right.m_size == 0)
+		return;
+	// same capacity, so every element can stay in its slot
+	Allocate( right.m_capacity );
+	memcpy( m_pCtrl, right.m_pCtrl, m_capacity + 1 );
+	for (size_type i = 0; i < m_capacity; ++i)
+	{
+		if (m_pCtrl[i] >= 0)
+			new (&m_pSlots[i]) value_type( right.m_pSlots[i] );
+	}
+	m_size = right.m_size;
+	m_growthLeft = right.m_growthLeft;
+}
+
+FLATHASH_TEMPLATE
+FLATHASH_CLASS::~FlatHashTable()
+{
+	DestroyAll();
+	Deallocate();
+}
+
+FLATHASH_TEMPLATE
+FLATHASH_CLASS& FLATHASH_CLASS::operator=( const FlatHashTable& right )
+{
+	if (this != &right)
+	{
+		FlatHashTable copy( right );
+		swap( copy );
+	}
+	return *this;
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::iterator FLATHASH_CLASS::begin()
+{
+	iterator it( m_pCtrl, m_pSlots );
+	it.SkipFree();
+	return it;
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::const_iterator FLATHASH_CLASS::begin() const
+{
+	const_iterator it( m_pCtrl, m_pSlots );
+	it.SkipFree();
+	return it;
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::iterator FLATHASH_CLASS::end()
+{
+	return iterator( m_pCtrl + m_capacity, m_pSlots + m_capacity );
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::const_iterator FLATHASH_CLASS::end() const
+{
+	return const_iterator( m_pCtrl + m_capacity, m_pSlots + m_capacity );
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::clear()
+{
+	if (m_capacity == 0)
+		return;
+	DestroyAll();
+	memset( m_pCtrl, FlatHashDetail::CTRL_EMPTY, m_capacity );
+	m_size = 0;
+	m_growthLeft = MaxLoad();
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::reserve( size_type count )
+{
+	size_type capacity = FlatHashDetail::MIN_CAPACITY;
+	while (capacity - capacity / 8 < count)
+		capacity *= 2;
+	if (capacity > m_capacity)
+		Rehash( capacity );
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::swap( FlatHashTable& other )
+{
+	std::swap( static_cast<hasher&>(*this), static_cast<hasher&>(other) );
+	std::swap( static_cast<key_equal&>(*this), static_cast<key_equal&>(other) );
+	std::swap( m_pCtrl, other.m_pCtrl );
+	std::swap( m_pSlots, other.m_pSlots );
+	std::swap( m_capacity, other.m_capacity );
+	std::swap( m_size, other.m_size );
+	std::swap( m_growthLeft, other.m_growthLeft );
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::size_type FLATHASH_CLASS::FindIndex( const key_type& key ) const
+{
+	if (m_size == 0)
+		return m_capacity;
+
+	const size_t hash = hasher::operator()( key );
+	const signed char h2 = H2( hash );
+	const size_type groupMask = m_capacity / FlatHashDetail::GROUP_WIDTH - 1;
+	size_type group = H1( hash ) & groupMask;
+	// triangular probing visits every group exactly once, when the number of groups is a power of two
+	for (size_type step = 1; ; ++step)
+	{
+		const size_type first = group * FlatHashDetail::GROUP_WIDTH;
+		FlatHashDetail::Group g( m_pCtrl + first );
+		for (uint32 match = g.Match( h2 ); match; match &= match - 1)
+		{
+			const size_type index = first + FlatHashDetail::LowestBit( match );
+			if (key_equal::operator()( KeyOf()( m_pSlots[index] ), key ))
+				return index;
+		}
+		// the key would have been inserted into the first empty slot on its way
+		if (g.MatchEmpty() || step > groupMask)
+			return m_capacity;
+		group = (group + step) & groupMask;
+	}
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::size_type FLATHASH_CLASS::FindFreeIndex( size_t hash ) const
+{
+	const size_type groupMask = m_capacity / FlatHashDetail::GROUP_WIDTH - 1;
+	size_type group = H1( hash ) & groupMask;
+	for (size_type step = 1; ; ++step)
+	{
+		const size_type first = group * FlatHashDetail::GROUP_WIDTH;
+		uint32 mask = FlatHashDetail::Group( m_pCtrl + first ).MatchEmptyOrDeleted();
+		if (mask)
+			return first + FlatHashDetail::LowestBit( mask );
+		group = (group + step) & groupMask;
+	}
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::iterator FLATHASH_CLASS::find( const key_type& key )
+{
+	const size_type index = FindIndex( key );
+	return iterator( m_pCtrl + index, m_pSlots + index );
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::const_iterator FLATHASH_CLASS::find( const key_type& key ) const
+{
+	const size_type index = FindIndex( key );
+	return const_iterator( m_pCtrl + index, m_pSlots + index );
+}
+
+FLATHASH_TEMPLATE
+std::pair<typename FLATHASH_CLASS::iterator, bool> FLATHASH_CLASS::insert( const value_type& val )
+{
+	const key_type& key = KeyOf()( val );
+	size_type index = FindIndex( key );
+	if (index != m_capacity)
+		return std::make_pair( iterator( m_pCtrl + index, m_pSlots + index ), false );
+
+	const size_t hash = hasher::operator()( key );
+	if (m_capacity == 0)
+		Rehash( FlatHashDetail::MIN_CAPACITY );
+	index = FindFreeIndex( hash );
+	// reusing a deleted slot doesn't make the probe sequences longer, so it doesn't need to grow
+	if (m_growthLeft == 0 && m_pCtrl[index] != FlatHashDetail::CTRL_DELETED)
+	{
+		// many deleted slots - clean them up in place, otherwise grow
+		Rehash( m_size < MaxLoad() / 2 ? m_capacity : m_capacity * 2 );
+		index = FindFreeIndex( hash );
+	}
+	if (m_pCtrl[index] == FlatHashDetail::CTRL_EMPTY)
+		--m_growthLeft;
+	new (&m_pSlots[index]) value_type( val );
+	SetCtrl( index, H2( hash ) );
+	++m_size;
+	return std::make_pair( iterator( m_pCtrl + index, m_pSlots + index ), true );
+}
+
+FLATHASH_TEMPLATE
+template <class InputIterator> void FLATHASH_CLASS::insert( InputIterator first, InputIterator last )
+{
+	for (; first != last; ++first)
+		insert( *first );
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::erase( iterator where )
+{
+	const size_type index = where.m_pSlot - m_pSlots;
+	m_pSlots[index].~value_type();
+	--m_size;
+	// the slot can become empty again only if no probe sequence went through its group,
+	// which is true, when the group still has another empty slot
+	const size_type first = index & ~(size_type)(FlatHashDetail::GROUP_WIDTH - 1);
+	if (FlatHashDetail::Group( m_pCtrl + first ).MatchEmpty())
+	{
+		SetCtrl( index, FlatHashDetail::CTRL_EMPTY );
+		++m_growthLeft;
+	}
+	else
+		SetCtrl( index, FlatHashDetail::CTRL_DELETED );
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::size_type FLATHASH_CLASS::erase( const key_type& key )
+{
+	const size_type index = FindIndex( key );
+	if (index == m_capacity)
+		return 0;
+	erase( iterator( m_pCtrl + index, m_pSlots + index ) );
+	return 1;
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::Rehash( size_type newCapacity )
+{
+	signed char *pOldCtrl = m_pCtrl;
+	value_type *pOldSlots = m_pSlots;
+	const size_type oldCapacity = m_capacity;
+
+	Allocate( newCapacity );
+	for (size_type i = 0; i < oldCapacity; ++i)
+	{
+		if (pOldCtrl[i] < 0)
+			continue;
+		const size_t hash = hasher::operator()( KeyOf()( pOldSlots[i] ) );
+		const size_type index = FindFreeIndex( hash );
+		new (&m_pSlots[index]) value_type( pOldSlots[i] );
+		SetCtrl( index, H2( hash ) );
+		pOldSlots[i].~value_type();
+	}
+	m_growthLeft = MaxLoad() - m_size;
+
+	if (oldCapacity)
+	{
+		Node_Allocator<A> allocator;
+		allocator.pool_free( pOldCtrl );
+		allocator.pool_free( pOldSlots );
+	}
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::Allocate( size_type capacity )
+{
+	Node_Allocator<A> allocator;
+	m_pCtrl = (signed char *)allocator.pool_alloc( capacity + 1 );
+	m_pSlots = (value_type *)allocator.pool_alloc( capacity * sizeof(value_type) );
+	memset( m_pCtrl, FlatHashDetail::CTRL_EMPTY, capacity );
+	m_pCtrl[capacity] = FlatHashDetail::CTRL_SENTINEL;
+	m_capacity = capacity;
+	m_growthLeft = MaxLoad();
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::Deallocate()
+{
+	if (m_capacity == 0)
+		return;
+	Node_Allocator<A> allocator;
+	allocator.pool_free( m_pCtrl );
+	allocator.pool_free( m_pSlots );
+	m_pCtrl = FlatHashDetail::EmptyCtrl();
+	m_pSlots = 0;
+	m_capacity = 0;
+	m_size = 0;
+	m_growthLeft = 0;
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::DestroyAll()
+{
+	for (size_type i = 0; i < m_capacity; ++i)
+	{
+		if (m_pCtrl[i] >= 0)
+			m_pSlots[i].~value_type();
+	}
+}
+
+FLATHASH_TEMPLATE
+typename FLATHASH_CLASS::size_type FLATHASH_CLASS::get_alloc_size() const
+{
+	return m_capacity ? m_capacity + 1 + m_capacity * sizeof(value_type) : 0;
+}
+
+FLATHASH_TEMPLATE
+void FLATHASH_CLASS::GetMemoryUsage( ICrySizer *pSizer ) const
+{
+	if (m_capacity)
+	{
+		pSizer->AddObject( m_pCtrl, m_capacity + 1 );
+		pSizer->AddObject( m_pSlots, m_capacity * sizeof(value_type), (int)m_size );
+	}
+}
+
+#undef FLATHASH_TEMPLATE
+#undef FLATHASH_CLASS
+
+#endif // __FLATHASHMAP_H__
@@ -38,6 +38,10 @@
 
 #include "IFacialAnimation.h"
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+#include "CryFire/PickupIndex.h" // !!CryFire - added: pickup validation
+
 IItemSystem *CActor::m_pItemSystem=0;
 IGameFramework	*CActor::m_pGameFramework=0;
 IGameplayRecorder	*CActor::m_pGameplayRecorder=0;
@@ -248,6 +252,7 @@ CActor::CActor()
 , m_pGrabHandler(NULL)
 ,	m_teamId(0)
 ,	m_lastItemId(0)
+,	m_pfnCurrentItemChanged(0) // !!CryFire - added
 , m_pInventory(0)
 , m_pInteractor(0)
 , m_sleepTimer(0.0f)
@@ -295,6 +300,10 @@ CActor::~CActor()
 	SAFE_DELETE(m_screenEffects);
 	SAFE_DELETE(m_pGrabHandler);
 	SAFE_DELETE(m_pWeaponAM);
+
+	// !!CryFire - added
+	if (m_pfnCurrentItemChanged)
+		gEnv->pScriptSystem->ReleaseFunc(m_pfnCurrentItemChanged);
 }
 
 void CActor::ClearExtensionCache()
@@ -415,6 +424,7 @@ void CActor::InitClient(int channelId)
 void CActor::Revive( bool fromInit )
 {
 	ClearExtensionCache();
+	m_scriptStats.invalidate(); // !!CryFire - added: scripts may reset their stats on revive
 
 	if (fromInit)
 		g_pGame->GetGameRules()->OnRevive(this, GetEntity()->GetWorldPos(), GetEntity()->GetWorldRotation(), m_teamId);
@@ -1161,6 +1171,15 @@ void CActor::ProcessEvent(SEntityEvent& event)
 		break;
   case ENTITY_EVENT_RESET:
     Reset(event.nParam[0]==1);
+		//-- !!CryFire - added: the script could have been reloaded, look up its table and function again
+		m_actorStats = NULL;
+		if (m_pfnCurrentItemChanged)
+		{
+			gEnv->pScriptSystem->ReleaseFunc(m_pfnCurrentItemChanged);
+			m_pfnCurrentItemChanged = 0;
+		}
+		m_scriptStats.invalidate();
+		//------------------------------------------------------------------
 		GetGameObject()->RequestRemoteUpdate(eEA_Physics | eEA_GameClientDynamic | eEA_GameServerDynamic | eEA_GameClientStatic | eEA_GameServerStatic);
     break;
 	case ENTITY_EVENT_ANIM_EVENT:
@@ -1345,21 +1364,24 @@ void CActor::Update(SEntityUpdateContext& ctx, int slot)
 	{
 		IScriptTable* pScriptTable = GetEntity()->GetScriptTable();
 		if (pScriptTable)
+		{
 			pScriptTable->GetValue("actorStats", m_actorStats);
+			// !!CryFire - added: look the function up together with the table, not on every item change
+			if (!m_pfnCurrentItemChanged && pScriptTable->GetValueType("CurrentItemChanged")==svtFunction)
+				pScriptTable->GetValue("CurrentItemChanged", m_pfnCurrentItemChanged);
+		}
 	}
+	m_scriptStats.begin(m_actorStats); // !!CryFire - added
 	UpdateScriptStats(m_actorStats);
 
 	EntityId currentItemId=GetCurrentItemId();
 	if (currentItemId!=m_lastItemId)
 	{
-		HSCRIPTFUNCTION pfnCurrentItemChanged=0;
+		//-- !!CryFire - modded: use the cached function
 		IScriptTable *pTable=GetEntity()->GetScriptTable();
-		if (pTable && (pTable->GetValueType("CurrentItemChanged")==svtFunction) &&
-			pTable->GetValue("CurrentItemChanged", pfnCurrentItemChanged))
-		{
-			Script::CallMethod(pTable, pfnCurrentItemChanged, ScriptHandle(currentItemId), ScriptHandle(m_lastItemId));
-			gEnv->pScriptSystem->ReleaseFunc(pfnCurrentItemChanged);
-		}
+		if (pTable && m_pfnCurrentItemChanged)
+			Script::CallMethod(pTable, m_pfnCurrentItemChanged, ScriptHandle(currentItemId), ScriptHandle(m_lastItemId));
+		//--------------------------------------------------------------------
 
 		m_lastItemId=currentItemId;
 	}
@@ -1368,27 +1390,28 @@ void CActor::Update(SEntityUpdateContext& ctx, int slot)
 void CActor::UpdateScriptStats(SmartScriptTable &rTable)
 {
 	CScriptSetGetChain stats(rTable);
-	stats.SetValue("stance",m_stance);
-	stats.SetValue("thirdPerson",IsThirdPerson());
+	// !!CryFire - modded: values set through m_scriptStats are written only when they change
+	m_scriptStats.set("stance",(int)m_stance);
+	m_scriptStats.set("thirdPerson",IsThirdPerson());
 
 	SActorStats *pStats = GetActorStats();
 	if (pStats)
 	{
 		//REUSE_VECTOR(rTable, "velocity", pStats->velocity);
 	
-		stats.SetValue("inAir",pStats->inAir);
-		stats.SetValue("onGround",pStats->onGround);
+		m_scriptStats.set("inAir",pStats->inAir);
+		m_scriptStats.set("onGround",pStats->onGround);
 
 		//stats.SetValue("inWater",pStats->inWater);
 		//pStats->headUnderWater.SetDirtyValue(stats, "headUnderWater");
 		//stats.SetValue("waterLevel",pStats->waterLevel);
 		//stats.SetValue("bottomDepth",pStats->bottomDepth);
 
-		stats.SetValue("flatSpeed",pStats->speedFlat);
+		m_scriptStats.set("flatSpeed",pStats->speedFlat);
 		//stats.SetValue("speedModule",pStats->speed);
 
-		stats.SetValue("godMode",IsGod());
-		stats.SetValue("inFiring",pStats->inFiring);		
+		m_scriptStats.set("godMode",IsGod());
+		m_scriptStats.set("inFiring",pStats->inFiring);		
 		pStats->inFreefall.SetDirtyValue(stats, "inFreeFall");
 		pStats->isHidden.SetDirtyValue(stats, "isHidden");
 		pStats->isShattered.SetDirtyValue(stats, "isShattered");
@@ -1678,6 +1701,12 @@ void CActor::SetHealth( int health )
 
 	int prevHealth=(int)m_health;
 	m_health = float(min(health, m_maxHealth));
+
+	//-- !!CryFire - added: dying and reviving change who hears the chat of this actor ---
+	if ((prevHealth<=0) != (GetHealth()<=0) || (prevHealth<0) != (GetHealth()<0))
+		if (CGameRules *pGameRules=g_pGame->GetGameRules())
+			pGameRules->InvalidateChatStatus(GetEntityId());
+	//------
 	if (m_health!=prevHealth && m_health<=0)
 	{
 		IItem *pItem = GetCurrentItem();
@@ -2100,6 +2129,13 @@ bool CActor::NetSerialize( TSerialize ser, EEntityAspects aspect, uint8 profile,
 		}
 
 		pEPP->SerializeTyped( ser, type, pflags );
+
+		//-- !!CryFire - added: network traffic accounting -----------------
+		// only an estimate, the snapshot is opaque, so count what a living entity sends uncompressed:
+		// mass, position, velocity and orientation, every client which sees the actor gets it
+		if (gEnv->bServer && ser.IsWriting())
+			NetStats::onAspectSerialized(aspect, sizeof(float) + 2*sizeof(Vec3) + sizeof(Quat));
+		//------------------------------------------------------------------
 	}
 
 	return true;
@@ -2390,7 +2426,7 @@ bool CActor::CheckInventoryRestrictions(const char *itemClassName)
 {
 	bool noLimit = false;
 
-	if(gEnv->pConsole->GetCVar("i_noweaponlimit")->GetIVal() != 0)
+	if(g_pGameCVars->pBindings->i_noweaponlimit.Get() != 0) // !!CryFire - modded
 		noLimit = true;
 
 	const char *itemCategory = m_pItemSystem->GetItemCategory(itemClassName);
@@ -2423,7 +2459,7 @@ bool CActor::CheckVirtualInventoryRestrictions(const std::vector<string> &invent
 {
 	bool noLimit = false;
 
-	if(gEnv->pConsole->GetCVar("i_noweaponlimit")->GetIVal() != 0)
+	if(g_pGameCVars->pBindings->i_noweaponlimit.Get() != 0) // !!CryFire - modded
 		noLimit = true;
 
 	const char *itemCategory = m_pItemSystem->GetItemCategory(itemClassName);
@@ -3162,6 +3198,8 @@ void CActor::SetSleepTimer(float timer)
 // !!CryFire - modded: detects drop item spoof
 IMPLEMENT_RMI(CActor, SvRequestDropItem)
 {
+	CF_COUNT_RMI("RequestDropItem");
+
 	CItem *pItem = GetItem(params.itemId);
 	if (!pItem)
 	{
@@ -3174,11 +3212,14 @@ IMPLEMENT_RMI(CActor, SvRequestDropItem)
 	CActor * real      = static_cast<CActor *>(m_pGameFramework->GetIActorSystem()->GetActorByChannelId(chnlId));
 	CActor * pretended = pItem->GetOwnerActor();
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestDropItem", chnlId, "actor related to the request channel not found", "item", pItem->GetEntity()->GetName());
+	}
 	if (!pretended)
 		RMIwarning("RequestDropItem", chnlId, real->GetEntity()->GetName(), "actor not found!", "item", pItem->GetEntity()->GetName());
 	else if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestDropItem", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName(), "item", pItem->GetEntity()->GetName());
 		g_pGame->GetGameRules()->OnCheat(real, "DropItemSpoof");
 		return true;
@@ -3198,6 +3239,8 @@ IMPLEMENT_RMI(CActor, SvRequestDropItem)
 // !!CryFire - modded: allows server to hook item pickups and decide if pickup is allowed
 IMPLEMENT_RMI(CActor, SvRequestPickUpItem)
 {
+	CF_COUNT_RMI("RequestPickUpItem");
+
 	CItem *pItem = GetItem(params.itemId);
 	if (!pItem)
 	{
@@ -3217,6 +3260,14 @@ IMPLEMENT_RMI(CActor, SvRequestPickUpItem)
 	if (ownerId)
 		return true;
 
+	// !!CryFire - added: the item has to lie in the world near the player
+	float maxDistance = g_pGameCVars->cf_pickup_maxdistance;
+	if (maxDistance > 0.0f && !PickupIndex::isWithinReach(params.itemId, GetEntity()->GetWorldPos(), maxDistance))
+	{
+		CF_REJECT_RMI();
+		return true;
+	}
+
 	bool canPickup = true;
 	Script::CallReturn("g_gameRules", "CanPickupItem", GetEntity()->GetScriptTable(), pItem->GetEntity()->GetScriptTable(), canPickup);
 	if (!canPickup)
@@ -3229,6 +3280,8 @@ IMPLEMENT_RMI(CActor, SvRequestPickUpItem)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CActor, SvRequestUseItem)
 {
+	CF_COUNT_RMI("RequestUseItem");
+
 	if (!IsFrozen())
 		UseItem(params.itemId);
 
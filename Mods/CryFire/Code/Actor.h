@@ -31,6 +31,7 @@
 #include "ScreenEffects.h"
 #include "GrabHandler.h"
 #include "WeaponAttachmentManager.h"
+#include "CryFire/ScriptStats.h" // !!CryFire - added
 
 struct SActorFrameMovementParams
 {
@@ -1176,6 +1177,8 @@ protected:
 	float m_zoomSpeedMultiplier;
 
 	SmartScriptTable m_actorStats;
+	ScriptStats m_scriptStats;                   // !!CryFire - added: writes only changed values into m_actorStats
+	HSCRIPTFUNCTION m_pfnCurrentItemChanged;     // !!CryFire - added: looked up only once
 
 	IAnimatedCharacter *m_pAnimatedCharacter;
 	IActorMovementController * m_pMovementController;
@@ -597,7 +597,7 @@ void CBeam::TickDamage(ray_hit &hit, const Vec3 &dir, uint16 seq)
 
 		HitInfo info(m_pWeapon->GetOwnerId(), pEntity->GetId(), m_pWeapon->GetEntityId(), 
 			m_pWeapon->GetFireModeIdx(GetName()), 0.25f, pGameRules->GetHitMaterialIdFromSurfaceId(hit.surface_idx), hit.partid, 
-			pGameRules->GetHitTypeId(m_fireparams.hit_type.c_str()), hit.pt, dir, hit.n);
+			pGameRules->GetHitTypeId(m_fireparams.hit_type), hit.pt, dir, hit.n);
 
 		if (m_pWeapon->GetForcedHitMaterial() != -1)
 			info.material=pGameRules->GetHitMaterialIdFromSurfaceId(m_pWeapon->GetForcedHitMaterial());
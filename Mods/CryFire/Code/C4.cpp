@@ -19,6 +19,9 @@ History:
 #include "WeaponSystem.h"
 #include "GameActions.h"
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+
 
 TActionHandler<CC4>	CC4::s_actionHandler;
 //------------------------------------------------------------------------
@@ -203,6 +206,8 @@ IMPLEMENT_RMI(CC4, ClSetProjectileId)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CC4, SvRequestTime)
 {
+	CF_COUNT_RMI("RequestTime"); // !!CryFire - added
+
 	IFireMode *pFireMode=GetFireMode(params.fmId);
 	if (pFireMode && !stricmp(pFireMode->GetType(), "Plant"))
 	{
@@ -210,7 +215,10 @@ IMPLEMENT_RMI(CC4, SvRequestTime)
 		pPlant->SetTime(params.time);
 	}
 	else
+	{
+		CF_REJECT_RMI(); // !!CryFire - added
 		return false;
+	}
 
 	return true;
 }
\ No newline at end of file
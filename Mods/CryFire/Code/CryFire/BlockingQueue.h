@@ -142,11 +142,11 @@ uint FixedQueue<elem_t>::count() const {
 template<typename elem_t>
 BlockingQueue<elem_t>::BlockingQueue(uint length)
 
- : FixedQueue(length) {
+ : FixedQueue<elem_t>(length) {
 
 	_mutex    = CreateMutex(NULL, false, NULL);
-	_free_sem = CreateSemaphore(NULL, _length, LONG_MAX, NULL);
-	_used_sem = CreateSemaphore(NULL, _count,  LONG_MAX, NULL);
+	_free_sem = CreateSemaphore(NULL, this->_length, LONG_MAX, NULL);
+	_used_sem = CreateSemaphore(NULL, this->_count,  LONG_MAX, NULL);
 
 }
 
@@ -166,7 +166,7 @@ void BlockingQueue<elem_t>::push(const elem_t & elem) {
 
 	WaitForSingleObject(_free_sem, INFINITE);
 	WaitForSingleObject(_mutex, INFINITE);
-	FixedQueue::push(elem);
+	FixedQueue<elem_t>::push(elem);
 	ReleaseMutex(_mutex);
 	ReleaseSemaphore(_used_sem, 1, NULL);
 
@@ -178,7 +178,7 @@ elem_t BlockingQueue<elem_t>::pop() {
 
 	WaitForSingleObject(_used_sem, INFINITE);
 	WaitForSingleObject(_mutex, INFINITE);
-	elem_t temp = FixedQueue::pop();
+	elem_t temp = FixedQueue<elem_t>::pop();
 	ReleaseMutex(_mutex);
 	ReleaseSemaphore(_free_sem, 1, NULL);
 	return temp;
@@ -190,8 +190,9 @@ template<typename elem_t>
 const elem_t & BlockingQueue<elem_t>::top() const {
 
 	WaitForSingleObject(_mutex, INFINITE);
-	return FixedQueue::top();
+	const elem_t & temp = FixedQueue<elem_t>::top();
 	ReleaseMutex(_mutex);
+	return temp;
 
 }
 
@@ -200,8 +201,9 @@ template<typename elem_t>
 uint BlockingQueue<elem_t>::count() const {
 
 	WaitForSingleObject(_mutex, INFINITE);
-	return FixedQueue::count();
+	uint temp = FixedQueue<elem_t>::count();
 	ReleaseMutex(_mutex);
+	return temp;
 
 }
 
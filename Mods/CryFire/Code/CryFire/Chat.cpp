@@ -0,0 +1,229 @@
+//================================================================================
+// File:    Code/CryFire/Chat.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Native chat front-end: flood protection, !command dispatch and message history
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "Chat.h"
+
+#include <Game.h>
+#include <GameCVars.h>
+#include <GameRules.h>
+#include <ScriptHelpers.h>
+
+#include "CryFire/Logging.h"
+
+#include <windows.h>
+#include <cstring>
+#include <cctype>
+
+
+//----------------------------------------------------------------------------------------------------
+std::map<int, Chat::Bucket>    Chat::buckets;
+std::vector<Chat::Node>        Chat::nodes;
+std::vector<Chat::Command>     Chat::commands;
+Chat::Message                  Chat::history [HISTORY_SIZE];
+uint                           Chat::historyHead = 0;
+uint                           Chat::historyCount = 0;
+
+//----------------------------------------------------------------------------------------------------
+int Chat::findNode( const char * name, uint length, bool create )
+{
+	if (nodes.empty()) {
+		if (!create)
+			return -1;
+		Node root = { '\0', -1, -1, -1 };
+		nodes.push_back( root );
+	}
+
+	int node = 0;
+	for (uint i = 0; i < length; i++) {
+		char ch = (char)tolower( (unsigned char)name[i] );
+		int child = nodes[node].child;
+		while (child >= 0 && nodes[child].ch != ch)
+			child = nodes[child].sibling;
+		if (child < 0) {
+			if (!create)
+				return -1;
+			Node newNode = { ch, -1, nodes[node].child, -1 };
+			child = (int)nodes.size();
+			nodes.push_back( newNode );   // don't hold references to nodes over this
+			nodes[node].child = child;
+		}
+		node = child;
+	}
+	return node;
+}
+
+int Chat::getCommand( const char * name, uint length, bool create )
+{
+	if (length == 0 || length > MAX_COMMAND_LENGTH)
+		return -1;
+	int node = findNode( name, length, create );
+	if (node < 0)
+		return -1;
+
+	if (nodes[node].command < 0 && create) {
+		Command command = { NULL, NULL };
+		nodes[node].command = (int)commands.size();
+		commands.push_back( command );
+	}
+	return nodes[node].command;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Chat::registerCommand( const char * name, CommandHandler handler )
+{
+	int command = getCommand( name, strlen( name ), true );
+	if (command < 0) {
+		CF_LogError( "invalid chat command name \"%s\"", name );
+		return false;
+	}
+	commands[command].native = handler;
+	return true;
+}
+
+bool Chat::registerScriptCommand( const char * name, HSCRIPTFUNCTION handler )
+{
+	int command = getCommand( name, strlen( name ), true );
+	if (command < 0) {
+		CF_LogError( "invalid chat command name \"%s\"", name );
+		gEnv->pScriptSystem->ReleaseFunc( handler );
+		return false;
+	}
+	if (commands[command].script)
+		gEnv->pScriptSystem->ReleaseFunc( commands[command].script );
+	commands[command].script = handler;
+	return true;
+}
+
+void Chat::releaseScriptCommands()
+{
+	for (uint i = 0; i < commands.size(); i++) {
+		if (commands[i].script) {
+			gEnv->pScriptSystem->ReleaseFunc( commands[i].script );
+			commands[i].script = NULL;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Chat::allowMessage( int chnlId, uint & droppedInRow )
+{
+	int burst = g_pGameCVars->cf_chat_burst;
+	if (burst <= 0)
+		return true;
+	uint capacity = (uint)burst * 1000;
+	uint now = GetTickCount();
+
+	std::map<int, Bucket>::iterator it = buckets.find( chnlId );
+	if (it == buckets.end()) {
+		Bucket newBucket = { capacity, now, 0 };
+		it = buckets.insert( std::make_pair( chnlId, newBucket ) ).first;
+	}
+	Bucket & bucket = it->second;
+
+	uint elapsed = now - bucket.lastTime;   // milliseconds, so elapsed * rate gives 1/1000 messages
+	if (elapsed > 60000)
+		elapsed = 60000;
+	bucket.lastTime = now;
+	uint tokens = bucket.tokens + (uint)(elapsed * max( g_pGameCVars->cf_chat_rate, 0.0f ));
+	bucket.tokens = tokens < capacity ? tokens : capacity;
+
+	if (bucket.tokens < 1000) {
+		droppedInRow = ++bucket.dropped;
+		return false;
+	}
+	bucket.tokens -= 1000;
+	bucket.dropped = 0;
+	return true;
+}
+
+void Chat::onClientDisconnect( int chnlId )
+{
+	buckets.erase( chnlId );
+}
+
+//----------------------------------------------------------------------------------------------------
+Chat::EResult Chat::dispatch( EntityId sourceId, const char * msg )
+{
+	if (msg[0] != '!')
+		return ePass;
+
+	const char * name = msg + 1;
+	uint length = 0;
+	while (name[length] && name[length] != ' ')
+		length++;
+	int command = getCommand( name, length, false );
+	if (command < 0)
+		return ePass;
+
+	const char * args = name + length;
+	while (*args == ' ')
+		args++;
+
+	const Command & cmd = commands[command];
+	if (cmd.native)
+		return cmd.native( sourceId, args );
+	if (cmd.script) {
+		bool show = false;
+		Script::CallReturn( gEnv->pScriptSystem, cmd.script, ScriptHandle( sourceId ), args, show );
+		return show ? eShow : eHide;
+	}
+	return ePass;   // script handler was released with the previous map
+}
+
+//----------------------------------------------------------------------------------------------------
+Chat::EResult Chat::onMessage( EChatMessageType type, EntityId sourceId, EntityId targetId, const char * msg )
+{
+	CGameRules * pGameRules = g_pGame->GetGameRules();
+	int chnlId = pGameRules ? pGameRules->GetChannelId( sourceId ) : 0;
+	uint droppedInRow = 0;
+	if (chnlId && !allowMessage( chnlId, droppedInRow )) {
+		if (droppedInRow == 1) {   // tell the player only once per flood
+			pGameRules->SendTextMessage( eTextMessageError, "Chat flood protection: your messages are not delivered, slow down", eRMI_ToClientChannel, chnlId );
+			IEntity * pSource = gEnv->pEntitySystem->GetEntity( sourceId );
+			CF_Log( 1, "chat flood from %s", pSource ? pSource->GetName() : "<unknown>" );
+		}
+		return eHide;
+	}
+
+	// keep it for the history, this is the only copy made on the way
+	Message & entry = history[ historyHead ];
+	entry.type = type;
+	entry.sourceId = sourceId;
+	entry.targetId = targetId;
+	entry.time = GetTickCount();
+	strncpy( entry.text, msg, MAX_MESSAGE_LENGTH - 1 );
+	entry.text[ MAX_MESSAGE_LENGTH - 1 ] = '\0';
+	historyHead = (historyHead + 1) % HISTORY_SIZE;
+	if (historyCount < HISTORY_SIZE)
+		historyCount++;
+
+	return dispatch( sourceId, msg );
+}
+
+const Chat::Message * Chat::getHistory( uint age )
+{
+	if (age >= historyCount)
+		return NULL;
+	return &history[ (historyHead + HISTORY_SIZE - 1 - age) % HISTORY_SIZE ];
+}
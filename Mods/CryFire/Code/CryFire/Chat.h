@@ -0,0 +1,112 @@
+//================================================================================
+// File:    Code/CryFire/Chat.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Native chat front-end: flood protection, !command dispatch and message history
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef CHAT_INCLUDED
+#define CHAT_INCLUDED
+
+
+#include <IGameRulesSystem.h>
+#include <IScriptSystem.h>
+
+#include <map>
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+class Chat {
+
+  public:
+
+	/* how many last messages are kept in the history */
+	static const uint HISTORY_SIZE = 64;
+	/* longer messages are truncated in the history, the original message is still delivered whole */
+	static const uint MAX_MESSAGE_LENGTH = 256;
+	static const uint MAX_COMMAND_LENGTH = 32;
+
+	enum EResult {
+		ePass = 0,   // not a registered command, continue with the usual processing
+		eShow,       // message should be delivered to the players
+		eHide        // message was blocked or consumed by a command
+	};
+
+	/* native command handler, args point behind the command name with leading spaces skipped */
+	typedef EResult (*CommandHandler)( EntityId sourceId, const char * args );
+
+	struct Message {
+		EChatMessageType type;
+		EntityId sourceId;
+		EntityId targetId;
+		uint time;                          // tick count
+		char text [MAX_MESSAGE_LENGTH];
+	};
+
+	/* registers a native command without the leading '!', case insensitive,
+	   native handler is used when both native and script ones are registered */
+	static bool registerCommand( const char * name, CommandHandler handler );
+	/* Lua handler gets (sourceId, args) and returns true, if the message should be shown */
+	static bool registerScriptCommand( const char * name, HSCRIPTFUNCTION handler );
+	/* releases Lua handlers, they belong to the script system of the current map */
+	static void releaseScriptCommands();
+
+	/* limits the rate, stores the message into the history and dispatches !commands */
+	static EResult onMessage( EChatMessageType type, EntityId sourceId, EntityId targetId, const char * msg );
+	static void onClientDisconnect( int chnlId );
+
+	/* returns message sent "age" messages ago (0 = last one), or NULL */
+	static const Message * getHistory( uint age );
+
+
+  protected:
+
+	struct Bucket {
+		uint tokens;      // in 1/1000 of a message
+		uint lastTime;    // tick count
+		uint dropped;     // dropped in a row
+	};
+	struct Node {         // left-child right-sibling trie of command names
+		char ch;
+		int child;
+		int sibling;
+		int command;      // index into commands, -1 if no command ends here
+	};
+	struct Command {
+		CommandHandler native;
+		HSCRIPTFUNCTION script;
+	};
+
+	static bool    allowMessage( int chnlId, uint & droppedInRow );
+	static int     findNode( const char * name, uint length, bool create );
+	static int     getCommand( const char * name, uint length, bool create );
+	static EResult dispatch( EntityId sourceId, const char * msg );
+
+	static std::map<int, Bucket>   buckets;
+	static std::vector<Node>       nodes;
+	static std::vector<Command>    commands;
+	static Message                 history [HISTORY_SIZE];
+	static uint                    historyHead;
+	static uint                    historyCount;
+
+};
+
+#endif // CHAT_INCLUDED
@@ -0,0 +1,49 @@
+//================================================================================
+// File:    Code/CryFire/ChatStatus.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Who can hear whom in the chat, by being dead or spectating
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef CHAT_STATUS_INCLUDED
+#define CHAT_STATUS_INCLUDED
+
+
+typedef unsigned char byte;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Status of a player for the chat routing of CGameRules, which caches it per player until it changes.
+   Dead players are heard only by dead ones, spectators only by spectators, but spectators hear the players. */
+class ChatStatus {
+
+  public:
+
+	enum Flags {
+		SPECTATOR = 1 << 0,   // not actively playing
+		DEAD      = 1 << 1
+	};
+
+	/* called for every recipient of every message, so it's only bit operations */
+	static bool allows( byte sourceStatus, byte targetStatus )
+	{
+		return ((sourceStatus ^ targetStatus) & (DEAD | (~targetStatus & SPECTATOR))) == 0;
+	}
+
+};
+
+#endif // CHAT_STATUS_INCLUDED
@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  15.2.2017
-// Last edited: 15.2.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: Entry point of CryFire hooks
 //--------------------------------------------------------------------------------
@@ -25,12 +25,21 @@
 
 #include <ISystem.h>
 #include <GameRules.h>
+#include <GameCVars.h>
 
 #include "CryFire/ScriptBind_CryFire.h"
 #include "CryFire/ScriptBind_Integer.h"
 #include "CryFire/AsyncTasks.h"
 #include "CryFire/MSrvConnection.h"
 #include "CryFire/Hooking.h"
+#include "CryFire/PacketFilter.h"
+#include "CryFire/NetStats.h"
+#include "CryFire/Relevancy.h"
+#include "CryFire/Chat.h"
+#include "CryFire/RayQueue.h"
+#include "CryFire/Jobs.h"
+#include "CryFire/Telemetry.h"
+#include "CryFire/MovementCheck.h"
 
 #include <set>
 
@@ -58,9 +67,23 @@ void CryFire::initialize( ISystem * pSystem, IGameFramework * pGameFramework )
 		}
 
 		// initialize thread for performing asynchronous tasks
-		AsyncTasks::initialize( 1 + gEnv->pConsole->GetCVar("sv_maxplayers")->GetIVal() );
+		AsyncTasks::initialize( 1 + g_pGameCVars->pBindings->sv_maxplayers.Get() );
+		// worker threads for the game jobs, one less than processors, the main thread works too
+		Jobs::initialize();
+		// start of the TSC calibration, timers measure nothing until this
+		Telemetry::initialize();
+
+		// native chat commands, Lua ones are registered by scripts on every map load
+		Chat::registerCommand( "validate", MSrvConnection::onValidateCommand );
 	}
 
+	// deferred updates of the previous map were dropped together with the old game rules
+	Relevancy::reset();
+	// owners of the queued rays belong to the previous map
+	RayQueue::reset();
+	// players of the previous map are gone
+	MovementCheck::reset();
+
 	// bind CryFire C++ functions to Lua
 	ScriptBind_CryFire::initialize( pSystem, pGameFramework );   // re-initialize everytime to update
 	ScriptBind_Integer::initialize( pSystem, pGameFramework );   // pSystem pointer in case it changed
@@ -82,6 +105,8 @@ void CryFire::terminate()
 	// !!No-GameSpy - added: terminates connection and communication with master server
 	if (MSrvConnection::useGameSpyReplacement())
 		MSrvConnection::terminate();
+	// Lua functions of chat commands belong to the old scripts
+	Chat::releaseScriptCommands();
 	// delete script table binded to lua
 	ScriptBind_Integer::terminate();
 	ScriptBind_CryFire::terminate();
@@ -98,7 +123,15 @@ void CryFire::onUpdate( float frameTime )
 		return;
 
 	Logging_onUpdate();
-	AsyncTasks::onUpdate( frameTime );
+	{
+		CF_TELEMETRY_SCOPE("AsyncTasks.onUpdate");
+		AsyncTasks::onUpdate( frameTime );
+	}
+	NetStats::onUpdate( frameTime );
+	Relevancy::onUpdate( frameTime );
+	RayQueue::onUpdate();
+	MovementCheck::onUpdate( frameTime );
+	Telemetry::onUpdate( frameTime );
 	if (MSrvConnection::useGameSpyReplacement())
 		MSrvConnection::onUpdate( frameTime );
 }
@@ -108,15 +141,28 @@ bool CryFire::onChatMessage( EChatMessageType type, EntityId sourceId, EntityId
 	if (!initialized)
 		return true;
 
-	// !!No-GameSpy: check for !validate command comming from SafeWriting client
-	if (MSrvConnection::checkChatMessage(sourceId, msg))
-		return false;
+	// flood protection and registered commands (including !No-GameSpy !validate comming from SafeWriting client)
+	Chat::EResult result = Chat::onMessage( type, sourceId, targetId, msg );
+	if (result != Chat::ePass)
+		return result == Chat::eShow;
 	// notify lua and ask if hide the message
 	bool showMsg = true;
 	pGameRules->CallScriptReturn(pGameRules->GetScriptTable(), "OnChatMessage", type, ScriptHandle(sourceId), ScriptHandle(targetId), msg, showMsg);
 	return showMsg;
 }
 
+void CryFire::onClientConnect( int chnlId )
+{
+	NetStats::onClientConnect( (channelId)chnlId );
+}
+
+void CryFire::onClientDisconnect( int chnlId )
+{
+	NetStats::onClientDisconnect( (channelId)chnlId );
+	Relevancy::onClientDisconnect( chnlId );
+	Chat::onClientDisconnect( chnlId );
+}
+
 //----------------------------------------------------------------------------------------------------
 struct Address {
 	void * VMT; // no idea why there is VMT, but there is
@@ -126,48 +172,16 @@ struct Address {
 	// is hard to find, even with source codes of CryEngine3 :/
 };
 
-static std::map<uint,uint> connected;
-
 static int onPacketReceived( const Address * from, byte * data, uint len )
 {
-	if (data[0] == '\x3E') { // disconnect packet
-
-		if (data[1] == '\x19' && data[2] == '%' && data[3] == 's' && data[4] == '%' && data[5] == 's') {
-			for (uint i = 2; i < len; i++)
-				if (data[i] == '%')
-					data[i] = '_';	
-			CF_AsyncLog( 0, "crysisfs (crash) attack detected from %d.%d.%d.%d", from->IPv4[3], from->IPv4[2], from->IPv4[1], from->IPv4[0] );
-		}
-		std::map<uint,uint>::iterator connCnt = connected.find( *(uint*)&from->IPv4 );
-		if (connCnt != connected.end()) {
-			CF_AsyncLog( 1, "%u connect packets sent by this player", connCnt->second);
-			connected.erase( *(uint*)&from->IPv4 );
-		}
-		return 1;
-
-	} else if (data[0] == '\x3C') { // connect packet
-
-		std::map<uint,uint>::iterator connCnt = connected.find( *(uint*)&from->IPv4 );
-		if (connCnt == connected.end()) { // no connect packet was sent yet
-			connCnt->second = 0;
-		} else {
-			(connCnt->second)++;
-			if (connCnt->second > 10) { // sometimes client can resend connection packet, so consider it hack, when at least 10 were sent
-				if (connCnt->second % 50 == 10) // display warning only every 50th attempt to not spam them during attack
-					CF_AsyncLog( 0, "crysisdos (freeze) attack detected from %d.%d.%d.%d", from->IPv4[3], from->IPv4[2], from->IPv4[1], from->IPv4[0] );
-				return 0;
-			}
-		}
-		return 1;
-
-	}
-
-	return 1;
+	// decide before the engine starts parsing the packet
+	return PacketFilter::onPacket( *(uint*)&from->IPv4, data, len ) ? 1 : 0;
 }
 
 void CryFire::hookOtherLibs()
 {
 	CF_Log( 1, "hooking other DLL libraries" );
+	PacketFilter::initialize();
 	// hook packet processing
 	hookCode( 0x3954AAA7, 5, &onPacketReceived, 3, false ); // alternatively: 0x3954AAAC
 }
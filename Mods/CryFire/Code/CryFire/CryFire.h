@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  15.2.2017
-// Last edited: 15.2.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: Entry point of CryFire hooks
 //--------------------------------------------------------------------------------
@@ -42,6 +42,9 @@ class CryFire {
 
 	static bool onChatMessage( EChatMessageType type, EntityId sourceId, EntityId targetId, const char *msg );
 
+	static void onClientConnect( int chnlId );
+	static void onClientDisconnect( int chnlId );
+
  protected:
 
 	static void hookOtherLibs();
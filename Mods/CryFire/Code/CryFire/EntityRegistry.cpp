@@ -0,0 +1,133 @@
+//================================================================================
+// File:    Code/CryFire/EntityRegistry.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Index of entities by class, kept up to date by entity system events
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "EntityRegistry.h"
+
+
+//----------------------------------------------------------------------------------------------------
+EntityRegistry::Sink        EntityRegistry::sink;
+bool                        EntityRegistry::initialized = false;
+EntityRegistry::ClassMap    EntityRegistry::classes;
+EntityRegistry::IndexMap    EntityRegistry::index;
+
+//----------------------------------------------------------------------------------------------------
+void EntityRegistry::initialize()
+{
+	if (initialized)
+		return;
+
+	classes.clear();
+	index.clear();
+	// this is the last full walk, since now we will be told about every new entity
+	IEntityItPtr pIt = gEnv->pEntitySystem->GetEntityIterator();
+	while (!pIt->IsEnd())
+		if (IEntity * pEntity = pIt->Next())
+			add( pEntity );
+
+	gEnv->pEntitySystem->AddSink( &sink );
+	initialized = true;
+}
+
+void EntityRegistry::terminate()
+{
+	if (!initialized)
+		return;
+	gEnv->pEntitySystem->RemoveSink( &sink );
+	classes.clear();
+	index.clear();
+	initialized = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityRegistry::add( IEntity * pEntity )
+{
+	EntityId id = pEntity->GetId();
+	IndexMap::const_iterator it = index.find( id );
+	if (it != index.end()) {
+		if (it->second.pClass == pEntity->GetClass())
+			return;
+		// the id was reused by an entity of another class, while the removal of the old one was missed
+		remove( id );
+	}
+
+	Ids & ids = classes[ pEntity->GetClass() ];
+	Slot slot;
+	slot.pClass = pEntity->GetClass();
+	slot.position = ids.size();
+	ids.push_back( id );
+	index.insert( IndexMap::value_type( id, slot ) );
+}
+
+void EntityRegistry::remove( EntityId id )
+{
+	IndexMap::iterator it = index.find( id );
+	if (it == index.end())
+		return;
+
+	// the order doesn't matter, so move the last one into the hole
+	Ids & ids = classes[ it->second.pClass ];
+	uint position = it->second.position;
+	if (position != ids.size() - 1) {
+		ids[position] = ids.back();
+		index[ ids[position] ].position = position;
+	}
+	ids.pop_back();
+	index.erase( id );
+}
+
+//----------------------------------------------------------------------------------------------------
+void EntityRegistry::Sink::OnSpawn( IEntity * pEntity, SEntitySpawnParams & )
+{
+	EntityRegistry::add( pEntity );
+}
+
+bool EntityRegistry::Sink::OnRemove( IEntity * pEntity )
+{
+	EntityRegistry::remove( pEntity->GetId() );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+EntityRegistry::Ids EntityRegistry::getAllOfClass( IEntityClass * pClass )
+{
+	ClassMap::iterator it = classes.find( pClass );
+	if (!pClass || it == classes.end())
+		return Ids();
+
+	// in case the entity system was reset without telling the sinks
+	Ids & ids = it->second;
+	for (uint i = 0; i < ids.size(); ) {
+		if (gEnv->pEntitySystem->GetEntity( ids[i] ))
+			i++;
+		else
+			remove( ids[i] );   // moves another id to this position
+	}
+	return ids;
+}
+
+EntityRegistry::Ids EntityRegistry::getAllOfClass( const char * className )
+{
+	return getAllOfClass( gEnv->pEntitySystem->GetClassRegistry()->FindClass( className ) );
+}
@@ -0,0 +1,95 @@
+//================================================================================
+// File:    Code/CryFire/EntityRegistry.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Index of entities by class, kept up to date by entity system events
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef ENTITY_REGISTRY_INCLUDED
+#define ENTITY_REGISTRY_INCLUDED
+
+
+#include <IEntitySystem.h>
+#include <FlatHashMap.h>
+
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Code looking for all HQs, factories or energy points used to walk through all entities of the map,
+   which are thousands on Power Struggle maps. The registry listens to spawns and removals instead
+   and keeps ids of entities of every class in a dense list. Actors are not indexed here,
+   IActorSystem already has a list of them. */
+class EntityRegistry {
+
+  public:
+
+	typedef std::vector<EntityId> Ids;
+
+	/* registers the sink and indexes entities, which already exist, call after the entity system is created */
+	static void initialize();
+	static void terminate();
+
+	/* ids of all entities of the class, a copy, because a spawn of an entity of a new class
+	   can rehash the map and move the lists of all classes */
+	static Ids getAllOfClass( IEntityClass * pClass );
+	static Ids getAllOfClass( const char * className );
+
+	/* calls func( IEntity * ) for every entity of the class */
+	template <class Func>
+	static void forEachOfClass( IEntityClass * pClass, Func & func )
+	{
+		Ids ids = getAllOfClass( pClass );
+		for (uint i = 0; i < ids.size(); i++)
+			if (IEntity * pEntity = gEnv->pEntitySystem->GetEntity( ids[i] ))
+				func( pEntity );
+	}
+
+	static uint getCount() { return index.size(); }
+
+
+  protected:
+
+	struct Sink : public IEntitySystemSink {
+		virtual bool OnBeforeSpawn( SEntitySpawnParams & ) { return true; }
+		virtual void OnSpawn( IEntity * pEntity, SEntitySpawnParams & );
+		virtual bool OnRemove( IEntity * pEntity );
+		virtual void OnEvent( IEntity *, SEntityEvent & ) {}
+	};
+
+	struct Slot {
+		IEntityClass * pClass;
+		uint position;   // in the list of the class
+	};
+	typedef FlatHashMap<IEntityClass *, Ids> ClassMap;
+	typedef FlatHashMap<EntityId, Slot> IndexMap;
+
+	static void add( IEntity * pEntity );
+	static void remove( EntityId id );
+
+	static Sink        sink;
+	static bool        initialized;
+	static ClassMap    classes;
+	static IndexMap    index;
+
+};
+
+#endif // ENTITY_REGISTRY_INCLUDED
@@ -0,0 +1,67 @@
+//================================================================================
+// File:    Code/CryFire/EventChain.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Events which are triggered together with the events they follow
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef EVENT_CHAIN_INCLUDED
+#define EVENT_CHAIN_INCLUDED
+
+
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Events numbered from 0 which can follow another event, like the briefing of the MP tutorial, where
+   every message follows the one before it. The user keeps the state of the events and decides whether
+   an event can still be triggered, the chain only knows which events follow which. */
+class EventChain {
+
+  public:
+
+	enum { NONE = -1 };
+
+	EventChain( uint count ) : after( count, (int)NONE ) {}
+
+	/* NONE = the event is triggered only by its own condition */
+	void setAfter( int event, int previous )  { after[event] = previous; }
+	int  getAfter( int event ) const          { return after[event]; }
+
+	/* calls fire for the event, and if it returns true, triggers the events which follow it,
+	   in the order of their numbers, returns what fire returned for the event,
+	   fire must return false for an already triggered event, so that a cycle can't loop forever */
+	template <class Fire>
+	bool trigger( int event, Fire & fire ) const
+	{
+		if (!fire( event ))
+			return false;
+		for (uint i = 0; i < after.size(); i++)
+			if (after[i] == event)
+				trigger( i, fire );
+		return true;
+	}
+
+  protected:
+
+	std::vector<int> after;   // event -> the event it follows
+
+};
+
+#endif // EVENT_CHAIN_INCLUDED
@@ -0,0 +1,571 @@
+//================================================================================
+// File:    Code/CryFire/GameplayRecorder.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Columnar recording of gameplay of all players into a binary file, the file and its conversion
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "GameplayRecorder.h"
+
+#include <IEntitySystem.h>
+
+#include "CryFire/Logging.h"
+
+
+//----------------------------------------------------------------------------------------------------
+const GameplayRecorder::Column GameplayRecorder::columns [NUM_COLUMNS] = {
+	{ "frame", eUInt32 }, { "time", eFloat }, { "entityId", eUInt32 }, { "channel", eUInt16 }, { "team", eUInt8 },
+	{ "posX", eFloat }, { "posY", eFloat }, { "posZ", eFloat }, { "health", eUInt16 }, { "kills", eUInt16 }, { "deaths", eUInt16 },
+	{ "weapon", eString }, { "suitEnergy", eFloat }, { "suitMode", eUInt8 }, { "nightVision", eUInt8 }, { "timesFired", eUInt16 },
+	{ "vehicle", eString }, { "vehicleDamage", eFloat },
+	{ "aiAll", eUInt16 }, { "aiAlertness", eFloat }, { "aiProximity", eUInt16 }, { "aiAlerted", eUInt16 }, { "aiAttacking", eUInt16 }, { "aiInVehicle", eUInt16 }
+};
+
+const char * const GameplayRecorder::eventNames [NUM_EVENTS] = {
+	"itemSelected", "itemPickedUp", "itemDropped",
+	"enteredVehicle", "leftVehicle",
+	"reload", "death", "disconnected",
+	"gameSaved", "gameLoaded"
+};
+
+static const uint typeSizes [GameplayRecorder::NUM_TYPES] = { 1, 2, 4, 4, 2 };
+
+static const uint EVENT_RECORD_SIZE = 1 + 4 + 4 + 4 + 1 + 2 + 4;
+
+bool                                             GameplayRecorder::recording = false;
+HANDLE                                           GameplayRecorder::thread;
+BlockingQueue<GameplayRecorder::Chunk *> *       GameplayRecorder::fullChunks = NULL;
+BlockingQueue<GameplayRecorder::Chunk *> *       GameplayRecorder::freeChunks = NULL;
+GameplayRecorder::Chunk *                        GameplayRecorder::current = NULL;
+std::string                                      GameplayRecorder::fileName;
+uint                                             GameplayRecorder::frame = 0;
+float                                            GameplayRecorder::lastTime = 0.0f;
+GameplayRecorder::CounterMap                     GameplayRecorder::counters;
+GameplayRecorder::ClassStringMap                 GameplayRecorder::classStrings;
+std::map<std::string, ushort>                    GameplayRecorder::strings;
+ushort                                           GameplayRecorder::nextString = 1;
+uint                                             GameplayRecorder::droppedRecords = 0;
+
+//----------------------------------------------------------------------------------------------------
+// this wrapper is here, because CreateThread does not accept static methods
+static DWORD WINAPI writerFunc( LPVOID )
+{
+	GameplayRecorder::run();
+	return 0;
+}
+
+template <class T>
+static inline void put( byte * & pos, T value )
+{
+	memcpy( pos, &value, sizeof(T) );
+	pos += sizeof(T);
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::startFile( const char * name )
+{
+	if (recording)
+		finishFile();
+
+	if (!fullChunks) {
+		// one more place than chunks, so pushing the NULL at the end never blocks
+		fullChunks = new BlockingQueue<Chunk *>( MAX_CHUNKS + 1 );
+		freeChunks = new BlockingQueue<Chunk *>( MAX_CHUNKS + 1 );
+		for (uint i = 0; i < MAX_CHUNKS; i++)
+			freeChunks->push( new Chunk );
+		thread = CreateThread( NULL, 0, (LPTHREAD_START_ROUTINE)writerFunc, NULL, 0, NULL );
+	}
+
+	fileName = name;
+	frame = 0;
+	lastTime = 0.0f;
+	counters.clear();
+	classStrings.clear();
+	strings.clear();
+	nextString = 1;
+	droppedRecords = 0;
+	recording = true;
+
+	// the header is in the first chunk, wait for it, so that the file is always valid
+	current = freeChunks->pop();
+	current->fileName = fileName;
+	current->close = false;
+	current->size = 0;
+	writeHeader();
+}
+
+void GameplayRecorder::finishFile()
+{
+	if (!recording)
+		return;
+
+	submit( true );
+	recording = false;
+}
+
+void GameplayRecorder::stopWriter()
+{
+	finishFile();
+	if (!fullChunks)
+		return;
+
+	fullChunks->push( NULL );
+	WaitForSingleObject( thread, INFINITE );
+	CloseHandle( thread );
+
+	while (freeChunks->count() > 0)
+		delete freeChunks->pop();
+	while (fullChunks->count() > 0)
+		delete fullChunks->pop();
+	delete freeChunks;
+	delete fullChunks;
+	freeChunks = fullChunks = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::run()
+{
+	FILE * file = NULL;
+	while (Chunk * chunk = fullChunks->pop()) {
+		if (!chunk->fileName.empty()) {
+			if (file)
+				fclose( file );
+			file = fopen( chunk->fileName.c_str(), "wb" );
+			if (!file)
+				CF_AsyncError( "gameplay recorder cannot open %s", chunk->fileName.c_str() );
+		}
+		if (file)
+			fwrite( chunk->data, 1, chunk->size, file );
+		if (file && chunk->close) {
+			fclose( file );
+			file = NULL;
+		}
+		freeChunks->push( chunk );
+	}
+	if (file)
+		fclose( file );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* returns place for a record of this size, NULL if there is no free chunk */
+byte * GameplayRecorder::reserve( uint size )
+{
+	if (!current) {
+		// don't wait for the writer, the game would freeze with the disk
+		if (freeChunks->count() == 0)
+			return NULL;
+		current = freeChunks->pop();
+		current->fileName.clear();
+		current->close = false;
+		current->size = 0;
+	}
+	if (current->size + size > CHUNK_SIZE) {
+		submit( false );
+		return reserve( size );
+	}
+	byte * pos = current->data + current->size;
+	current->size += size;
+	return pos;
+}
+
+void GameplayRecorder::submit( bool close )
+{
+	if (!current) {
+		if (!close)
+			return;
+		// the last chunk carries only the request to close the file, this one can wait
+		current = freeChunks->pop();
+		current->fileName.clear();
+		current->size = 0;
+	}
+	current->close = close;
+	fullChunks->push( current );
+	current = NULL;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::writeHeader()
+{
+	uint size = 4 + 4 + 4 + 4;
+	for (uint c = 0; c < NUM_COLUMNS; c++)
+		size += 2 + strlen( columns[c].name );
+	for (uint e = 0; e < NUM_EVENTS; e++)
+		size += 1 + strlen( eventNames[e] );
+
+	byte * pos = reserve( size );
+	memcpy( pos, "CFGR", 4 );
+	pos += 4;
+	put( pos, VERSION );
+	put( pos, (uint)NUM_COLUMNS );
+	for (uint c = 0; c < NUM_COLUMNS; c++) {
+		uint len = strlen( columns[c].name );
+		put( pos, (byte)columns[c].type );
+		put( pos, (byte)len );
+		memcpy( pos, columns[c].name, len );
+		pos += len;
+	}
+	put( pos, (uint)NUM_EVENTS );
+	for (uint e = 0; e < NUM_EVENTS; e++) {
+		uint len = strlen( eventNames[e] );
+		put( pos, (byte)len );
+		memcpy( pos, eventNames[e], len );
+		pos += len;
+	}
+}
+
+ushort GameplayRecorder::writeString( const char * str, bool & ok )
+{
+	// check the limit first, a reserved place has to be filled, otherwise the file is broken
+	if (nextString == 0xFFFF) {
+		ok = false;
+		return NO_STRING;
+	}
+	uint len = min( strlen( str ), (size_t)255 );
+	byte * pos = reserve( 1 + 2 + 1 + len );
+	if (!pos) {
+		ok = false;
+		return NO_STRING;
+	}
+	ushort id = nextString++;
+	put( pos, (byte)'S' );
+	put( pos, id );
+	put( pos, (byte)len );
+	memcpy( pos, str, len );
+	return id;
+}
+
+ushort GameplayRecorder::internClass( IEntityClass * pClass, bool & ok )
+{
+	if (!pClass)
+		return NO_STRING;
+	// classes are looked up by pointer, no string compares in the usual case
+	ClassStringMap::iterator it = classStrings.find( pClass );
+	if (it != classStrings.end())
+		return it->second;
+	ushort id = internString( pClass->GetName(), ok );
+	if (ok)
+		classStrings.insert( ClassStringMap::value_type( pClass, id ) );
+	return id;
+}
+
+ushort GameplayRecorder::internString( const char * str, bool & ok )
+{
+	if (!str || !str[0])
+		return NO_STRING;
+	std::map<std::string, ushort>::iterator it = strings.find( str );
+	if (it != strings.end())
+		return it->second;
+	ushort id = writeString( str, ok );
+	if (ok)
+		strings.insert( std::make_pair( std::string( str ), id ) );
+	return id;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool GameplayRecorder::recordRow( const Value * values )
+{
+	if (!recording)
+		return false;
+
+	uint size = 1;
+	for (uint c = 0; c < NUM_COLUMNS; c++)
+		size += typeSizes[ columns[c].type ];
+	byte * pos = reserve( size );
+	if (!pos) {
+		droppedRecords++;
+		return false;
+	}
+	put( pos, (byte)'R' );
+	for (uint c = 0; c < NUM_COLUMNS; c++) {
+		switch (columns[c].type) {
+			case eUInt8:  put( pos, (byte)min( values[c].u, 0xFFu ) ); break;
+			case eUInt16:
+			case eString: put( pos, (ushort)min( values[c].u, 0xFFFFu ) ); break;
+			case eUInt32: put( pos, values[c].u ); break;
+			case eFloat:  put( pos, values[c].f ); break;
+		}
+	}
+	return true;
+}
+
+void GameplayRecorder::recordEvent( EEvent event, EntityId entityId, const char * str, float value )
+{
+	if (!recording)
+		return;
+
+	bool ok = true;
+	ushort strId = internString( str, ok );
+	byte * pos = ok ? reserve( EVENT_RECORD_SIZE ) : NULL;
+	if (!pos) {
+		droppedRecords++;
+		return;
+	}
+	put( pos, (byte)'E' );
+	put( pos, frame );
+	put( pos, lastTime );
+	put( pos, (uint)entityId );
+	put( pos, (byte)event );
+	put( pos, strId );
+	put( pos, value );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* bounds checked reading of the recorded file */
+class RecordReader {
+ public:
+	RecordReader( const std::vector<byte> & data ) : data( data ), pos( 0 ), failed( false ) {}
+	template <class T> T get()
+	{
+		T value = T();
+		if (pos + sizeof(T) > data.size())
+			failed = true;
+		else
+			memcpy( &value, &data[pos], sizeof(T) );
+		pos += sizeof(T);
+		return value;
+	}
+	std::string getString( uint len )
+	{
+		if (pos + len > data.size()) {
+			failed = true;
+			pos += len;
+			return std::string();
+		}
+		std::string str( (const char *)&data[pos], len );
+		pos += len;
+		return str;
+	}
+	bool atEnd() const { return pos >= data.size(); }
+	bool ok() const { return !failed; }
+ private:
+	const std::vector<byte> & data;
+	size_t pos;
+	bool failed;
+};
+
+/* one cell of the output, row is ended by finishRow */
+class TableWriter {
+ public:
+	TableWriter( FILE * file, bool xml ) : file( file ), xml( xml ), first( true ) {}
+	void startRow()
+	{
+		if (xml)
+			fputs( "   <Row>", file );
+		first = true;
+	}
+	void finishRow()
+	{
+		fputs( xml ? "</Row>\n" : "\n", file );
+	}
+	void number( double value, bool integer )
+	{
+		if (xml)
+			fprintf( file, integer ? "<Cell><Data ss:Type=\"Number\">%.0f</Data></Cell>" : "<Cell><Data ss:Type=\"Number\">%g</Data></Cell>", value );
+		else
+			fprintf( file, integer ? "%s%.0f" : "%s%g", first ? "" : ",", value );
+		first = false;
+	}
+	void text( const std::string & str )
+	{
+		if (xml) {
+			fputs( "<Cell><Data ss:Type=\"String\">", file );
+			for (uint i = 0; i < str.size(); i++) {
+				switch (str[i]) {
+					case '&': fputs( "&amp;", file ); break;
+					case '<': fputs( "&lt;", file ); break;
+					case '>': fputs( "&gt;", file ); break;
+					default:  fputc( str[i], file ); break;
+				}
+			}
+			fputs( "</Data></Cell>", file );
+		} else {
+			// quote the strings always, they can contain the separator
+			fputs( first ? "\"" : ",\"", file );
+			for (uint i = 0; i < str.size(); i++) {
+				if (str[i] == '"')
+					fputc( '"', file );
+				fputc( str[i], file );
+			}
+			fputc( '"', file );
+		}
+		first = false;
+	}
+	void startSheet( const char * name )
+	{
+		if (xml)
+			fprintf( file, " <Worksheet ss:Name=\"%s\">\n  <Table>\n", name );
+	}
+	void finishSheet()
+	{
+		if (xml)
+			fputs( "  </Table>\n </Worksheet>\n", file );
+	}
+ private:
+	FILE * file;
+	bool xml;
+	bool first;
+};
+
+bool GameplayRecorder::convert( const char * inFile, const char * outFile )
+{
+	std::vector<byte> data;
+	FILE * in = fopen( inFile, "rb" );
+	if (!in) {
+		CryLogAlways( "cannot open %s", inFile );
+		return false;
+	}
+	byte buffer [4096];
+	size_t read;
+	while ((read = fread( buffer, 1, sizeof(buffer), in )) > 0)
+		data.insert( data.end(), buffer, buffer + read );
+	fclose( in );
+
+	RecordReader reader( data );
+	if (reader.getString( 4 ) != "CFGR" || reader.get<uint>() != VERSION) {
+		CryLogAlways( "%s is not a gameplay record of version %u", inFile, VERSION );
+		return false;
+	}
+	// the file describes itself, so older files can be read even when the columns change
+	uint numColumns = reader.get<uint>();
+	if (numColumns > 255) {   // a byte in the file would need more
+		CryLogAlways( "%s has a broken header", inFile );
+		return false;
+	}
+	std::vector<Column> fileColumns( numColumns );
+	std::vector<std::string> columnNames( fileColumns.size() );
+	for (uint c = 0; c < fileColumns.size() && reader.ok(); c++) {
+		fileColumns[c].type = (EColumnType)reader.get<byte>();
+		columnNames[c] = reader.getString( reader.get<byte>() );
+	}
+	uint numEventTypes = reader.get<uint>();
+	if (numEventTypes > 255) {
+		CryLogAlways( "%s has a broken header", inFile );
+		return false;
+	}
+	std::vector<std::string> fileEvents( numEventTypes );
+	for (uint e = 0; e < fileEvents.size() && reader.ok(); e++)
+		fileEvents[e] = reader.getString( reader.get<byte>() );
+	if (!reader.ok()) {
+		CryLogAlways( "%s has a broken header", inFile );
+		return false;
+	}
+
+	std::string outName( outFile );
+	bool xml = outName.size() > 4 && stricmp( outName.c_str() + outName.size() - 4, ".xml" ) == 0;
+	std::string eventsName = xml ? outName + ".events.tmp" : outName + ".events.csv";
+	FILE * out = fopen( outName.c_str(), "w" );
+	FILE * events = fopen( eventsName.c_str(), xml ? "w+" : "w" );
+	if (!out || !events) {
+		CryLogAlways( "cannot write %s", !out ? outName.c_str() : eventsName.c_str() );
+		if (out) fclose( out );
+		if (events) fclose( events );
+		return false;
+	}
+	TableWriter frames( out, xml ), eventRows( events, xml );
+
+	if (xml) {
+		fputs( "<?xml version=\"1.0\"?>\n<?mso-application progid=\"Excel.Sheet\"?>\n", out );
+		fputs( "<Workbook xmlns=\"urn:schemas-microsoft-com:office:spreadsheet\" xmlns:ss=\"urn:schemas-microsoft-com:office:spreadsheet\">\n", out );
+	}
+	frames.startSheet( "frames" );
+	frames.startRow();
+	for (uint c = 0; c < columnNames.size(); c++)
+		frames.text( columnNames[c] );
+	frames.finishRow();
+	eventRows.startRow();
+	eventRows.text( "frame" ); eventRows.text( "time" ); eventRows.text( "entityId" );
+	eventRows.text( "event" ); eventRows.text( "string" ); eventRows.text( "value" );
+	eventRows.finishRow();
+
+	std::vector<std::string> stringTable( 1 );
+	uint numRows = 0, numEvents = 0;
+	while (!reader.atEnd() && reader.ok()) {
+		byte tag = reader.get<byte>();
+		if (tag == 'S') {
+			ushort id = reader.get<ushort>();
+			std::string str = reader.getString( reader.get<byte>() );
+			if (id >= stringTable.size())
+				stringTable.resize( id + 1 );
+			stringTable[id] = str;
+		} else if (tag == 'R') {
+			frames.startRow();
+			for (uint c = 0; c < fileColumns.size(); c++) {
+				switch (fileColumns[c].type) {
+					case eUInt8:  frames.number( reader.get<byte>(), true ); break;
+					case eUInt16: frames.number( reader.get<ushort>(), true ); break;
+					case eUInt32: frames.number( reader.get<uint>(), true ); break;
+					case eFloat:  frames.number( reader.get<float>(), false ); break;
+					case eString: {
+						ushort id = reader.get<ushort>();
+						frames.text( id < stringTable.size() ? stringTable[id] : std::string() );
+						break;
+					}
+					default:
+						CryLogAlways( "%s has an unknown type of column %s", inFile, columnNames[c].c_str() );
+						fclose( out );
+						fclose( events );
+						return false;
+				}
+			}
+			frames.finishRow();
+			numRows++;
+		} else if (tag == 'E') {
+			uint frame = reader.get<uint>();
+			float time = reader.get<float>();
+			uint entityId = reader.get<uint>();
+			byte event = reader.get<byte>();
+			ushort id = reader.get<ushort>();
+			float value = reader.get<float>();
+			eventRows.startRow();
+			eventRows.number( frame, true );
+			eventRows.number( time, false );
+			eventRows.number( entityId, true );
+			eventRows.text( event < fileEvents.size() ? fileEvents[event] : std::string() );
+			eventRows.text( id < stringTable.size() ? stringTable[id] : std::string() );
+			eventRows.number( value, false );
+			eventRows.finishRow();
+			numEvents++;
+		} else {
+			CryLogAlways( "%s has an unknown record, the rest is skipped", inFile );
+			break;
+		}
+	}
+	// the last records may be cut off, when the game crashed
+	if (!reader.ok())
+		CryLogAlways( "%s ends in the middle of a record", inFile );
+	frames.finishSheet();
+
+	if (xml) {
+		// events were written aside, the sheets must follow each other
+		fseek( events, 0, SEEK_SET );
+		fprintf( out, " <Worksheet ss:Name=\"events\">\n  <Table>\n" );
+		while ((read = fread( buffer, 1, sizeof(buffer), events )) > 0)
+			fwrite( buffer, 1, read, out );
+		fputs( "  </Table>\n </Worksheet>\n</Workbook>\n", out );
+	}
+	fclose( out );
+	fclose( events );
+	if (xml)
+		remove( eventsName.c_str() );
+
+	CryLogAlways( "%s converted: %u frames, %u events", inFile, numRows, numEvents );
+	return true;
+}
@@ -0,0 +1,182 @@
+//================================================================================
+// File:    Code/CryFire/GameplayRecorder.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Columnar recording of gameplay of all players into a binary file
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef GAMEPLAY_RECORDER_INCLUDED
+#define GAMEPLAY_RECORDER_INCLUDED
+
+
+#include <IGameplayRecorder.h>
+#include <FlatHashMap.h>
+
+#include "BlockingQueue.h"
+
+#include <vector>
+#include <string>
+#include <map>
+
+#undef GetUserName       // windows.h defines some stupid macros, which overwrites Crysis methods names
+#undef GetCommandLine
+
+struct IActor;
+
+typedef unsigned int uint;
+typedef unsigned short ushort;
+typedef unsigned char byte;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Samples the state of every player in regular intervals into rows of a fixed set of typed columns
+   and records gameplay events in between. The records are packed into chunks of a fixed size,
+   full chunks are written into a binary file by a background thread and come back to be reused,
+   so the memory doesn't grow with the length of the recording. When the writer can't keep up,
+   records are dropped and counted. Class names and other strings are stored only once in the file.
+
+   File format (little endian):
+     header  "CFGR", uint version, uint number of columns, { byte type, byte name length, name } per column,
+             uint number of event types, { byte name length, name } per event type
+     records byte tag and its data:
+       'S'  ushort string id, byte length, characters            (string table, before its first use)
+       'R'  values of all columns, sizes according to their types
+       'E'  uint frame, float time, uint entity id, byte event, ushort string id, float value
+   String id 0 is always the empty string. The players are sampled in GameplayRecorderSampling.cpp. */
+class GameplayRecorder {
+
+  public:
+
+	static const uint VERSION = 1;
+	static const uint CHUNK_SIZE = 64 * 1024;
+	static const uint MAX_CHUNKS = 16;            // 1 MB at most, including the chunks being written
+	static const ushort NO_STRING = 0;
+
+	enum EColumnType {
+		eUInt8 = 0,
+		eUInt16,
+		eUInt32,
+		eFloat,
+		eString,      // ushort id into the string table
+		NUM_TYPES
+	};
+	enum EColumn {
+		eFrame = 0, eTime, eEntityId, eChannel, eTeam,
+		ePosX, ePosY, ePosZ, eHealth, eKills, eDeaths,
+		eWeapon, eSuitEnergy, eSuitMode, eNightVision, eTimesFired,
+		eVehicle, eVehicleDamage,
+		eAIAll, eAIAlertness, eAIProximity, eAIAlerted, eAIAttacking, eAIInVehicle,   // only for the local player
+		NUM_COLUMNS
+	};
+	enum EEvent {
+		eItemSelected = 0, eItemPickedUp, eItemDropped,
+		eEnteredVehicle, eLeftVehicle,
+		eReload, eDeath, eDisconnected,
+		eGameSaved, eGameLoaded,
+		NUM_EVENTS
+	};
+
+	struct Column {
+		const char * name;
+		EColumnType type;
+	};
+	union Value {
+		uint u;
+		float f;
+	};
+
+	static const Column       columns [NUM_COLUMNS];
+	static const char * const eventNames [NUM_EVENTS];
+
+	/* starts recording into a new file, the previous recording is finished */
+	static void start( const char * fileName );
+	/* finishes the file, the rest is written in the background */
+	static void stop();
+	/* stops the writer thread, waits until everything is written */
+	static void terminate();
+	static bool isRecording() { return recording; }
+
+	/* the same without the gameplay listener, start, stop and terminate call these, tests directly */
+	static void startFile( const char * fileName );
+	static void finishFile();
+	static void stopWriter();
+
+	/* adds a row for every player, call it in regular intervals */
+	static void recordFrame( float time );
+	/* packs a row of values of all columns, returns false if it was dropped */
+	static bool recordRow( const Value * values );
+	/* str is a name of a class, a file and so on */
+	static void recordEvent( EEvent event, EntityId entityId, const char * str, float value = 0.0f );
+
+	/* converts a recorded file to CSV (events go to <outFile>.events.csv) or,
+	   if outFile ends with .xml, to an Excel XML workbook with a sheet of frames and a sheet of events */
+	static bool convert( const char * inFile, const char * outFile );
+
+	static uint getDroppedRecords() { return droppedRecords; }
+
+	/* PRIVATE!! This method has to be public because of implementation reasons, don't call it */
+	static void run();
+
+
+  protected:
+
+	struct Chunk {
+		std::string fileName;   // the writer opens this file before writing the data, if not empty
+		bool close;             // the writer closes the file after writing the data
+		uint size;
+		byte data [CHUNK_SIZE];
+	};
+	struct PlayerCounters {
+		uint kills;
+		uint deaths;
+		uint timesFired;        // since the last frame
+		PlayerCounters() : kills(0), deaths(0), timesFired(0) {}
+	};
+	struct Listener : public IGameplayListener {
+		virtual void OnGameplayEvent( IEntity * pEntity, const GameplayEvent & event );
+	};
+	typedef FlatHashMap<EntityId, PlayerCounters> CounterMap;
+	typedef FlatHashMap<IEntityClass *, ushort> ClassStringMap;
+
+	static void   sampleActor( IActor * pActor, float time );
+	static byte * reserve( uint size );
+	static void   submit( bool close );
+	static ushort internClass( IEntityClass * pClass, bool & ok );
+	static ushort internString( const char * str, bool & ok );
+	static ushort writeString( const char * str, bool & ok );
+	static void   writeHeader();
+
+	static Listener                      listener;
+	static bool                          recording;
+	static HANDLE                        thread;
+	static BlockingQueue<Chunk *> *      fullChunks;   // to the writer, NULL stops it
+	static BlockingQueue<Chunk *> *      freeChunks;   // back from the writer
+	static Chunk *                       current;
+	static std::string                   fileName;
+	static uint                          frame;
+	static float                         lastTime;
+	static CounterMap                    counters;
+	static ClassStringMap                classStrings;
+	static std::map<std::string, ushort> strings;
+	static ushort                        nextString;
+	static uint                          droppedRecords;
+
+};
+
+#endif // GAMEPLAY_RECORDER_INCLUDED
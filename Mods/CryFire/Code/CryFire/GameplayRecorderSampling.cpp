@@ -0,0 +1,210 @@
+//================================================================================
+// File:    Code/CryFire/GameplayRecorderSampling.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Sampling of the players and their gameplay events for GameplayRecorder
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "GameplayRecorder.h"
+
+#include "CryFire/Logging.h"
+#include "Game.h"
+#include "GameRules.h"
+#include "Player.h"
+#include "NanoSuit.h"
+#include "HUD/HUD.h"
+#include "HUD/HUDRadar.h"
+
+#include <IActorSystem.h>
+#include <IItemSystem.h>
+#include <IVehicleSystem.h>
+#include <IAgent.h>
+
+
+//----------------------------------------------------------------------------------------------------
+GameplayRecorder::Listener  GameplayRecorder::listener;
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::start( const char * name )
+{
+	if (recording)
+		stop();
+
+	startFile( name );
+	g_pGame->GetIGameFramework()->GetIGameplayRecorder()->RegisterListener( &listener );
+	CF_Log( 2, "recording gameplay into %s", fileName.c_str() );
+}
+
+void GameplayRecorder::stop()
+{
+	if (!recording)
+		return;
+
+	g_pGame->GetIGameFramework()->GetIGameplayRecorder()->UnregisterListener( &listener );
+	finishFile();
+	if (droppedRecords)
+		CF_Log( 1, "gameplay recording %s: %u records dropped, the disk is too slow", fileName.c_str(), droppedRecords );
+}
+
+void GameplayRecorder::terminate()
+{
+	stop();
+	stopWriter();
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::recordFrame( float time )
+{
+	if (!recording)
+		return;
+
+	frame++;
+	lastTime = time;
+	IActorIteratorPtr pIt = g_pGame->GetIGameFramework()->GetIActorSystem()->CreateActorIterator();
+	while (IActor * pActor = pIt->Next())
+		if (pActor->IsPlayer())
+			sampleActor( pActor, time );
+}
+
+void GameplayRecorder::sampleActor( IActor * pActor, float time )
+{
+	CActor * pCActor = static_cast<CActor *>( pActor );
+	IEntity * pEntity = pActor->GetEntity();
+	EntityId id = pEntity->GetId();
+	PlayerCounters & cnt = counters[ id ];
+	bool ok = true;
+
+	Value values [NUM_COLUMNS];
+	memset( values, 0, sizeof(values) );
+	values[eFrame].u = frame;
+	values[eTime].f = time;
+	values[eEntityId].u = id;
+	values[eChannel].u = pCActor->GetChannelId();
+	if (CGameRules * pGameRules = g_pGame->GetGameRules())
+		values[eTeam].u = pGameRules->GetTeam( id );
+	const Vec3 & worldPos = pEntity->GetWorldPos();
+	values[ePosX].f = worldPos.x;
+	values[ePosY].f = worldPos.y;
+	values[ePosZ].f = worldPos.z;
+	values[eHealth].u = max( pActor->GetHealth(), 0 );
+	values[eKills].u = cnt.kills;
+	values[eDeaths].u = cnt.deaths;
+	if (IItem * pItem = pActor->GetCurrentItem())
+		values[eWeapon].u = internClass( pItem->GetEntity()->GetClass(), ok );
+	values[eTimesFired].u = cnt.timesFired;
+
+	if (pCActor->GetActorClass() == CPlayer::GetActorClassType()) {
+		if (CNanoSuit * pSuit = static_cast<CPlayer *>( pCActor )->GetNanoSuit()) {
+			values[eSuitEnergy].f = pSuit->GetSuitEnergy();
+			values[eSuitMode].u = pSuit->GetMode();
+			values[eNightVision].u = pSuit->IsNightVisionEnabled() ? 1 : 0;
+		}
+	}
+
+	if (IVehicle * pVehicle = pActor->GetLinkedVehicle()) {
+		values[eVehicle].u = internClass( pVehicle->GetEntity()->GetClass(), ok );
+		values[eVehicleDamage].f = pVehicle->GetDamageRatio( true );
+	}
+
+	// only the local player has the radar with AI around
+	CHUDRadar * pRadar = pActor->IsClient() && g_pGame->GetHUD() ? g_pGame->GetHUD()->GetRadar() : NULL;
+	if (pRadar) {
+		IAIObject * pPlayerAI = pEntity->GetAI();
+		const std::vector<EntityId> & nearby = *pRadar->GetNearbyEntities();
+		for (uint i = 0; i < nearby.size(); i++) {
+			IEntity * pNearby = gEnv->pEntitySystem->GetEntity( nearby[i] );
+			IAIObject * pAI = pNearby ? pNearby->GetAI() : NULL;
+			if (!pAI)
+				continue;
+			values[eAIAll].u++;
+			if (!pAI->IsHostile( pPlayerAI, false ))
+				continue;
+			values[eAIProximity].u++;
+			if (IUnknownProxy * pAIProxy = pAI->GetProxy()) {
+				int alertness = pAIProxy->GetAlertnessState();
+				if (alertness == 1)
+					values[eAIAlerted].u++;
+				else if (alertness > 1)
+					values[eAIAttacking].u++;
+				if (pAIProxy->GetLinkedVehicleEntityId())
+					values[eAIInVehicle].u++;
+			}
+		}
+		values[eAIAlertness].f = pRadar->GetStealthValue();
+	}
+
+	if (!ok) {
+		droppedRecords++;
+		return;
+	}
+	if (recordRow( values ))
+		cnt.timesFired = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void GameplayRecorder::Listener::OnGameplayEvent( IEntity * pEntity, const GameplayEvent & event )
+{
+	if (!pEntity)
+		return;
+	EntityId id = pEntity->GetId();
+	IGameFramework * pGameFW = g_pGame->GetIGameFramework();
+
+	switch (event.event) {
+		case eGE_Kill:
+			counters[id].kills++;
+			break;
+		case eGE_Death:
+			counters[id].deaths++;
+			recordEvent( eDeath, id, NULL );
+			break;
+		case eGE_WeaponShot:
+			counters[id].timesFired++;
+			break;
+		case eGE_WeaponReload:
+			recordEvent( eReload, id, NULL );
+			break;
+		case eGE_Disconnected:
+			recordEvent( eDisconnected, id, NULL );
+			counters.erase( id );
+			break;
+		case eGE_ItemSelected:
+		case eGE_ItemPickedUp:
+		case eGE_ItemDropped: {
+			IItem * pItem = event.extra ? pGameFW->GetIItemSystem()->GetItem( EntityId((int)event.extra) ) : NULL;
+			if (!pItem)
+				break;
+			EEvent recEvent = event.event == eGE_ItemSelected ? eItemSelected : event.event == eGE_ItemPickedUp ? eItemPickedUp : eItemDropped;
+			recordEvent( recEvent, id, pItem->GetEntity()->GetClass()->GetName() );
+			break;
+		}
+		case eGE_EnteredVehicle:
+		case eGE_LeftVehicle: {
+			IVehicle * pVehicle = event.extra ? pGameFW->GetIVehicleSystem()->GetVehicle( EntityId((int)event.extra) ) : NULL;
+			EEvent recEvent = event.event == eGE_EnteredVehicle ? eEnteredVehicle : eLeftVehicle;
+			recordEvent( recEvent, id, pVehicle ? pVehicle->GetEntity()->GetClass()->GetName() : NULL, (float)(int)event.extra );
+			break;
+		}
+		default:
+			break;
+	}
+}
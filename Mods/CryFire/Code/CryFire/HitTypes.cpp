@@ -0,0 +1,110 @@
+//================================================================================
+// File:    Code/CryFire/HitTypes.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Hit type names and ids of the game rules, looked up without comparing strings
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "HitTypes.h"
+
+
+//----------------------------------------------------------------------------------------------------
+HitTypes::HitTypes()
+ : lastId(0)
+{
+}
+
+int HitTypes::registerType( const char * type )
+{
+	if (int id = getId( type ))
+		return id;
+
+	names.insert( NameMap::value_type( ++lastId, type ) );
+	ids.insert( IdMap::value_type( CCryName( type ), lastId ) );   // keeps the first spelling
+	addresses.clear();   // may have remembered this type as unknown
+	return lastId;
+}
+
+int HitTypes::getId( const char * type ) const
+{
+	if (!type)
+		return 0;
+	// only finds the name, names that were never interned can't be registered hit types
+	return findId( ids.find( CCryName( type, true ) ), type );
+}
+
+int HitTypes::getId( const CCryName & type ) const
+{
+	return findId( ids.find( type ), type.c_str() );
+}
+
+int HitTypes::findId( IdMap::const_iterator indexed, const char * type ) const
+{
+	if (indexed == ids.end())
+		return 0;
+	if (names.find( indexed->second )->second == type)
+		return indexed->second;
+
+	// another spelling of an indexed name
+	for (NameMap::const_iterator it = names.begin(); it != names.end(); ++it)
+		if (it->second == type)
+			return it->first;
+	return 0;
+}
+
+int HitTypes::getIdByAddress( const char * type ) const
+{
+	AddressMap::const_iterator it = addresses.find( type );
+	if (it != addresses.end())
+		return it->second;
+
+	int id = getId( type );
+	addresses.insert( AddressMap::value_type( type, id ) );
+	return id;
+}
+
+const char * HitTypes::getName( int id ) const
+{
+	NameMap::const_iterator it = names.find( id );
+	if (it == names.end())
+		return NULL;
+	return it->second.c_str();
+}
+
+void HitTypes::reset()
+{
+	names.clear();
+	ids.clear();
+	addresses.clear();
+	lastId = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void HitTypes::GetMemoryUsage( ICrySizer * s ) const
+{
+	names.GetMemoryUsage( s );
+	ids.GetMemoryUsage( s );
+	addresses.GetMemoryUsage( s );
+	for (NameMap::const_iterator it = names.begin(); it != names.end(); ++it)
+		s->Add( it->second );
+}
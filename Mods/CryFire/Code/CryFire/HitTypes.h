@@ -0,0 +1,77 @@
+//================================================================================
+// File:    Code/CryFire/HitTypes.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Hit type names and ids of the game rules, looked up without comparing strings
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef HIT_TYPES_INCLUDED
+#define HIT_TYPES_INCLUDED
+
+
+#include <CryName.h>
+#include <FlatHashMap.h>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Registered hit types of CGameRules. Names are indexed by CCryName, so a lookup is a pointer hash
+   instead of comparing every registered name. The name table ignores case, but hit types don't,
+   so the index only holds the first registered spelling and the other spellings are found by a scan.
+   Doesn't touch anything but the name table, CGameRules forwards its hit type methods here. */
+class HitTypes {
+
+  public:
+
+	HitTypes();
+
+	/* returns the id of the type, registers it if it's new */
+	int registerType( const char * type );
+	/* 0 if the type isn't registered */
+	int getId( const char * type ) const;
+	int getId( const CCryName & type ) const;
+	/* only for strings that are never freed or changed (interned item strings, literals),
+	   otherwise a new string at the same address would get the old id */
+	int getIdByAddress( const char * type ) const;
+	/* NULL if the id isn't registered */
+	const char * getName( int id ) const;
+	uint getCount() const  { return names.size(); }
+	void reset();
+
+	void GetMemoryUsage( ICrySizer * s ) const;
+
+
+  protected:
+
+	typedef FlatHashMap<int, string> NameMap;
+	typedef FlatHashMap<CCryName, int, stl::flat_hash_cryname<CCryName> > IdMap;
+	typedef FlatHashMap<const char *, int> AddressMap;
+
+	/* id of the indexed spelling, if it's the same as the type, otherwise scans all names */
+	int findId( IdMap::const_iterator indexed, const char * type ) const;
+
+	NameMap             names;
+	IdMap               ids;
+	mutable AddressMap  addresses;   // filled lazily by getIdByAddress
+	int                 lastId;
+
+};
+
+#endif // HIT_TYPES_INCLUDED
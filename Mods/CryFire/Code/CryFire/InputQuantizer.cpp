@@ -0,0 +1,60 @@
+//================================================================================
+// File:    Code/CryFire/InputQuantizer.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Player input reduced to the precision worth resending to other clients
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "InputQuantizer.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static int quantizeRange( float value, float minValue, float maxValue, int steps )
+{
+	float t = (clamp_tpl(value, minValue, maxValue) - minValue) / (maxValue - minValue);
+	return (int)floorf( t * steps + 0.5f );
+}
+
+void SQuantizedInput::quantize( const SSerializedPlayerInput & input, int moveBits, int yawBits, int pitchBits )
+{
+	moveBits = clamp_tpl(moveBits, 2, 8);
+	yawBits = clamp_tpl(yawBits, 4, 16);
+	pitchBits = clamp_tpl(pitchBits, 4, 16);
+
+	stance = input.stance;
+	flags = (input.sprint ? 1 : 0) | (input.leanl ? 2 : 0) | (input.leanr ? 4 : 0);
+
+	// symmetric around zero, so that zero movement always stays exactly zero
+	int moveSteps = (1 << (moveBits - 1)) - 1;
+	for (int i = 0; i < 3; i++)
+		move[i] = (int8)(quantizeRange( input.deltaMovement[i], -1.0f, 1.0f, 2 * moveSteps ) - moveSteps);
+
+	// yaw wraps around, so -pi and pi end up in the same step
+	int yawSteps = 1 << yawBits;
+	float yawAngle = cry_atan2f( -input.lookDirection.x, input.lookDirection.y );
+	yaw = (uint16)(quantizeRange( yawAngle, -gf_PI, gf_PI, yawSteps ) & (yawSteps - 1));
+
+	int pitchSteps = (1 << pitchBits) - 1;
+	float pitchAngle = asinf( clamp_tpl(input.lookDirection.z, -1.0f, 1.0f) );
+	pitch = (uint16)quantizeRange( pitchAngle, -gf_PI * 0.5f, gf_PI * 0.5f, pitchSteps );
+}
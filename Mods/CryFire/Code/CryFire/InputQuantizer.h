@@ -0,0 +1,62 @@
+//================================================================================
+// File:    Code/CryFire/InputQuantizer.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Player input reduced to the precision worth resending to other clients
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef INPUT_QUANTIZER_INCLUDED
+#define INPUT_QUANTIZER_INCLUDED
+
+
+#include "IPlayerInput.h"
+
+
+//----------------------------------------------------------------------------------------------------
+/* Input reduced to the precision which is worth sending to other clients, the server marks the input aspect
+   dirty only when this changes since the last time it was marked. Comparing is always done against the state
+   from the last time the aspect was marked dirty, not against the previous input, so slow continuous turning
+   still gets sent each time it crosses a quantization step. Input which other clients see and the newest input
+   always lie in the same step, so the error is below:
+     deltaMovement   1 / (2^(bits-1) - 1)   per axis (1.6% with 7 bits)
+     yaw             2*pi / 2^bits          radians (0.088 deg with 12 bits)
+     pitch           pi / (2^bits - 1)      radians (0.088 deg with 11 bits)
+   The wire format stays the same, so vanilla clients are not affected. */
+struct SQuantizedInput {
+
+	uint8 stance;
+	uint8 flags;     // sprint, leanl, leanr
+	int8 move[3];    // deltaMovement components
+	uint16 yaw;      // lookDirection
+	uint16 pitch;
+
+	/* bits are clamped to 2-8 for movement and 4-16 for yaw and pitch */
+	void quantize( const SSerializedPlayerInput & input, int moveBits, int yawBits, int pitchBits );
+
+	bool operator==( const SQuantizedInput & other ) const
+	{
+		return stance == other.stance && flags == other.flags
+		    && move[0] == other.move[0] && move[1] == other.move[1] && move[2] == other.move[2]
+		    && yaw == other.yaw && pitch == other.pitch;
+	}
+	bool operator!=( const SQuantizedInput & other ) const { return !(*this == other); }
+
+};
+
+#endif // INPUT_QUANTIZER_INCLUDED
@@ -0,0 +1,130 @@
+//================================================================================
+// File:    Code/CryFire/InterestGrid.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Spatial index of clients for deciding which entities interest them
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "InterestGrid.h"
+
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------------------------------
+const float InterestGrid::VIEW_COS = 0.707f;   // half-angle of the view cone is 45 degrees
+const int InterestGrid::VIEW_CELLS = 2;        // view range is 2 * radius and cell size is the radius
+
+InterestGrid::InterestGrid()
+ : cellSize(200.0f)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void InterestGrid::reset( float cellSize )
+{
+	observers.clear();
+	cells.clear();
+	teams.clear();
+	this->cellSize = cellSize;
+}
+
+void InterestGrid::addObserver( int chnlId, const Vec3 & pos, const Vec3 & dir, int team )
+{
+	Observer & observer = observers[ chnlId ];
+	observer.pos = pos;
+	observer.dir = dir;
+	observer.team = team;
+
+	cells[ getCell( cellCoord( pos.x ), cellCoord( pos.y ) ) ].push_back( chnlId );
+	if (team)
+		teams[ team ].push_back( chnlId );
+}
+
+/* the channel stays in its cell and team until the next reset, lookups skip channels without an observer */
+void InterestGrid::removeObserver( int chnlId )
+{
+	observers.erase( chnlId );
+}
+
+//----------------------------------------------------------------------------------------------------
+uint InterestGrid::getCell( int x, int y )
+{
+	return ((uint)(x & 0xFFFF) << 16) | (uint)(y & 0xFFFF);
+}
+
+bool InterestGrid::observes( const Observer & observer, const Vec3 & pos, int team ) const
+{
+	if (team != 0 && team == observer.team)
+		return true;
+
+	Vec3 diff = pos - observer.pos;
+	float dist2 = diff.GetLengthSquared();
+	if (dist2 <= cellSize * cellSize)
+		return true;
+
+	// things in front of the player are interesting further away, the player may be looking through a scope
+	float viewRange = VIEW_CELLS * cellSize;
+	return dist2 <= viewRange * viewRange && diff.Dot( observer.dir ) >= VIEW_COS * sqrtf( dist2 );
+}
+
+//----------------------------------------------------------------------------------------------------
+bool InterestGrid::isInterested( int chnlId, const Vec3 & pos, int team ) const
+{
+	ObserverMap::const_iterator observer = observers.find( chnlId );
+	if (observer == observers.end())
+		return true;
+
+	return observes( observer->second, pos, team );
+}
+
+void InterestGrid::getInterested( const Vec3 & pos, int team, std::vector<int> & channels ) const
+{
+	channels.clear();
+
+	int cx = cellCoord( pos.x );
+	int cy = cellCoord( pos.y );
+	for (int x = cx - VIEW_CELLS; x <= cx + VIEW_CELLS; x++) {
+		for (int y = cy - VIEW_CELLS; y <= cy + VIEW_CELLS; y++) {
+			CellMap::const_iterator cell = cells.find( getCell( x, y ) );
+			if (cell == cells.end())
+				continue;
+			for (std::vector<int>::const_iterator chnl = cell->second.begin(); chnl != cell->second.end(); chnl++) {
+				ObserverMap::const_iterator observer = observers.find( *chnl );
+				if (observer != observers.end() && observes( observer->second, pos, team ))
+					channels.push_back( *chnl );
+			}
+		}
+	}
+
+	if (team) {
+		TeamMap::const_iterator teamChnls = teams.find( team );
+		if (teamChnls != teams.end()) {
+			for (std::vector<int>::const_iterator chnl = teamChnls->second.begin(); chnl != teamChnls->second.end(); chnl++)
+				if (isKnown( *chnl ))
+					channels.push_back( *chnl );
+		}
+	}
+
+	std::sort( channels.begin(), channels.end() );
+	channels.erase( std::unique( channels.begin(), channels.end() ), channels.end() );
+}
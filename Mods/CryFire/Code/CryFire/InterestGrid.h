@@ -0,0 +1,89 @@
+//================================================================================
+// File:    Code/CryFire/InterestGrid.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Spatial index of clients for deciding which entities interest them
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef INTEREST_GRID_INCLUDED
+#define INTEREST_GRID_INCLUDED
+
+
+#include <Cry_Math.h>
+
+#include <map>
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Positions, view directions and teams of the clients, sorted into horizontal cells of the size of the radius.
+   An entity is interesting for a client, if it's in the client's team, closer than the radius, or in the
+   client's view cone and closer than VIEW_CELLS radii. Channels which are not in the grid are interested
+   in everything. Doesn't touch the engine, Relevancy fills it from the actors. */
+class InterestGrid {
+
+  public:
+
+	static const float VIEW_COS;   // cosine of the half-angle of the view cone
+	static const int VIEW_CELLS;   // view range in cells
+
+	InterestGrid();
+
+	/* removes all observers and sets the radius for the next ones */
+	void reset( float cellSize );
+	void addObserver( int chnlId, const Vec3 & pos, const Vec3 & dir, int team );
+	void removeObserver( int chnlId );
+
+	bool isEmpty() const           { return observers.empty(); }
+	uint getObserverCount() const  { return observers.size(); }
+	uint getCellCount() const      { return cells.size(); }
+	float getCellSize() const      { return cellSize; }
+
+	/* whether an entity at pos in the team is interesting for the channel */
+	bool isInterested( int chnlId, const Vec3 & pos, int team ) const;
+	/* known channels interested in an entity at pos in the team, sorted, only looks at the surrounding cells */
+	void getInterested( const Vec3 & pos, int team, std::vector<int> & channels ) const;
+	bool isKnown( int chnlId ) const  { return observers.find( chnlId ) != observers.end(); }
+
+
+  protected:
+
+	struct Observer {
+		Vec3 pos;
+		Vec3 dir;
+		int team;
+	};
+	typedef std::map<int, Observer> ObserverMap;             // key is channel id
+	typedef std::map<uint, std::vector<int> > CellMap;       // key is packed cell coordinates, value are channel ids
+	typedef std::map<int, std::vector<int> > TeamMap;        // key is team id, value are channel ids
+
+	int cellCoord( float value ) const  { return (int)floorf( value / cellSize ); }
+	static uint getCell( int x, int y );
+	bool observes( const Observer & observer, const Vec3 & pos, int team ) const;
+
+	ObserverMap  observers;
+	CellMap      cells;
+	TeamMap      teams;
+	float        cellSize;
+
+};
+
+#endif // INTEREST_GRID_INCLUDED
@@ -0,0 +1,374 @@
+//================================================================================
+// File:    Code/CryFire/Jobs.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Worker threads running a graph of game jobs every frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "Jobs.h"
+
+#include "CryFire/Logging.h"
+
+#include <Game.h>
+#include <GameCVars.h>
+
+#include <windows.h>
+
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Jobs::Job>                  Jobs::jobs;
+Jobs::Worker                            Jobs::workers [MAX_WORKERS];
+uint                                    Jobs::numWorkers = 0;
+volatile bool                           Jobs::running = false;
+HANDLE                                  Jobs::workSem;
+HANDLE                                  Jobs::mainEvent;
+CRITICAL_SECTION                        Jobs::mainLock;
+std::deque<Jobs::jobId>                 Jobs::mainQueue;
+volatile LONG                           Jobs::remaining = 0;
+bool                                    Jobs::inFrame = false;
+bool                                    Jobs::parallel = false;
+float                                   Jobs::budgetMs = 0.0f;
+LARGE_INTEGER                           Jobs::frameStart;
+LARGE_INTEGER                           Jobs::frequency;
+std::map<std::string, Jobs::JobStats>   Jobs::stats;
+uint                                    Jobs::frames = 0;
+
+//----------------------------------------------------------------------------------------------------
+// this wrapper is here, because CreateThread does not accept static methods
+static DWORD WINAPI workerFunc( LPVOID param )
+{
+	Jobs::run( (uint)(size_t)param );
+	return 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Jobs::initialize( uint workerCount )
+{
+	if (running) // already initialized
+		return;
+
+	if (workerCount == 0) {
+		SYSTEM_INFO sysInfo;
+		GetSystemInfo( &sysInfo );
+		workerCount = sysInfo.dwNumberOfProcessors > 1 ? sysInfo.dwNumberOfProcessors - 1 : 1;
+	}
+	if (workerCount > MAX_WORKERS)
+		workerCount = MAX_WORKERS;
+
+	QueryPerformanceFrequency( &frequency );
+	InitializeCriticalSection( &mainLock );
+	workSem = CreateSemaphore( NULL, 0, LONG_MAX, NULL );
+	mainEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+	running = true;
+
+	CF_Log( 2, "starting %u threads for game jobs", workerCount );
+	for (numWorkers = 0; numWorkers < workerCount; numWorkers++) {
+		InitializeCriticalSection( &workers[numWorkers].lock );
+		workers[numWorkers].thread = CreateThread( NULL, 0, workerFunc, (LPVOID)(size_t)numWorkers, 0, NULL );
+	}
+}
+
+void Jobs::terminate()
+{
+	if (!running || inFrame)
+		return;
+
+	CF_Log( 2, "terminating threads for game jobs" );
+	running = false;
+	ReleaseSemaphore( workSem, numWorkers, NULL ); // wake them up, so they can see they should quit
+	for (uint i = 0; i < numWorkers; i++) {
+		WaitForSingleObject( workers[i].thread, INFINITE );
+		CloseHandle( workers[i].thread );
+		DeleteCriticalSection( &workers[i].lock );
+	}
+	numWorkers = 0;
+	CloseHandle( workSem );
+	CloseHandle( mainEvent );
+	DeleteCriticalSection( &mainLock );
+	jobs.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+Jobs::jobId Jobs::add( const char * name, job_t func, void * arg, uint flags )
+{
+	if (inFrame) {
+		CF_LogError( "job %s added between beginFrame and endFrame, dropping it", name );
+		return NO_JOB;
+	}
+
+	for (uint i = 0; i < jobs.size(); i++)
+		if (jobs[i].func == func && jobs[i].arg == arg)
+			return (jobId)i;
+
+	jobs.push_back( Job() );
+	Job & job = jobs.back();
+	job.name = name;
+	job.func = func;
+	job.arg = arg;
+	job.flags = flags;
+	job.pendingDeps = 0;
+	job.state = eWaiting;
+	job.duration = 0.0f;
+	return (jobId)jobs.size() - 1;
+}
+
+void Jobs::addDependency( jobId job, jobId prerequisite )
+{
+	if (inFrame || job == NO_JOB || prerequisite == NO_JOB || job == prerequisite)
+		return;
+	std::vector<jobId> & prerequisites = jobs[job].prerequisites;
+	for (uint i = 0; i < prerequisites.size(); i++)
+		if (prerequisites[i] == prerequisite)
+			return;
+	prerequisites.push_back( prerequisite );
+	jobs[prerequisite].dependents.push_back( job );
+}
+
+//----------------------------------------------------------------------------------------------------
+void Jobs::push( jobId id, int workerIdx )
+{
+	if (!running) // endFrame finds the ready jobs itself
+		return;
+
+	if (!parallel || (jobs[id].flags & eMainThread)) {
+		EnterCriticalSection( &mainLock );
+		mainQueue.push_back( id );
+		LeaveCriticalSection( &mainLock );
+		SetEvent( mainEvent );
+		return;
+	}
+
+	// the worker which finished the prerequisite continues with the dependent job, data are still in its cache
+	static uint nextWorker = 0;
+	Worker & worker = workers[ workerIdx >= 0 ? workerIdx : nextWorker++ % numWorkers ];
+	EnterCriticalSection( &worker.lock );
+	worker.queue.push_back( id );
+	LeaveCriticalSection( &worker.lock );
+	ReleaseSemaphore( workSem, 1, NULL );
+}
+
+bool Jobs::pop( int workerIdx, jobId & id )
+{
+	// own jobs from the back, the last pushed are the most likely to have data in cache
+	if (workerIdx >= 0) {
+		Worker & worker = workers[workerIdx];
+		EnterCriticalSection( &worker.lock );
+		bool found = !worker.queue.empty();
+		if (found) {
+			id = worker.queue.back();
+			worker.queue.pop_back();
+		}
+		LeaveCriticalSection( &worker.lock );
+		if (found)
+			return true;
+	}
+
+	// steal from the front of the others
+	for (uint i = 1; i <= numWorkers; i++) {
+		Worker & victim = workers[ (workerIdx + i) % numWorkers ];
+		EnterCriticalSection( &victim.lock );
+		bool found = !victim.queue.empty();
+		if (found) {
+			id = victim.queue.front();
+			victim.queue.pop_front();
+		}
+		LeaveCriticalSection( &victim.lock );
+		if (found)
+			return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+float Jobs::elapsedMs( const LARGE_INTEGER & since )
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter( &now );
+	return (float)(now.QuadPart - since.QuadPart) * 1000.0f / (float)frequency.QuadPart;
+}
+
+void Jobs::execute( jobId id, int workerIdx )
+{
+	Job & job = jobs[id];
+
+	if ((job.flags & eDeferrable) && budgetMs > 0.0f && elapsedMs( frameStart ) > budgetMs) {
+		postpone( id );
+		return;
+	}
+
+	job.state = eStarted;
+	LARGE_INTEGER start;
+	QueryPerformanceCounter( &start );
+	job.func( job.arg );
+	job.duration = elapsedMs( start );
+	job.state = eDone;
+
+	for (uint i = 0; i < job.dependents.size(); i++)
+		if (InterlockedDecrement( &jobs[ job.dependents[i] ].pendingDeps ) == 0)
+			push( job.dependents[i], workerIdx );
+
+	if (InterlockedDecrement( &remaining ) == 0 && running)
+		SetEvent( mainEvent );
+}
+
+void Jobs::postpone( jobId id )
+{
+	// dependents can't be started yet, because this one isn't finished, so they are postponed too
+	Job & job = jobs[id];
+	if (InterlockedCompareExchange( &job.state, ePostponed, eWaiting ) != eWaiting)
+		return;
+	for (uint i = 0; i < job.dependents.size(); i++)
+		postpone( job.dependents[i] );
+	if (InterlockedDecrement( &remaining ) == 0 && running)
+		SetEvent( mainEvent );
+}
+
+//----------------------------------------------------------------------------------------------------
+void Jobs::run( uint workerIdx )
+{
+	jobId id;
+	while (true) {
+		WaitForSingleObject( workSem, INFINITE ); // here the thread sleeps until some job is pushed
+		if (!running)
+			break;
+		while (pop( workerIdx, id ))
+			execute( id, workerIdx );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+void Jobs::beginFrame()
+{
+	beginFrame( g_pGameCVars->cf_jobs != 0, g_pGameCVars->cf_jobs_budget );
+}
+
+void Jobs::beginFrame( bool useWorkers, float frameBudgetMs )
+{
+	if (inFrame)
+		return;
+	inFrame = true;
+	frames++;
+
+	// without threads everything is done in endFrame
+	parallel = running && numWorkers > 0 && useWorkers;
+	budgetMs = frameBudgetMs;
+	if (!running)
+		QueryPerformanceFrequency( &frequency );
+	QueryPerformanceCounter( &frameStart );
+
+	remaining = (LONG)jobs.size();
+	for (uint i = 0; i < jobs.size(); i++) {
+		jobs[i].pendingDeps = (LONG)jobs[i].prerequisites.size();
+		jobs[i].state = eWaiting;
+	}
+	if (!running)
+		return;
+	// pendingDeps of the later jobs can already be lowered by workers running the first ones
+	for (uint i = 0; i < jobs.size(); i++)
+		if (jobs[i].prerequisites.empty())
+			push( (jobId)i, -1 );
+}
+
+void Jobs::endFrame()
+{
+	if (!inFrame)
+		return;
+
+	if (running) {
+		// the main thread helps the workers, when it has nothing of its own
+		while (remaining > 0) {
+			jobId id;
+			EnterCriticalSection( &mainLock );
+			bool found = !mainQueue.empty();
+			if (found) {
+				id = mainQueue.front();
+				mainQueue.pop_front();
+			}
+			LeaveCriticalSection( &mainLock );
+			if (found || (parallel && pop( -1, id )))
+				execute( id, -1 );
+			else
+				WaitForSingleObject( mainEvent, 1 );
+		}
+	} else {
+		// not initialized, go through the graph in the order of dependencies
+		for (bool progress = true; progress && remaining > 0; ) {
+			progress = false;
+			for (uint i = 0; i < jobs.size(); i++) {
+				if (jobs[i].state == eWaiting && jobs[i].pendingDeps == 0) {
+					execute( (jobId)i, -1 );
+					progress = true;
+				}
+			}
+		}
+	}
+
+	// collect statistics and keep the postponed part of the graph for the next frame
+	std::vector<jobId> remap( jobs.size(), (jobId)NO_JOB );
+	std::vector<Job> postponed;
+	for (uint i = 0; i < jobs.size(); i++) {
+		JobStats & jobStats = stats[ jobs[i].name ];
+		if (jobs[i].state == ePostponed) {
+			jobStats.postponed++;
+			remap[i] = (jobId)postponed.size();
+			postponed.push_back( jobs[i] );
+			postponed.back().prerequisites.clear();
+			postponed.back().dependents.clear();
+		} else {
+			jobStats.runs++;
+			jobStats.totalMs += jobs[i].duration;
+			if (jobs[i].duration > jobStats.maxMs)
+				jobStats.maxMs = jobs[i].duration;
+		}
+	}
+	for (uint i = 0; i < jobs.size(); i++) {
+		if (remap[i] == NO_JOB)
+			continue;
+		for (uint j = 0; j < jobs[i].prerequisites.size(); j++) {
+			jobId prerequisite = remap[ jobs[i].prerequisites[j] ];
+			if (prerequisite != NO_JOB) {  // finished prerequisites are already satisfied
+				postponed[ remap[i] ].prerequisites.push_back( prerequisite );
+				postponed[ prerequisite ].dependents.push_back( remap[i] );
+			}
+		}
+	}
+	jobs.swap( postponed );
+	inFrame = false;
+}
+
+void Jobs::reset()
+{
+	if (!inFrame)
+		jobs.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void Jobs::dump()
+{
+	CryLogAlways("$8jobs$o over %u frames, %u worker threads%s", frames, numWorkers, parallel ? "" : " (not used)");
+	CryLogAlways("  job                              runs postponed  avg ms  max ms");
+	for (std::map<std::string, JobStats>::const_iterator it = stats.begin(); it != stats.end(); it++) {
+		const JobStats & jobStats = it->second;
+		CryLogAlways("  %-30s %6u %9u %7.3f %7.3f", it->first.c_str(), jobStats.runs, jobStats.postponed,
+		             jobStats.runs ? jobStats.totalMs / jobStats.runs : 0.0f, jobStats.maxMs);
+	}
+	stats.clear();
+	frames = 0;
+}
@@ -0,0 +1,145 @@
+//================================================================================
+// File:    Code/CryFire/Jobs.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Worker threads running a graph of game jobs every frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef JOBS_INCLUDED
+#define JOBS_INCLUDED
+
+
+#include <windows.h>
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <string>
+
+#undef GetUserName       // windows.h defines some stupid macros, which overwrites Crysis methods names
+#undef GetCommandLine
+
+
+typedef unsigned int uint;
+
+//----------------------------------------------------------------------------------------------------
+/* Subsystems add their jobs during the frame, then beginFrame starts them on worker threads
+   and endFrame waits until they are finished, the main thread can do other things in between.
+   Each worker has its own queue and steals from the others when it's empty.
+   !! jobs without eMainThread must not call the engine, they can only work with their own data,
+   and nobody else may touch that data between beginFrame and endFrame */
+class Jobs {
+
+  public:
+
+	typedef void (* job_t)(void * arg);
+	typedef int jobId;
+
+	static const jobId NO_JOB = -1;
+	static const uint MAX_WORKERS = 8;
+
+	enum EFlags {
+		eMainThread = 1,   // calls the engine, so it runs in the main thread inside endFrame
+		eDeferrable = 2,   // can be moved to the next frame, if it would start after the frame budget ran out
+	};
+
+	/* starts the worker threads, 0 = one less than the number of processors */
+	static void initialize( uint numWorkers = 0 );
+	/* stops the worker threads, can't be called between beginFrame and endFrame */
+	static void terminate();
+
+	/* adds a job into the graph of this frame, name should be a string literal, it's used for statistics,
+	   adding the same function with the same argument again returns the existing job (e.g. one postponed from the last frame) */
+	static jobId add( const char * name, job_t job, void * arg, uint flags = 0 );
+	/* the job will be started after the prerequisite is finished */
+	static void addDependency( jobId job, jobId prerequisite );
+
+	/* starts the jobs added since the last frame */
+	static void beginFrame();
+	/* the same with explicit settings instead of cf_jobs and cf_jobs_budget, for tests */
+	static void beginFrame( bool useWorkers, float frameBudgetMs );
+	/* runs the main thread jobs and waits until all jobs are finished or postponed */
+	static void endFrame();
+
+	/* drops all jobs, call it when the objects passed to them are deleted */
+	static void reset();
+
+	/* writes the statistics of all jobs into console and clears them */
+	static void dump();
+
+	/* PRIVATE!! This method has to be public because of implementation reasons, don't call it */
+	static void run( uint workerIdx );
+
+
+  protected:
+
+	enum EState {
+		eWaiting = 0,
+		eStarted,
+		eDone,
+		ePostponed
+	};
+	struct Job {
+		const char * name;
+		job_t func;
+		void * arg;
+		uint flags;
+		volatile LONG pendingDeps;   // unfinished prerequisites
+		volatile LONG state;
+		float duration;              // milliseconds
+		std::vector<jobId> prerequisites;
+		std::vector<jobId> dependents;
+	};
+	struct Worker {
+		HANDLE thread;
+		CRITICAL_SECTION lock;
+		std::deque<jobId> queue;
+	};
+	struct JobStats {
+		uint runs;
+		uint postponed;
+		float totalMs;
+		float maxMs;
+	};
+
+	static void  push( jobId id, int workerIdx );
+	static bool  pop( int workerIdx, jobId & id );
+	static void  execute( jobId id, int workerIdx );
+	static void  postpone( jobId id );
+	static float elapsedMs( const LARGE_INTEGER & since );
+
+	static std::vector<Job>                  jobs;        // graph of the current frame, doesn't change between beginFrame and endFrame
+	static Worker                            workers [MAX_WORKERS];
+	static uint                              numWorkers;
+	static volatile bool                     running;
+	static HANDLE                            workSem;     // counts jobs pushed into the worker queues
+	static HANDLE                            mainEvent;   // set when a main thread job is ready or all jobs are finished
+	static CRITICAL_SECTION                  mainLock;
+	static std::deque<jobId>                 mainQueue;
+	static volatile LONG                     remaining;
+	static bool                              inFrame;
+	static bool                              parallel;
+	static float                             budgetMs;
+	static LARGE_INTEGER                     frameStart;
+	static LARGE_INTEGER                     frequency;
+	static std::map<std::string, JobStats>   stats;
+	static uint                              frames;
+
+};
+
+#endif // JOBS_INCLUDED
@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  5.8.2016
-// Last edited: 18.2.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: simple C++ logging utilities
 //--------------------------------------------------------------------------------
@@ -151,7 +151,7 @@ bool RMIerror(const char * RMIname, channelId chnlId, const char * message, cons
 	if (moreInfo && moreData)
 		CryLogAlways("$4[CryFire DLL] RMI %s; from channel: %u; %s; %s: %s  ", RMIname, chnlId, message, moreInfo, moreData);
 	else
-		CryLogAlways("$4[CryFire DLL] RMI %s; from channel: %u; %s  ", RMIname, message, chnlId);
+		CryLogAlways("$4[CryFire DLL] RMI %s; from channel: %u; %s  ", RMIname, chnlId, message);
 	return false;
 }
 
@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  5.8.2016
-// Last edited: 18.2.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: simple C++ logging utilities
 //--------------------------------------------------------------------------------
@@ -43,6 +43,7 @@ void CF_AsyncError( const char * format, ... );
 
 typedef unsigned int channelId;
 
+/// these only log, a request which is really refused must also be counted with CF_REJECT_RMI from NetStats.h
 bool RMIerror( const char * RMIname, channelId chnlId, const char * message, const char * moreInfo = NULL, const char * moreData = NULL );
 bool RMIwarning( const char * RMIname, channelId chnlId, const char * realActor, const char * pretendedActor, const char * moreInfo = NULL, const char * moreData = NULL );
 void RMIdebug( uint level, const char * RMIname, channelId chnlId, const char * realActor, const char * pretendedActor, const char * moreInfo = NULL, const char * moreData = NULL );
@@ -46,8 +46,10 @@ or send it to lua by CallScript.
 #include "NetworkUtils.h"
 #include "BlockingQueue.h"
 #include "AsyncTasks.h"
+#include "Telemetry.h"
 #include "Game.h"
 #include "GameRules.h"
+#include "GameCVars.h"
 
 #include <windows.h>
 #include <string>
@@ -113,6 +115,7 @@ const char * const MSrvConnection::VERSION  = "6156";
 bool MSrvConnection::UseGameSpyReplacement = false;
 bool MSrvConnection::running = false;
 bool MSrvConnection::announced = false;
+bool MSrvConnection::serverInfoDirty = false;
 float MSrvConnection::timer = 0;
 fd_t MSrvConnection::sockFd = -1;
 struct sockaddr_in MSrvConnection::MSrvAddr;
@@ -123,7 +126,7 @@ std::map<std::string, MSrvConnection::ConnInfo> * MSrvConnection::validated = NU
 // called when value of CVar cf_usegsreplacement is changed
 void MSrvConnection::onGSReplacementChange(bool enabled)
 {
-	UseGameSpyReplacement = enabled && gEnv->pConsole->GetCVar("sv_lanonly")->GetIVal() == 0;
+	UseGameSpyReplacement = enabled && g_pGameCVars->pBindings->sv_lanonly.Get() == 0;
 	gEnv->pSystem->GetIScriptSystem()->SetGlobalValue("UseGameSpyReplacement", UseGameSpyReplacement);
 }
 
@@ -145,6 +148,26 @@ void MSrvConnection::initialize()
 		AsyncTasks::addTask(asyncGetMSrvAddr, NULL, NULL);
 	}
 	timer = 2; // schedule update in some near future
+
+	// subscribing is ignored when we are already subscribed from previous map
+	SCVarBindings * pBindings = g_pGameCVars->pBindings;
+	pBindings->sv_servername.Subscribe(onServerInfoChange);
+	pBindings->sv_password.Subscribe(onServerInfoChange);
+	pBindings->sv_maxplayers.Subscribe(onServerInfoChange);
+	pBindings->sv_ranked.Subscribe(onServerInfoChange);
+}
+
+//----------------------------------------------------------------------------------------------------
+// called from main thread when one of the CVars sent to master server changes
+void MSrvConnection::onServerInfoChange(ICVar * pCVar)
+{
+	if (serverInfoDirty)
+		return;
+	serverInfoDirty = true;
+	// tell the master server soon, not in up to DELAY seconds
+	if (announced && timer > 2)
+		timer = 2;
+	CF_Log(4, "%s changed, master server will be updated", pCVar->GetName());
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -197,15 +220,17 @@ void MSrvConnection::announceServerStart()
 	InformParams * params = new InformParams;
 
 	// gather needed info and schedule contacting master server
-	int port  = gEnv->pConsole->GetCVar("sv_port")->GetIVal();
-	int maxpl = gEnv->pConsole->GetCVar("sv_maxplayers")->GetIVal();
+	const SCVarBindings * pBindings = g_pGameCVars->pBindings;
+	int port  = pBindings->sv_port.Get();
+	int maxpl = pBindings->sv_maxplayers.Get();
 	int numpl = 0;
-	const char * svname = gEnv->pConsole->GetCVar("sv_servername")->GetString();
-	const char * svpass = strlen(gEnv->pConsole->GetCVar("sv_password")->GetString()) > 0 ? "true" : "";
+	const char * svname = pBindings->sv_servername.Get().c_str();
+	const char * svpass = !pBindings->sv_password.Get().empty() ? "true" : "";
 	const char * map = g_pGame->GetIGameFramework()->GetLevelName(); map = map ? map : "";
 	int remtime = (int)g_pGame->GetGameRules()->GetRemainingGameTime();
 	std::string maplink = getMapDownloadLink(map);
-	int ranked = gEnv->pConsole->GetCVar("sv_ranked")->GetIVal();
+	int ranked = pBindings->sv_ranked.Get();
+	serverInfoDirty = false;
 	NetworkUtils::GetLocalIP(localIP);
 	const char * desc = getServerDescription();
 
@@ -224,21 +249,24 @@ void MSrvConnection::updateServerInfo()
 	InformParams * params = new InformParams;
 
 	// gather needed info and schedule contacting master server
-	int port  = gEnv->pConsole->GetCVar("sv_port")->GetIVal();
-	int maxpl = gEnv->pConsole->GetCVar("sv_maxplayers")->GetIVal();
+	const SCVarBindings * pBindings = g_pGameCVars->pBindings;
+	int port  = pBindings->sv_port.Get();
+	int maxpl = pBindings->sv_maxplayers.Get();
 	int numpl = g_pGame->GetGameRules()->GetPlayerCount();
-	const char * svname = gEnv->pConsole->GetCVar("sv_servername")->GetString();
-	const char * svpass = strlen(gEnv->pConsole->GetCVar("sv_password")->GetString()) > 0 ? "true" : "";
+	const char * svname = pBindings->sv_servername.Get().c_str();
+	const char * svpass = !pBindings->sv_password.Get().empty() ? "true" : "";
 	const char * map = g_pGame->GetIGameFramework()->GetLevelName(); map = map ? map : "";
 	int remtime = (int)g_pGame->GetGameRules()->GetRemainingGameTime();
 	std::string maplink = getMapDownloadLink(map);
 	std::string plstring = gatherPlayersInfo();
-	int ranked = gEnv->pConsole->GetCVar("sv_ranked")->GetIVal();
+	std::string perf = Telemetry::getSummary();
+	int ranked = pBindings->sv_ranked.Get();
+	serverInfoDirty = false;
 	NetworkUtils::GetLocalIP(localIP);
 	const char * desc = getServerDescription();
 
-	params->page = formatURL("/api/up.php?port=%d&numpl=%d&name=%s&pass=%s&cookie=%s&map=%s&timel=%d&mapdl=%s&players=%s&ver=%s&ranked=%d&local=%s&desc=%s",
-		                               port,   numpl, svname, svpass,cookie.c_str(),map, remtime, maplink.c_str(), plstring.c_str(),VERSION,ranked,localIP,desc);
+	params->page = formatURL("/api/up.php?port=%d&numpl=%d&name=%s&pass=%s&cookie=%s&map=%s&timel=%d&mapdl=%s&players=%s&ver=%s&ranked=%d&local=%s&desc=%s&perf=%s",
+		                               port,   numpl, svname, svpass,cookie.c_str(),map, remtime, maplink.c_str(), plstring.c_str(),VERSION,ranked,localIP,desc,perf.c_str());
 
 	CF_Log(4, "sending updated server status to master server");
 	AsyncTasks::addTask(asyncUpdate, params, NULL); // add task to the queue, from which will the other thread pop and do it
@@ -296,40 +324,35 @@ void * MSrvConnection::asyncUpdate(void * arg)
 }
 
 //----------------------------------------------------------------------------------------------------
-// called from SendChatMessage - checks the message for !validate command and splits it into arguments
-bool MSrvConnection::checkChatMessage(EntityId sourceId, const char * message)
+// called from chat command dispatcher on !validate command - splits it into arguments
+Chat::EResult MSrvConnection::onValidateCommand(EntityId sourceId, const char * args)
 {
-	char * msgcopy;
+	char argscopy [Chat::MAX_MESSAGE_LENGTH];
 	char * prof;
 	char * uid;
 	char * name;
 	int profId;
 
 	if (!UseGameSpyReplacement)
-		return false;
+		return Chat::ePass;
 	if (!running)
-		return true;
-
-	if (strncmp(message, "!validate ", 10) != 0)
-		return false;
+		return Chat::eHide;
 
-	// make a copy because we need to modify it
-	msgcopy = new char [strlen(message)+1];
-	strcpy(msgcopy, message);
+	// make a copy because we need to modify it, longer messages can't be valid anyway
+	if (strlen(args) >= sizeof(argscopy))
+		return Chat::eHide;
+	strcpy(argscopy, args);
 
 	// split input message into the char* strings
-	prof = getNextArg(msgcopy + 9);
+	prof = argscopy;
 	uid = getNextArg(prof);
 	name = getNextArg(uid);
-	if (!prof || !uid || !name || !sscanf(prof, "%d", &profId)) {
-		delete msgcopy;
-		return true;
-	}
+	if (!uid || !name || !sscanf(prof, "%d", &profId))
+		return Chat::eHide;
 
 	validateClient(sourceId, profId, uid, name);
 
-	delete msgcopy;
-	return true;
+	return Chat::eHide;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -681,7 +704,7 @@ std::string MSrvConnection::createRequest(const std::string & page, HTTPMethod m
 	if (version != HTTP11)
 		request << "HTTP/1.0\r\n";
 	else
-		request << "HTTP/1.1\r\nUser-Agent: " << gEnv->pConsole->GetCVar("sv_servername")->GetString() << "\r\n";
+		request << "HTTP/1.1\r\nUser-Agent: " << g_pGameCVars->pBindings->sv_servername.Get().c_str() << "\r\n";
 	request << "Host: " << HOSTNAME << "\r\n";
 	if (method == HTTPPOST)
 		request << "Content-length: " << append.length() << "\r\n" << "Content-Type: application/x-www-form-urlencoded\r\n";
@@ -28,6 +28,7 @@
 
 #include "NetworkUtils.h"
 #include "BlockingQueue.h"
+#include "Chat.h"
 
 #undef GetUserName       // windows.h defines some stupid macros, which overwrites Crysis methods names
 #undef GetCommandLine
@@ -66,9 +67,9 @@ class MSrvConnection {
 	   it is needed to notify master server about current status and process results of other thread */
 	static void onUpdate(float frameTime);
 
-	/* call this from CGameRules::SendChatMessage function
-	   it is needed to check the chat message for command !validate with parameters profileID and uID */
-	static bool checkChatMessage(EntityId sourceId, const char * message);
+	/* handler of chat command !validate with parameters profileID, uID and name,
+	   register it with Chat::registerCommand */
+	static Chat::EResult onValidateCommand(EntityId sourceId, const char * args);
 
 
   protected:
@@ -83,6 +84,7 @@ class MSrvConnection {
 	static bool               UseGameSpyReplacement;
 	static bool               running;
 	static bool               announced;
+	static bool               serverInfoDirty;  // name, password, max players or ranked changed since the last update
 	static float              timer;
 	static fd_t               sockFd;
 	static struct sockaddr_in MSrvAddr;
@@ -96,6 +98,7 @@ class MSrvConnection {
 	static std::map<std::string, ConnInfo> * validated;
 
 	static void checkUpdateTime(float frameTime);
+	static void onServerInfoChange(ICVar * pCVar);
 	static void announceServerStart();
 	static void updateServerInfo();
 	static void validateClient(EntityId sourceId, int profId, const char * uid, const char * name);
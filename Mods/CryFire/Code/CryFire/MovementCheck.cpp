@@ -0,0 +1,189 @@
+//================================================================================
+// File:    Code/CryFire/MovementCheck.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Server-side check of plausibility of player movement
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "MovementCheck.h"
+
+#include "CryFire/Telemetry.h"
+#include "Game.h"
+#include "GameCVars.h"
+#include "GameRules.h"
+#include "Player.h"
+#include "PlayerMovement.h"
+
+#include <IActorSystem.h>
+#include <ScriptHelpers.h>
+
+
+//----------------------------------------------------------------------------------------------------
+const float MovementCheck::SAMPLE_INTERVAL = 0.1f;
+
+MovementEnvelopes *          MovementCheck::envelopes = NULL;
+MovementCheck::PlayerMap     MovementCheck::players;
+EntityId                     MovementCheck::slotOwners [MovementEnvelopes::MAX_SLOTS];
+float                        MovementCheck::timer = 0.0f;
+
+static const char * const severityNames [MovementEnvelopes::NUM_SEVERITIES] = { "none", "minor", "major", "teleport" };
+
+//----------------------------------------------------------------------------------------------------
+void MovementCheck::onUpdate( float frameTime )
+{
+	if (!g_pGameCVars->cf_movecheck || !gEnv->bServer || !gEnv->bMultiplayer) {
+		if (envelopes)
+			reset();
+		return;
+	}
+
+	timer += frameTime;
+	if (timer < SAMPLE_INTERVAL)
+		return;
+
+	CF_TELEMETRY_SCOPE("MovementCheck.onUpdate");
+	if (!envelopes) {
+		envelopes = new MovementEnvelopes;
+		memset( slotOwners, 0, sizeof(slotOwners) );
+	}
+	sample();
+	timer = 0.0f;
+}
+
+void MovementCheck::sample()
+{
+	IActorIteratorPtr pIt = g_pGame->GetIGameFramework()->GetIActorSystem()->CreateActorIterator();
+	while (IActor * pActor = pIt->Next()) {
+		if (!pActor->IsPlayer() || static_cast<CActor *>( pActor )->GetActorClass() != CPlayer::GetActorClassType())
+			continue;
+		CPlayer * pPlayer = static_cast<CPlayer *>( pActor );
+		EntityId id = pPlayer->GetEntityId();
+
+		PlayerMap::iterator it = players.find( id );
+		if (it == players.end()) {
+			int slot = envelopes->addSlot();
+			if (slot < 0)
+				continue;
+			Player player;
+			player.slot = slot;
+			memset( &player.counters, 0, sizeof(player.counters) );
+			it = players.insert( PlayerMap::value_type( id, player ) ).first;
+			slotOwners[slot] = id;
+		}
+		Player & player = it->second;
+
+		float maxSpeed = CPlayerMovement::GetMaxSpeed( *pPlayer );
+		if (maxSpeed <= 0.0f) {
+			envelopes->resetSlot( player.slot );
+			continue;
+		}
+		const Vec3 & pos = pPlayer->GetEntity()->GetWorldPos();
+		// the real time since the last sample, frames don't come exactly after the interval
+		envelopes->setSample( player.slot, pos.x, pos.y, maxSpeed, timer );
+		player.counters.samples++;
+	}
+
+	MovementEnvelopes::Result results [MovementEnvelopes::MAX_SLOTS];
+	envelopes->evaluate( g_pGameCVars->cf_movecheck_tolerance, g_pGameCVars->cf_movecheck_slack, results );
+
+	for (uint slot = 0; slot < MovementEnvelopes::MAX_SLOTS; slot++) {
+		if (!slotOwners[slot])
+			continue;
+		if (!envelopes->isUsed( slot )) {
+			players.erase( slotOwners[slot] );
+			slotOwners[slot] = 0;
+		} else if (results[slot].severity != MovementEnvelopes::eNone) {
+			PlayerMap::iterator it = players.find( slotOwners[slot] );
+			if (it != players.end())
+				report( it->first, it->second, results[slot] );
+		}
+	}
+}
+
+void MovementCheck::report( EntityId playerId, Player & player, const MovementEnvelopes::Result & result )
+{
+	player.counters.violations[ result.severity ]++;
+	player.counters.maxRatio = max( player.counters.maxRatio, result.distance / max( result.allowed, 0.01f ) );
+
+	CGameRules * pGameRules = g_pGame->GetGameRules();
+	IScriptTable * pScript = pGameRules ? pGameRules->GetScriptTable() : NULL;
+	if (pScript && pScript->HaveValue( "OnMovementViolation" ))
+		Script::CallMethod( pScript, "OnMovementViolation", ScriptHandle( playerId ), (int)result.severity, result.distance, result.allowed );
+}
+
+void MovementCheck::onTeleport( EntityId playerId )
+{
+	PlayerMap::iterator it = players.find( playerId );
+	if (envelopes && it != players.end())
+		envelopes->resetSlot( it->second.slot );
+}
+
+void MovementCheck::onImpulse( EntityId playerId )
+{
+	PlayerMap::iterator it = players.find( playerId );
+	if (envelopes && it != players.end())
+		envelopes->addImpulse( it->second.slot, g_pGameCVars->cf_movecheck_impulse );
+}
+
+void MovementCheck::reset()
+{
+	delete envelopes;
+	envelopes = NULL;
+	players.clear();
+	timer = 0.0f;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MovementCheck::toScriptTable( EntityId playerId, IScriptTable * table )
+{
+	PlayerMap::iterator it = players.find( playerId );
+	if (it == players.end())
+		return false;
+	const Counters & counters = it->second.counters;
+
+	table->SetValue( "samples", (int)counters.samples );
+	for (uint s = MovementEnvelopes::eMinor; s < MovementEnvelopes::NUM_SEVERITIES; s++)
+		table->SetValue( severityNames[s], (int)counters.violations[s] );
+	table->SetValue( "maxRatio", counters.maxRatio );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void printViolation( uint lineNum, float time, const MovementEnvelopes::Result & result )
+{
+	CryLogAlways( "line %u, time %.2f: %s, moved %.2f m, allowed %.2f m",
+	              lineNum, time, severityNames[ result.severity ], result.distance, result.allowed );
+}
+
+bool MovementCheck::checkTrace( const char * fileName )
+{
+	MovementEnvelopes::TraceSummary summary;
+	if (!MovementEnvelopes::replayTrace( fileName, g_pGameCVars->cf_movecheck_tolerance, g_pGameCVars->cf_movecheck_slack,
+	                                     g_pGameCVars->cf_movecheck_impulse, summary, printViolation )) {
+		CryLogAlways( "cannot open %s", fileName );
+		return false;
+	}
+
+	CryLogAlways( "%s: %u samples, %u minor, %u major, %u teleport", fileName, summary.samples,
+	              summary.violations[MovementEnvelopes::eMinor], summary.violations[MovementEnvelopes::eMajor],
+	              summary.violations[MovementEnvelopes::eTeleport] );
+	return true;
+}
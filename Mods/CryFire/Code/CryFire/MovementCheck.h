@@ -0,0 +1,83 @@
+//================================================================================
+// File:    Code/CryFire/MovementCheck.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Server-side check of plausibility of player movement
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef MOVEMENT_CHECK_INCLUDED
+#define MOVEMENT_CHECK_INCLUDED
+
+
+#include <IEntity.h>
+#include <IScriptSystem.h>
+#include <FlatHashMap.h>
+
+#include "MovementEnvelopes.h"
+
+
+//----------------------------------------------------------------------------------------------------
+/* Samples positions of players on a multiplayer server every SAMPLE_INTERVAL and compares them
+   with the speed the player movement code allows. Violations are counted per player and reported
+   to game rules script: OnMovementViolation(playerId, severity, distance, allowed). */
+class MovementCheck {
+
+  public:
+
+	static const float SAMPLE_INTERVAL;
+
+	struct Counters {
+		uint samples;
+		uint violations [MovementEnvelopes::NUM_SEVERITIES];
+		float maxRatio;       // the worst distance / allowed distance
+	};
+
+	/* samples players and reports violations, needs to be called regularly from game loop */
+	static void onUpdate( float frameTime );
+	/* the server moved the player, the next window starts at the new position */
+	static void onTeleport( EntityId playerId );
+	/* the player was hit or pushed by an explosion, the window allows cf_movecheck_impulse more meters */
+	static void onImpulse( EntityId playerId );
+	static void reset();
+
+	/* fills a Lua table with counters of a player, returns false, if the player isn't checked */
+	static bool toScriptTable( EntityId playerId, IScriptTable * table );
+
+	/* replays a trace file with lines "time x y z maxSpeed [hit]" (separated by spaces or commas)
+	   and writes the violations into console, returns false if the file can't be read */
+	static bool checkTrace( const char * fileName );
+
+  protected:
+
+	struct Player {
+		uint slot;
+		Counters counters;
+	};
+	typedef FlatHashMap<EntityId, Player> PlayerMap;
+
+	static void sample();
+	static void report( EntityId playerId, Player & player, const MovementEnvelopes::Result & result );
+
+	static MovementEnvelopes *   envelopes;
+	static PlayerMap             players;
+	static EntityId              slotOwners [MovementEnvelopes::MAX_SLOTS];
+	static float                 timer;
+
+};
+
+#endif // MOVEMENT_CHECK_INCLUDED
@@ -0,0 +1,191 @@
+//================================================================================
+// File:    Code/CryFire/MovementEnvelopes.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Envelopes of the distance players can move, the engine independent part of MovementCheck
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "MovementEnvelopes.h"
+
+#include <cstdio>
+
+
+//----------------------------------------------------------------------------------------------------
+MovementEnvelopes::MovementEnvelopes()
+ : head(0), speedHead(0)
+{
+	memset( x, 0, sizeof(x) );
+	memset( y, 0, sizeof(y) );
+	memset( speed, 0, sizeof(speed) );
+	memset( interval, 0, sizeof(interval) );
+	memset( filled, 0, sizeof(filled) );
+	memset( used, 0, sizeof(used) );
+	memset( sampled, 0, sizeof(sampled) );
+	memset( pushed, 0, sizeof(pushed) );
+	memset( pushSteps, 0, sizeof(pushSteps) );
+}
+
+int MovementEnvelopes::addSlot()
+{
+	for (uint i = 0; i < MAX_SLOTS; i++) {
+		if (!used[i]) {
+			used[i] = true;
+			resetSlot( i );
+			return i;
+		}
+	}
+	return -1;
+}
+
+void MovementEnvelopes::removeSlot( uint slot )
+{
+	used[slot] = false;
+	sampled[slot] = false;
+	filled[slot] = 0;
+	pushed[slot] = 0.0f;
+	pushSteps[slot] = 0;
+}
+
+void MovementEnvelopes::resetSlot( uint slot )
+{
+	filled[slot] = 0;
+	sampled[slot] = true;
+	for (uint s = 0; s < SPEED_RING; s++)
+		speed[s][slot] = 0.0f;
+}
+
+void MovementEnvelopes::setSample( uint slot, float posX, float posY, float maxSpeed, float time )
+{
+	x[head][slot] = posX;
+	y[head][slot] = posY;
+	speed[speedHead][slot] = maxSpeed;
+	interval[head][slot] = time;
+	if (filled[slot] < RING)
+		filled[slot]++;
+	sampled[slot] = true;
+}
+
+void MovementEnvelopes::addImpulse( uint slot, float distance )
+{
+	pushed[slot] = min( pushed[slot] + distance, MAX_PUSHES * distance );
+	pushSteps[slot] = PUSH_STEPS;
+}
+
+void MovementEnvelopes::evaluate( float tolerance, float slack, Result * results )
+{
+	const uint oldest = (head + 1) % RING;
+
+	// the loops go through all slots, used or not, there are no branches to break them
+	float topSpeed [MAX_SLOTS], time [MAX_SLOTS];
+	memcpy( topSpeed, speed[0], sizeof(topSpeed) );
+	for (uint s = 1; s < SPEED_RING; s++) {
+		const float * v = speed[s];
+		for (uint i = 0; i < MAX_SLOTS; i++)
+			topSpeed[i] = max( topSpeed[i], v[i] );
+	}
+	memset( time, 0, sizeof(time) );
+	for (uint s = 1; s < RING; s++) {
+		const float * t = interval[ (oldest + s) % RING ];
+		for (uint i = 0; i < MAX_SLOTS; i++)
+			time[i] += t[i];
+	}
+	float distSq [MAX_SLOTS], allowed [MAX_SLOTS];
+	const float * hx = x[head], * hy = y[head], * ox = x[oldest], * oy = y[oldest];
+	for (uint i = 0; i < MAX_SLOTS; i++) {
+		float dx = hx[i] - ox[i], dy = hy[i] - oy[i];
+		distSq[i] = dx*dx + dy*dy;
+		allowed[i] = topSpeed[i] * time[i] * tolerance + pushed[i] + slack;
+		pushSteps[i] -= pushSteps[i] > 0 ? 1 : 0;
+		pushed[i] = pushSteps[i] > 0 ? pushed[i] : 0.0f;
+	}
+
+	for (uint i = 0; i < MAX_SLOTS; i++) {
+		results[i].severity = eNone;
+		if (!used[i])
+			continue;
+		if (!sampled[i]) {   // the player is gone
+			removeSlot( i );
+			continue;
+		}
+		sampled[i] = false;
+		if (filled[i] < RING || distSq[i] <= allowed[i] * allowed[i])
+			continue;
+
+		results[i].distance = sqrtf( distSq[i] );
+		results[i].allowed = allowed[i];
+		float ratio = results[i].distance / max( allowed[i], 0.01f );
+		results[i].severity = ratio > 4.0f ? eTeleport : ratio > 2.0f ? eMajor : eMinor;
+		// the new window starts here, so the same jump isn't reported again by the next samples
+		filled[i] = 1;
+	}
+
+	head = oldest;
+	speedHead = (speedHead + 1) % SPEED_RING;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MovementEnvelopes::replayTrace( const char * fileName, float tolerance, float slack, float impulse,
+                                     TraceSummary & summary, TraceFunc func )
+{
+	FILE * file = fopen( fileName, "r" );
+	if (!file)
+		return false;
+
+	// one player in the first slot, the same code as on the server
+	MovementEnvelopes * envelopes = new MovementEnvelopes;
+	envelopes->addSlot();
+	Result results [MAX_SLOTS];
+	memset( &summary, 0, sizeof(summary) );
+	uint lineNum = 0;
+	float lastTime = 0.0f;
+
+	char line [256];
+	while (fgets( line, sizeof(line), file )) {
+		lineNum++;
+		for (char * c = line; *c; c++)
+			if (*c == ',' || *c == ';')
+				*c = ' ';
+		float time, posX, posY, posZ, maxSpeed;
+		int hit = 0;
+		int numValues = sscanf( line, "%f %f %f %f %f %d", &time, &posX, &posY, &posZ, &maxSpeed, &hit );
+		if (numValues < 5)
+			continue;   // header or comment
+
+		if (hit)
+			envelopes->addImpulse( 0, impulse );
+		if (maxSpeed <= 0.0f)
+			envelopes->resetSlot( 0 );
+		else
+			envelopes->setSample( 0, posX, posY, maxSpeed, summary.samples ? time - lastTime : 0.0f );
+		envelopes->evaluate( tolerance, slack, results );
+		lastTime = time;
+		summary.samples++;
+
+		if (results[0].severity != eNone) {
+			summary.violations[ results[0].severity ]++;
+			if (func)
+				func( lineNum, time, results[0] );
+		}
+	}
+	fclose( file );
+	delete envelopes;
+	return true;
+}
@@ -0,0 +1,112 @@
+//================================================================================
+// File:    Code/CryFire/MovementEnvelopes.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Envelopes of the distance players can move, the engine independent part of MovementCheck
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef MOVEMENT_ENVELOPES_INCLUDED
+#define MOVEMENT_ENVELOPES_INCLUDED
+
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Envelopes of reachable distance of many players, stored as structure of arrays, so that one loop goes
+   through the same sample of all players. Every sample stores the horizontal position, the highest
+   speed the player movement allows at that moment and the time since the previous sample. A player
+   moved too far, when the distance between the newest and the oldest sample of the window is longer
+   than the highest speed of this and the previous window for the whole window. The allowed speed drops
+   at once, when the sprint is released or the energy runs out, but the player keeps the momentum for up
+   to a second, so the speed of a single sample would not be enough. Hits and explosions push the player
+   for a while, their distance is added to every window which can overlap the push. It doesn't depend on
+   the engine, so it can be fed from a trace. */
+class MovementEnvelopes {
+
+  public:
+
+	static const uint MAX_SLOTS = 64;
+	static const uint WINDOW = 10;                // samples compared, the ring has one more
+	static const uint RING = WINDOW + 1;
+	static const uint SPEED_RING = 2 * WINDOW + 1;   // speeds are kept for the previous window too
+	static const uint PUSH_STEPS = 2 * WINDOW;    // a push lasts up to a window, so it can be in the windows of this many steps
+	static const uint MAX_PUSHES = 3;             // a stream of bullets must not turn the check off
+
+	enum ESeverity {
+		eNone = 0,
+		eMinor,       // a bit faster than possible, lag or a knockback
+		eMajor,       // clearly faster
+		eTeleport,    // many times faster
+		NUM_SEVERITIES
+	};
+
+	struct Result {
+		ESeverity severity;
+		float distance;
+		float allowed;
+	};
+
+	struct TraceSummary {
+		uint samples;
+		uint violations [NUM_SEVERITIES];
+	};
+	typedef void (* TraceFunc)( uint lineNum, float time, const Result & result );
+
+	MovementEnvelopes();
+
+	/* returns a free slot or -1 */
+	int  addSlot();
+	void removeSlot( uint slot );
+	/* forgets the samples, the next window starts with the next sample, the slot is kept in this step */
+	void resetSlot( uint slot );
+	bool isUsed( uint slot ) const { return used[slot]; }
+
+	/* stores a sample of a slot for the current step, maxSpeed is what the player movement allows now
+	   and interval is the time since the last step */
+	void setSample( uint slot, float x, float y, float maxSpeed, float interval );
+	/* the player was hit or pushed by an explosion and could move this much further, the distance is allowed
+	   for PUSH_STEPS, more pushes in this time add up to MAX_PUSHES times the distance */
+	void addImpulse( uint slot, float distance );
+	/* evaluates the windows of all slots and moves to the next step, slots without a sample in this step are reset,
+	   results has MAX_SLOTS elements, slots which moved too far are reset, so one jump is reported only once */
+	void evaluate( float tolerance, float slack, Result * results );
+
+	/* replays a trace with lines "time x y z maxSpeed [hit]" (separated by spaces, commas or semicolons)
+	   through one slot, hit 1 means a push of the impulse distance before that sample,
+	   func is called for every violation, returns false if the file can't be read */
+	static bool replayTrace( const char * fileName, float tolerance, float slack, float impulse,
+	                         TraceSummary & summary, TraceFunc func = 0 );
+
+  protected:
+
+	// [sample][slot], the slots of one sample are next to each other
+	float x [RING][MAX_SLOTS];
+	float y [RING][MAX_SLOTS];
+	float speed [SPEED_RING][MAX_SLOTS];
+	float interval [RING][MAX_SLOTS];
+	uint  filled [MAX_SLOTS];     // valid samples in the ring, the window is complete when it's RING
+	bool  used [MAX_SLOTS];
+	bool  sampled [MAX_SLOTS];
+	float pushed [MAX_SLOTS];     // distance of the pushes in the last PUSH_STEPS
+	uint  pushSteps [MAX_SLOTS];  // steps until the pushes are forgotten
+	uint  head;                   // sample of the current step
+	uint  speedHead;              // the same in the ring of speeds
+
+};
+
+#endif // MOVEMENT_ENVELOPES_INCLUDED
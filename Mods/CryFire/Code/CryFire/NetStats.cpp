@@ -0,0 +1,238 @@
+//================================================================================
+// File:    Code/CryFire/NetStats.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Server-side accounting of network traffic per channel and per RMI
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#include "StdAfx.h"
+
+#include "NetStats.h"
+
+#include <IScriptSystem.h>
+#include <ScriptHelpers.h>
+
+
+//----------------------------------------------------------------------------------------------------
+NetStats::ChannelMap        NetStats::channels;
+std::vector<std::string>    NetStats::rmiNames;
+float                       NetStats::timer = 0.0f;
+
+static const char * const counterNames [NetStats::NUM_COUNTERS] = {
+	"rmiReceived", "rmiRejected", "aspectWrites", "aspectBytesEstimate", "synchedMessages", "synchedBytesEstimate", "inputSkips"
+};
+
+//----------------------------------------------------------------------------------------------------
+RollingCounter::RollingCounter()
+ : head(0), current(0), second(0), minute(0), total(0)
+{
+	memset( slots, 0, sizeof(slots) );
+}
+
+void RollingCounter::shift()
+{
+	minute -= slots[head];
+	slots[head] = current;
+	minute += current;
+	second = current;
+	current = 0;
+	if (++head == NUM_SLOTS)
+		head = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint NetStats::registerRMI( const char * name )
+{
+	for (uint i = 0; i < rmiNames.size(); i++)
+		if (rmiNames[i] == name)
+			return i;
+	rmiNames.push_back( name );
+	return rmiNames.size() - 1;
+}
+
+NetStats::ChannelStats & NetStats::getChannel( channelId chnlId )
+{
+	return channels[ chnlId ];
+}
+
+//----------------------------------------------------------------------------------------------------
+void NetStats::onRMIReceived( uint rmiIndex, channelId chnlId )
+{
+	ChannelStats & stats = getChannel( chnlId );
+	stats.counters[eRMIReceived].add( 1 );
+	stats.rmis[rmiIndex].received.add( 1 );
+}
+
+void NetStats::onRMIRejected( uint rmiIndex, channelId chnlId )
+{
+	ChannelStats & stats = getChannel( chnlId );
+	stats.counters[eRMIRejected].add( 1 );
+	stats.rmis[rmiIndex].rejected.add( 1 );
+}
+
+void NetStats::onAspectSerialized( uint aspect, uint estimatedBytes, channelId skipChnlId )
+{
+	for (ChannelMap::iterator chnl = channels.begin(); chnl != channels.end(); chnl++) {
+		if (chnl->first == skipChnlId)
+			continue;
+		ChannelStats & stats = chnl->second;
+		stats.counters[eAspectWrites].add( 1 );
+		stats.counters[eAspectBytesEstimate].add( estimatedBytes );
+		stats.aspects[aspect].add( estimatedBytes );
+	}
+}
+
+void NetStats::onSynchedMessage( channelId chnlId, uint estimatedBytes )
+{
+	ChannelStats & stats = getChannel( chnlId );
+	stats.counters[eSynchedMessages].add( 1 );
+	stats.counters[eSynchedBytesEstimate].add( estimatedBytes );
+}
+
+void NetStats::onInputSkipped( channelId chnlId )
+{
+	getChannel( chnlId ).counters[eInputSkips].add( 1 );
+}
+
+//----------------------------------------------------------------------------------------------------
+void NetStats::onUpdate( float frameTime )
+{
+	timer += frameTime;
+	if (timer < 1.0f)
+		return;
+	timer -= 1.0f;
+	if (timer > 1.0f) // long freeze, don't try to catch up
+		timer = 0.0f;
+
+	for (ChannelMap::iterator chnl = channels.begin(); chnl != channels.end(); chnl++) {
+		ChannelStats & stats = chnl->second;
+		for (uint i = 0; i < NUM_COUNTERS; i++)
+			stats.counters[i].shift();
+		for (std::map<uint, RMICounters>::iterator rmi = stats.rmis.begin(); rmi != stats.rmis.end(); rmi++) {
+			rmi->second.received.shift();
+			rmi->second.rejected.shift();
+		}
+		for (std::map<uint, RollingCounter>::iterator asp = stats.aspects.begin(); asp != stats.aspects.end(); asp++)
+			asp->second.shift();
+	}
+}
+
+void NetStats::onClientConnect( channelId chnlId )
+{
+	getChannel( chnlId );
+}
+
+void NetStats::onClientDisconnect( channelId chnlId )
+{
+	channels.erase( chnlId );
+}
+
+void NetStats::reset()
+{
+	channels.clear();
+	timer = 0.0f;
+}
+
+//----------------------------------------------------------------------------------------------------
+void NetStats::dumpChannel( channelId chnlId, const ChannelStats & stats )
+{
+	CryLogAlways("$8channel %u$o              last 1s   last 60s      total", chnlId);
+	for (uint i = 0; i < NUM_COUNTERS; i++) {
+		const RollingCounter & cnt = stats.counters[i];
+		CryLogAlways("  %-20s %9u %10u %10u", counterNames[i], cnt.lastSecond(), cnt.lastMinute(), cnt.allTime());
+	}
+	for (std::map<uint, RMICounters>::const_iterator rmi = stats.rmis.begin(); rmi != stats.rmis.end(); rmi++) {
+		const RMICounters & cnt = rmi->second;
+		CryLogAlways("  RMI %-24s %6u/%-4u %7u/%-5u %8u/%u", rmiNames[rmi->first].c_str(),
+		             cnt.received.lastSecond(), cnt.rejected.lastSecond(),
+		             cnt.received.lastMinute(), cnt.rejected.lastMinute(),
+		             cnt.received.allTime(), cnt.rejected.allTime());
+	}
+	for (std::map<uint, RollingCounter>::const_iterator asp = stats.aspects.begin(); asp != stats.aspects.end(); asp++) {
+		CryLogAlways("  aspect 0x%-8x ~bytes %6u %10u %10u", asp->first, asp->second.lastSecond(), asp->second.lastMinute(), asp->second.allTime());
+	}
+}
+
+void NetStats::dump( channelId chnlId )
+{
+	if (chnlId) {
+		ChannelMap::const_iterator chnl = channels.find( chnlId );
+		if (chnl == channels.end())
+			CryLogAlways("no network statistics for channel %u", chnlId);
+		else
+			dumpChannel( chnl->first, chnl->second );
+		return;
+	}
+
+	for (ChannelMap::const_iterator chnl = channels.begin(); chnl != channels.end(); chnl++)
+		dumpChannel( chnl->first, chnl->second );
+}
+
+//----------------------------------------------------------------------------------------------------
+bool NetStats::toScriptTable( channelId chnlId, IScriptTable * table )
+{
+	ChannelMap::const_iterator chnl = channels.find( chnlId );
+	if (chnl == channels.end())
+		return false;
+	const ChannelStats & stats = chnl->second;
+	IScriptSystem * pSS = gEnv->pScriptSystem;
+
+	for (uint i = 0; i < NUM_COUNTERS; i++) {
+		SmartScriptTable cntTable( pSS );
+		cntTable->SetValue( "second", (int)stats.counters[i].lastSecond() );
+		cntTable->SetValue( "minute", (int)stats.counters[i].lastMinute() );
+		cntTable->SetValue( "total", (int)stats.counters[i].allTime() );
+		table->SetValue( counterNames[i], cntTable );
+	}
+
+	SmartScriptTable rmiTable( pSS );
+	for (std::map<uint, RMICounters>::const_iterator rmi = stats.rmis.begin(); rmi != stats.rmis.end(); rmi++) {
+		SmartScriptTable cntTable( pSS );
+		cntTable->SetValue( "second", (int)rmi->second.received.lastSecond() );
+		cntTable->SetValue( "minute", (int)rmi->second.received.lastMinute() );
+		cntTable->SetValue( "total", (int)rmi->second.received.allTime() );
+		cntTable->SetValue( "rejectedSecond", (int)rmi->second.rejected.lastSecond() );
+		cntTable->SetValue( "rejectedMinute", (int)rmi->second.rejected.lastMinute() );
+		cntTable->SetValue( "rejectedTotal", (int)rmi->second.rejected.allTime() );
+		rmiTable->SetValue( rmiNames[rmi->first].c_str(), cntTable );
+	}
+	table->SetValue( "rmi", rmiTable );
+
+	return true;
+}
+
+bool NetStats::getCounter( channelId chnlId, ECounter counter, RollingCounter & result )
+{
+	ChannelMap::const_iterator chnl = channels.find( chnlId );
+	if (chnl == channels.end())
+		return false;
+	result = chnl->second.counters[counter];
+	return true;
+}
+
+bool NetStats::getRMICounters( channelId chnlId, const char * name, RollingCounter & received, RollingCounter & rejected )
+{
+	ChannelMap::const_iterator chnl = channels.find( chnlId );
+	if (chnl == channels.end())
+		return false;
+	std::map<uint, RMICounters>::const_iterator rmi = chnl->second.rmis.find( registerRMI( name ) );
+	if (rmi == chnl->second.rmis.end())
+		return false;
+	received = rmi->second.received;
+	rejected = rmi->second.rejected;
+	return true;
+}
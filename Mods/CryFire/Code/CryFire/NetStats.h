@@ -0,0 +1,143 @@
+//================================================================================
+// File:    Code/CryFire/NetStats.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Server-side accounting of network traffic per channel and per RMI
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef NET_STATS_INCLUDED
+#define NET_STATS_INCLUDED
+
+
+#include <IScriptSystem.h>
+
+#include <map>
+#include <vector>
+#include <string>
+
+typedef unsigned int uint;
+typedef unsigned int channelId;
+
+
+//----------------------------------------------------------------------------------------------------
+/* counts incoming RMI, put it at the beginning of server RMI handlers,
+   the name should be the same as the one used in RMIerror/RMIwarning/RMIdebug */
+#define CF_COUNT_RMI(name) \
+	static const uint s_rmiIndex = NetStats::registerRMI(name); \
+	NetStats::onRMIReceived( s_rmiIndex, (uint)g_pGame->GetIGameFramework()->GetGameChannelId(pNetChannel) )
+
+/* counts rejected RMI, put it where the handler refuses the request, can be used only after CF_COUNT_RMI
+   in the same handler, RMIerror/RMIwarning/RMIdebug only log and don't count anything */
+#define CF_REJECT_RMI() \
+	NetStats::onRMIRejected( s_rmiIndex, (uint)g_pGame->GetIGameFramework()->GetGameChannelId(pNetChannel) )
+
+
+//----------------------------------------------------------------------------------------------------
+/* value summed over the last second and the last minute, shifted once per second,
+   the last minute are the last NUM_SLOTS whole seconds, the current second isn't included until it's shifted */
+class RollingCounter {
+
+  public:
+
+	static const uint NUM_SLOTS = 60;
+
+	RollingCounter();
+
+	inline void add( uint value ) { current += value; total += value; }
+	void shift();
+
+	inline uint lastSecond() const { return second; }
+	inline uint lastMinute() const { return minute; }
+	inline uint allTime() const    { return total; }
+
+  protected:
+
+	uint slots [NUM_SLOTS];
+	uint head;
+	uint current;
+	uint second;
+	uint minute;
+	uint total;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+class NetStats {
+
+  public:
+
+	enum ECounter {
+		eRMIReceived = 0,
+		eRMIRejected,
+		eAspectWrites,
+		eAspectBytesEstimate,    // uncompressed size of the written values, not what goes on the wire
+		eSynchedMessages,
+		eSynchedBytesEstimate,   // uncompressed size of key and value
+		eInputSkips,       // input updates not resent, because they didn't change enough
+		NUM_COUNTERS
+	};
+
+	/* returns index of RMI with this name, registers it when it's used for the first time */
+	static uint registerRMI( const char * name );
+
+	static void onRMIReceived( uint rmiIndex, channelId chnlId );
+	static void onRMIRejected( uint rmiIndex, channelId chnlId );
+	/* the engine serializes an aspect once and sends it to every client which has the entity in its context,
+	   the game doesn't know to which ones, so it's counted for every connected channel except skipChnlId,
+	   the size is an estimate by the caller, the engine doesn't report the compressed size */
+	static void onAspectSerialized( uint aspect, uint estimatedBytes, channelId skipChnlId = 0 );
+	static void onSynchedMessage( channelId chnlId, uint estimatedBytes );
+	static void onInputSkipped( channelId chnlId );
+
+	/* shifts the rolling windows, needs to be called regularly from game loop */
+	static void onUpdate( float frameTime );
+	static void onClientConnect( channelId chnlId );
+	static void onClientDisconnect( channelId chnlId );
+	static void reset();
+
+	/* writes the statistics of one channel (or all channels, if chnlId is 0) into console */
+	static void dump( channelId chnlId );
+	/* fills a Lua table with statistics of one channel, returns false, if nothing is known about the channel */
+	static bool toScriptTable( channelId chnlId, IScriptTable * table );
+	/* copies the counter of one channel, returns false, if nothing is known about the channel */
+	static bool getCounter( channelId chnlId, ECounter counter, RollingCounter & result );
+	static bool getRMICounters( channelId chnlId, const char * name, RollingCounter & received, RollingCounter & rejected );
+
+
+  protected:
+
+	struct RMICounters {
+		RollingCounter received;
+		RollingCounter rejected;
+	};
+	struct ChannelStats {
+		RollingCounter counters [NUM_COUNTERS];
+		std::map<uint, RMICounters> rmis;        // key is RMI index
+		std::map<uint, RollingCounter> aspects;  // key is aspect, value is bytes
+	};
+	typedef std::map<channelId, ChannelStats> ChannelMap;
+
+	static ChannelStats & getChannel( channelId chnlId );
+	static void dumpChannel( channelId chnlId, const ChannelStats & stats );
+
+	static ChannelMap                 channels;
+	static std::vector<std::string>   rmiNames;
+	static float                      timer;
+
+};
+
+#endif // NET_STATS_INCLUDED
@@ -0,0 +1,243 @@
+//================================================================================
+// File:    Code/CryFire/PacketFilter.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Rate-limiting pre-filter for incoming network packets
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#include "StdAfx.h"
+
+#include "PacketFilter.h"
+
+#include "CryFire/Logging.h"
+
+#include <windows.h>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------------------------------
+PacketFilter::Limit  PacketFilter::limits [NUM_CLASSES];
+PacketFilter::Entry  PacketFilter::table [TABLE_SIZE];
+uint                 PacketFilter::passed [NUM_CLASSES];
+uint                 PacketFilter::dropped [NUM_CLASSES];
+uint                 PacketFilter::crashAttempts = 0;
+uint                 PacketFilter::floodSources = 0;
+uint                 PacketFilter::evictions = 0;
+
+// guards everything above, kept out of the header, so that it doesn't need windows.h
+static CRITICAL_SECTION  lock;
+static bool              lockInitialized = false;
+
+static const char * const classNames [PacketFilter::NUM_CLASSES] = { "connect", "disconnect", "other" };
+
+#define IP_FORMAT "%u.%u.%u.%u"
+#define IP_ARGS(ip) ((ip) >> 24) & 0xFF, ((ip) >> 16) & 0xFF, ((ip) >> 8) & 0xFF, (ip) & 0xFF
+
+//----------------------------------------------------------------------------------------------------
+void PacketFilter::initialize()
+{
+	if (!lockInitialized) {
+		InitializeCriticalSection( &lock );
+		lockInitialized = true;
+	}
+	EnterCriticalSection( &lock );
+
+	// sometimes client can resend connection packet, so allow a few of them in a row,
+	// then only one per second, that's still enough for a legit reconnect
+	limits[eConnect].rate = 1;
+	limits[eConnect].burst = 10;
+	limits[eDisconnect].rate = 2;
+	limits[eDisconnect].burst = 10;
+	// regular game traffic of one client is well below this, even with high cl_bandwidth
+	limits[eOther].rate = 1000;
+	limits[eOther].burst = 2000;
+
+	memset( table, 0, sizeof(table) );
+	for (uint i = 0; i < NUM_CLASSES; i++) {
+		passed[i] = 0;
+		dropped[i] = 0;
+	}
+	crashAttempts = 0;
+	floodSources = 0;
+	evictions = 0;
+
+	LeaveCriticalSection( &lock );
+}
+
+//----------------------------------------------------------------------------------------------------
+PacketFilter::Entry * PacketFilter::findEntry( uint IPv4, uint now )
+{
+	uint start = (IPv4 * 2654435761u) >> 22;   // Fibonacci hashing into 1024 slots
+	Entry * freeSlot = NULL;
+	Entry * oldest = NULL;
+
+	for (uint i = 0; i < MAX_PROBE; i++) {
+		Entry & entry = table[ (start + i) & (TABLE_SIZE - 1) ];
+		if (entry.IPv4 == IPv4)
+			return &entry;
+		bool expired = entry.IPv4 == 0 || now - entry.lastSeen > ENTRY_TTL;
+		if (expired && !freeSlot)
+			freeSlot = &entry;
+		if (!oldest || now - entry.lastSeen > now - oldest->lastSeen)
+			oldest = &entry;
+	}
+
+	// not found, take a free slot or sacrifice the least recently seen address
+	Entry * entry = freeSlot;
+	if (!entry) {
+		entry = oldest;
+		evictions++;
+	}
+	entry->IPv4 = IPv4;
+	entry->lastSeen = now;
+	for (uint i = 0; i < NUM_CLASSES; i++) {
+		entry->tokens[i] = limits[i].burst * 1000;
+		entry->dropped[i] = 0;
+	}
+	return entry;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PacketFilter::refill( Entry & entry, uint now )
+{
+	uint elapsed = now - entry.lastSeen;   // milliseconds, so elapsed * rate gives 1/1000 tokens
+	if (elapsed > ENTRY_TTL)
+		elapsed = ENTRY_TTL;
+	entry.lastSeen = now;
+	if (elapsed == 0)
+		return;
+
+	for (uint i = 0; i < NUM_CLASSES; i++) {
+		uint capacity = limits[i].burst * 1000;
+		uint tokens = entry.tokens[i] + elapsed * limits[i].rate;
+		entry.tokens[i] = tokens < capacity ? tokens : capacity;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PacketFilter::onPacket( uint IPv4, byte * data, uint len )
+{
+	return onPacket( IPv4, data, len, GetTickCount() );
+}
+
+bool PacketFilter::onPacket( uint IPv4, byte * data, uint len, uint now )
+{
+	EnterCriticalSection( &lock );
+	bool pass = filterPacket( IPv4, data, len, now );
+	LeaveCriticalSection( &lock );
+	return pass;
+}
+
+bool PacketFilter::filterPacket( uint IPv4, byte * data, uint len, uint now )
+{
+	if (len == 0)
+		return false;
+
+	EPacketClass packetClass;
+	if (data[0] == '\x3C')
+		packetClass = eConnect;
+	else if (data[0] == '\x3E')
+		packetClass = eDisconnect;
+	else
+		packetClass = eOther;
+
+	if (packetClass == eDisconnect && len >= 6 && data[1] == '\x19' && data[2] == '%' && data[3] == 's' && data[4] == '%' && data[5] == 's') {
+		// disconnect reason is later used as a format string by the engine, so defuse it
+		for (uint i = 2; i < len; i++)
+			if (data[i] == '%')
+				data[i] = '_';
+		crashAttempts++;
+		CF_AsyncLog( 0, "crysisfs (crash) attack detected from " IP_FORMAT, IP_ARGS(IPv4) );
+	}
+
+	Entry * entry = findEntry( IPv4, now );
+	refill( *entry, now );
+
+	if (entry->tokens[packetClass] < 1000) {
+		dropped[packetClass]++;
+		uint droppedInRow = ++entry->dropped[packetClass];
+		if (packetClass == eConnect) {
+			if (droppedInRow == 1)
+				floodSources++;
+			if (droppedInRow % 50 == 1) // display warning only every 50th attempt to not spam them during attack
+				CF_AsyncLog( 0, "crysisdos (freeze) attack detected from " IP_FORMAT, IP_ARGS(IPv4) );
+		}
+		return false;
+	}
+
+	entry->tokens[packetClass] -= 1000;
+	if (packetClass == eDisconnect && entry->dropped[eConnect] > 0)
+		CF_AsyncLog( 1, "%u connect packets were dropped from " IP_FORMAT, entry->dropped[eConnect], IP_ARGS(IPv4) );
+	entry->dropped[packetClass] = 0;
+	passed[packetClass]++;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void PacketFilter::setLimit( EPacketClass packetClass, uint ratePerSec, uint burst )
+{
+	if (burst < 1)
+		burst = 1;
+	else if (burst > MAX_BURST)
+		burst = MAX_BURST;
+	if (ratePerSec > MAX_RATE)
+		ratePerSec = MAX_RATE;
+	EnterCriticalSection( &lock );
+	limits[packetClass].rate = ratePerSec;
+	limits[packetClass].burst = burst;
+	LeaveCriticalSection( &lock );
+}
+
+bool PacketFilter::getClassByName( const char * name, EPacketClass & packetClass )
+{
+	for (uint i = 0; i < NUM_CLASSES; i++) {
+		if (stricmp( name, classNames[i] ) == 0) {
+			packetClass = (EPacketClass)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+const char * PacketFilter::getClassName( EPacketClass packetClass )
+{
+	return classNames[packetClass];
+}
+
+//----------------------------------------------------------------------------------------------------
+void PacketFilter::getStats( Stats & stats )
+{
+	getStats( stats, GetTickCount() );
+}
+
+void PacketFilter::getStats( Stats & stats, uint now )
+{
+	EnterCriticalSection( &lock );
+	for (uint i = 0; i < NUM_CLASSES; i++) {
+		stats.passed[i] = passed[i];
+		stats.dropped[i] = dropped[i];
+	}
+	stats.crashAttempts = crashAttempts;
+	stats.floodSources = floodSources;
+	stats.evictions = evictions;
+
+	stats.activeEntries = 0;
+	for (uint i = 0; i < TABLE_SIZE; i++)
+		if (table[i].IPv4 != 0 && now - table[i].lastSeen <= ENTRY_TTL)
+			stats.activeEntries++;
+	LeaveCriticalSection( &lock );
+}
@@ -0,0 +1,111 @@
+//================================================================================
+// File:    Code/CryFire/PacketFilter.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Rate-limiting pre-filter for incoming network packets
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef PACKET_FILTER_INCLUDED
+#define PACKET_FILTER_INCLUDED
+
+
+typedef unsigned int uint;
+typedef unsigned char byte;
+
+
+//----------------------------------------------------------------------------------------------------
+class PacketFilter {
+
+  public:
+
+	enum EPacketClass {
+		eConnect = 0,
+		eDisconnect,
+		eOther,
+		NUM_CLASSES
+	};
+
+	/* size of the per-IP table, it never grows, old entries are reused */
+	static const uint TABLE_SIZE = 1024;
+	/* how many neighbouring slots are searched before the least recently seen one is replaced */
+	static const uint MAX_PROBE = 8;
+	/* entries not seen for this long are considered free */
+	static const uint ENTRY_TTL = 60000;
+	/* limits from scripts are clamped to these, so that the tokens (in 1/1000) don't overflow 32 bits:
+	   MAX_BURST * 1000 + ENTRY_TTL * MAX_RATE < 2^32 */
+	static const uint MAX_RATE = 30000;
+	static const uint MAX_BURST = 1000000;
+
+	struct Stats {
+		uint passed [NUM_CLASSES];
+		uint dropped [NUM_CLASSES];
+		uint crashAttempts;   // crysisfs
+		uint floodSources;    // crysisdos, counted once per flood
+		uint evictions;
+		uint activeEntries;
+	};
+
+	/* sets default limits and clears the table, call from the primary thread before the hook is installed */
+	static void initialize();
+
+	/* decides whether the packet may be passed to the engine, returns false, if it should be dropped
+	   !! called from the network thread, use only CF_AsyncLog and the filter's own data here,
+	   the table and the counters are locked, because the limits and the stats come from the primary thread */
+	static bool onPacket( uint IPv4, byte * data, uint len );
+	/* the same with explicit time in milliseconds, for tests */
+	static bool onPacket( uint IPv4, byte * data, uint len, uint now );
+
+	/* changes the token bucket of a packet class, rate is in packets per second, see MAX_RATE and MAX_BURST */
+	static void setLimit( EPacketClass packetClass, uint ratePerSec, uint burst );
+	static bool getClassByName( const char * name, EPacketClass & packetClass );
+	static const char * getClassName( EPacketClass packetClass );
+
+	/* copies the counters and counts the table entries seen within ENTRY_TTL, all at one moment */
+	static void getStats( Stats & stats );
+	/* the same with explicit time in milliseconds, for tests */
+	static void getStats( Stats & stats, uint now );
+
+
+  protected:
+
+	struct Limit {
+		uint rate;    // tokens per second
+		uint burst;   // bucket capacity in tokens
+	};
+	struct Entry {
+		uint IPv4;                      // 0 = free slot
+		uint lastSeen;                  // tick count of the last packet
+		uint tokens [NUM_CLASSES];      // in 1/1000 of a token
+		uint dropped [NUM_CLASSES];     // dropped in a row, reset when a packet passes
+	};
+
+	static Entry * findEntry( uint IPv4, uint now );
+	static void    refill( Entry & entry, uint now );
+
+	static bool filterPacket( uint IPv4, byte * data, uint len, uint now );
+
+	static Limit  limits [NUM_CLASSES];
+	static Entry  table [TABLE_SIZE];
+	static uint   passed [NUM_CLASSES];
+	static uint   dropped [NUM_CLASSES];
+	static uint   crashAttempts;
+	static uint   floodSources;
+	static uint   evictions;
+
+};
+
+#endif // PACKET_FILTER_INCLUDED
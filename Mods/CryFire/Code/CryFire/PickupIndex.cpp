@@ -0,0 +1,221 @@
+//================================================================================
+// File:    Code/CryFire/PickupIndex.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Index of items lying in the world for pickup checks
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "PickupIndex.h"
+
+#include "Item.h"
+#include "Game.h"
+
+#include <IItemSystem.h>
+#include <IScriptSystem.h>
+
+
+//----------------------------------------------------------------------------------------------------
+const float              PickupIndex::CELL_SIZE = 4.0f;
+const float              PickupIndex::REFRESH_INTERVAL = 0.25f;
+const float              PickupIndex::MAX_EXTENT = 1.5f;
+PickupIndex::PickupMap   PickupIndex::pickups;
+PickupIndex::CellMap     PickupIndex::cells;
+PickupIndex::ClassMap    PickupIndex::classes;
+CTimeValue               PickupIndex::lastRefresh;
+
+//----------------------------------------------------------------------------------------------------
+uint PickupIndex::cellOf( float x, float y )
+{
+	int cx = (int)floor_tpl( x / CELL_SIZE );
+	int cy = (int)floor_tpl( y / CELL_SIZE );
+	return ((uint)(cx & 0xFFFF) << 16) | (uint)(cy & 0xFFFF);
+}
+
+//----------------------------------------------------------------------------------------------------
+const PickupIndex::ClassInfo & PickupIndex::getClassInfo( IEntityClass * pClass )
+{
+	ClassMap::iterator it = classes.find( pClass );
+	if (it != classes.end())
+		return it->second;
+
+	IItemSystem * pItemSystem = g_pGame->GetIGameFramework()->GetIItemSystem();
+	const char * className = pClass->GetName();
+	const char * category = pItemSystem->GetItemCategory( className );
+
+	ClassInfo info;
+	info.customAmmo = !strcmp( className, "CustomAmmoPickup" );
+	info.dualWield = !strcmp( className, "SOCOM" );
+	info.checkLimit = !category || !strcmp( category, "medium" ) || !strcmp( category, "heavy" );
+	info.uniqueId = pItemSystem->GetItemUniqueId( className );
+	return classes.insert( ClassMap::value_type( pClass, info ) ).first->second;
+}
+
+const char * PickupIndex::getShownName( IEntity * pItemEntity )
+{
+	PickupMap::const_iterator it = pickups.find( pItemEntity->GetId() );
+	if (it != pickups.end())
+		return it->second.name.c_str();
+
+	// not lying in the world, resolve it now
+	if (getClassInfo( pItemEntity->GetClass() ).customAmmo) {
+		SmartScriptTable props;
+		const char * name = NULL;
+		if (pItemEntity->GetScriptTable() && pItemEntity->GetScriptTable()->GetValue( "Properties", props ) && props->GetValue( "AmmoName", name ) && name)
+			return name;
+	}
+	return pItemEntity->GetClass()->GetName();
+}
+
+//----------------------------------------------------------------------------------------------------
+void PickupIndex::onOwnerChanged( CItem * pItem )
+{
+	if (pItem->GetOwnerId())
+		remove( pItem->GetEntityId() );
+	else
+		add( pItem );
+}
+
+void PickupIndex::onItemRemoved( EntityId itemId )
+{
+	remove( itemId );
+}
+
+void PickupIndex::add( CItem * pItem )
+{
+	IEntity * pEntity = pItem->GetEntity();
+	if (pickups.find( pEntity->GetId() ) != pickups.end())
+		return;
+
+	Pickup pickup;
+	pickup.pClass = pEntity->GetClass();
+	pickup.name = pEntity->GetClass()->GetName();
+	if (getClassInfo( pickup.pClass ).customAmmo) {
+		SmartScriptTable props;
+		const char * name = NULL;
+		if (pEntity->GetScriptTable() && pEntity->GetScriptTable()->GetValue( "Properties", props ) && props->GetValue( "AmmoName", name ) && name)
+			pickup.name = name;
+	}
+	Vec3 pos = pEntity->GetWorldPos();
+	pickup.cell = cellOf( pos.x, pos.y );
+
+	pickups.insert( PickupMap::value_type( pEntity->GetId(), pickup ) );
+	cells[ pickup.cell ].push_back( pEntity->GetId() );
+}
+
+void PickupIndex::remove( EntityId itemId )
+{
+	PickupMap::iterator it = pickups.find( itemId );
+	if (it == pickups.end())
+		return;
+
+	CellMap::iterator cell = cells.find( it->second.cell );
+	if (cell != cells.end()) {
+		stl::find_and_erase( cell->second, itemId );
+		if (cell->second.empty())
+			cells.erase( cell->first );
+	}
+	pickups.erase( itemId );
+}
+
+//----------------------------------------------------------------------------------------------------
+void PickupIndex::refresh()
+{
+	CTimeValue now = gEnv->pTimer->GetFrameStartTime();
+	if ((now - lastRefresh).GetSeconds() < REFRESH_INTERVAL)
+		return;
+	lastRefresh = now;
+
+	// dropped items fall and roll, explosions push them, move them to their current cells
+	for (PickupMap::iterator it = pickups.begin(); it != pickups.end(); ++it) {
+		IEntity * pEntity = gEnv->pEntitySystem->GetEntity( it->first );
+		if (!pEntity)
+			continue;   // removed by CItem destructor
+		Vec3 pos = pEntity->GetWorldPos();
+		uint cell = cellOf( pos.x, pos.y );
+		if (cell == it->second.cell)
+			continue;
+
+		CellMap::iterator oldCell = cells.find( it->second.cell );
+		if (oldCell != cells.end()) {
+			stl::find_and_erase( oldCell->second, it->first );
+			if (oldCell->second.empty())
+				cells.erase( oldCell->first );
+		}
+		cells[ cell ].push_back( it->first );
+		it->second.cell = cell;
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+uint PickupIndex::queryCone( const AABB & box, const Vec3 & pos, const Vec3 & dir, float maxLineDistSq, Hits & hits )
+{
+	hits.resize( 0 );
+	refresh();
+
+	int minX = (int)floor_tpl( (box.min.x - MAX_EXTENT) / CELL_SIZE ), maxX = (int)floor_tpl( (box.max.x + MAX_EXTENT) / CELL_SIZE );
+	int minY = (int)floor_tpl( (box.min.y - MAX_EXTENT) / CELL_SIZE ), maxY = (int)floor_tpl( (box.max.y + MAX_EXTENT) / CELL_SIZE );
+	Line line( pos, dir );
+
+	for (int cx = minX; cx <= maxX; cx++) {
+		for (int cy = minY; cy <= maxY; cy++) {
+			CellMap::const_iterator cell = cells.find( ((uint)(cx & 0xFFFF) << 16) | (uint)(cy & 0xFFFF) );
+			if (cell == cells.end())
+				continue;
+			const std::vector<EntityId> & ids = cell->second;
+			for (uint i = 0; i < ids.size(); i++) {
+				IEntity * pEntity = gEnv->pEntitySystem->GetEntity( ids[i] );
+				if (!pEntity)
+					continue;
+				AABB bounds;
+				pEntity->GetWorldBounds( bounds );
+				if (bounds.min.x > box.max.x || bounds.max.x < box.min.x ||
+				    bounds.min.y > box.max.y || bounds.max.y < box.min.y ||
+				    bounds.min.z > box.max.z || bounds.max.z < box.min.z)
+					continue;
+				Vec3 center = bounds.GetCenter();
+				if (dir.Dot( center - pos ) <= 0.0f)
+					continue;
+				float lineDistSq = LinePointDistanceSqr( line, center );
+				if (lineDistSq >= maxLineDistSq)
+					continue;
+				Hit hit;
+				hit.id = ids[i];
+				hit.lineDistSq = lineDistSq;
+				hits.push_back( hit );
+			}
+		}
+	}
+
+	std::sort( hits.begin(), hits.end() );
+	return hits.size();
+}
+
+bool PickupIndex::isWithinReach( EntityId itemId, const Vec3 & pos, float maxDist )
+{
+	if (pickups.find( itemId ) == pickups.end())
+		return false;
+	IEntity * pEntity = gEnv->pEntitySystem->GetEntity( itemId );
+	if (!pEntity)
+		return false;
+	AABB bounds;
+	pEntity->GetWorldBounds( bounds );
+	return bounds.GetDistanceSqr( pos ) <= maxDist * maxDist;
+}
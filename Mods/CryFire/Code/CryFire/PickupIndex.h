@@ -0,0 +1,107 @@
+//================================================================================
+// File:    Code/CryFire/PickupIndex.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Index of items lying in the world for pickup checks
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef PICKUP_INDEX_INCLUDED
+#define PICKUP_INDEX_INCLUDED
+
+
+#include <IEntity.h>
+#include <FlatHashMap.h>
+
+#include <vector>
+
+typedef unsigned int uint;
+
+class CItem;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Items lying in the world without an owner, sorted into horizontal grid cells, so that the offhand
+   crosshair and the server looks only at the items around the player instead of querying the entity
+   system for everything in a box. Items are added and removed when their owner changes, the positions
+   are refreshed lazily by the first query after REFRESH_INTERVAL, the exact bounds of the candidates
+   are read on every query. What the pickup checks need to know about a class is resolved once per class,
+   the shown name of an item (AmmoName property of custom ammo pickups) once per item. */
+class PickupIndex {
+
+  public:
+
+	static const float CELL_SIZE;          // meters
+	static const float REFRESH_INTERVAL;   // seconds
+	static const float MAX_EXTENT;         // how far an item can be outside of its cell, covers its size and movement
+
+	struct ClassInfo {
+		bool customAmmo;       // CustomAmmoPickup, the shown name is the AmmoName property of the entity
+		bool dualWield;        // the second one is picked up for dual wield instead of for ammo (SOCOM)
+		bool checkLimit;       // counts to the weapon limit or has no category, CActor::CheckInventoryRestrictions decides
+		uint8 uniqueId;        // IItemSystem::GetItemUniqueId, all kits share one
+	};
+
+	struct Hit {
+		EntityId id;
+		float lineDistSq;
+		bool operator<( const Hit & other ) const { return lineDistSq < other.lineDistSq; }
+	};
+	typedef std::vector<Hit> Hits;
+
+	/* call when the owner of the item changes, it's indexed while it has none */
+	static void onOwnerChanged( CItem * pItem );
+	static void onItemRemoved( EntityId itemId );
+
+	/* the reference is valid until another class is resolved */
+	static const ClassInfo & getClassInfo( IEntityClass * pClass );
+	/* class name of the item, or the AmmoName of a custom ammo pickup */
+	static const char * getShownName( IEntity * pItemEntity );
+
+	/* items whose bounds overlap the box and whose centre is in front of pos and closer than
+	   sqrt(maxLineDistSq) to the line (pos, dir), sorted from the nearest to the line */
+	static uint queryCone( const AABB & box, const Vec3 & pos, const Vec3 & dir, float maxLineDistSq, Hits & hits );
+
+	/* true if the item lies in the world and its bounds are at most maxDist from pos */
+	static bool isWithinReach( EntityId itemId, const Vec3 & pos, float maxDist );
+
+	static uint getCount() { return pickups.size(); }
+
+
+  protected:
+
+	struct Pickup {
+		IEntityClass * pClass;
+		string name;      // shown name
+		uint cell;
+	};
+	typedef FlatHashMap<EntityId, Pickup> PickupMap;
+	typedef FlatHashMap<uint, std::vector<EntityId> > CellMap;
+	typedef FlatHashMap<IEntityClass *, ClassInfo> ClassMap;
+
+	static uint cellOf( float x, float y );
+	static void add( CItem * pItem );
+	static void remove( EntityId itemId );
+	static void refresh();
+
+	static PickupMap   pickups;
+	static CellMap     cells;
+	static ClassMap    classes;
+	static CTimeValue  lastRefresh;
+
+};
+
+#endif // PICKUP_INDEX_INCLUDED
@@ -0,0 +1,155 @@
+//================================================================================
+// File:    Code/CryFire/RayQueue.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Rays traced in a batch at the beginning of the next frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "RayQueue.h"
+
+#include <Game.h>
+#include <GameCVars.h>
+
+
+//----------------------------------------------------------------------------------------------------
+std::deque<RayQueue::Request>          RayQueue::queue;
+std::vector<RayQueue::CallerStats>     RayQueue::callers;
+uint                                   RayQueue::frames = 0;
+uint                                   RayQueue::maxPending = 0;
+
+//----------------------------------------------------------------------------------------------------
+uint RayQueue::registerCaller( const char * name )
+{
+	for (uint i = 0; i < callers.size(); i++)
+		if (callers[i].name == name)
+			return i;
+	CallerStats caller;
+	caller.name = name;
+	caller.submitted = caller.traced = caller.hits = caller.dropped = 0;
+	caller.latencySum = caller.latencyMax = 0.0f;
+	callers.push_back( caller );
+	return callers.size() - 1;
+}
+
+void RayQueue::submit( const Request & request )
+{
+	queue.push_back( request );
+	queue.back().submitTime = gEnv->pTimer->GetFrameStartTime();
+	callers[request.caller].submitted++;
+	if (queue.size() > maxPending)
+		maxPending = queue.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RayQueue::trace( const Request & request, Result & result )
+{
+	IPhysicalEntity * pSkipEnts [2];
+	int nSkip = 0;
+	for (uint i = 0; i < 2; i++) {
+		if (!request.skipIds[i])
+			continue;
+		IEntity * pSkip = gEnv->pEntitySystem->GetEntity( request.skipIds[i] );
+		if (pSkip && pSkip->GetPhysics())
+			pSkipEnts[nSkip++] = pSkip->GetPhysics();
+	}
+
+	ray_hit hit;
+	int nHits = gEnv->pPhysicalWorld->RayWorldIntersection( request.origin, request.dir, request.objTypes, request.flags,
+	                                                        &hit, 1, pSkipEnts, nSkip, 0, 0, callers[request.caller].name.c_str() );
+	result.hit = nHits > 0;
+	result.hitEntityId = 0;
+	if (result.hit) {
+		result.pos = hit.pt;
+		result.normal = hit.n;
+		result.dist = hit.dist;
+		if (hit.pCollider)
+			if (IEntity * pEntity = (IEntity*)hit.pCollider->GetForeignData( PHYS_FOREIGN_ID_ENTITY ))
+				result.hitEntityId = pEntity->GetId();
+	} else {
+		result.pos = request.origin + request.dir;
+		result.normal.zero();
+		result.dist = request.dir.GetLength();
+	}
+}
+
+bool RayQueue::entityExists( EntityId entityId )
+{
+	return gEnv->pEntitySystem->GetEntity( entityId ) != NULL;
+}
+
+void RayQueue::onUpdate()
+{
+	uint budget = g_pGameCVars->cf_rayqueue_budget > 0 ? (uint)g_pGameCVars->cf_rayqueue_budget : ~0u;
+	onUpdate( budget, trace, entityExists );
+}
+
+void RayQueue::onUpdate( uint budget, TraceFunc traceFunc, ExistsFunc existsFunc )
+{
+	frames++;
+	CTimeValue frame = gEnv->pTimer->GetFrameStartTime();
+
+	// requests are ordered by time, so stop at the first one submitted in this frame,
+	// this also stops at the requests the callbacks submit
+	for (uint traced = 0; traced < budget && !queue.empty() && queue.front().submitTime < frame; ) {
+		Request request = queue.front();
+		queue.pop_front();
+		CallerStats & caller = callers[request.caller];
+
+		if (request.ownerId && !existsFunc( request.ownerId )) {
+			caller.dropped++;
+			continue;
+		}
+
+		Result result;
+		traceFunc( request, result );
+		traced++;
+
+		float latency = (frame - request.submitTime).GetMilliSeconds();
+		caller.traced++;
+		caller.latencySum += latency;
+		if (latency > caller.latencyMax)
+			caller.latencyMax = latency;
+		if (result.hit)
+			caller.hits++;
+
+		request.callback( request, result );
+	}
+}
+
+void RayQueue::reset()
+{
+	queue.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RayQueue::dump()
+{
+	CryLogAlways("$8ray queue$o over %u frames, %u rays pending now, at most %u", frames, (uint)queue.size(), maxPending);
+	CryLogAlways("  caller             submitted  traced    hits dropped  avg ms  max ms");
+	for (uint i = 0; i < callers.size(); i++) {
+		CallerStats & caller = callers[i];
+		CryLogAlways("  %-18s %9u %7u %7u %7u %7.1f %7.1f", caller.name.c_str(), caller.submitted, caller.traced, caller.hits,
+		             caller.dropped, caller.traced ? caller.latencySum / caller.traced : 0.0f, caller.latencyMax);
+		caller.submitted = caller.traced = caller.hits = caller.dropped = 0;
+		caller.latencySum = caller.latencyMax = 0.0f;
+	}
+	frames = 0;
+	maxPending = queue.size();
+}
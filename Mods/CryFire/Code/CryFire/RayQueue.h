@@ -0,0 +1,114 @@
+//================================================================================
+// File:    Code/CryFire/RayQueue.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Rays traced in a batch at the beginning of the next frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef RAY_QUEUE_INCLUDED
+#define RAY_QUEUE_INCLUDED
+
+
+#include <IEntity.h>
+#include <TimeValue.h>
+
+#include <deque>
+#include <vector>
+#include <string>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Gameplay code which doesn't need the answer immediately (visibility checks of AI, turrets, ...)
+   submits its rays here instead of calling RayWorldIntersection in the middle of its update.
+   The queue traces them all together at the beginning of the next frame on the game thread
+   and hands the results to the callbacks, so it's safe to touch entities there. */
+class RayQueue {
+
+  public:
+
+	struct Request;
+
+	struct Result {
+		bool hit;
+		EntityId hitEntityId;   // 0 for terrain and objects without entity
+		Vec3 pos;
+		Vec3 normal;
+		float dist;
+	};
+
+	/* called from RayQueue::onUpdate, the owner entity (if any) still exists at this time */
+	typedef void (*Callback)( const Request & request, const Result & result );
+
+	typedef void (*TraceFunc)( const Request & request, Result & result );
+	typedef bool (*ExistsFunc)( EntityId entityId );
+
+	struct Request {
+		Vec3 origin;
+		Vec3 dir;                // direction multiplied by length
+		int objTypes;            // ent_* flags
+		uint flags;              // rwi_* flags
+		EntityId skipIds [2];    // physics of these entities are ignored, 0 = none
+		EntityId ownerId;        // request is dropped, if this entity is removed meanwhile, 0 = nobody
+		uint tag;                // anything the caller needs to recognize the ray in the callback
+		uint caller;             // index from registerCaller, for statistics
+		Callback callback;
+		CTimeValue submitTime;   // filled by submit
+	};
+
+	/* returns index of caller with this name, registers it when it's used for the first time */
+	static uint registerCaller( const char * name );
+
+	/* the callback is called in the next frame at the earliest, later if the ray budget is exhausted */
+	static void submit( const Request & request );
+
+	/* traces rays submitted in previous frames, needs to be called once per frame from game loop */
+	static void onUpdate();
+	/* the same with explicit budget and with the physics and the entity system replaced, for tests */
+	static void onUpdate( uint budget, TraceFunc traceFunc, ExistsFunc existsFunc );
+	/* drops all pending requests without calling their callbacks */
+	static void reset();
+
+	/* writes the statistics of all callers into console and clears them */
+	static void dump();
+
+
+  protected:
+
+	struct CallerStats {
+		std::string name;
+		uint submitted;
+		uint traced;
+		uint hits;
+		uint dropped;          // owner removed before the ray was traced
+		float latencySum;      // milliseconds between submitting and tracing
+		float latencyMax;
+	};
+
+	static void trace( const Request & request, Result & result );
+	static bool entityExists( EntityId entityId );
+
+	static std::deque<Request>       queue;
+	static std::vector<CallerStats>  callers;
+	static uint                      frames;
+	static uint                      maxPending;
+
+};
+
+#endif // RAY_QUEUE_INCLUDED
@@ -0,0 +1,173 @@
+//================================================================================
+// File:    Code/CryFire/Relevancy.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Interest management deciding which clients need entity updates right now
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "Relevancy.h"
+
+#include <Game.h>
+#include <GameCVars.h>
+#include <GameRules.h>
+#include <Actor.h>
+#include <ServerSynchedStorage.h>
+#include <IActorSystem.h>
+
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------------------------------
+const float Relevancy::UPDATE_INTERVAL = 0.5f;
+
+InterestGrid                Relevancy::grid;
+float                       Relevancy::timer = 0.0f;
+float                       Relevancy::flushTimer = 0.0f;
+uint                        Relevancy::immediate = 0;
+uint                        Relevancy::deferred = 0;
+
+//----------------------------------------------------------------------------------------------------
+bool Relevancy::isEnabled()
+{
+	return gEnv->bServer && gEnv->bMultiplayer && g_pGameCVars->cf_relevancy != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void flushDeferred( bool all )
+{
+	if (CServerSynchedStorage * pStorage = g_pGame->GetServerSynchedStorage())
+		pStorage->FlushDeferredEntities( all );
+	if (CGameRules * pGameRules = g_pGame->GetGameRules())
+		pGameRules->FlushDeferredMinimap( all );
+}
+
+void Relevancy::onUpdate( float frameTime )
+{
+	if (!isEnabled()) {
+		// it was turned off, so nothing new gets deferred, send what's left
+		if (!grid.isEmpty()) {
+			flushDeferred( true );
+			reset();
+		}
+		return;
+	}
+
+	timer += frameTime;
+	if (timer < UPDATE_INTERVAL)
+		return;
+	timer = 0.0f;
+
+	refreshObservers();
+
+	flushTimer += UPDATE_INTERVAL;
+	bool flushAll = flushTimer >= g_pGameCVars->cf_relevancy_maxdelay;
+	if (flushAll)
+		flushTimer = 0.0f;
+	flushDeferred( flushAll );
+}
+
+void Relevancy::onClientDisconnect( int chnlId )
+{
+	grid.removeObserver( chnlId );
+}
+
+void Relevancy::reset()
+{
+	grid.reset( grid.getCellSize() );
+	timer = 0.0f;
+	flushTimer = 0.0f;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Relevancy::refreshObservers()
+{
+	grid.reset( max( g_pGameCVars->cf_relevancy_radius, 10.0f ) );
+
+	CGameRules * pGameRules = g_pGame->GetGameRules();
+	IActorIteratorPtr it = g_pGame->GetIGameFramework()->GetIActorSystem()->CreateActorIterator();
+	while (CActor * pActor = (CActor*)it->Next()) {
+		int chnlId = pActor->GetChannelId();
+		if (!chnlId)
+			continue;
+
+		int team = pGameRules ? pGameRules->GetTeam( pActor->GetEntityId() ) : 0;
+		grid.addObserver( chnlId, pActor->GetEntity()->GetWorldPos(), pActor->GetViewRotation().GetColumn1(), team );
+	}
+}
+
+bool Relevancy::getEntityInfo( EntityId entityId, Vec3 & pos, int & team )
+{
+	CGameRules * pGameRules = g_pGame->GetGameRules();
+	IEntity * pEntity = gEnv->pEntitySystem->GetEntity( entityId );
+	// game rules hold values for everybody, its position doesn't mean anything
+	if (!pEntity || !pGameRules || entityId == pGameRules->GetEntityId())
+		return false;
+
+	pos = pEntity->GetWorldPos();
+	team = pGameRules->GetTeam( entityId );
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Relevancy::isInterested( int chnlId, EntityId entityId )
+{
+	if (!isEnabled())
+		return true;
+
+	if (!grid.isKnown( chnlId ))
+		return true;
+
+	Vec3 pos;
+	int team;
+	if (!getEntityInfo( entityId, pos, team ))
+		return true;
+
+	return grid.isInterested( chnlId, pos, team );
+}
+
+//----------------------------------------------------------------------------------------------------
+void Relevancy::getStats( Stats & stats )
+{
+	stats.observers = grid.getObserverCount();
+	stats.cells = grid.getCellCount();
+	stats.immediate = immediate;
+	stats.deferred = deferred;
+}
+
+//----------------------------------------------------------------------------------------------------
+InterestSet::InterestSet( EntityId entityId )
+ : all(true)
+{
+	Vec3 pos;
+	int team;
+	if (!Relevancy::isEnabled() || !Relevancy::getEntityInfo( entityId, pos, team ))
+		return;
+	all = false;
+
+	Relevancy::grid.getInterested( pos, team, channels );
+}
+
+bool InterestSet::contains( int chnlId ) const
+{
+	if (all || std::binary_search( channels.begin(), channels.end(), chnlId ))
+		return true;
+	// channels we don't know yet get everything
+	return !Relevancy::grid.isKnown( chnlId );
+}
@@ -0,0 +1,106 @@
+//================================================================================
+// File:    Code/CryFire/Relevancy.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Interest management deciding which clients need entity updates right now
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef RELEVANCY_INCLUDED
+#define RELEVANCY_INCLUDED
+
+
+#include <IEntity.h>
+
+#include "InterestGrid.h"
+
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Server keeps a position, team and view direction of every client, refreshed a few times per second.
+   An entity is interesting for a client, if it's close, in the client's view, or in the client's team.
+   Updates for other clients are deferred by the callers and sent when the entity gets interesting
+   or when the maximum delay expires, so every client still ends up with the latest values. */
+class Relevancy {
+
+  public:
+
+	/* how often the observers are refreshed and the deferred updates are checked (seconds) */
+	static const float UPDATE_INTERVAL;
+
+	struct Stats {
+		uint observers;
+		uint cells;
+		uint immediate;   // updates sent right away
+		uint deferred;    // updates postponed for a later flush
+	};
+
+	static bool isEnabled();
+
+	/* refreshes the observers at a low rate and lets the callers flush their deferred updates */
+	static void onUpdate( float frameTime );
+	static void onClientDisconnect( int chnlId );
+	static void reset();
+
+	/* whether changes of the entity should be sent to the channel right now,
+	   channels, which are not known yet, are always interested */
+	static bool isInterested( int chnlId, EntityId entityId );
+
+	/* callers report what they did with an update, only for statistics */
+	static inline void countImmediate() { immediate++; }
+	static inline void countDeferred()  { deferred++; }
+
+	static void getStats( Stats & stats );
+
+
+  protected:
+
+	friend class InterestSet;
+
+	static void refreshObservers();
+	/* returns false for entities whose position doesn't matter */
+	static bool getEntityInfo( EntityId entityId, Vec3 & pos, int & team );
+
+	static InterestGrid grid;
+	static float        timer;
+	static float        flushTimer;
+	static uint         immediate;
+	static uint         deferred;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+/* channels interested in one entity, uses the spatial cells, so it doesn't have to check every client */
+class InterestSet {
+
+  public:
+
+	InterestSet( EntityId entityId );
+
+	bool contains( int chnlId ) const;
+
+  protected:
+
+	std::vector<int> channels;   // sorted
+	bool all;
+
+};
+
+#endif // RELEVANCY_INCLUDED
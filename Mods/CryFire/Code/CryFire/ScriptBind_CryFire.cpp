@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  1.9.2016
-// Last edited: 7.10.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: DLL/C++ functions accessible in Lua
 //--------------------------------------------------------------------------------
@@ -29,6 +29,12 @@
 #include "CryFire/NetworkUtils.h"
 #include "CryFire/Http.h"
 #include "CryFire/Logging.h"
+#include "CryFire/PacketFilter.h"
+#include "CryFire/NetStats.h"
+#include "CryFire/Relevancy.h"
+#include "CryFire/Chat.h"
+#include "CryFire/TurretTargets.h"
+#include "CryFire/MovementCheck.h"
 
 #include <ctime>
 
@@ -90,6 +96,17 @@ void ScriptBind_CryFire::RegisterMethods()
 	SCRIPT_REG_TEMPLFUNC(IsInLAN, "playerId");
 	SCRIPT_REG_TEMPLFUNC(HTTP_Get, "hostName, port, urlPath, headers, luaCallback");
 	SCRIPT_REG_TEMPLFUNC(HTTP_Post, "hostName, port, urlPath, headers, data, luaCallback");
+	SCRIPT_REG_TEMPLFUNC(GetPacketFilterStats, "");
+	SCRIPT_REG_TEMPLFUNC(SetPacketFilterLimit, "packetClass, ratePerSec, burst");
+	SCRIPT_REG_TEMPLFUNC(GetNetStats, "playerId");
+	SCRIPT_REG_TEMPLFUNC(GetRelevancyStats, "");
+	SCRIPT_REG_TEMPLFUNC(RegisterChatCommand, "name, handler");
+	SCRIPT_REG_TEMPLFUNC(GetChatHistory, "count");
+	SCRIPT_REG_TEMPLFUNC(RegisterVoteType, "name, ratio, teamRatio, cooldown, handler");
+	SCRIPT_REG_TEMPLFUNC(StartVote, "playerId, type, targetId, subject");
+	SCRIPT_REG_TEMPLFUNC(GetTurretStats, "");
+	SCRIPT_REG_TEMPLFUNC(GetMovementStats, "playerId");
+	SCRIPT_REG_TEMPLFUNC(ResetMovementCheck, "playerId");
 	SCRIPT_REG_TEMPLFUNC(TestSpeed, "");
 	SCRIPT_REG_TEMPLFUNC(Test, "arg");
 }
@@ -263,6 +280,164 @@ int ScriptBind_CryFire::HTTP_Post( IFunctionHandler * pH, const char * hostName,
 	return pH->EndFunction();
 }
 
+int ScriptBind_CryFire::GetPacketFilterStats(IFunctionHandler * pH)
+{
+	PacketFilter::Stats stats;
+	PacketFilter::getStats( stats );
+
+	SmartScriptTable statsTable( m_pSS );
+	for (uint i = 0; i < PacketFilter::NUM_CLASSES; i++) {
+		SmartScriptTable classTable( m_pSS );
+		classTable->SetValue( "passed", (int)stats.passed[i] );
+		classTable->SetValue( "dropped", (int)stats.dropped[i] );
+		statsTable->SetValue( PacketFilter::getClassName( (PacketFilter::EPacketClass)i ), classTable );
+	}
+	statsTable->SetValue( "crashAttempts", (int)stats.crashAttempts );
+	statsTable->SetValue( "floodSources", (int)stats.floodSources );
+	statsTable->SetValue( "evictions", (int)stats.evictions );
+	statsTable->SetValue( "activeEntries", (int)stats.activeEntries );
+
+	return pH->EndFunction( statsTable );
+}
+
+int ScriptBind_CryFire::SetPacketFilterLimit(IFunctionHandler * pH, const char * packetClass, int ratePerSec, int burst)
+{
+	PacketFilter::EPacketClass cls;
+	if (!PacketFilter::getClassByName( packetClass, cls ) || ratePerSec < 0 || burst < 0) {
+		CF_LogError("SetPacketFilterLimit: invalid arguments");
+		return pH->EndFunction(false);
+	}
+
+	PacketFilter::setLimit( cls, (uint)ratePerSec, (uint)burst );
+	return pH->EndFunction(true);
+}
+
+int ScriptBind_CryFire::GetNetStats(IFunctionHandler * pH, ScriptHandle playerId)
+{
+	CGameRules * pGameRules = GetGameRules(pH);
+	if (!pGameRules)
+		return pH->EndFunction();
+
+	int chnlId = pGameRules->GetChannelId((EntityId)playerId.n);
+	if (!chnlId)
+		return pH->EndFunction();
+
+	SmartScriptTable statsTable( m_pSS );
+	if (!NetStats::toScriptTable( (channelId)chnlId, statsTable ))
+		return pH->EndFunction();
+
+	return pH->EndFunction( statsTable );
+}
+
+int ScriptBind_CryFire::GetRelevancyStats(IFunctionHandler * pH)
+{
+	Relevancy::Stats stats;
+	Relevancy::getStats( stats );
+
+	SmartScriptTable statsTable( m_pSS );
+	statsTable->SetValue( "observers", (int)stats.observers );
+	statsTable->SetValue( "cells", (int)stats.cells );
+	statsTable->SetValue( "immediate", (int)stats.immediate );
+	statsTable->SetValue( "deferred", (int)stats.deferred );
+	return pH->EndFunction( statsTable );
+}
+
+int ScriptBind_CryFire::RegisterChatCommand(IFunctionHandler * pH, const char * name, HSCRIPTFUNCTION handler)
+{
+	return pH->EndFunction( Chat::registerScriptCommand( name, handler ) );
+}
+
+int ScriptBind_CryFire::RegisterVoteType(IFunctionHandler * pH, const char * name, float ratio, float teamRatio, int cooldown, HSCRIPTFUNCTION handler)
+{
+	CGameRules * pGameRules = GetGameRules(pH);
+	CVotingSystem * pVotingSystem = pGameRules ? pGameRules->GetVotingSystem() : NULL;
+	if (!pVotingSystem) {
+		m_pSS->ReleaseFunc(handler);
+		return pH->EndFunction(false);
+	}
+
+	SVoteType type;
+	int existing = pVotingSystem->FindType(name);
+	if (existing >= 0)
+		type = pVotingSystem->GetVoteType(existing);   // keeps what the built-in type does
+	else
+		type.state = eVS_consoleCmd;                   // clients know only the built-in states
+	type.name = name;
+	type.ratio = ratio;
+	type.teamRatio = teamRatio;
+	type.cooldown = cooldown;
+	if (existing < 0 || type.handler)
+		type.handler = handler;
+	else
+		m_pSS->ReleaseFunc(handler);
+
+	if (pVotingSystem->RegisterType(type) < 0) {
+		CF_LogError("cannot register vote type \"%s\", there are too many", name);
+		m_pSS->ReleaseFunc(handler);
+		return pH->EndFunction(false);
+	}
+	return pH->EndFunction(true);
+}
+
+int ScriptBind_CryFire::StartVote(IFunctionHandler * pH, ScriptHandle playerId, const char * type, ScriptHandle targetId, const char * subject)
+{
+	CGameRules * pGameRules = GetGameRules(pH);
+	CVotingSystem * pVotingSystem = pGameRules ? pGameRules->GetVotingSystem() : NULL;
+	CActor * pActor = pGameRules ? pGameRules->GetActorByEntityId((EntityId)playerId.n) : NULL;
+	if (!pVotingSystem || !pActor)
+		return pH->EndFunction(false);
+
+	bool started = pGameRules->StartVotingOfType(pActor, pVotingSystem->FindType(type), (EntityId)targetId.n, subject);
+	return pH->EndFunction(started);
+}
+
+int ScriptBind_CryFire::GetChatHistory(IFunctionHandler * pH, int count)
+{
+	uint now = GetTickCount();
+	SmartScriptTable historyTable( m_pSS );
+	for (int i = 0; i < count; i++) {
+		const Chat::Message * msg = Chat::getHistory( (uint)i );
+		if (!msg)
+			break;
+		SmartScriptTable msgTable( m_pSS );
+		msgTable->SetValue( "type", (int)msg->type );
+		msgTable->SetValue( "sourceId", ScriptHandle( msg->sourceId ) );
+		msgTable->SetValue( "targetId", ScriptHandle( msg->targetId ) );
+		msgTable->SetValue( "age", (now - msg->time) / 1000.0f );
+		msgTable->SetValue( "text", msg->text );
+		historyTable->SetAt( i + 1, msgTable );
+	}
+	return pH->EndFunction( historyTable );
+}
+
+int ScriptBind_CryFire::GetTurretStats(IFunctionHandler * pH)
+{
+	TurretTargets::Stats stats;
+	TurretTargets::getStats( stats );
+
+	SmartScriptTable statsTable( m_pSS );
+	statsTable->SetValue( "candidates", (int)stats.candidates );
+	statsTable->SetValue( "searches", (int)stats.searches );
+	statsTable->SetValue( "searchesDelayed", (int)stats.searchesDelayed );
+	statsTable->SetValue( "rays", (int)stats.rays );
+	statsTable->SetValue( "rayCacheHits", (int)stats.rayCacheHits );
+	return pH->EndFunction( statsTable );
+}
+
+int ScriptBind_CryFire::GetMovementStats(IFunctionHandler * pH, ScriptHandle playerId)
+{
+	SmartScriptTable statsTable( m_pSS );
+	if (!MovementCheck::toScriptTable( (EntityId)playerId.n, statsTable ))
+		return pH->EndFunction();
+	return pH->EndFunction( statsTable );
+}
+
+int ScriptBind_CryFire::ResetMovementCheck(IFunctionHandler * pH, ScriptHandle playerId)
+{
+	MovementCheck::onTeleport( (EntityId)playerId.n );
+	return pH->EndFunction();
+}
+
 int ScriptBind_CryFire::TestSpeed(IFunctionHandler * pH)
 {
 	CGameRules * pGameRules = g_pGame->GetGameRules();
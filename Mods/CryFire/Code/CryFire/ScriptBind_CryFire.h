@@ -10,7 +10,7 @@
 //                                        /\___/
 //                                        \/__/
 // Created on:  1.9.2016
-// Last edited: 7.10.2017
+// Last edited: 19.10.2026
 //--------------------------------------------------------------------------------
 // Description: DLL/C++ functions accessible in Lua
 //--------------------------------------------------------------------------------
@@ -62,6 +62,29 @@ class ScriptBind_CryFire : public CScriptableBase {
 	/// performs an asynchronous HTTP POST request and calls you callback when result is ready
 	int HTTP_Post(IFunctionHandler * pH, const char * hostName, uint port, const char * urlPath,
 	              SmartScriptTable headers, const char * data, HSCRIPTFUNCTION luaCallback);
+	/// returns counters of the packet pre-filter as a table
+	int GetPacketFilterStats(IFunctionHandler * pH);
+	/// changes the rate limit of one packet class ("connect", "disconnect", "other")
+	int SetPacketFilterLimit(IFunctionHandler * pH, const char * packetClass, int ratePerSec, int burst);
+	/// returns network traffic statistics of a player's channel as a table
+	int GetNetStats(IFunctionHandler * pH, ScriptHandle playerId);
+	/// returns counters of the interest management (updates sent immediately and deferred for far players)
+	int GetRelevancyStats(IFunctionHandler * pH);
+	/// registers handler(sourceId, args) of chat command !name, handler returns true, if the message should be shown
+	int RegisterChatCommand(IFunctionHandler * pH, const char * name, HSCRIPTFUNCTION handler);
+	/// returns up to count last chat messages as an array of tables, the newest first
+	int GetChatHistory(IFunctionHandler * pH, int count);
+	/// registers a vote type (or changes a built-in one: kick, nextmap, map, command), negative ratio or cooldown
+	/// uses the sv_voting CVars, custom types call handler(subject, initiatorId) when they pass, returns false when there are too many types
+	int RegisterVoteType(IFunctionHandler * pH, const char * name, float ratio, float teamRatio, int cooldown, HSCRIPTFUNCTION handler);
+	/// starts a voting of a registered type on behalf of a player, returns false if the player is cooling down or a voting is in progress
+	int StartVote(IFunctionHandler * pH, ScriptHandle playerId, const char * type, ScriptHandle targetId, const char * subject);
+	/// returns counters of the target search shared by gun turrets
+	int GetTurretStats(IFunctionHandler * pH);
+	/// returns counters of the movement check of a player (samples, minor, major, teleport, maxRatio)
+	int GetMovementStats(IFunctionHandler * pH, ScriptHandle playerId);
+	/// tells the movement check, that a script moved the player, so the jump isn't a violation
+	int ResetMovementCheck(IFunctionHandler * pH, ScriptHandle playerId);
 	/// does some tests
 	int TestSpeed(IFunctionHandler * pH);
 	/// function for experimenting
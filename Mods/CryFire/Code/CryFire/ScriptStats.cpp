@@ -0,0 +1,145 @@
+//================================================================================
+// File:    Code/CryFire/ScriptStats.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Change-tracking writer of script tables updated every frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "ScriptStats.h"
+
+
+//----------------------------------------------------------------------------------------------------
+const float            ScriptStats::REFRESH_INTERVAL = 1.0f;
+ScriptStats::Counters  ScriptStats::counters = { 0, 0, 0 };
+CTimeValue             ScriptStats::lastFrame;
+
+//----------------------------------------------------------------------------------------------------
+ScriptStats::ScriptStats()
+ : table(NULL), cursor(0)
+{
+}
+
+void ScriptStats::begin( IScriptTable * newTable )
+{
+	CTimeValue frame = gEnv->pTimer->GetFrameStartTime();
+	// the timer goes back, when a level is loaded
+	if (newTable != table || frame < refreshTime || (frame - refreshTime).GetSeconds() >= REFRESH_INTERVAL) {
+		table = newTable;
+		fields.clear();
+		refreshTime = frame;
+	}
+	cursor = 0;
+
+	if (frame != lastFrame) {
+		lastFrame = frame;
+		counters.frames++;
+	}
+}
+
+void ScriptStats::invalidate()
+{
+	fields.clear();
+	cursor = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+ScriptStats::Field * ScriptStats::findField( const char * name, EType type, bool & isNew )
+{
+	isNew = false;
+	if (cursor < fields.size() && fields[cursor].name == name)
+		return &fields[cursor++];
+
+	// different order than last time (some fields can be set only sometimes)
+	for (uint i = 0; i < fields.size(); i++) {
+		if (fields[i].name == name) {
+			cursor = i + 1;
+			return &fields[i];
+		}
+	}
+
+	isNew = true;
+	Field field;
+	field.name = name;
+	field.type = type;
+	field.i = 0;
+	fields.insert( fields.begin() + cursor, field );
+	return &fields[cursor++];
+}
+
+void ScriptStats::set( const char * name, bool value )
+{
+	if (!table)
+		return;
+	bool isNew;
+	Field * field = findField( name, eBool, isNew );
+	if (!isNew && field->type == eBool && field->b == value) {
+		counters.skipped++;
+		return;
+	}
+	field->type = eBool;
+	field->b = value;
+	table->SetValue( name, value );
+	counters.writes++;
+}
+
+void ScriptStats::set( const char * name, int value )
+{
+	if (!table)
+		return;
+	bool isNew;
+	Field * field = findField( name, eInt, isNew );
+	if (!isNew && field->type == eInt && field->i == value) {
+		counters.skipped++;
+		return;
+	}
+	field->type = eInt;
+	field->i = value;
+	table->SetValue( name, value );
+	counters.writes++;
+}
+
+void ScriptStats::set( const char * name, float value )
+{
+	if (!table)
+		return;
+	bool isNew;
+	Field * field = findField( name, eFloat, isNew );
+	if (!isNew && field->type == eFloat && field->f == value) {
+		counters.skipped++;
+		return;
+	}
+	field->type = eFloat;
+	field->f = value;
+	table->SetValue( name, value );
+	counters.writes++;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ScriptStats::getCounters( Counters & result )
+{
+	result = counters;
+}
+
+void ScriptStats::resetCounters()
+{
+	counters.writes = 0;
+	counters.skipped = 0;
+	counters.frames = 0;
+}
@@ -0,0 +1,95 @@
+//================================================================================
+// File:    Code/CryFire/ScriptStats.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Change-tracking writer of script tables updated every frame
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef SCRIPT_STATS_INCLUDED
+#define SCRIPT_STATS_INCLUDED
+
+
+#include <IScriptSystem.h>
+#include <TimeValue.h>
+
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Remembers what was last written into a script table and writes only values which changed.
+   Fields are expected to be set in the same order every frame, then finding them costs nothing.
+   Names must be string literals or otherwise live as long as the object, only pointers are kept.
+   Scripts can write into the same table, so all values are written again every REFRESH_INTERVAL,
+   and the owner invalidates them, when the script could have been reset or reloaded. */
+class ScriptStats {
+
+  public:
+
+	struct Counters {
+		uint writes;    // values really written into tables
+		uint skipped;   // values equal to the last written ones
+		uint frames;
+	};
+
+	static const float REFRESH_INTERVAL;   // seconds
+
+	ScriptStats();
+
+	/* call before setting the fields every frame, a different table or a refresh invalidates the remembered values */
+	void begin( IScriptTable * table );
+	/* forces writing all values next time, use when scripts could have changed the table */
+	void invalidate();
+
+	void set( const char * name, bool value );
+	void set( const char * name, int value );
+	void set( const char * name, float value );
+
+	/* returns counters summed over all tables since the last reset */
+	static void getCounters( Counters & counters );
+	static void resetCounters();
+
+
+  protected:
+
+	enum EType { eBool, eInt, eFloat };
+
+	struct Field {
+		const char * name;
+		EType type;
+		union {
+			bool b;
+			int i;
+			float f;
+		};
+	};
+
+	Field * findField( const char * name, EType type, bool & isNew );
+
+	IScriptTable *        table;
+	std::vector<Field>    fields;
+	uint                  cursor;   // index of the field expected next
+	CTimeValue            refreshTime;
+
+	static Counters       counters;
+	static CTimeValue     lastFrame;
+
+};
+
+#endif // SCRIPT_STATS_INCLUDED
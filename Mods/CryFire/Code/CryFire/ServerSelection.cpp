@@ -0,0 +1,95 @@
+//================================================================================
+// File:    Code/CryFire/ServerSelection.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Decisions of the lobby server filter and of the quick game search
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "ServerSelection.h"
+
+#include <cctype>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------------------------------
+/* whether the lowercase part is anywhere in the text, ignoring the case of the text */
+static bool containsLowercase( const char * text, const char * part )
+{
+	size_t partLength = strlen( part );
+	for (; *text; text++) {
+		size_t i = 0;
+		while (i < partLength && text[i] && char(tolower( (unsigned char)text[i] )) == part[i])
+			i++;
+		if (i == partLength)
+			return true;
+	}
+	return partLength == 0;
+}
+
+bool ServerSelection::passesFilter( const Filter & filter, const LobbyServer & server )
+{
+	if (!filter.on)
+		return true;
+	if (filter.gameMode[0] && strcmp( server.gameType, filter.gameMode ) != 0)
+		return false;
+	if (filter.mapName[0] && !containsLowercase( server.mapName, filter.mapName ))
+		return false;
+	if (filter.maxPing != 0 && server.ping > filter.maxPing)
+		return false;
+	if (filter.notFull && server.maxPlayers == server.numPlayers)
+		return false;
+	if (filter.notEmpty && server.numPlayers == 0)
+		return false;
+	if (filter.notPrivate && server.isPrivate)
+		return false;
+	if (filter.antiCheat && !server.antiCheat)
+		return false;
+	if (filter.friendlyFire && !server.friendlyFire)
+		return false;
+	if (filter.gamepadsOnly && !server.gamepadsOnly)
+		return false;
+	if (filter.noVoiceComms && server.voiceComm)
+		return false;
+	if (filter.dedicated && !server.dedicated)
+		return false;
+	if (filter.dx10 && !server.dx10)
+		return false;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ServerSelection::quickGameScore( const QuickGameServer & server, const QuickGamePreferences & preferences )
+{
+	int score = ((128 - min( 127u, server.players )) << 10) + min( 1023u, server.ping );
+	if (server.ping > preferences.ping1)
+		score += 1 << 20;
+	if (server.players < server.maxPlayers / 2)
+		score += 1 << 21;
+	if (preferences.preferCountry && strcmp( server.country, preferences.country ) == 0)
+		score += 1 << 22;
+	if (server.ping > preferences.ping2)
+		score += 1 << 23;
+	if (preferences.preferFavorites && !server.favorite)
+		score += 1 << 24;
+	if (!server.mapMatch)
+		score += 1 << 25;
+	return score;
+}
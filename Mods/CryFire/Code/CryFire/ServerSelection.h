@@ -0,0 +1,96 @@
+//================================================================================
+// File:    Code/CryFire/ServerSelection.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Decisions of the lobby server filter and of the quick game search
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef SERVER_SELECTION_INCLUDED
+#define SERVER_SELECTION_INCLUDED
+
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Which servers the lobby list shows and which server the quick game joins first. The menus fill these
+   structures from their server infos, options and cvars, so the decisions don't need the server browser,
+   the profile or Flash and can be tested. The strings are only pointed to, nothing is copied. */
+class ServerSelection {
+
+  public:
+
+	/* the filter of the lobby server list, which shows all servers when it's off */
+	struct Filter {
+		bool on;
+		const char * gameMode;   // empty for all modes
+		const char * mapName;    // lowercase part of the map name, empty for all maps
+		int  maxPing;            // 0 for any ping
+		bool notFull;
+		bool notEmpty;
+		bool notPrivate;
+		bool antiCheat;
+		bool friendlyFire;
+		bool gamepadsOnly;
+		bool noVoiceComms;
+		bool dedicated;
+		bool dx10;
+	};
+
+	struct LobbyServer {
+		const char * gameType;
+		const char * mapName;
+		int  ping;
+		int  numPlayers;
+		int  maxPlayers;
+		bool isPrivate;
+		bool antiCheat;
+		bool friendlyFire;
+		bool gamepadsOnly;
+		bool voiceComm;
+		bool dedicated;
+		bool dx10;
+	};
+
+	static bool passesFilter( const Filter & filter, const LobbyServer & server );
+
+	/* the g_quickGame_* preferences */
+	struct QuickGamePreferences {
+		uint ping1;              // a ping over this is worse than more players
+		uint ping2;              // a ping over this is worse than the same country
+		bool preferCountry;
+		const char * country;    // of the player
+		bool preferFavorites;
+	};
+
+	struct QuickGameServer {
+		uint players;
+		uint maxPlayers;
+		uint ping;
+		const char * country;
+		bool favorite;
+		bool mapMatch;           // the map asked for or any map
+	};
+
+	/* lower is better, each criterion outweighs all the ones after it: the map, a favorite, ping2,
+	   the country, at least half full, ping1, then more players and a lower ping. With preferCountry
+	   the servers of the player's own country get the penalty, that's how the game always ranked them. */
+	static int quickGameScore( const QuickGameServer & server, const QuickGamePreferences & preferences );
+
+};
+
+#endif // SERVER_SELECTION_INCLUDED
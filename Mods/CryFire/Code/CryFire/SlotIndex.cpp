@@ -0,0 +1,98 @@
+//================================================================================
+// File:    Code/CryFire/SlotIndex.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Slots of items found by id, which stay valid when other items are removed
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "SlotIndex.h"
+
+
+//----------------------------------------------------------------------------------------------------
+int SlotIndex::add( int id )
+{
+	FlatHashMap<int, int>::const_iterator it = index.find( id );
+	if (it != index.end())
+		return it->second;
+
+	int slot;
+	if (!freeSlots.empty()) {
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		ids[slot] = id;
+	} else {
+		slot = ids.size();
+		ids.push_back( id );
+		changedFlags.push_back( 0 );
+	}
+	index[id] = slot;
+	return slot;
+}
+
+int SlotIndex::remove( int id )
+{
+	FlatHashMap<int, int>::iterator it = index.find( id );
+	if (it == index.end())
+		return NONE;
+	int slot = it->second;
+	index.erase( it );
+	ids[slot] = NONE;
+	freeSlots.push_back( slot );
+	return slot;
+}
+
+int SlotIndex::find( int id ) const
+{
+	FlatHashMap<int, int>::const_iterator it = index.find( id );
+	return it != index.end() ? it->second : NONE;
+}
+
+void SlotIndex::clear()
+{
+	index.clear();
+	ids.clear();
+	freeSlots.clear();
+	changed.clear();
+	changedFlags.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void SlotIndex::markChanged( int slot )
+{
+	if (!changedFlags[slot]) {
+		changedFlags[slot] = 1;
+		changed.push_back( slot );
+	}
+}
+
+void SlotIndex::clearChanges()
+{
+	for (uint i = 0; i < changed.size(); i++)
+		changedFlags[ changed[i] ] = 0;
+	changed.clear();
+}
+
+void SlotIndex::getPositions( const std::vector<int> & list, std::vector<int> & positions ) const
+{
+	positions.assign( ids.size(), NONE );
+	for (uint i = 0; i < list.size(); i++)
+		positions[ list[i] ] = i;
+}
@@ -0,0 +1,95 @@
+//================================================================================
+// File:    Code/CryFire/SlotIndex.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Slots of items found by id, which stay valid when other items are removed
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef SLOT_INDEX_INCLUDED
+#define SLOT_INDEX_INCLUDED
+
+
+#include <FlatHashMap.h>
+
+#include <vector>
+
+typedef unsigned int uint;
+typedef unsigned char byte;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Gives items with an id a slot in a vector which the user keeps next to it. A removed item frees its slot
+   for the next added one, so the slots of the other items, and the lists of slots, stay valid. Changed items
+   are collected until clearChanges, every one only once, so that a list can be updated once per frame. */
+class SlotIndex {
+
+  public:
+
+	enum { NONE = -1 };
+
+	/* returns the slot of the id, a freed one or a new one at the end, if the id isn't there yet */
+	int  add( int id );
+	/* frees the slot of the id and returns it, NONE if the id isn't there */
+	int  remove( int id );
+	int  find( int id ) const;
+	bool isFree( int slot ) const { return ids[slot] == NONE; }
+	/* number of slots, used and free */
+	uint getSize() const { return ids.size(); }
+	void clear();
+
+	/* remembers the slot until clearChanges, a slot is remembered only once */
+	void markChanged( int slot );
+	const std::vector<int> & getChanged() const { return changed; }
+	void clearChanges();
+
+	/* position of every slot in a list of slots, NONE for the slots which aren't in it */
+	void getPositions( const std::vector<int> & list, std::vector<int> & positions ) const;
+	/* true if a list of slots, which was sorted by less before the changes, is still sorted,
+	   only the neighbours of the changed slots can be out of order, so only these are compared,
+	   two slots which are less than each other (a descending sort of equal keys) are in order */
+	template <class Less>
+	bool isStillSorted( const std::vector<int> & list, const std::vector<int> & positions, const Less & less ) const
+	{
+		for (uint i = 0; i < changed.size(); i++) {
+			int pos = positions[ changed[i] ];
+			if (pos == NONE)
+				continue;
+			if (pos > 0 && isBefore( list[pos], list[pos - 1], less ))
+				return false;
+			if (pos + 1 < (int)list.size() && isBefore( list[pos + 1], list[pos], less ))
+				return false;
+		}
+		return true;
+	}
+
+  protected:
+
+	template <class Less>
+	static bool isBefore( int slot1, int slot2, const Less & less )
+	{
+		return less( slot1, slot2 ) && !less( slot2, slot1 );
+	}
+
+	FlatHashMap<int, int> index;        // id -> slot
+	std::vector<int>      ids;          // id of every slot, NONE if it's free
+	std::vector<int>      freeSlots;
+	std::vector<int>      changed;
+	std::vector<byte>     changedFlags; // of every slot, to add it to changed only once
+
+};
+
+#endif // SLOT_INDEX_INCLUDED
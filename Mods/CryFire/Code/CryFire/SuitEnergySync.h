@@ -0,0 +1,50 @@
+//================================================================================
+// File:    Code/CryFire/SuitEnergySync.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Suit energy as the clients know it, decides when it has to be sent
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef SUIT_ENERGY_SYNC_INCLUDED
+#define SUIT_ENERGY_SYNC_INCLUDED
+
+
+//----------------------------------------------------------------------------------------------------
+/* The server marks the energy aspect of a suit only when the energy moved by the step since the last mark
+   or reached 0 or the maximum. The value is read when the aspect is sent, so all changes in between go out
+   at once and the clients are never off by more than the step, the limits always arrive exactly. */
+class SuitEnergySync {
+
+  public:
+
+	SuitEnergySync( float maximum, float step ) : maximum( maximum ), step( step ), sent( -1.0f ) {}
+
+	/* returns true, when the aspect has to be marked, the value counts as sent then */
+	bool update( float value );
+	/* the aspect was marked without asking, e.g. when the energy was reset */
+	void setSent( float value ) { sent = value; }
+	float getSent() const { return sent; }
+
+  protected:
+
+	float maximum;
+	float step;
+	float sent;   // -1 until the first mark
+
+};
+
+#endif // SUIT_ENERGY_SYNC_INCLUDED
@@ -0,0 +1,364 @@
+//================================================================================
+// File:    Code/CryFire/Telemetry.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Frame-time telemetry of game subsystems for dedicated servers
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#include "StdAfx.h"
+
+#include "Telemetry.h"
+
+#include "GameCVars.h"
+#include "CryFire/Logging.h"
+
+#include <windows.h>
+#include <cstdio>
+#include <ctime>
+
+
+//----------------------------------------------------------------------------------------------------
+const char *                 Telemetry::names [MAX_TIMERS];
+volatile long                Telemetry::numTimers = 0;
+Telemetry::ThreadSlot *      Telemetry::slots [MAX_THREADS];
+volatile long                Telemetry::numSlots = 0;
+unsigned long                Telemetry::tlsIndex = TLS_OUT_OF_INDEXES;
+bool                         Telemetry::enabled = false;
+Telemetry::Accumulator       Telemetry::exported [MAX_TIMERS];
+Telemetry::Accumulator       Telemetry::summed [MAX_TIMERS];
+Telemetry::TimerStats        Telemetry::last [MAX_TIMERS];
+uint                         Telemetry::lastCount = 0;
+float                        Telemetry::lastSeconds = 0.0f;
+float                        Telemetry::timer = 0.0f;
+double                       Telemetry::ticksPerMs = 0.0;
+uint64                       Telemetry::startTicks = 0;
+__int64                      Telemetry::startCounter = 0;
+
+static volatile LONG         registerLock = 0;
+
+//----------------------------------------------------------------------------------------------------
+void Telemetry::initialize()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter( &counter );
+	startTicks = __rdtsc();
+	startCounter = counter.QuadPart;
+
+	tlsIndex = TlsAlloc();
+	if (tlsIndex == TLS_OUT_OF_INDEXES)
+		CF_LogError("telemetry: no TLS index left, timers are disabled");
+}
+
+//----------------------------------------------------------------------------------------------------
+uint Telemetry::registerTimer( const char * name )
+{
+	// timers are registered by function-local statics, which are not thread-safe in VS2008,
+	// so two threads can get here at once for the same name
+	while (InterlockedCompareExchange( &registerLock, 1, 0 ) != 0)
+		Sleep( 0 );
+
+	uint index = MAX_TIMERS;
+	for (uint i = 0; i < (uint)numTimers; i++) {
+		if (strcmp( names[i], name ) == 0) {
+			index = i;
+			break;
+		}
+	}
+	if (index == MAX_TIMERS && (uint)numTimers < MAX_TIMERS) {
+		index = numTimers;
+		names[index] = name;
+		numTimers++;
+	}
+
+	InterlockedCompareExchange( &registerLock, 0, 1 );
+	if (index == MAX_TIMERS && tlsIndex != TLS_OUT_OF_INDEXES)   // logging is ready only after initialize
+		CF_AsyncLog( 0, "telemetry: too many timers, %s is not measured", name );
+	return index;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Telemetry::record( uint timer, uint64 ticks )
+{
+	if (!enabled || timer >= MAX_TIMERS)
+		return;
+
+	ThreadSlot * slot = (ThreadSlot *)TlsGetValue( tlsIndex );
+	if (!slot) {
+		// first measurement in this thread, the slot is never freed, threads of the game live as long as the process
+		static ThreadSlot overflow;   // shared by threads above the limit and never exported
+		long slotIdx = InterlockedIncrement( &numSlots ) - 1;
+		if (slotIdx < (long)MAX_THREADS) {
+			slot = new ThreadSlot;
+			memset( slot, 0, sizeof(ThreadSlot) );
+			slots[slotIdx] = slot;
+		} else {
+			slot = &overflow;
+		}
+		TlsSetValue( tlsIndex, slot );
+	}
+
+	// 64-bit values are written in two halves in 32-bit builds, the version tells the export
+	// that it has to read again, the owner thread is the only writer, so this needs no lock
+	Accumulator & acc = slot->timers[timer];
+	acc.version++;
+	_ReadWriteBarrier();
+	acc.count++;
+	acc.ticks += ticks;
+	if (ticks > acc.maxTicks)
+		acc.maxTicks = ticks;
+	acc.buckets[ getBucket( ticks ) ]++;
+	_ReadWriteBarrier();
+	acc.version++;
+}
+
+/* copies an accumulator of another thread, x86 doesn't reorder stores with stores or loads with loads,
+   so only the compiler has to be stopped from moving the accesses around the version */
+void Telemetry::readAccumulator( const Accumulator & acc, Accumulator & copy )
+{
+	while (true) {
+		uint version = acc.version;
+		_ReadWriteBarrier();
+		if ((version & 1) == 0) {
+			memcpy( &copy, (const void *)&acc, sizeof(Accumulator) );
+			_ReadWriteBarrier();
+			if (acc.version == version)
+				return;
+		}
+		YieldProcessor();
+	}
+}
+
+uint Telemetry::getBucket( uint64 ticks )
+{
+	if (ticks < 256)
+		return 0;
+	unsigned long msb;
+	if (ticks >> 32) {
+		_BitScanReverse( &msb, (unsigned long)(ticks >> 32) );
+		msb += 32;
+	} else {
+		_BitScanReverse( &msb, (unsigned long)ticks );
+	}
+	uint sub = (uint)(ticks >> (msb - 2)) & 3;   // 2 bits below the highest one
+	uint bucket = 1 + (msb - 8) * 4 + sub;
+	return bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+float Telemetry::ticksToMs( uint64 ticks )
+{
+	return ticksPerMs > 0.0 ? (float)((double)ticks / ticksPerMs) : 0.0f;
+}
+
+float Telemetry::bucketToMs( uint bucket )
+{
+	if (bucket == 0)
+		return ticksToMs( 128 );
+	uint msb = 8 + (bucket - 1) / 4;
+	uint sub = (bucket - 1) % 4;
+	uint64 lower = (uint64)(4 + sub) << (msb - 2);
+	uint64 upper = (uint64)(5 + sub) << (msb - 2);
+	return ticksToMs( (lower + upper) / 2 );
+}
+
+float Telemetry::percentileMs( const uint * buckets, uint count, float fraction )
+{
+	uint wanted = (uint)(count * fraction);
+	if (wanted < 1)
+		wanted = 1;
+	uint sum = 0;
+	for (uint i = 0; i < NUM_BUCKETS; i++) {
+		sum += buckets[i];
+		if (sum >= wanted)
+			return bucketToMs( i );
+	}
+	return bucketToMs( NUM_BUCKETS - 1 );
+}
+
+void Telemetry::calibrate()
+{
+	// measured against the whole time since start, so the error of reading the two clocks is negligible,
+	// this assumes invariant TSC, which all CPUs able to run a server nowadays have
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter( &counter );
+	QueryPerformanceFrequency( &frequency );
+	uint64 ticks = __rdtsc();
+	double elapsedMs = (double)(counter.QuadPart - startCounter) * 1000.0 / (double)frequency.QuadPart;
+	if (elapsedMs > 100.0)
+		ticksPerMs = (double)(ticks - startTicks) / elapsedMs;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Telemetry::onUpdate( float frameTime )
+{
+	int mode = g_pGameCVars->cf_telemetry;
+	enabled = tlsIndex != TLS_OUT_OF_INDEXES && (mode >= 2 || (mode == 1 && gEnv->pSystem->IsDedicated()));
+	if (!enabled) {
+		timer = 0.0f;
+		return;
+	}
+
+	float interval = g_pGameCVars->cf_telemetry_interval;
+	if (interval < 1.0f)
+		interval = 1.0f;
+	timer += frameTime;
+	if (timer < interval)
+		return;
+
+	exportInterval( timer );
+	timer = 0.0f;
+}
+
+void Telemetry::exportInterval( float seconds )
+{
+	calibrate();
+
+	// the accumulators are read while the other threads may be writing into them, each of them is copied
+	// consistently, but a measurement can occasionally fall into the next interval, that's all
+	uint timerCount = (uint)numTimers;
+	uint slotCount = (uint)numSlots < MAX_THREADS ? (uint)numSlots : MAX_THREADS;
+	memset( summed, 0, sizeof(summed) );
+	for (uint s = 0; s < slotCount; s++) {
+		const ThreadSlot * slot = slots[s];
+		if (!slot)   // the thread is just creating it
+			continue;
+		for (uint t = 0; t < timerCount; t++) {
+			Accumulator acc;
+			readAccumulator( slot->timers[t], acc );
+			Accumulator & sum = summed[t];
+			sum.count += acc.count;
+			sum.ticks += acc.ticks;
+			if (acc.maxTicks > sum.maxTicks)
+				sum.maxTicks = acc.maxTicks;
+			for (uint b = 0; b < NUM_BUCKETS; b++)
+				sum.buckets[b] += acc.buckets[b];
+		}
+	}
+
+	// the sums only grow, so the difference against the last export is this interval
+	lastCount = 0;
+	for (uint t = 0; t < timerCount; t++) {
+		Accumulator & sum = summed[t];
+		Accumulator & prev = exported[t];
+		uint buckets [NUM_BUCKETS];
+		uint highest = 0;
+		for (uint b = 0; b < NUM_BUCKETS; b++) {
+			buckets[b] = sum.buckets[b] - prev.buckets[b];
+			if (buckets[b])
+				highest = b;
+		}
+		uint count = sum.count - prev.count;
+		if (count) {
+			TimerStats & stats = last[lastCount++];
+			stats.name = names[t];
+			stats.count = count;
+			stats.totalMs = ticksToMs( sum.ticks - prev.ticks );
+			stats.p50Ms = percentileMs( buckets, count, 0.5f );
+			stats.p99Ms = percentileMs( buckets, count, 0.99f );
+			// the all-time maximum is exact, when it grew in this interval, otherwise estimate it from the histogram
+			stats.maxMs = sum.maxTicks > prev.maxTicks ? ticksToMs( sum.maxTicks ) : bucketToMs( highest );
+			if (stats.p99Ms > stats.maxMs)
+				stats.p99Ms = stats.maxMs;
+			if (stats.p50Ms > stats.p99Ms)
+				stats.p50Ms = stats.p99Ms;
+		}
+		prev = sum;
+	}
+	lastSeconds = seconds;
+
+	const char * fileName = g_pGameCVars->cf_telemetry_file->GetString();
+	if (fileName && fileName[0])
+		writeFile( fileName, seconds );
+}
+
+//----------------------------------------------------------------------------------------------------
+void Telemetry::writeFile( const char * fileName, float seconds )
+{
+	size_t len = strlen( fileName );
+	bool csv = len > 4 && stricmp( fileName + len - 4, ".csv" ) == 0;
+
+	FILE * file = fopen( fileName, "a" );
+	if (!file) {
+		CF_Log( 1, "telemetry: cannot open %s", fileName );
+		return;
+	}
+	fseek( file, 0, SEEK_END );
+	long size = ftell( file );
+	if (g_pGameCVars->cf_telemetry_maxsize > 0 && size > g_pGameCVars->cf_telemetry_maxsize * 1024) {
+		// keep one older file, so there is always at least one full file of history
+		fclose( file );
+		std::string oldName = std::string( fileName ) + ".1";
+		remove( oldName.c_str() );
+		rename( fileName, oldName.c_str() );
+		file = fopen( fileName, "a" );
+		if (!file)
+			return;
+		size = 0;
+	}
+
+	uint now = (uint)time( NULL );
+	if (csv) {
+		if (size == 0)
+			fprintf( file, "time,interval,timer,count,totalMs,p50Ms,p99Ms,maxMs\n" );
+		for (uint i = 0; i < lastCount; i++) {
+			const TimerStats & stats = last[i];
+			fprintf( file, "%u,%.1f,%s,%u,%.3f,%.3f,%.3f,%.3f\n", now, seconds, stats.name,
+			         stats.count, stats.totalMs, stats.p50Ms, stats.p99Ms, stats.maxMs );
+		}
+	} else {
+		// one object per line, so the file can be appended and parsed line by line
+		fprintf( file, "{\"time\":%u,\"interval\":%.1f,\"timers\":{", now, seconds );
+		for (uint i = 0; i < lastCount; i++) {
+			const TimerStats & stats = last[i];
+			fprintf( file, "%s\"%s\":{\"count\":%u,\"totalMs\":%.3f,\"p50Ms\":%.3f,\"p99Ms\":%.3f,\"maxMs\":%.3f}",
+			         i ? "," : "", stats.name, stats.count, stats.totalMs, stats.p50Ms, stats.p99Ms, stats.maxMs );
+		}
+		fprintf( file, "}}\n" );
+	}
+	fclose( file );
+}
+
+//----------------------------------------------------------------------------------------------------
+std::string Telemetry::getSummary()
+{
+	std::string summary;
+	char buf [128];
+	for (uint i = 0; i < lastCount; i++) {
+		const TimerStats & stats = last[i];
+		_snprintf( buf, sizeof(buf), "%s%s:%u/%.2f/%.2f/%.2f", i ? ";" : "", stats.name, stats.count, stats.p50Ms, stats.p99Ms, stats.maxMs );
+		buf[sizeof(buf) - 1] = '\0';
+		summary += buf;
+	}
+	return summary;
+}
+
+void Telemetry::dump()
+{
+	if (!enabled) {
+		CryLogAlways("telemetry is disabled, see cf_telemetry");
+		return;
+	}
+	if (lastCount == 0) {
+		CryLogAlways("no telemetry yet, it's exported every %.0f seconds", g_pGameCVars->cf_telemetry_interval);
+		return;
+	}
+	CryLogAlways("$8telemetry of the last %.1f seconds$o          count   total ms     p50 ms     p99 ms     max ms", lastSeconds);
+	for (uint i = 0; i < lastCount; i++) {
+		const TimerStats & stats = last[i];
+		CryLogAlways("  %-32s %9u %10.2f %10.3f %10.3f %10.3f", stats.name, stats.count, stats.totalMs, stats.p50Ms, stats.p99Ms, stats.maxMs);
+	}
+}
@@ -0,0 +1,132 @@
+//================================================================================
+// File:    Code/CryFire/Telemetry.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Frame-time telemetry of game subsystems for dedicated servers
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef TELEMETRY_INCLUDED
+#define TELEMETRY_INCLUDED
+
+
+#include <intrin.h>
+
+#include <string>
+
+typedef unsigned int uint;
+typedef unsigned __int64 uint64;
+
+
+//----------------------------------------------------------------------------------------------------
+/* measures the rest of the enclosing block, the name should be a string literal,
+   timers with the same name are summed together, so it can be used in templates too */
+#define CF_TELEMETRY_SCOPE(name) \
+	static const uint s_telemetryTimer = Telemetry::registerTimer(name); \
+	Telemetry::Scope telemetryScope( s_telemetryTimer )
+
+
+//----------------------------------------------------------------------------------------------------
+/* Timers are cheap enough to stay in production: a scope costs two rdtsc and a few additions
+   into an accumulator owned by the current thread, no locks and no shared cache lines.
+   Once per interval the main thread sums the accumulators of all threads, computes what changed
+   since the last export and writes it into a file and into the master server heartbeat. */
+class Telemetry {
+
+  public:
+
+	static const uint MAX_TIMERS = 32;
+	static const uint MAX_THREADS = 16;
+	/* 4 buckets per power of 2 of TSC ticks, the lowest one is everything below 256 ticks */
+	static const uint NUM_BUCKETS = 128;
+
+	struct TimerStats {
+		const char * name;
+		uint count;
+		float totalMs;
+		float p50Ms;
+		float p99Ms;
+		float maxMs;
+	};
+
+	class Scope {
+	  public:
+		inline Scope( uint timer ) : timer( timer ), start( __rdtsc() ) {}
+		inline ~Scope() { Telemetry::record( timer, __rdtsc() - start ); }
+	  protected:
+		uint timer;
+		uint64 start;
+	};
+
+	/* calibrates the TSC and allocates the thread slots, call from the primary thread */
+	static void initialize();
+
+	/* returns index of timer with this name, registers it when it's used for the first time, can be called from any thread */
+	static uint registerTimer( const char * name );
+	/* adds one measurement, called by Scope from any thread */
+	static void record( uint timer, uint64 ticks );
+
+	/* exports the results every cf_telemetry_interval seconds, needs to be called regularly from game loop */
+	static void onUpdate( float frameTime );
+
+	/* returns the results of the last interval in a short form for the master server, empty when there are none */
+	static std::string getSummary();
+	/* writes the results of the last interval into console */
+	static void dump();
+
+
+  protected:
+
+	struct Accumulator {
+		volatile uint version;   // odd while the owner thread is writing, so the export can repeat a torn read
+		uint count;
+		uint64 ticks;
+		uint64 maxTicks;
+		uint buckets [NUM_BUCKETS];
+	};
+	/* one thread's accumulators, written only by that thread */
+	struct ThreadSlot {
+		Accumulator timers [MAX_TIMERS];
+	};
+
+	static void  readAccumulator( const Accumulator & acc, Accumulator & copy );
+	static uint  getBucket( uint64 ticks );
+	static float bucketToMs( uint bucket );
+	static float ticksToMs( uint64 ticks );
+	static float percentileMs( const uint * buckets, uint count, float fraction );
+	static void  calibrate();
+	static void  exportInterval( float seconds );
+	static void  writeFile( const char * fileName, float seconds );
+
+	static const char *      names [MAX_TIMERS];
+	static volatile long     numTimers;
+	static ThreadSlot *      slots [MAX_THREADS];
+	static volatile long     numSlots;
+	static unsigned long     tlsIndex;
+	static bool              enabled;
+	static Accumulator       exported [MAX_TIMERS];   // sums at the time of the last export
+	static Accumulator       summed [MAX_TIMERS];     // sums of the current export, too big for the stack
+	static TimerStats        last [MAX_TIMERS];       // results of the last interval
+	static uint              lastCount;
+	static float             lastSeconds;
+	static float             timer;
+	static double            ticksPerMs;
+	static uint64            startTicks;
+	static __int64           startCounter;            // QueryPerformanceCounter at startTicks
+
+};
+
+#endif // TELEMETRY_INCLUDED
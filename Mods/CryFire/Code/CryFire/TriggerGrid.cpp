@@ -0,0 +1,44 @@
+//================================================================================
+// File:    Code/CryFire/TriggerGrid.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Grid of proximity triggers, which lists the triggers that can be near a position
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "TriggerGrid.h"
+
+
+//----------------------------------------------------------------------------------------------------
+void TriggerGrid::add( int trigger, const Vec3 & pos, float radius )
+{
+	int minX = getCoord( pos.x - radius ), maxX = getCoord( pos.x + radius );
+	int minY = getCoord( pos.y - radius ), maxY = getCoord( pos.y + radius );
+	for (int x = minX; x <= maxX; x++)
+		for (int y = minY; y <= maxY; y++)
+			cells[ getCellKey( x, y ) ].push_back( trigger );
+}
+
+const std::vector<int> & TriggerGrid::getTriggers( uint cell ) const
+{
+	static const std::vector<int> noTriggers;
+	Cells::const_iterator it = cells.find( cell );
+	return it != cells.end() ? it->second : noTriggers;
+}
@@ -0,0 +1,64 @@
+//================================================================================
+// File:    Code/CryFire/TriggerGrid.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Grid of proximity triggers, which lists the triggers that can be near a position
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+#ifndef TRIGGER_GRID_INCLUDED
+#define TRIGGER_GRID_INCLUDED
+
+
+#include <FlatHashMap.h>
+
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Square cells on the XY plane, every trigger is listed in all the cells its radius overlaps, so only
+   the triggers of the cell of a position have to be tested for distance. The triggers don't move,
+   they are numbered by the user and listed in the order they were added. */
+class TriggerGrid {
+
+  public:
+
+	TriggerGrid( float cellSize ) : cellSize( cellSize ) {}
+
+	void add( int trigger, const Vec3 & pos, float radius );
+	void clear()  { cells.clear(); }
+
+	uint getCell( const Vec3 & pos ) const  { return getCellKey( getCoord( pos.x ), getCoord( pos.y ) ); }
+	/* empty if there are no triggers in the cell */
+	const std::vector<int> & getTriggers( uint cell ) const;
+	bool hasTriggers( uint cell ) const  { return cells.find( cell ) != cells.end(); }
+
+	static uint getCellKey( int x, int y )  { return (uint(x & 0xFFFF) << 16) | uint(y & 0xFFFF); }
+
+  protected:
+
+	int getCoord( float coord ) const  { return (int)floor_tpl( coord / cellSize ); }
+
+	typedef FlatHashMap<uint, std::vector<int> > Cells;   // cell -> triggers
+
+	float  cellSize;
+	Cells  cells;
+
+};
+
+#endif // TRIGGER_GRID_INCLUDED
@@ -0,0 +1,207 @@
+//================================================================================
+// File:    Code/CryFire/TurretTargets.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Target candidates and visibility results shared by all gun turrets
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#include "StdAfx.h"
+
+#include "TurretTargets.h"
+
+#include <Game.h>
+#include <Actor.h>
+#include <IActorSystem.h>
+#include <IVehicleSystem.h>
+#include <IMovementController.h>
+
+
+//----------------------------------------------------------------------------------------------------
+const float TurretTargets::RAY_CACHE_TTL = 0.25f;
+const float TurretTargets::RAY_CACHE_STALE = 2.0f;
+
+TurretTargets::GatherFunc  TurretTargets::gatherFunc = TurretTargets::gatherActors;
+TurretTargets::Candidates  TurretTargets::candidates;
+TurretTargets::RayCache    TurretTargets::rayCache;
+CTimeValue                 TurretTargets::lastFrame;
+uint                       TurretTargets::searchesInFrame = 0;
+TurretTargets::Stats       TurretTargets::stats = { 0, 0, 0, 0, 0 };
+
+//----------------------------------------------------------------------------------------------------
+void TurretTargets::newFrame()
+{
+	CTimeValue frame = gEnv->pTimer->GetFrameStartTime();
+	if (frame == lastFrame)
+		return;
+	lastFrame = frame;
+	searchesInFrame = 0;
+
+	candidates.clear();
+	gatherFunc( candidates );
+	stats.candidates = candidates.size();
+
+	RayCache::iterator ray = rayCache.begin();
+	while (ray != rayCache.end()) {
+		// a request can get lost when the queue is reset on map change, so don't wait for it forever
+		if ((frame - ray->second.time).GetSeconds() > RAY_CACHE_STALE && (frame - ray->second.requested).GetSeconds() > 1.0f)
+			rayCache.erase( ray++ );
+		else
+			++ray;
+	}
+}
+
+void TurretTargets::gatherActors( Candidates & candidates )
+{
+	IActorIteratorPtr it = g_pGame->GetIGameFramework()->GetIActorSystem()->CreateActorIterator();
+	while (CActor * pActor = (CActor*)it->Next()) {
+		// per-turret conditions (team, species, cloak, vehicles only) are still checked by every turret
+		if (pActor->GetHealth() <= 0 || pActor->GetSpectatorMode() != 0)
+			continue;
+		Candidate candidate;
+		candidate.entityId = pActor->GetEntityId();
+		candidate.pos = pActor->GetEntity()->GetWorldPos();
+		candidates.push_back( candidate );
+	}
+}
+
+void TurretTargets::setGatherFunc( GatherFunc func )
+{
+	gatherFunc = func ? func : gatherActors;
+	lastFrame = CTimeValue();
+}
+
+const TurretTargets::Candidates & TurretTargets::getCandidates()
+{
+	newFrame();
+	return candidates;
+}
+
+bool TurretTargets::allowSearch()
+{
+	newFrame();
+	if (searchesInFrame >= MAX_SEARCHES_PER_FRAME) {
+		stats.searchesDelayed++;
+		return false;
+	}
+	searchesInFrame++;
+	stats.searches++;
+	return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TurretTargets::getCachedShootable( EntityId turretId, EntityId targetId, bool & shootable )
+{
+	newFrame();
+	RayCache::const_iterator ray = rayCache.find( std::make_pair( turretId, targetId ) );
+	if (ray == rayCache.end() || (lastFrame - ray->second.time).GetSeconds() > RAY_CACHE_TTL)
+		return false;
+	shootable = ray->second.shootable;
+	stats.rayCacheHits++;
+	return true;
+}
+
+void TurretTargets::storeShootable( EntityId turretId, EntityId targetId, bool shootable )
+{
+	RayResult & result = rayCache[ std::make_pair( turretId, targetId ) ];
+	result.time = lastFrame;
+	result.shootable = shootable;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TurretTargets::requestShootable( EntityId turretId, EntityId targetId, const Vec3 & firePos, const Vec3 & targetPos )
+{
+	newFrame();
+	RayResult & result = rayCache[ std::make_pair( turretId, targetId ) ];
+	// a pending request can get lost when the queue is reset, so it's submitted again after a second
+	if (result.requested == CTimeValue() || (lastFrame - result.requested).GetSeconds() > 1.0f) {
+		result.requested = lastFrame;
+		result.firePos = firePos;
+		submitRay( turretId, targetId, firePos, targetPos, onCenterRay );
+	}
+	return result.shootable;
+}
+
+void TurretTargets::submitRay( EntityId turretId, EntityId targetId, const Vec3 & from, const Vec3 & to, RayQueue::Callback callback )
+{
+	static const uint caller = RayQueue::registerCaller( "GunTurret" );
+
+	RayQueue::Request request;
+	request.dir = to - from;
+	request.origin = from + 0.3f * request.dir;   // the same start as CGunTurret::RayCheck, to not be inside the turret
+	request.objTypes = ent_all;
+	request.flags = rwi_stop_at_pierceable|rwi_colltype_any;
+	request.skipIds[0] = turretId;
+	request.skipIds[1] = 0;
+	request.ownerId = turretId;
+	request.tag = targetId;
+	request.caller = caller;
+	request.callback = callback;
+	RayQueue::submit( request );
+	stats.rays++;
+}
+
+bool TurretTargets::isTargetHit( EntityId targetId, const RayQueue::Result & result )
+{
+	if (!result.hit || result.hitEntityId == targetId)
+		return true;
+	// actors in vehicles are hit through the vehicle
+	CActor * pActor = (CActor*)g_pGame->GetIGameFramework()->GetIActorSystem()->GetActor( targetId );
+	IVehicle * pVehicle = pActor ? pActor->GetLinkedVehicle() : NULL;
+	return pVehicle && pVehicle->GetEntity()->GetId() == result.hitEntityId;
+}
+
+void TurretTargets::finishRequest( EntityId turretId, EntityId targetId, bool shootable )
+{
+	newFrame();
+	RayResult & ray = rayCache[ std::make_pair( turretId, targetId ) ];
+	ray.time = lastFrame;
+	ray.requested = CTimeValue();
+	ray.shootable = shootable;
+}
+
+void TurretTargets::onCenterRay( const RayQueue::Request & request, const RayQueue::Result & result )
+{
+	EntityId targetId = request.tag;
+	if (isTargetHit( targetId, result )) {
+		finishRequest( request.ownerId, targetId, true );
+		return;
+	}
+
+	// fallback for actors, the center can be hidden behind a low wall while the head is not
+	CActor * pActor = (CActor*)g_pGame->GetIGameFramework()->GetIActorSystem()->GetActor( targetId );
+	if (pActor && pActor->GetMovementController()) {
+		SMovementState state;
+		pActor->GetMovementController()->GetMovementState( state );
+		submitRay( request.ownerId, targetId, rayCache[ std::make_pair( request.ownerId, targetId ) ].firePos, state.eyePosition, onEyeRay );
+		return;
+	}
+
+	finishRequest( request.ownerId, targetId, false );
+}
+
+void TurretTargets::onEyeRay( const RayQueue::Request & request, const RayQueue::Result & result )
+{
+	EntityId targetId = request.tag;
+	finishRequest( request.ownerId, targetId, isTargetHit( targetId, result ) );
+}
+
+//----------------------------------------------------------------------------------------------------
+void TurretTargets::getStats( Stats & result )
+{
+	result = stats;
+}
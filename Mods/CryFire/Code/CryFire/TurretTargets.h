@@ -0,0 +1,117 @@
+//================================================================================
+// File:    Code/CryFire/TurretTargets.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Target candidates and visibility results shared by all gun turrets
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef TURRET_TARGETS_INCLUDED
+#define TURRET_TARGETS_INCLUDED
+
+
+#include "RayQueue.h"
+
+#include <IEntity.h>
+#include <TimeValue.h>
+
+#include <map>
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Power Struggle bases have many turrets looking at the same players, so instead of every turret
+   querying all entities around and casting its own rays, they share one list of living actors per frame
+   and remember visibility results for a short time. Target searches are spread over several frames. */
+class TurretTargets {
+
+  public:
+
+	/* how long a result of the visibility ray check is reused (seconds) */
+	static const float RAY_CACHE_TTL;
+	/* how long an outdated result is still returned while the new one is being traced (seconds) */
+	static const float RAY_CACHE_STALE;
+	/* how many turrets can search for a new target in one frame, the others wait for the next one */
+	static const uint MAX_SEARCHES_PER_FRAME = 4;
+
+	struct Candidate {
+		EntityId entityId;
+		Vec3 pos;
+	};
+	typedef std::vector<Candidate> Candidates;
+	/* fills the candidates of a new frame */
+	typedef void (*GatherFunc)( Candidates & candidates );
+
+	struct Stats {
+		uint candidates;
+		uint searches;          // target searches performed
+		uint searchesDelayed;   // target searches moved to the next frame
+		uint rays;              // rays really cast
+		uint rayCacheHits;
+	};
+
+	/* actors which are alive and not spectating, rebuilt once per frame */
+	static const Candidates & getCandidates();
+
+	/* returns false, if too many turrets searched for a target in this frame already */
+	static bool allowSearch();
+
+	static bool getCachedShootable( EntityId turretId, EntityId targetId, bool & shootable );
+	static void storeShootable( EntityId turretId, EntityId targetId, bool shootable );
+	/* submits the visibility check into RayQueue and returns the last known result (false, if there is none),
+	   the check is the same as CGunTurret::IsTargetShootable including the fallback ray to the actor's eyes */
+	static bool requestShootable( EntityId turretId, EntityId targetId, const Vec3 & firePos, const Vec3 & targetPos );
+	static inline void countRay() { stats.rays++; }
+
+	static void getStats( Stats & result );
+
+	/* replaces the actor system as the source of candidates, for tests, NULL restores it */
+	static void setGatherFunc( GatherFunc func );
+
+
+  protected:
+
+	struct RayResult {
+		CTimeValue time;        // when the result was stored, 0 = no result yet
+		CTimeValue requested;   // when the ray was submitted, 0 = nothing pending
+		bool shootable;
+		Vec3 firePos;
+		RayResult() : shootable(false) {}
+	};
+	typedef std::map<std::pair<EntityId, EntityId>, RayResult> RayCache;   // key is turret and target
+
+	static void newFrame();
+	static void gatherActors( Candidates & candidates );
+
+	static bool isTargetHit( EntityId targetId, const RayQueue::Result & result );
+	static void finishRequest( EntityId turretId, EntityId targetId, bool shootable );
+	static void submitRay( EntityId turretId, EntityId targetId, const Vec3 & from, const Vec3 & to, RayQueue::Callback callback );
+	static void onCenterRay( const RayQueue::Request & request, const RayQueue::Result & result );
+	static void onEyeRay( const RayQueue::Request & request, const RayQueue::Result & result );
+
+	static GatherFunc    gatherFunc;
+	static Candidates    candidates;
+	static RayCache      rayCache;
+	static CTimeValue    lastFrame;
+	static uint          searchesInFrame;
+	static Stats         stats;
+
+};
+
+#endif // TURRET_TARGETS_INCLUDED
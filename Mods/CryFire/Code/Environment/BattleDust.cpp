@@ -21,6 +21,7 @@ History:
 #include "GameRules.h"
 #include "IRenderAuxGeom.h"
 #include "IEntitySystem.h"
+#include "CryFire/Jobs.h"	// !!CryFire - added
 
 //////////////////////////////////////////////////////////////////////////
 //	CBattleEvent
@@ -35,6 +36,7 @@ CBattleEvent::CBattleEvent()
 , m_numParticles(0)
 , m_pParticleEffect(NULL)
 , m_entityId(0)
+, m_areaIndex(-1)	// !!CryFire - added
 {
 }
 
@@ -83,6 +85,12 @@ void CBattleEvent::Release()
 //------------------------------------------------------------------------
 void CBattleEvent::FullSerialize(TSerialize ser)
 {
+	//-- !!CryFire - added ---
+	CBattleDust* pBD = (gEnv->bServer && g_pGame->GetGameRules()) ? g_pGame->GetGameRules()->GetBattleDust() : NULL;
+	if(pBD && !ser.IsReading())
+		pBD->SaveArea(this);
+	//------
+
 	ser.BeginGroup("BattleEvent");
 	ser.Value("worldPos", m_worldPos);
 	ser.Value("numParticles", m_numParticles);
@@ -95,6 +103,8 @@ void CBattleEvent::FullSerialize(TSerialize ser)
 	{
 		m_pParticleEffect = NULL;
 		m_entityId = (GetEntity() != NULL) ? GetEntity()->GetId() : 0;
+		if(pBD)
+			pBD->LoadArea(this);	// !!CryFire - added
 	}
 }
 
@@ -191,6 +201,8 @@ CBattleDust::CBattleDust()
 	m_minParticleCount = 0;
 	m_maxParticleCount = 0;
 	m_distanceBetweenEvents = 0;
+	m_cellSize = 1.0f;	// !!CryFire - added
+	m_pendingDecay = 0.0f;	// !!CryFire - added
 
 	m_maxBattleEvents = 0;
 
@@ -265,7 +277,8 @@ void CBattleDust::ReloadXml()
 						param.m_pClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass(name);
 						param.m_power = power;
 						param.m_lifetime = lifetime;
-						m_weaponPower.push_back(param);
+						if(param.m_pClass)
+							m_weaponPower[param.m_pClass] = param;	// !!CryFire - modded
 					}
 				}
 			}
@@ -298,7 +311,8 @@ void CBattleDust::ReloadXml()
 						param.m_pClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass(name);
 						param.m_power = power;
 						param.m_lifetime = lifetime;
-						m_explosionPower.push_back(param);
+						if(param.m_pClass)
+							m_explosionPower[param.m_pClass] = param;	// !!CryFire - modded
 					}
 				}
 			}
@@ -331,7 +345,8 @@ void CBattleDust::ReloadXml()
 						param.m_pClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass(name);
 						param.m_power = power;
 						param.m_lifetime = lifetime;
-						m_vehicleExplosionPower.push_back(param);
+						if(param.m_pClass)
+							m_vehicleExplosionPower[param.m_pClass] = param;	// !!CryFire - modded
 					}
 				}
 			}
@@ -364,12 +379,16 @@ void CBattleDust::ReloadXml()
 						param.m_pClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass(name);
 						param.m_lifetime = lifetime;
 						param.m_power = power;
-						m_bulletImpactPower.push_back(param);
+						if(param.m_pClass)
+							m_bulletImpactPower[param.m_pClass] = param;	// !!CryFire - modded
 					}
 				}
 			}
 		}
 	}
+
+	// !!CryFire - added: cell size depends on m_distanceBetweenEvents
+	RebuildGrid();
 }
 
 void CBattleDust::RecordEvent(EBattleDustEventType event, Vec3 worldPos, const IEntityClass* pClass)
@@ -397,59 +416,53 @@ void CBattleDust::RecordEvent(EBattleDustEventType event, Vec3 worldPos, const I
 		m_pBattleEventClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass( "BattleEvent" );
 
 	// first check if we need a new event
-	bool newEvent = true;
-	for(std::list<EntityId>::iterator it = m_eventIdList.begin(); it != m_eventIdList.end(); ++it)
+	// !!CryFire - modded: only areas in the neighbouring grid cells can intersect
+	int area = FindIntersectingArea(worldPos, param.m_power, -1);
+	if(area >= 0)
 	{
-		EntityId areaId = (*it);
-		CBattleEvent *pBattleArea = FindEvent(areaId);
-		if(pBattleArea && CheckIntersection(pBattleArea, worldPos, param.m_power))
-		{
-			// don't need a new event as this one is within an existing one. Just merge them.
-			MergeAreas(pBattleArea, worldPos, param.m_power);
-			pBattleArea->m_lifeRemaining += param.m_lifetime;
-			pBattleArea->m_lifetime = pBattleArea->m_lifeRemaining;
-			pBattleArea->m_lifetime = CLAMP(pBattleArea->m_lifetime, 0.0f, m_maxLifetime);
-			pBattleArea->m_lifeRemaining = CLAMP(pBattleArea->m_lifeRemaining, 0.0f, m_maxLifetime);
-			newEvent = false;			
-			break;
-		}
+		// don't need a new event as this one is within an existing one. Just merge them.
+		MergeAreas(area, worldPos, param.m_power);
+		m_areaLifeRemaining[area] += param.m_lifetime;
+		m_areaLifetime[area] = m_areaLifeRemaining[area];
+		m_areaLifetime[area] = CLAMP(m_areaLifetime[area], 0.0f, m_maxLifetime);
+		m_areaLifeRemaining[area] = CLAMP(m_areaLifeRemaining[area], 0.0f, m_maxLifetime);
+		return;
 	}
  
-	if(newEvent)
+	IEntitySystem * pEntitySystem = gEnv->pEntitySystem;
+	SEntitySpawnParams esp;
+	esp.id = 0;
+	esp.nFlags = 0;
+	esp.pClass = m_pBattleEventClass;
+	if (!esp.pClass)
+		return;
+	esp.pUserData = NULL;
+	esp.sName = "BattleDust";
+	esp.vPosition	= worldPos;
+
+	// when CBattleEvent is created it will add itself to the list
+	IEntity * pEntity = pEntitySystem->SpawnEntity( esp );
+	if(pEntity)
 	{
-		IEntitySystem * pEntitySystem = gEnv->pEntitySystem;
- 		SEntitySpawnParams esp;
- 		esp.id = 0;
- 		esp.nFlags = 0;
- 		esp.pClass = m_pBattleEventClass;
- 		if (!esp.pClass)
- 			return;
- 		esp.pUserData = NULL;
- 		esp.sName = "BattleDust";
- 		esp.vPosition	= worldPos;
-	
-		// when CBattleEvent is created it will add itself to the list
-		IEntity * pEntity = pEntitySystem->SpawnEntity( esp );
-		if(pEntity)
+		// find the just-added entity in the list, and set it's properties
+		IGameObject* pGO = g_pGame->GetIGameFramework()->GetGameObject(pEntity->GetId());
+		if(pGO)
 		{
-			// find the just-added entity in the list, and set it's properties
-			IGameObject* pGO = g_pGame->GetIGameFramework()->GetGameObject(pEntity->GetId());
-			if(pGO)
+			CBattleEvent* pNewEvent = static_cast<CBattleEvent*>(pGO->QueryExtension("BattleEvent"));
+			if(pNewEvent && pNewEvent->m_areaIndex >= 0)
 			{
-				CBattleEvent* pNewEvent = static_cast<CBattleEvent*>(pGO->QueryExtension("BattleEvent"));
-				if(pNewEvent)
-				{
-					pNewEvent->m_radius = param.m_power;
-					pNewEvent->m_peakRadius = param.m_power;
-					pNewEvent->m_lifetime = param.m_lifetime;
-					pNewEvent->m_lifeRemaining = param.m_lifetime;
-					pNewEvent->m_worldPos = worldPos;
-
-					pNewEvent->m_lifetime = CLAMP(pNewEvent->m_lifetime, 0.0f, m_maxLifetime);
-					pNewEvent->m_lifeRemaining = CLAMP(pNewEvent->m_lifeRemaining, 0.0f, m_maxLifetime);
-
-					pGO->ChangedNetworkState(CBattleEvent::PROPERTIES_ASPECT);
-				}
+				int newArea = pNewEvent->m_areaIndex;
+				m_areaRadius[newArea] = param.m_power;
+				m_areaPeakRadius[newArea] = param.m_power;
+				m_areaLifetime[newArea] = CLAMP(param.m_lifetime, 0.0f, m_maxLifetime);
+				m_areaLifeRemaining[newArea] = m_areaLifetime[newArea];
+				m_areaPos[newArea] = worldPos;
+				pNewEvent->m_worldPos = worldPos;
+
+				RemoveFromGrid(newArea);
+				AddToGrid(newArea);
+
+				pGO->ChangedNetworkState(CBattleEvent::PROPERTIES_ASPECT);
 			}
 		}
 	}
@@ -460,97 +473,169 @@ void CBattleDust::NewBattleArea(CBattleEvent* pEvent)
 	if(!g_pGameCVars->g_battleDust_enable)
 		return;
 
-	int num = 0;
-	if (pEvent)
+	if (pEvent && pEvent->m_areaIndex < 0)
  	{
-		m_eventIdList.push_back(pEvent->GetEntityId());
-		num = m_eventIdList.size();
+		pEvent->m_areaIndex = (int)m_areaIds.size();
+		m_areaIds.push_back(pEvent->GetEntityId());
+		m_areaEvents.push_back(pEvent);
+		m_areaPos.push_back(pEvent->m_worldPos);
+		m_areaRadius.push_back(pEvent->m_radius);
+		m_areaPeakRadius.push_back(pEvent->m_peakRadius);
+		m_areaLifetime.push_back(pEvent->m_lifetime);
+		m_areaLifeRemaining.push_back(pEvent->m_lifeRemaining);
+		m_areaParticles.push_back(pEvent->m_numParticles);
+		m_areaCell.push_back(0);
+		AddToGrid(pEvent->m_areaIndex);
 	}
 }
 
 void CBattleDust::RemoveBattleArea(CBattleEvent* pEvent)
 {
-	int numRemain = 0;
-	if(pEvent)
-	{
-		stl::find_and_erase(m_eventIdList, pEvent->GetEntityId());
+	if(!pEvent || pEvent->m_areaIndex < 0)
+		return;
 
-		numRemain = m_eventIdList.size();
+	// !!CryFire - modded: move the last area into the freed slot
+	int area = pEvent->m_areaIndex;
+	int last = (int)m_areaIds.size() - 1;
+	RemoveFromGrid(area);
+	if(area != last)
+	{
+		RemoveFromGrid(last);
+		m_areaIds[area] = m_areaIds[last];
+		m_areaEvents[area] = m_areaEvents[last];
+		m_areaPos[area] = m_areaPos[last];
+		m_areaRadius[area] = m_areaRadius[last];
+		m_areaPeakRadius[area] = m_areaPeakRadius[last];
+		m_areaLifetime[area] = m_areaLifetime[last];
+		m_areaLifeRemaining[area] = m_areaLifeRemaining[last];
+		m_areaParticles[area] = m_areaParticles[last];
+		m_areaEvents[area]->m_areaIndex = area;
+		AddToGrid(area);
 	}
+	m_areaIds.pop_back();
+	m_areaEvents.pop_back();
+	m_areaPos.pop_back();
+	m_areaRadius.pop_back();
+	m_areaPeakRadius.pop_back();
+	m_areaLifetime.pop_back();
+	m_areaLifeRemaining.pop_back();
+	m_areaParticles.pop_back();
+	m_areaCell.pop_back();
+	pEvent->m_areaIndex = -1;
 }
 
 void CBattleDust::Update()
 {
 	FUNCTION_PROFILER(GetISystem(), PROFILE_GAME);
 
+	//-- !!CryFire - modded ---
+	if(!BeginUpdate())
+		return;
+
+	DecayAreas();
+	EndUpdate();
+	//------
+}
+
+//-- !!CryFire - added ------------------------------------------------------------------------------
+void CBattleDust::AddUpdateJobs()
+{
+	if(!BeginUpdate())
+		return;
+
+	// shrinking touches only the area arrays, the rest calls the engine
+	Jobs::jobId decay = Jobs::add("BattleDust::DecayAreas", DecayAreasJob, this, Jobs::eDeferrable);
+	Jobs::jobId end = Jobs::add("BattleDust::EndUpdate", EndUpdateJob, this, Jobs::eMainThread|Jobs::eDeferrable);
+	Jobs::addDependency(end, decay);
+}
+
+void CBattleDust::DecayAreasJob(void* pBattleDust)
+{
+	static_cast<CBattleDust*>(pBattleDust)->DecayAreas();
+}
+
+void CBattleDust::EndUpdateJob(void* pBattleDust)
+{
+	static_cast<CBattleDust*>(pBattleDust)->EndUpdate();
+}
+
+bool CBattleDust::BeginUpdate()
+{
 	if(!g_pGameCVars->g_battleDust_enable)
 	{
 		RemoveAllEvents();
-		return;
+		return false;
 	}
 
 	if(!gEnv->bServer)
-		return;
+		return false;
+
+	// accumulated in case the decay is postponed to the next frame
+	m_pendingDecay += gEnv->pTimer->GetFrameTime();
+	return true;
+}
+
+void CBattleDust::DecayAreas()
+{
+	// shrink all areas in one pass over the arrays
+	float frameTime = m_pendingDecay;
+	m_pendingDecay = 0.0f;
+	int numAreas = (int)m_areaIds.size();
+	for(int i = 0; i < numAreas; ++i)
+	{
+		if(m_areaLifetime[i] > 0.0f)
+		{
+			m_areaLifeRemaining[i] -= frameTime;
+			m_areaRadius[i] = m_areaPeakRadius[i] * (m_areaLifeRemaining[i] / m_areaLifetime[i]);
+		}
+	}
+}
+
+void CBattleDust::EndUpdate()
+{
+	int numAreas = (int)m_areaIds.size();
 
 	if(g_pGameCVars->g_battleDust_debug != 0)
 	{
 		float col[] = {1,1,1,1};
-		gEnv->pRenderer->Draw2dLabel(50, 40, 2.0f, col, false, "Num BD areas: %d (max %d)", m_eventIdList.size(), m_maxBattleEvents);
+		gEnv->pRenderer->Draw2dLabel(50, 40, 2.0f, col, false, "Num BD areas: %d (max %d)", numAreas, m_maxBattleEvents);
 	}
 	float ypos = 60.0f;
 
+	m_maxBattleEvents = MAX(m_maxBattleEvents, numAreas);
+
 	// go through the list of areas, remove any which are too small
-	m_maxBattleEvents = MAX(m_maxBattleEvents, m_eventIdList.size());
-	std::list<EntityId>::iterator next;
-	std::list<EntityId>::iterator it = m_eventIdList.begin();
-	for(; it != m_eventIdList.end(); it = next)
+	std::vector<EntityId> expired;
+	for(int i = 0; i < numAreas; ++i)
 	{
-		next = it; ++next;
-		EntityId areaId = (*it);
-		CBattleEvent *pBattleArea = FindEvent(areaId);
-		if(!pBattleArea)
-			continue;
-
-		if(pBattleArea->m_lifetime > 0.0f)
-		{
-			pBattleArea->m_lifeRemaining -= gEnv->pTimer->GetFrameTime();
-			pBattleArea->m_radius = pBattleArea->m_peakRadius * (pBattleArea->m_lifeRemaining / pBattleArea->m_lifetime);
-		}
-
 		if(g_pGameCVars->g_battleDust_debug != 0)
 		{
 			float col[] = {1,1,1,1};
-			gEnv->pRenderer->Draw2dLabel(50, ypos, 1.4f, col, false, "Area: (%.2f, %.2f, %.2f), Radius: %.2f/%.2f, Particles: %.0f, Lifetime: %.2f/%.2f", pBattleArea->m_worldPos.x, pBattleArea->m_worldPos.y, pBattleArea->m_worldPos.z, pBattleArea->m_radius, pBattleArea->m_peakRadius, pBattleArea->m_numParticles, pBattleArea->m_lifeRemaining, pBattleArea->m_lifetime);
+			gEnv->pRenderer->Draw2dLabel(50, ypos, 1.4f, col, false, "Area: (%.2f, %.2f, %.2f), Radius: %.2f/%.2f, Particles: %.0f, Lifetime: %.2f/%.2f", m_areaPos[i].x, m_areaPos[i].y, m_areaPos[i].z, m_areaRadius[i], m_areaPeakRadius[i], m_areaParticles[i], m_areaLifeRemaining[i], m_areaLifetime[i]);
 			ypos += 10.0f;
 		}
 
-		if(pBattleArea->m_lifeRemaining < 0.0f)
-		{
-			// remove it (NB this will also call RemoveBattleArea(), which will remove it from the list)
-			gEnv->pEntitySystem->RemoveEntity(areaId);
-		}
+		if(m_areaLifeRemaining[i] < 0.0f)
+			expired.push_back(m_areaIds[i]);
 		else
-		{
-			if(pBattleArea->GetEntity())
-			{
-				UpdateParticlesForArea(pBattleArea);
-			}
-		}
+			UpdateParticlesForArea(i);
 	}
+
+	// removing the entity calls RemoveBattleArea(), which reorders the arrays, so do it after the loop
+	for(size_t i = 0; i < expired.size(); ++i)
+		gEnv->pEntitySystem->RemoveEntity(expired[i]);
 }
+//---------------------------------------------------------------------------------------------------
 
 void CBattleDust::RemoveAllEvents()
 {
 	// go through the list and remove all entities (eg if user switches off battledust)
-	std::list<EntityId>::iterator next;
-	std::list<EntityId>::iterator it = m_eventIdList.begin();
-	for(; it != m_eventIdList.end(); it = next)
+	// !!CryFire - modded: removing reorders the arrays, so use a copy
+	std::vector<EntityId> ids(m_areaIds);
+	for(size_t i = 0; i < ids.size(); ++i)
 	{
-		next = it; ++next;
-		EntityId areaId = (*it);
-
 		// remove it (NB this will also call RemoveBattleArea(), which will remove it from the list)
-		gEnv->pEntitySystem->RemoveEntity(areaId);
+		gEnv->pEntitySystem->RemoveEntity(ids[i]);
 	}
 }
 
@@ -559,73 +644,44 @@ bool CBattleDust::GetEventParams(EBattleDustEventType event, const IEntityClass*
 	if(!g_pGameCVars->g_battleDust_enable)
 		return false;
 
+	// !!CryFire - modded: classes are looked up in hash tables
+	const TClassParams* pParams = NULL;
 	switch(event)
 	{
 		case eBDET_ShotFired:
 			out = m_defaultWeapon;
-			if(pClass != NULL)
-			{
-				// find weapon name in list.
-				for(int i=0; i<m_weaponPower.size(); ++i)
-				{
-					if(pClass == m_weaponPower[i].m_pClass)
-					{
-						out = m_weaponPower[i];
-						return true;
-					}
-				}
-			}
+			pParams = &m_weaponPower;
 			break;
 
 		case eBDET_Explosion:
 			out = m_defaultExplosion;
-			if(pClass != NULL)
-			{
-				for(int i=0; i<m_explosionPower.size(); ++i)
-				{
-					if(pClass == m_explosionPower[i].m_pClass)
-					{
-						out = m_explosionPower[i];
-						return true;
-					}
-				}
-			}
+			pParams = &m_explosionPower;
 			break;
 
 		case eBDET_VehicleExplosion:
 			out = m_defaultVehicleExplosion;
-			if(pClass != NULL)
-			{
-				for(int i=0; i<m_vehicleExplosionPower.size(); ++i)
-				{
-					if(pClass == m_vehicleExplosionPower[i].m_pClass)
-					{
-						out = m_vehicleExplosionPower[i];
-						return true;
-					}
-				}
-			}
+			pParams = &m_vehicleExplosionPower;
 			break;
 
 		case eBDET_ShotImpact:
 			out = m_defaultBulletImpact;
-			if(pClass != NULL)
-			{
-				for(int i=0; i<m_bulletImpactPower.size(); ++i)
-				{
-					if(pClass == m_bulletImpactPower[i].m_pClass)
-					{
-						out = m_bulletImpactPower[i];
-						return true;
-					}
-				}
-			}
+			pParams = &m_bulletImpactPower;
 			break;
 
 		default:
 			break;
 	}
 
+	if(pParams && pClass != NULL)
+	{
+		TClassParams::const_iterator it = pParams->find(pClass);
+		if(it != pParams->end())
+		{
+			out = it->second;
+			return true;
+		}
+	}
+
 	return (out.m_power != 0);
 }
 
@@ -636,33 +692,28 @@ bool CBattleDust::CheckForMerging(CBattleEvent* pEvent)
 	if(!g_pGameCVars->g_battleDust_enable)
 		return false;
 
-	if(!pEvent)
+	if(!pEvent || pEvent->m_areaIndex < 0)
 		return false;
 
 	if(!gEnv->bServer)
 		return false;
 
 	// check if area can merge with nearby areas
-	for(std::list<EntityId>::iterator it = m_eventIdList.begin(); it != m_eventIdList.end(); ++it)
+	// !!CryFire - modded: only areas in the neighbouring grid cells can intersect
+	int area = pEvent->m_areaIndex;
+	int other = FindIntersectingArea(m_areaPos[area], m_areaRadius[area], area);
+	if(other >= 0)
 	{
-		EntityId areaId = (*it);
-		CBattleEvent *pBattleArea = FindEvent(areaId);
-		if(!pBattleArea)
-			continue;
-
-		if(CheckIntersection(pEvent, pBattleArea->m_worldPos, pBattleArea->m_radius) && pBattleArea->m_radius > 0 && (pBattleArea != pEvent) && pBattleArea->GetEntity())
-		{
-			MergeAreas(pBattleArea, pEvent->m_worldPos, pEvent->m_radius);
-			return true;
-		}
+		MergeAreas(other, m_areaPos[area], m_areaRadius[area]);
+		return true;
 	}
 
 	return false;
 }
 
-bool CBattleDust::MergeAreas(CBattleEvent* pExisting, Vec3& pos, float radius)
+bool CBattleDust::MergeAreas(int area, const Vec3& pos, float radius)
 {
-	if(!pExisting)
+	if(area < 0)
 		return false;
 
 	// increase the size of existing area to take into account toAdd which overlaps.
@@ -671,15 +722,24 @@ bool CBattleDust::MergeAreas(CBattleEvent* pExisting, Vec3& pos, float radius)
 	//	- new centre pos is the average position, weighted by initial radius
 	//	- new radius is total of the two starting radii
 
-	float totalRadii = pExisting->m_radius + radius;
-	float oldFraction = pExisting->m_radius / totalRadii;
+	float totalRadii = m_areaRadius[area] + radius;
+	float oldFraction = m_areaRadius[area] / totalRadii;
 	float newFraction = radius / totalRadii;
 
-	pExisting->m_worldPos = (oldFraction * pExisting->m_worldPos) + (newFraction * pos);
-	pExisting->m_radius = CLAMP(totalRadii, 0.0f, m_maxEventPower);
-	pExisting->m_peakRadius = pExisting->m_radius;
+	m_areaPos[area] = (oldFraction * m_areaPos[area]) + (newFraction * pos);
+	m_areaRadius[area] = CLAMP(totalRadii, 0.0f, m_maxEventPower);
+	m_areaPeakRadius[area] = m_areaRadius[area];
+
+	// !!CryFire - added: the area might have moved into another cell
+	if(GetCell(m_areaPos[area]) != m_areaCell[area])
+	{
+		RemoveFromGrid(area);
+		AddToGrid(area);
+	}
 
 	// position has moved, so need to serialize
+	CBattleEvent* pExisting = m_areaEvents[area];
+	pExisting->m_worldPos = m_areaPos[area];
 	if(pExisting->GetGameObject())
 	{
 		pExisting->GetGameObject()->ChangedNetworkState(CBattleEvent::PROPERTIES_ASPECT);
@@ -688,59 +748,145 @@ bool CBattleDust::MergeAreas(CBattleEvent* pExisting, Vec3& pos, float radius)
 	return true;
 }
 
-void CBattleDust::UpdateParticlesForArea(CBattleEvent* pEvent)
+void CBattleDust::UpdateParticlesForArea(int area)
 {
-	float oldParticleCount = pEvent->m_numParticles;
-	float fraction = CLAMP((pEvent->m_radius - m_entitySpawnPower) / (m_maxEventPower - m_entitySpawnPower), 0.0f, 1.0f);
-	pEvent->m_numParticles = LERP(m_minParticleCount, m_maxParticleCount, fraction);
+	float oldParticleCount = m_areaParticles[area];
+	float fraction = CLAMP((m_areaRadius[area] - m_entitySpawnPower) / (m_maxEventPower - m_entitySpawnPower), 0.0f, 1.0f);
+	m_areaParticles[area] = LERP(m_minParticleCount, m_maxParticleCount, fraction);
 
-	if(pEvent->GetGameObject() && oldParticleCount != pEvent->m_numParticles)
+	// !!CryFire - modded: the event is touched only when the count changes
+	CBattleEvent* pEvent = m_areaEvents[area];
+	if(oldParticleCount != m_areaParticles[area])
 	{
-		pEvent->GetGameObject()->ChangedNetworkState(CBattleEvent::PROPERTIES_ASPECT);
+		pEvent->m_numParticles = m_areaParticles[area];
+		if(pEvent->GetGameObject())
+			pEvent->GetGameObject()->ChangedNetworkState(CBattleEvent::PROPERTIES_ASPECT);
 	}
 }
 
-bool CBattleDust::CheckIntersection(CBattleEvent* pEventOne, Vec3& pos, float radius)
+bool CBattleDust::CheckIntersection(int area, const Vec3& pos, float radius) const
+{
+	Vec3 centreToCentre = pos - m_areaPos[area];
+	float sumRadiiSquared = (radius * radius) + (m_areaRadius[area] * m_areaRadius[area]);
+	float distanceSquared = centreToCentre.GetLengthSquared();
+
+	return ((distanceSquared < sumRadiiSquared) && (distanceSquared < m_distanceBetweenEvents*m_distanceBetweenEvents));
+}
+
+//-- !!CryFire - added ------------------------------------------------------------------------------
+int CBattleDust::FindIntersectingArea(const Vec3& pos, float radius, int skipArea) const
 {
 	FUNCTION_PROFILER(GetISystem(), PROFILE_GAME);
 
-	if(!pEventOne)
-		return false;
+	// areas further than m_distanceBetweenEvents never intersect, so the 3x3 cells around are enough,
+	// take the lowest slot of the candidates, so the result doesn't depend on the order in the cells
+	int found = -1;
+	uint32 cell = GetCell(pos);
+	int cx = (int)(int16)(cell >> 16);
+	int cy = (int)(int16)(cell & 0xFFFF);
+	for(int x = cx - 1; x <= cx + 1; ++x)
+	{
+		for(int y = cy - 1; y <= cy + 1; ++y)
+		{
+			TAreaGrid::const_iterator it = m_areaGrid.find(((uint32)(uint16)x << 16) | (uint16)y);
+			if(it == m_areaGrid.end())
+				continue;
+			const std::vector<int>& areas = it->second;
+			for(size_t i = 0; i < areas.size(); ++i)
+			{
+				int area = areas[i];
+				if(area != skipArea && (found < 0 || area < found) && m_areaRadius[area] > 0 && CheckIntersection(area, pos, radius))
+					found = area;
+			}
+		}
+	}
+	return found;
+}
 
-	Vec3 centreToCentre = pos - pEventOne->m_worldPos;
-	float sumRadiiSquared = (radius * radius) + (pEventOne->m_radius * pEventOne->m_radius);
-	float distanceSquared = centreToCentre.GetLengthSquared();
+uint32 CBattleDust::GetCell(const Vec3& pos) const
+{
+	int x = (int)floor_tpl(pos.x / m_cellSize);
+	int y = (int)floor_tpl(pos.y / m_cellSize);
+	return ((uint32)(uint16)x << 16) | (uint16)y;
+}
 
-	return ((distanceSquared < sumRadiiSquared) && (distanceSquared < m_distanceBetweenEvents*m_distanceBetweenEvents));
+void CBattleDust::AddToGrid(int area)
+{
+	m_areaCell[area] = GetCell(m_areaPos[area]);
+	m_areaGrid[m_areaCell[area]].push_back(area);
 }
 
+void CBattleDust::RemoveFromGrid(int area)
+{
+	TAreaGrid::iterator it = m_areaGrid.find(m_areaCell[area]);
+	if(it == m_areaGrid.end())
+		return;
+	stl::find_and_erase(it->second, area);
+	if(it->second.empty())
+		m_areaGrid.erase(it);
+}
+
+void CBattleDust::RebuildGrid()
+{
+	m_cellSize = MAX(m_distanceBetweenEvents, 1.0f);
+	m_areaGrid.clear();
+	for(int i = 0; i < (int)m_areaIds.size(); ++i)
+		AddToGrid(i);
+}
+
+void CBattleDust::SaveArea(CBattleEvent* pEvent) const
+{
+	int area = pEvent->m_areaIndex;
+	if(area < 0)
+		return;
+	pEvent->m_worldPos = m_areaPos[area];
+	pEvent->m_radius = m_areaRadius[area];
+	pEvent->m_peakRadius = m_areaPeakRadius[area];
+	pEvent->m_lifetime = m_areaLifetime[area];
+	pEvent->m_lifeRemaining = m_areaLifeRemaining[area];
+	pEvent->m_numParticles = m_areaParticles[area];
+}
+
+void CBattleDust::LoadArea(CBattleEvent* pEvent)
+{
+	int area = pEvent->m_areaIndex;
+	if(area < 0)
+		return;
+	m_areaPos[area] = pEvent->m_worldPos;
+	m_areaRadius[area] = pEvent->m_radius;
+	m_areaPeakRadius[area] = pEvent->m_peakRadius;
+	m_areaLifetime[area] = pEvent->m_lifetime;
+	m_areaLifeRemaining[area] = pEvent->m_lifeRemaining;
+	m_areaParticles[area] = pEvent->m_numParticles;
+	RemoveFromGrid(area);
+	AddToGrid(area);
+}
+//---------------------------------------------------------------------------------------------------
+
 void CBattleDust::Serialize(TSerialize ser)
 {
 	if(ser.GetSerializationTarget() != eST_Network)
 	{
 		ser.BeginGroup("BattleDust");
-		int amount = m_eventIdList.size();
+		int amount = m_areaIds.size();
 		ser.Value("AmountOfBattleEvents", amount);
-		std::list<EntityId>::iterator begin = m_eventIdList.begin();
-		std::list<EntityId>::iterator end = m_eventIdList.end();
 
 		if(ser.IsReading())
 		{
-			m_eventIdList.clear();
+			// !!CryFire - modded: the ids are only read to keep the format, loaded events add themselves again
 			for(int i = 0; i < amount; ++i)
 			{
 				EntityId id = 0;
 				ser.BeginGroup("BattleEventId");
 				ser.Value("BattleEventId", id);
 				ser.EndGroup();
-				m_eventIdList.push_back(id);
 			}
 		}
 		else
 		{
-			for(; begin != end; ++begin)
+			for(int i = 0; i < amount; ++i)
 			{
-				EntityId id = (*begin);
+				EntityId id = m_areaIds[i];
 				ser.BeginGroup("BattleEventId");
 				ser.Value("BattleEventId", id);
 				ser.EndGroup();
@@ -760,4 +906,4 @@ CBattleEvent* CBattleDust::FindEvent(EntityId id)
 	}
 
 	return NULL;
-}
\ No newline at end of file
+}
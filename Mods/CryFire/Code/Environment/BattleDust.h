@@ -19,6 +19,7 @@ History:
 
 #include <list>
 #include <IGameObject.h>
+#include <StlUtils.h>   // !!CryFire - added
 
 // possible events that might cause dust
 enum EBattleDustEventType
@@ -64,6 +65,7 @@ protected:
 	static const int PROPERTIES_ASPECT = eEA_GameServerStatic;
 
 	Vec3	m_worldPos;					// where in the world are we?
+	// !!CryFire - modded: on server the area is simulated by CBattleDust, these 4 are only copies for savegames
 	float m_radius;						// how big now
 	float m_peakRadius;				// how big it has been
 	float m_lifetime;					// how long we will live (total)
@@ -71,6 +73,7 @@ protected:
 	float m_numParticles;
 	IParticleEffect* m_pParticleEffect;
 	EntityId m_entityId;			// needed so we can find this event in the list after adding it.
+	int m_areaIndex;					// !!CryFire - added: slot in the area arrays of CBattleDust, -1 if it's not there
 };
 
 // since weapon events have lifetime as well as power
@@ -93,8 +96,12 @@ public:
 	void ReloadXml();
 	void RecordEvent(EBattleDustEventType event, Vec3 worldPos, const IEntityClass* pClass);
 	void Update();
+	void AddUpdateJobs();	// !!CryFire - added: does the same as Update, the part without engine calls on a worker thread
 	void NewBattleArea(CBattleEvent* pEvent);
 	void RemoveBattleArea(CBattleEvent* pEvent);
+	// !!CryFire - added: the event copies the state of its area before a savegame is written, and the other way after it's read
+	void SaveArea(CBattleEvent* pEvent) const;
+	void LoadArea(CBattleEvent* pEvent);
 
 	void Serialize(TSerialize ser);
 
@@ -103,10 +110,28 @@ protected:
 	
 	// if two areas overlap, make a big one instead
 	bool CheckForMerging(CBattleEvent* pEvent);								
-	bool CheckIntersection(CBattleEvent* pEventOne, Vec3& pos, float radius);
-	bool MergeAreas(CBattleEvent* pExisting, Vec3& pos, float radius);
-
-	void UpdateParticlesForArea(CBattleEvent* pEvent);
+	//-- !!CryFire - modded ---------------------------------------------------------------------------
+	// areas are passed as indexes into the area arrays
+	bool CheckIntersection(int area, const Vec3& pos, float radius) const;
+	bool MergeAreas(int area, const Vec3& pos, float radius);
+	int FindIntersectingArea(const Vec3& pos, float radius, int skipArea) const;
+
+	void UpdateParticlesForArea(int area);
+
+	// uniform grid over x and y, cells are as big as the max distance of merged events,
+	// so only the cells around need to be searched
+	uint32 GetCell(const Vec3& pos) const;
+	void AddToGrid(int area);
+	void RemoveFromGrid(int area);
+	void RebuildGrid();
+
+	// parts of Update
+	bool BeginUpdate();
+	void DecayAreas();
+	void EndUpdate();
+	static void DecayAreasJob(void* pBattleDust);
+	static void EndUpdateJob(void* pBattleDust);
+	//---------------------------------------------------------------------------------------------------
 
 	void RemoveAllEvents();
 
@@ -125,11 +150,29 @@ protected:
 	SBattleEventParameter m_defaultVehicleExplosion;
 	SBattleEventParameter m_defaultBulletImpact;
 
-	std::list<EntityId> m_eventIdList;												// what has happened recently
-	std::vector<SBattleEventParameter> m_weaponPower;					// what effect each shot has
-	std::vector<SBattleEventParameter> m_explosionPower;			// what effect each explosion has
-	std::vector<SBattleEventParameter> m_vehicleExplosionPower;// similar for vehicle explosions
-	std::vector<SBattleEventParameter> m_bulletImpactPower;		// and for bullet impacts
+	//-- !!CryFire - modded ---------------------------------------------------------------------------
+	// what has happened recently, one element per area in each array, the order changes when areas are removed
+	std::vector<EntityId> m_areaIds;
+	std::vector<CBattleEvent*> m_areaEvents;
+	std::vector<Vec3> m_areaPos;
+	std::vector<float> m_areaRadius;
+	std::vector<float> m_areaPeakRadius;
+	std::vector<float> m_areaLifetime;
+	std::vector<float> m_areaLifeRemaining;
+	std::vector<float> m_areaParticles;
+	std::vector<uint32> m_areaCell;
+
+	typedef stl::hash_map<uint32, std::vector<int>, stl::hash_uint32> TAreaGrid;
+	TAreaGrid m_areaGrid;																			// key is packed cell coordinates, value are area indexes
+	float m_cellSize;
+	float m_pendingDecay;																			// frame time not yet subtracted from lifetimes
+
+	typedef stl::hash_map<const IEntityClass*, SBattleEventParameter, stl::hash_simple<const IEntityClass*> > TClassParams;
+	TClassParams m_weaponPower;																// what effect each shot has
+	TClassParams m_explosionPower;														// what effect each explosion has
+	TClassParams m_vehicleExplosionPower;											// similar for vehicle explosions
+	TClassParams m_bulletImpactPower;													// and for bullet impacts
+	//---------------------------------------------------------------------------------------------------
 
 	IEntityClass* m_pBattleEventClass;
 
@@ -53,6 +53,7 @@
 #include "ClientSynchedStorage.h"
 
 #include "SPAnalyst.h"
+#include "CryFire/EntityRegistry.h" // !!CryFire - added
 
 #include "ISaveGame.h"
 #include "ILoadGame.h"
@@ -131,6 +132,7 @@ CGame::~CGame()
 	SAFE_DELETE(m_pSoundMoods);
 	SAFE_DELETE(m_pHUD);
 	SAFE_DELETE(m_pSPAnalyst);
+	EntityRegistry::terminate(); // !!CryFire - added
 	m_pWeaponSystem->Release();
 	SAFE_DELETE(m_pItemStrings);
 	SAFE_DELETE(m_pItemSharedParamsList);
@@ -182,6 +184,8 @@ bool CGame::Init(IGameFramework *pFramework)
   // Register all the games factory classes e.g. maps "Player" to CPlayer
   InitGameFactory(m_pFramework);
 
+	EntityRegistry::initialize(); // !!CryFire - added
+
 	//FIXME: horrible, remove this ASAP
 	//gEnv->pPhysicalWorld->AddEventClient( EventPhysImpulse::id,OnImpulse,0 );  
 
@@ -35,8 +35,6 @@
 // !!CryFire: variables for CVars' values
 
 static int cf_usegsreplacement;
-static int cf_removeexplosives;
-static int cf_showspectatorchat;
 
 //------------------------------------------------------------------------
 // !!CryFire: handlers of CVars and commands' functions
@@ -68,17 +66,78 @@ static void ReloadMaps(IConsoleCmdArgs* pArgs)
 }
 
 
-static void BroadcastChangeSafeMode( ICVar * )
+// cf_dumpnetstats command function
+#include "CryFire/NetStats.h"
+static void DumpNetStats(IConsoleCmdArgs* pArgs)
 {
-	SGameObjectEvent event(eCGE_ResetMovementController, eGOEF_ToExtensions);
-	IEntitySystem * pES = gEnv->pEntitySystem;
-	IEntityItPtr pIt = pES->GetEntityIterator();
-	while (!pIt->IsEnd())
+	uint chnlId = pArgs->GetArgCount() > 1 ? (uint)atoi(pArgs->GetArg(1)) : 0;
+	NetStats::dump(chnlId);
+}
+
+// cf_dumprayqueue command function
+#include "CryFire/RayQueue.h"
+static void DumpRayQueue(IConsoleCmdArgs* pArgs)
+{
+	RayQueue::dump();
+}
+
+// cf_dumpjobs command function
+#include "CryFire/Jobs.h"
+static void DumpJobs(IConsoleCmdArgs* pArgs)
+{
+	Jobs::dump();
+}
+
+// cf_dumptelemetry command function
+#include "CryFire/Telemetry.h"
+static void DumpTelemetry(IConsoleCmdArgs* pArgs)
+{
+	Telemetry::dump();
+}
+
+// cf_dumpscriptstats command function
+#include "CryFire/ScriptStats.h"
+static void DumpScriptStats(IConsoleCmdArgs* pArgs)
+{
+	ScriptStats::Counters counters;
+	ScriptStats::getCounters(counters);
+	uint frames = counters.frames ? counters.frames : 1;
+	CryLogAlways("actor script stats over %u frames: %u writes (%u per frame), %u skipped as unchanged (%u per frame)",
+		counters.frames, counters.writes, counters.writes / frames, counters.skipped, counters.skipped / frames);
+	ScriptStats::resetCounters();
+}
+
+// cf_checkmovementtrace command function
+#include "CryFire/MovementCheck.h"
+static void CheckMovementTrace(IConsoleCmdArgs* pArgs)
+{
+	if (pArgs->GetArgCount() < 2)
 	{
-		if (IEntity * pEnt = pIt->Next())
-			if (IActor * pActor = g_pGame->GetIGameFramework()->GetIActorSystem()->GetActor(pEnt->GetId()))
-				pActor->HandleEvent( event );
+		CryLogAlways("usage: cf_checkmovementtrace <file with lines: time x y z maxSpeed [hit]>");
+		return;
 	}
+	MovementCheck::checkTrace(pArgs->GetArg(1));
+}
+
+// cf_convertrecord command function
+#include "CryFire/GameplayRecorder.h"
+static void ConvertRecord(IConsoleCmdArgs* pArgs)
+{
+	if (pArgs->GetArgCount() < 3)
+	{
+		CryLogAlways("usage: cf_convertrecord <record.cfr> <output.csv|output.xml>");
+		return;
+	}
+	GameplayRecorder::convert(pArgs->GetArg(1), pArgs->GetArg(2));
+}
+
+static void BroadcastChangeSafeMode( ICVar * )
+{
+	SGameObjectEvent event(eCGE_ResetMovementController, eGOEF_ToExtensions);
+	// !!CryFire - modded: only actors are interested, the actor system has a list of them
+	IActorIteratorPtr pIt = g_pGame->GetIGameFramework()->GetIActorSystem()->CreateActorIterator();
+	while (IActor * pActor = pIt->Next())
+		pActor->HandleEvent( event );
 }
 
 void CmdBulletTimeMode( IConsoleCmdArgs* cmdArgs)
@@ -361,7 +420,8 @@ void SCVars::InitCVars(IConsole *pConsole)
 	pConsole->Register("g_trooperBankingMultiplier", &g_trooperBankingMultiplier, 1, VF_DUMPTODISK, "Trooper banking multiplier coeff (0..x)");
 	pConsole->Register("g_alienPhysicsAnimRatio", &g_alienPhysicsAnimRatio, 0.0f, VF_CHEAT ); 
 
-	pConsole->Register("g_spRecordGameplay", &g_spRecordGameplay, 0, 0, "Write sp gameplay information to harddrive.");
+	// !!CryFire - modded: the recorder works on servers for all players
+	pConsole->Register("g_spRecordGameplay", &g_spRecordGameplay, 0, 0, "Write gameplay information of all players to harddrive (cf_convertrecord makes CSV or Excel XML of it).");
 	pConsole->Register("g_spGameplayRecorderUpdateRate", &g_spGameplayRecorderUpdateRate, 1.0f, 0, "Update-delta of gameplay recorder in seconds.");
   
 	pConsole->Register("pl_debug_ladders", &pl_debug_ladders, 0, VF_CHEAT);
@@ -594,10 +654,37 @@ void SCVars::InitCVars(IConsole *pConsole)
 	pVehicleQuality = pConsole->GetCVar("v_vehicle_quality");		assert(pVehicleQuality);
 	
 	//-- !!CryFire - added ---------------------------------------------------
-	pConsole->GetCVar("sv_maxplayers")->SetOnChangeCallback(::OnMaxPlayersChange);
+	pBindings = new SCVarBindings();
+	pBindings->Bind();
+	// the engine's handler limits it to 32, so this one must be replaced
+	if (ICVar *pMaxPlayers = pBindings->sv_maxplayers.GetCVar())
+		pMaxPlayers->SetOnChangeCallback(::OnMaxPlayersChange);
 	pConsole->Register("cf_usegsreplacement", &cf_usegsreplacement, 0, 0, "Enables alternative master server replacing GameSpy", OnGSReplacementChange);
 	pConsole->Register("cf_removeexplosives", &cf_removeexplosives, 0, 0, "Toggles removing explosives on player death", NULL);
 	pConsole->Register("cf_showspectatorchat", &cf_showspectatorchat, 1, 0, "Allows chat messages from spectators to be shown to all players", NULL);
+	pConsole->Register("cf_input_quantize", &cf_input_quantize, 1, 0, "Server resends player input only when it changes by more than the quantization step");
+	pConsole->Register("cf_input_move_bits", &cf_input_move_bits, 7, 0, "Bits per axis for comparing movement of player input (2-8)");
+	pConsole->Register("cf_input_yaw_bits", &cf_input_yaw_bits, 12, 0, "Bits for comparing look direction yaw of player input (4-16)");
+	pConsole->Register("cf_input_pitch_bits", &cf_input_pitch_bits, 11, 0, "Bits for comparing look direction pitch of player input (4-16)");
+	pConsole->Register("cf_relevancy", &cf_relevancy, 0, 0, "Server delays minimap and synched entity updates for players far from the entity");
+	pConsole->Register("cf_relevancy_radius", &cf_relevancy_radius, 200.0f, 0, "Distance in which entities are always interesting for a player, twice as much in the view direction");
+	pConsole->Register("cf_relevancy_maxdelay", &cf_relevancy_maxdelay, 5.0f, 0, "Maximum delay in seconds of updates of entities, which are not interesting for a player");
+	pConsole->Register("cf_chat_rate", &cf_chat_rate, 1.0f, 0, "Chat messages per second a player can send in long term");
+	pConsole->Register("cf_chat_burst", &cf_chat_burst, 5, 0, "Chat messages a player can send in a row, 0 disables the flood protection");
+	pConsole->Register("cf_rayqueue", &cf_rayqueue, 0, 0, "Visibility rays of gun turrets are traced in a batch at the beginning of the next frame, a turret sees a new target only in the search after its rays were traced");
+	pConsole->Register("cf_rayqueue_budget", &cf_rayqueue_budget, 64, 0, "Maximum number of queued rays traced in one frame, the rest waits for the next one, 0 = unlimited");
+	pConsole->Register("cf_jobs", &cf_jobs, 1, 0, "Server runs thread-safe parts of game rules update (shot validator, battle dust) on worker threads");
+	pConsole->Register("cf_jobs_budget", &cf_jobs_budget, 4.0f, 0, "Milliseconds after which deferrable jobs are not started in this frame anymore, 0 = unlimited");
+	pConsole->Register("cf_telemetry", &cf_telemetry, 1, 0, "Measures time spent in game subsystems and exports it to a file and to the master server, 1 = on dedicated server, 2 = always");
+	pConsole->Register("cf_telemetry_interval", &cf_telemetry_interval, 10.0f, 0, "Seconds between telemetry exports");
+	cf_telemetry_file = pConsole->RegisterString("cf_telemetry_file", "telemetry.json", 0, "File receiving telemetry, one JSON object per line, or CSV rows when the name ends with .csv, empty = no file");
+	cf_votelog_file = pConsole->RegisterString("cf_votelog_file", "votes.log", 0, "File receiving results of votings, one per line, empty = no file");
+	pConsole->Register("cf_telemetry_maxsize", &cf_telemetry_maxsize, 1024, 0, "Size in kB after which the telemetry file is renamed to <name>.1 and a new one is started, 0 = unlimited");
+	pConsole->Register("cf_movecheck", &cf_movecheck, 0, 0, "Server compares distance moved by players within a second with the speed the player movement allows, try it with cf_checkmovementtrace first");
+	pConsole->Register("cf_movecheck_tolerance", &cf_movecheck_tolerance, 1.2f, 0, "Multiplier of the distance a player can move before it is a violation");
+	pConsole->Register("cf_movecheck_slack", &cf_movecheck_slack, 2.0f, 0, "Meters added to the distance a player can move, covers lag and position corrections");
+	pConsole->Register("cf_movecheck_impulse", &cf_movecheck_impulse, 6.0f, 0, "Meters added to the distance a player can move for every hit or explosion which reached the player within the second");
+	pConsole->Register("cf_pickup_maxdistance", &cf_pickup_maxdistance, 5.0f, 0, "Server rejects pickup requests for items farther than this from the player, 0 = no check");
 	//------------------------------------------------------------------------
 
   NetInputChainInitCVars();
@@ -906,8 +993,116 @@ void SCVars::ReleaseCVars()
 
  pConsole->UnregisterVariable("aim_assistCrosshairSize", true);
   pConsole->UnregisterVariable("aim_assistCrosshairDebug", true);
+
+	SAFE_DELETE(pBindings); // !!CryFire - added
+}
+
+//-- !!CryFire - added ---------------------------------------------------
+std::vector<CVarBindingBase*> CVarBindingBase::s_bound;
+CVarBindingBase::SSink CVarBindingBase::s_sink;
+
+CVarBindingBase::CVarBindingBase(const char *name)
+: m_name(name),
+	m_pCVar(0)
+{
+}
+
+CVarBindingBase::~CVarBindingBase()
+{
+	Unbind();
 }
 
+bool CVarBindingBase::Bind()
+{
+	if (m_pCVar)
+		return true;
+
+	m_pCVar = gEnv->pConsole->GetCVar(m_name);
+	if (!m_pCVar)
+	{
+		GameWarning("CVar %s doesn't exist, using its default value", m_name);
+		return false;
+	}
+	Fetch();
+
+	if (s_bound.empty())
+		gEnv->pConsole->AddConsoleVarSink(&s_sink);
+	s_bound.push_back(this);
+	return true;
+}
+
+void CVarBindingBase::Unbind()
+{
+	if (!m_pCVar)
+		return;
+
+	m_pCVar = 0;
+	stl::find_and_erase(s_bound, this);
+	if (s_bound.empty())
+		gEnv->pConsole->RemoveConsoleVarSink(&s_sink);
+}
+
+void CVarBindingBase::Subscribe(ConsoleVarFunc func)
+{
+	stl::push_back_unique(m_subscribers, func);
+}
+
+void CVarBindingBase::Unsubscribe(ConsoleVarFunc func)
+{
+	stl::find_and_erase(m_subscribers, func);
+}
+
+void CVarBindingBase::SSink::OnAfterVarChange(ICVar *pVar)
+{
+	// called for every CVar, there are only a few bindings
+	for (size_t i = 0; i < s_bound.size(); ++i)
+	{
+		CVarBindingBase *pBinding = s_bound[i];
+		if (pBinding->m_pCVar != pVar || !pBinding->Fetch())
+			continue;
+		// a subscriber may set the CVar again, which calls us recursively
+		std::vector<ConsoleVarFunc> subscribers = pBinding->m_subscribers;
+		for (size_t s = 0; s < subscribers.size(); ++s)
+			subscribers[s](pVar);
+		return;
+	}
+}
+
+//------------------------------------------------------------------------
+SCVarBindings::SCVarBindings()
+: sv_port("sv_port", 64087),
+	sv_maxplayers("sv_maxplayers", 32),
+	sv_servername("sv_servername", ""),
+	sv_password("sv_password", ""),
+	sv_ranked("sv_ranked", 0),
+	sv_lanonly("sv_lanonly", 0),
+	i_noweaponlimit("i_noweaponlimit", 0)
+{
+}
+
+void SCVarBindings::Bind()
+{
+	sv_port.Bind();
+	sv_maxplayers.Bind();
+	sv_servername.Bind();
+	sv_password.Bind();
+	sv_ranked.Bind();
+	sv_lanonly.Bind();
+	i_noweaponlimit.Bind();
+}
+
+void SCVarBindings::Unbind()
+{
+	sv_port.Unbind();
+	sv_maxplayers.Unbind();
+	sv_servername.Unbind();
+	sv_password.Unbind();
+	sv_ranked.Unbind();
+	sv_lanonly.Unbind();
+	i_noweaponlimit.Unbind();
+}
+//------------------------------------------------------------------------
+
 //------------------------------------------------------------------------
 void CGame::CmdDumpSS(IConsoleCmdArgs *pArgs)
 {
@@ -978,6 +1173,20 @@ void CGame::RegisterConsoleCommands()
 
 	// !!CryFire - added: command to reload maps for adding them during run
 	m_pConsole->AddCommand("reloadmaps", ReloadMaps, 0, "reloads maps from Crysis\\Game\\Levels directory");
+	// !!CryFire - added: command to find RMI floods and bandwidth hogs
+	m_pConsole->AddCommand("cf_dumpnetstats", DumpNetStats, 0, "prints network traffic statistics of a channel, or of all channels if none is given");
+	// !!CryFire - added: command to see how many Lua table writes the actors do
+	m_pConsole->AddCommand("cf_dumpscriptstats", DumpScriptStats, 0, "prints how many actor stats were written into Lua tables and how many were skipped since the last call");
+	// !!CryFire - added: command to see who submits the queued rays and how long they wait
+	m_pConsole->AddCommand("cf_dumprayqueue", DumpRayQueue, 0, "prints queued rays and their latency per caller since the last call");
+	// !!CryFire - added: command to see how long the game jobs take and how often they are postponed
+	m_pConsole->AddCommand("cf_dumpjobs", DumpJobs, 0, "prints duration of game jobs on worker threads since the last call");
+	// !!CryFire - added: command to see where the server spends its frame time
+	m_pConsole->AddCommand("cf_dumptelemetry", DumpTelemetry, 0, "prints time spent in game subsystems during the last telemetry interval");
+	// !!CryFire - added: command to test the movement check on recorded positions
+	m_pConsole->AddCommand("cf_checkmovementtrace", CheckMovementTrace, 0, "runs the movement check on a trace of positions of one player and prints the violations");
+	// !!CryFire - added: command to turn binary gameplay records into spreadsheets
+	m_pConsole->AddCommand("cf_convertrecord", ConvertRecord, 0, "converts a gameplay record to CSV, or to Excel XML if the output file ends with .xml");
 }
 
 //------------------------------------------------------------------------
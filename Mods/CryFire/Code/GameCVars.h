@@ -5,6 +5,8 @@
 #ifndef __GAMECVARS_H__
 #define __GAMECVARS_H__
 
+struct SCVarBindings; // !!CryFire - added
+
 struct SCVars
 {	
 	static const float v_altitudeLimitDefault()
@@ -431,6 +433,54 @@ struct SCVars
 	int			g_deathCam;
 	int			g_deathEffects;
 
+	// !!CryFire - added: game rules
+	int   cf_removeexplosives;
+	int   cf_showspectatorchat;
+
+	// !!CryFire - added: cached CVars registered by the engine
+	SCVarBindings *pBindings;
+
+	// !!CryFire - added: quantization of net player input
+	int   cf_input_quantize;
+	int   cf_input_move_bits;
+	int   cf_input_yaw_bits;
+	int   cf_input_pitch_bits;
+
+	// !!CryFire - added: interest management
+	int   cf_relevancy;
+	float cf_relevancy_radius;
+	float cf_relevancy_maxdelay;
+
+	// !!CryFire - added: chat flood protection
+	float cf_chat_rate;
+	int   cf_chat_burst;
+
+	// !!CryFire - added: batched rays
+	int   cf_rayqueue;
+	int   cf_rayqueue_budget;
+
+	// !!CryFire - added: game jobs on worker threads
+	int   cf_jobs;
+	float cf_jobs_budget;
+
+	// !!CryFire - added: frame-time telemetry
+	int   cf_telemetry;
+	float cf_telemetry_interval;
+	ICVar*cf_telemetry_file;
+	int   cf_telemetry_maxsize;
+
+	// !!CryFire - added: voting
+	ICVar*cf_votelog_file;
+
+	// !!CryFire - added: movement plausibility check
+	int   cf_movecheck;
+	float cf_movecheck_tolerance;
+	float cf_movecheck_slack;
+	float cf_movecheck_impulse;
+
+	// !!CryFire - added: pickup validation
+	float cf_pickup_maxdistance;
+
 	SCVars()
 	{
 		memset(this,0,sizeof(SCVars));
@@ -442,4 +492,82 @@ struct SCVars
 	void ReleaseCVars();
 };
 
+//-- !!CryFire - added ---------------------------------------------------
+// A CVar registered by somebody else, resolved once by name. The value is
+// kept up to date by a console variable sink, so reading it costs nothing
+// and a missing CVar just keeps the default value. The sink is used instead
+// of SetOnChangeCallback, because a CVar has only one callback and the
+// engine's own would be lost.
+class CVarBindingBase
+{
+public:
+	CVarBindingBase(const char *name);
+	virtual ~CVarBindingBase();
+
+	// finds the CVar and reads its value, returns false if it doesn't exist
+	bool Bind();
+	void Unbind();
+
+	bool IsBound() const { return m_pCVar != 0; }
+	ICVar *GetCVar() const { return m_pCVar; }
+	const char *GetName() const { return m_name; }
+
+	// func is called after the value changed, only when it really differs
+	void Subscribe(ConsoleVarFunc func);
+	void Unsubscribe(ConsoleVarFunc func);
+
+protected:
+	// reads the value from m_pCVar, returns true if it's different
+	virtual bool Fetch() = 0;
+
+	static bool Read(ICVar *pCVar, int &value) { int v = pCVar->GetIVal(); bool changed = v != value; value = v; return changed; }
+	static bool Read(ICVar *pCVar, float &value) { float v = pCVar->GetFVal(); bool changed = v != value; value = v; return changed; }
+	static bool Read(ICVar *pCVar, string &value) { const char *v = pCVar->GetString(); bool changed = value != v; if (changed) value = v; return changed; }
+
+	struct SSink : public IConsoleVarSink
+	{
+		virtual bool OnBeforeVarChange(ICVar *pVar, const char *sNewValue) { return true; }
+		virtual void OnAfterVarChange(ICVar *pVar);
+	};
+
+	const char *m_name;
+	ICVar *m_pCVar;
+	std::vector<ConsoleVarFunc> m_subscribers;
+
+	static std::vector<CVarBindingBase*> s_bound;
+	static SSink s_sink;
+};
+
+template <class T>
+class CVarBinding : public CVarBindingBase
+{
+public:
+	CVarBinding(const char *name, const T &defaultValue) : CVarBindingBase(name), m_value(defaultValue) {}
+
+	const T &Get() const { return m_value; }
+
+protected:
+	virtual bool Fetch() { return Read(m_pCVar, m_value); }
+
+	T m_value;
+};
+
+// the engine's CVars read by the game code in hot paths
+struct SCVarBindings
+{
+	CVarBinding<int>    sv_port;
+	CVarBinding<int>    sv_maxplayers;
+	CVarBinding<string> sv_servername;
+	CVarBinding<string> sv_password;
+	CVarBinding<int>    sv_ranked;
+	CVarBinding<int>    sv_lanonly;
+	CVarBinding<int>    i_noweaponlimit;
+
+	SCVarBindings();
+
+	void Bind();
+	void Unbind();
+};
+//------------------------------------------------------------------------
+
 #endif //__GAMECVARS_H__
@@ -50,6 +50,9 @@
 #include "CryFire/AsyncTasks.h"
 #include "CryFire/MSrvConnection.h"
 #include "CryFire/FSUtils.h"
+#include "CryFire/Relevancy.h"
+#include "CryFire/Jobs.h"
+#include "CryFire/MovementCheck.h"
 
 int CGameRules::s_invulnID = 0;
 int CGameRules::s_barbWireID = 0;
@@ -67,7 +70,7 @@ CGameRules::CGameRules()
 	m_pClientNetChannel(0),
 	m_teamIdGen(0),
 	m_hitMaterialIdGen(0),
-	m_hitTypeIdGen(0),
+	m_minimapTime(0.0),	// !!CryFire - added
 	m_currentStateId(0),
 	m_endTime(0.0f),
 	m_roundEndTime(0.0f),
@@ -100,6 +103,7 @@ CGameRules::~CGameRules()
 		m_pGameFramework->GetIViewSystem()->RemoveListener(this);
 	GetGameObject()->ReleaseActions(this);
 
+	Jobs::reset();	// !!CryFire - added: postponed jobs work with the objects deleted below
 	delete m_pShotValidator;
 	delete m_pRadio;
 	delete m_pBattleDust;
@@ -249,7 +253,7 @@ void CGameRules::PostInitClient(int channelId)
 
 	// update minimap entities on the client
 	for (TMinimap::const_iterator mit=m_minimap.begin(); mit!=m_minimap.end(); ++mit)
-		GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), AddMinimapEntityParams(mit->entityId, mit->lifetime, mit->type), eRMI_ToClientChannel, mit->entityId, channelId);
+		GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), AddMinimapEntityParams(mit->entityId, GetMinimapLifetime(*mit), mit->type), eRMI_ToClientChannel, mit->entityId, channelId);	// !!CryFire - modded
 
 	// freeze stuff on the clients
 	for (TFrozenEntities::const_iterator fit=m_frozen.begin(); fit!=m_frozen.end(); ++fit)
@@ -294,12 +298,12 @@ void CGameRules::FullSerialize( TSerialize ser )
 	if (ser.IsReading())    
 		ResetFrozen();            
 
-	TFrozenEntities frozen(m_frozen);
+	std::map<EntityId, CTimeValue> frozen(m_frozen.begin(), m_frozen.end());	// !!CryFire - modded: serializer knows only std containers
 	ser.Value("FrozenEntities", frozen);
 
 	if (ser.IsReading())
 	{
-		for (TFrozenEntities::const_iterator it=frozen.begin(),end=frozen.end(); it!=end; ++it)
+		for (std::map<EntityId, CTimeValue>::const_iterator it=frozen.begin(),end=frozen.end(); it!=end; ++it)	// !!CryFire - modded
 			FreezeEntity(it->first, true, false, true);
 	}
 
@@ -320,6 +324,8 @@ void CGameRules::Update( SEntityUpdateContext& ctx, int updateSlot )
 	if (updateSlot!=0)
 		return;
 
+	CF_TELEMETRY_SCOPE("GameRules.Update");	// !!CryFire - added
+
 	//g_pGame->GetServerSynchedStorage()->SetGlobalValue(15, 1026);
 
 	bool server=gEnv->bServer;
@@ -329,8 +335,14 @@ void CGameRules::Update( SEntityUpdateContext& ctx, int updateSlot )
     ProcessQueuedExplosions();
 		UpdateEntitySchedules(ctx.fFrameTime);
 
+		//-- !!CryFire - modded ---
+		// data of these are touched only by their jobs until Jobs::endFrame
 		if (m_pShotValidator)
-			m_pShotValidator->Update();
+			m_pShotValidator->AddUpdateJob();
+		if (m_pBattleDust)
+			m_pBattleDust->AddUpdateJobs();
+		Jobs::beginFrame();
+		//------
 
 		if (gEnv->bMultiplayer)
 		{
@@ -361,8 +373,12 @@ void CGameRules::Update( SEntityUpdateContext& ctx, int updateSlot )
 
 	UpdateMinimap(ctx.fFrameTime);
 
-	if(m_pBattleDust)
+	//-- !!CryFire - modded ---
+	if (server)
+		Jobs::endFrame();
+	else if(m_pBattleDust)
 		m_pBattleDust->Update();
+	//------
 
 	if(m_pMPTutorial)
 		m_pMPTutorial->Update();
@@ -453,20 +469,21 @@ void CGameRules::PostUpdate( float frameTime )
 {
   if(m_pVotingSystem && m_pVotingSystem->IsInProgress())
   {
-    int need_votes = int(ceilf(GetPlayerCount(false)*g_pGame->GetCVars()->sv_votingRatio));
+    // !!CryFire - modded: the voter counts are cached by the voting system
+    int need_votes = m_pVotingSystem->GetRequiredVotes();
     if(need_votes && m_pVotingSystem->GetNumVotes() >= need_votes)
     {
       EndVoting(true);
     }
-    if(int team = m_pVotingSystem->GetTeam())
+    if(m_pVotingSystem->IsInProgress() && m_pVotingSystem->GetTeam())
     {
-      int team_votes = int(ceilf(GetTeamPlayerCount(team,false)*g_pGame->GetCVars()->sv_votingRatio));
+      int team_votes = m_pVotingSystem->GetRequiredTeamVotes();
       if(team_votes && m_pVotingSystem->GetNumTeamVotes() >= team_votes)
       {
         EndVoting(true);
       }
     }
-    if(m_pVotingSystem->GetVotingTime().GetSeconds() > g_pGame->GetCVars()->sv_votingTimeout)    
+    if(m_pVotingSystem->IsInProgress() && m_pVotingSystem->GetVotingTime().GetSeconds() > g_pGame->GetCVars()->sv_votingTimeout)    
     {
       EndVoting(false);
     }
@@ -569,6 +586,9 @@ bool CGameRules::OnClientConnect(int channelId, bool isReset)
 	{
 		m_channelIds.push_back(channelId);
 		g_pGame->GetServerSynchedStorage()->OnClientConnect(channelId);
+		UpdateVoterCounts(0); // !!CryFire - added
+		if (gEnv->bServer)
+			CryFire::onClientConnect(channelId); // !!CryFire - added
 
 		if (m_pShotValidator)
 			m_pShotValidator->Connected(channelId);
@@ -625,6 +645,10 @@ void CGameRules::OnClientDisconnect(int channelId, EDisconnectionCause cause, co
 	if (m_pShotValidator)
 		m_pShotValidator->Disconnected(channelId);
 
+	// !!CryFire - added
+	if (gEnv->bServer)
+		CryFire::onClientDisconnect(channelId);
+
 	CActor *pActor=GetActorByChannelId(channelId);
 	//assert(pActor);
 
@@ -662,6 +686,7 @@ void CGameRules::OnClientDisconnect(int channelId, EDisconnectionCause cause, co
 	std::vector<int>::iterator channelit=std::find(m_channelIds.begin(), m_channelIds.end(), channelId);
 	if (channelit!=m_channelIds.end())
 		m_channelIds.erase(channelit);
+	UpdateVoterCounts(0); // !!CryFire - added
 
 	CallScript(m_serverStateScript, "OnClientDisconnect", channelId);
 
@@ -918,6 +943,8 @@ CActor *CGameRules::ChangePlayerClass(int channelId, const char *className)
 //------------------------------------------------------------------------
 void CGameRules::RevivePlayer(CActor *pActor, const Vec3 &pos, const Ang3 &angles, int teamId, bool clearInventory)
 {
+	MovementCheck::onTeleport(pActor->GetEntityId());	// !!CryFire - added
+
 	// get out of vehicles before reviving
 	if (IVehicle *pVehicle=pActor->GetLinkedVehicle())
 	{
@@ -1150,6 +1177,7 @@ void CGameRules::KillPlayer(CActor *pActor, bool dropItem, bool ragdoll, EntityI
 //------------------------------------------------------------------------
 void CGameRules::MovePlayer(CActor *pActor, const Vec3 &pos, const Ang3 &angles)
 {
+	MovementCheck::onTeleport(pActor->GetEntityId());	// !!CryFire - added
 	CActor::MoveParams params(pos, Quat(angles));
 	pActor->GetGameObject()->InvokeRMI(CActor::ClMoveTo(), params, eRMI_ToClientChannel|eRMI_NoLocalCalls, pActor->GetChannelId());
 	pActor->GetEntity()->SetWorldTM(Matrix34::Create(Vec3(1,1,1), params.rot, params.pos));
@@ -1333,36 +1361,63 @@ void CGameRules::StartVoting(CActor *pActor, EVotingState t, EntityId id, const
   {
     if(!m_pVotingSystem)
       return;
-    CTimeValue st;
-    CTimeValue curr_time = gEnv->pTimer->GetFrameStartTime();
-
-    if(!m_pVotingSystem->GetCooldownTime(entityId,st) || (curr_time-st).GetSeconds()>g_pGame->GetCVars()->sv_votingCooldown)
-    {
-      if(m_pVotingSystem->StartVoting(entityId,curr_time,t,id,param,GetTeam(id)))
-      {
-        m_pVotingSystem->Vote(entityId,GetTeam(entityId), true);
-        VotingStatusParams st_param(t,g_pGame->GetCVars()->sv_votingTimeout,id,param);
-        GetGameObject()->InvokeRMI(ClVotingStatus(), st_param, eRMI_ToAllClients);
-				if(t == eVS_kick)
-				{
-					CryFixedStringT<256> feedbackString("@mp_vote_initialized_kick:#:");
-
-					feedbackString.append(param);
-					SendChatMessage(eChatToAll, id, 0, feedbackString.c_str());
-				}
-				else
-					SendChatMessage(eChatToAll, id, 0, "@mp_vote_initialized_nextmap");
-      }
-    }
-    else
-    {
-      CryLog("Player %s cannot start voting yet",pActor->GetEntity()->GetName());
-    }
+    StartVotingOfType(pActor, m_pVotingSystem->GetTypeOf(t), id, param);
   }
   else if (pActor->GetEntityId() == m_pGameFramework->GetClientActor()->GetEntityId())
     GetGameObject()->InvokeRMIWithDependentObject(SvStartVoting(), params, eRMI_ToServer, entityId);
 }
 
+//------------------------------------------------------------------------
+// !!CryFire - added: server part of StartVoting, used by scripts for their own vote types
+bool CGameRules::StartVotingOfType(CActor *pActor, int type, EntityId id, const char* param)
+{
+  if(!pActor || !m_pVotingSystem || !gEnv->bServer || type < 0)
+    return false;
+
+  EntityId entityId = pActor->GetEntityId();
+  int channelId = pActor->GetChannelId();
+  CTimeValue curr_time = gEnv->pTimer->GetFrameStartTime();
+
+  if(m_pVotingSystem->IsCoolingDown(channelId, type, curr_time))
+  {
+    CryLog("Player %s cannot start voting yet",pActor->GetEntity()->GetName());
+    return false;
+  }
+
+  // counts may be stale, if players were moved to the new map without connecting again
+  UpdateVoterCounts(0);
+  UpdateVoterCounts(GetTeam(id));
+  if(!m_pVotingSystem->StartVoting(channelId,curr_time,type,id,param,GetTeam(id)))
+    return false;
+
+  const SVoteType& voteType = m_pVotingSystem->GetVoteType(type);
+  m_pVotingSystem->Vote(channelId,GetTeam(entityId), true);
+  VotingStatusParams st_param(voteType.state,g_pGame->GetCVars()->sv_votingTimeout,id,param);
+  GetGameObject()->InvokeRMI(ClVotingStatus(), st_param, eRMI_ToAllClients);
+  if(voteType.state == eVS_kick)
+  {
+    CryFixedStringT<256> feedbackString("@mp_vote_initialized_kick:#:");
+
+    feedbackString.append(param);
+    SendChatMessage(eChatToAll, id, 0, feedbackString.c_str());
+  }
+  else if(!voteType.handler)
+    SendChatMessage(eChatToAll, id, 0, "@mp_vote_initialized_nextmap");
+  return true;
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added: counts of voters are cached by the voting system, teamId 0 means all players
+void CGameRules::UpdateVoterCounts(int teamId)
+{
+  if(!m_pVotingSystem)
+    return;
+  if(teamId)
+    m_pVotingSystem->SetTeamVoterCount(teamId, GetTeamPlayerCount(teamId, false));
+  else
+    m_pVotingSystem->SetVoterCount(GetPlayerCount(false));
+}
+
 //------------------------------------------------------------------------
 void CGameRules::Vote(CActor* pActor, bool yes)
 {
@@ -1374,9 +1429,10 @@ void CGameRules::Vote(CActor* pActor, bool yes)
   {
     if(!m_pVotingSystem)
       return;
-    if(m_pVotingSystem->CanVote(id) && m_pVotingSystem->IsInProgress())
+    int channelId = pActor->GetChannelId(); // !!CryFire - modded: voters are tracked by channel
+    if(m_pVotingSystem->CanVote(channelId) && m_pVotingSystem->IsInProgress())
     {
-      m_pVotingSystem->Vote(id,GetTeam(id), yes);
+      m_pVotingSystem->Vote(channelId,GetTeam(id), yes);
 			if(yes)
 				SendChatMessage(eChatToAll, id, 0, "@mp_voted");
 			else
@@ -1402,6 +1458,27 @@ void CGameRules::EndVoting(bool success)
   if(!m_pVotingSystem || !gEnv->bServer)
     return;
 
+  //-- !!CryFire - added: audit log and vote types defined by scripts
+  if(!m_pVotingSystem->IsInProgress())
+    return;
+  CActor *pInitiator = GetActorByChannelId(m_pVotingSystem->GetInitiator());
+  m_pVotingSystem->LogResult(success, pInitiator ? pInitiator->GetEntity()->GetName() : "");
+  const SVoteType *pVoteType = m_pVotingSystem->GetVoteType();
+  if(success && pVoteType->handler)
+  {
+    // the voting is over before the handler runs, so that the handler can start another one
+    string subject = m_pVotingSystem->GetSubject();
+    HSCRIPTFUNCTION handler = pVoteType->handler;
+    ScriptHandle initiatorId(pInitiator ? pInitiator->GetEntityId() : 0);
+    CryLog("Voting \'%s\' succeeded.",subject.c_str());
+    m_pVotingSystem->EndVoting();
+    VotingStatusParams params(eVS_none, 0, GetEntityId(), "");
+    GetGameObject()->InvokeRMI(ClVotingStatus(), params, eRMI_ToAllClients);
+    Script::Call(gEnv->pScriptSystem, handler, subject.c_str(), initiatorId);
+    return;
+  }
+  //------------------------------------------------------------------------
+
   if(success)
   {
     CryLog("Voting \'%s\' succeeded.",m_pVotingSystem->GetSubject().c_str());
@@ -1444,6 +1521,7 @@ int CGameRules::CreateTeam(const char *name)
 
 	m_teams.insert(TTeamIdMap::value_type(name, ++m_teamIdGen));
 	m_playerteams.insert(TPlayerTeamIdMap::value_type(m_teamIdGen, TPlayers()));
+	InvalidateChatStatus(); // !!CryFire - added: the team count decides who is actively playing
 
 	return m_teamIdGen;
 }
@@ -1464,6 +1542,7 @@ void CGameRules::RemoveTeam(int teamId)
 	}
 
 	m_playerteams.erase(m_playerteams.find(teamId));
+	InvalidateChatStatus(); // !!CryFire - added
 }
 
 //------------------------------------------------------------------------
@@ -1573,6 +1652,8 @@ void CGameRules::SetTeam(int teamId, EntityId id)
 	if (oldTeam==teamId)
 		return;
 
+	InvalidateChatStatus(id); // !!CryFire - added
+
 	TEntityTeamIdMap::iterator it=m_entityteams.find(id);
 	if (it!=m_entityteams.end())
 		m_entityteams.erase(it);
@@ -1634,6 +1715,10 @@ void CGameRules::SetTeam(int teamId, EntityId id)
 
 		if (pActor->IsClient())
 			m_pRadio->SetTeam(GetTeamName(teamId));
+
+		// !!CryFire - added
+		UpdateVoterCounts(oldTeam);
+		UpdateVoterCounts(teamId);
 	}
 
 	ScriptHandle handle(id);
@@ -1643,6 +1728,9 @@ void CGameRules::SetTeam(int teamId, EntityId id)
 	{
 		ScriptHandle handle(id);
 		CallScript(m_clientStateScript, "OnSetTeam", handle, teamId);
+
+		if (m_pMPTutorial)
+			m_pMPTutorial->OnTeamChanged(id); // !!CryFire - added
 	}
 	
 	// if this is a spawn group, update it's validity
@@ -2213,7 +2301,8 @@ bool CGameRules::IsSpawnLocationSafe(EntityId playerId, EntityId spawnLocationId
 
 	query.box = AABB(Vec3(c.x-l,c.y-l,c.z-0.15f), Vec3(c.x+l,c.y+l,c.z+2.0f));
 	query.nEntityFlags = -1;
-	query.pEntityClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass("Player");
+	static IEntityClass* s_pPlayerClass = gEnv->pEntitySystem->GetClassRegistry()->FindClass("Player");	// !!CryFire - modded
+	query.pEntityClass = s_pPlayerClass;
 	gEnv->pEntitySystem->QueryProximity(query);
 
 	bool result=true;
@@ -2617,6 +2706,14 @@ EntityId CGameRules::GetInterestingSpectatorLocation() const
 void CGameRules::ResetMinimap()
 {
 	m_minimap.resize(0);
+	//-- !!CryFire - added ---
+	m_deferredMinimap.clear();
+	m_minimapIndex.clear();
+	m_minimapExpiry.clear();
+	m_minimapTime=0.0;
+	m_minimapChanges.clear();
+	m_minimapChangeOrder.clear();
+	//------
 
 	if (gEnv->bServer)
 		GetGameObject()->InvokeRMI(ClResetMinimap(), NoParams(), eRMI_ToAllClients|eRMI_NoLocalCalls);
@@ -2625,46 +2722,243 @@ void CGameRules::ResetMinimap()
 //------------------------------------------------------------------------
 void CGameRules::UpdateMinimap(float frameTime)
 {
-	TMinimap::iterator next;
-	for (TMinimap::iterator eit=m_minimap.begin(); eit!=m_minimap.end(); eit=next)
+	//-- !!CryFire - modded: entities expire in the order of their expiration, without walking all of them
+	m_minimapTime+=frameTime;
+
+	while (!m_minimapExpiry.empty() && m_minimapExpiry.front().time<=m_minimapTime)
 	{
-		next=eit;
-		++next;
-		SMinimapEntity &entity=*eit;
-		if (entity.lifetime>0.0f)
+		SMinimapExpiry expiry=m_minimapExpiry.front();
+		std::pop_heap(m_minimapExpiry.begin(), m_minimapExpiry.end());
+		m_minimapExpiry.pop_back();
+
+		TMinimapIndex::const_iterator iit=m_minimapIndex.find(expiry.entityId);
+		if (iit==m_minimapIndex.end())
+			continue;
+		const SMinimapEntity &entity=m_minimap[iit->second];
+		if (entity.lifetime>0.0f && entity.expireTime==expiry.time)
+			EraseMinimapEntity(iit->second);
+	}
+
+	// entities refreshed again and again leave outdated records behind
+	if (m_minimapExpiry.size()>4*m_minimap.size()+64)
+	{
+		m_minimapExpiry.clear();
+		for (TMinimap::const_iterator mit=m_minimap.begin(); mit!=m_minimap.end(); ++mit)
 		{
-			entity.lifetime-=frameTime;
-			if (entity.lifetime<=0.0f)
-				next=m_minimap.erase(eit);
+			if (mit->lifetime>0.0f)
+			{
+				SMinimapExpiry expiry={ mit->expireTime, mit->entityId };
+				m_minimapExpiry.push_back(expiry);
+			}
 		}
+		std::make_heap(m_minimapExpiry.begin(), m_minimapExpiry.end());
 	}
+
+	if (gEnv->bServer)
+		FlushMinimapChanges();
+	//--------------------------------------------------------------------
 }
 
 //------------------------------------------------------------------------
 void CGameRules::AddMinimapEntity(EntityId entityId, int type, float lifetime)
 {
-	TMinimap::iterator it=std::find(m_minimap.begin(), m_minimap.end(), SMinimapEntity(entityId, 0, 0.0f));
-	if (it!=m_minimap.end())
-	{
-		if (type>it->type)
-			it->type=type;
-		if (lifetime==0.0f || lifetime>it->lifetime)
-			it->lifetime=lifetime;
+	if (gEnv->bServer)
+		RecordMinimapChange(entityId, false);	// !!CryFire - added
+
+	//-- !!CryFire - modded ---
+	SMinimapEntity *pEntity=0;
+	TMinimapIndex::const_iterator iit=m_minimapIndex.find(entityId);
+	if (iit!=m_minimapIndex.end())
+	{
+		pEntity=&m_minimap[iit->second];
+		if (type>pEntity->type)
+			pEntity->type=type;
+		if (lifetime==0.0f || lifetime>GetMinimapLifetime(*pEntity))
+			pEntity->lifetime=lifetime;
+		else
+			return;
 	}
 	else
+	{
+		m_minimapIndex.insert(TMinimapIndex::value_type(entityId, (int)m_minimap.size()));
 		m_minimap.push_back(SMinimapEntity(entityId, type, lifetime));
+		pEntity=&m_minimap.back();
+	}
 
-	if (gEnv->bServer)
-		GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), AddMinimapEntityParams(entityId, lifetime, (int)type), eRMI_ToAllClients|eRMI_NoLocalCalls, entityId);
+	if (lifetime>0.0f)
+	{
+		pEntity->expireTime=m_minimapTime+lifetime;
+		SMinimapExpiry expiry={ pEntity->expireTime, entityId };
+		m_minimapExpiry.push_back(expiry);
+		std::push_heap(m_minimapExpiry.begin(), m_minimapExpiry.end());
+	}
+	//------
 }
 
 //------------------------------------------------------------------------
 void CGameRules::RemoveMinimapEntity(EntityId entityId)
 {
-	stl::find_and_erase(m_minimap, SMinimapEntity(entityId, 0, 0.0f));
-
+	//-- !!CryFire - modded ---
 	if (gEnv->bServer)
-		GetGameObject()->InvokeRMI(ClRemoveMinimapEntity(), EntityParams(entityId), eRMI_ToAllClients|eRMI_NoLocalCalls);
+		RecordMinimapChange(entityId, true);
+
+	TMinimapIndex::const_iterator iit=m_minimapIndex.find(entityId);
+	if (iit!=m_minimapIndex.end())
+		EraseMinimapEntity(iit->second);
+	//------
+
+	//-- !!CryFire - added: don't send it later to channels, which haven't got it yet
+	for (std::set<std::pair<int, EntityId> >::iterator dit=m_deferredMinimap.begin(); dit!=m_deferredMinimap.end(); )
+	{
+		if (dit->second==entityId)
+			m_deferredMinimap.erase(dit++);
+		else
+			++dit;
+	}
+	//--------------------------------------------------------------------
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+float CGameRules::GetMinimapLifetime(const SMinimapEntity &entity) const
+{
+	if (entity.lifetime<=0.0f)
+		return 0.0f;
+
+	return (float)(entity.expireTime-m_minimapTime);
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CGameRules::EraseMinimapEntity(int index)
+{
+	m_minimapIndex.erase(m_minimap[index].entityId);
+
+	// the order doesn't matter, so move the last one into the hole
+	int last=(int)m_minimap.size()-1;
+	if (index!=last)
+	{
+		m_minimap[index]=m_minimap[last];
+		m_minimapIndex[m_minimap[index].entityId]=index;
+	}
+	m_minimap.pop_back();
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CGameRules::RecordMinimapChange(EntityId entityId, bool remove)
+{
+	TMinimapChanges::iterator cit=m_minimapChanges.find(entityId);
+	if (cit!=m_minimapChanges.end())
+	{
+		// a remove after an add of entity, which clients didn't have before, cancels out
+		if (remove && cit->second.wasPresent)
+			cit->second.removed=true;
+		return;
+	}
+
+	SMinimapChange change;
+	change.removed=remove;
+	TMinimapIndex::const_iterator iit=m_minimapIndex.find(entityId);
+	change.wasPresent=iit!=m_minimapIndex.end();
+	change.type=change.wasPresent ? m_minimap[iit->second].type : 0;
+	change.lifetime=change.wasPresent ? GetMinimapLifetime(m_minimap[iit->second]) : 0.0f;
+	m_minimapChanges.insert(TMinimapChanges::value_type(entityId, change));
+	m_minimapChangeOrder.push_back(entityId);
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+// Sends clients only the result of all adds and removes of an entity in this frame, it has to come out
+// the same as if they applied all of them, because they merge ClAddMinimapEntity with what they have.
+void CGameRules::FlushMinimapChanges()
+{
+	for (std::vector<EntityId>::const_iterator oit=m_minimapChangeOrder.begin(); oit!=m_minimapChangeOrder.end(); ++oit)
+	{
+		EntityId entityId=*oit;
+		const SMinimapChange &change=m_minimapChanges[entityId];
+
+		TMinimapIndex::const_iterator iit=m_minimapIndex.find(entityId);
+		if (iit==m_minimapIndex.end())
+		{
+			if (change.wasPresent || change.removed)
+				GetGameObject()->InvokeRMI(ClRemoveMinimapEntity(), EntityParams(entityId), eRMI_ToAllClients|eRMI_NoLocalCalls);
+			continue;
+		}
+
+		const SMinimapEntity &entity=m_minimap[iit->second];
+		if (change.wasPresent)
+		{
+			// clients take the new lifetime only if it's infinite or longer than theirs, the result can be shorter
+			// when it was set to infinite and then to something else, in that case they have to forget the old one first
+			float lifetime=GetMinimapLifetime(entity);
+			bool merges=entity.type>=change.type && (lifetime==0.0f || lifetime>=change.lifetime);
+			if (change.removed || !merges)
+				GetGameObject()->InvokeRMI(ClRemoveMinimapEntity(), EntityParams(entityId), eRMI_ToAllClients|eRMI_NoLocalCalls);
+		}
+		SendMinimapEntity(entity);
+	}
+
+	m_minimapChanges.clear();
+	m_minimapChangeOrder.resize(0);
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CGameRules::SendMinimapEntity(const SMinimapEntity &entity)
+{
+	AddMinimapEntityParams params(entity.entityId, GetMinimapLifetime(entity), entity.type);
+
+	// channels not interested in the entity get it later
+	if (!Relevancy::isEnabled())
+	{
+		GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), params, eRMI_ToAllClients|eRMI_NoLocalCalls, entity.entityId);
+		return;
+	}
+
+	InterestSet interest(entity.entityId);
+	for (std::vector<int>::const_iterator cit=m_channelIds.begin(); cit!=m_channelIds.end(); ++cit)
+	{
+		if (interest.contains(*cit))
+		{
+			m_deferredMinimap.erase(std::make_pair(*cit, entity.entityId));
+			GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), params, eRMI_ToClientChannel|eRMI_NoLocalCalls, entity.entityId, *cit);
+			Relevancy::countImmediate();
+		}
+		else
+		{
+			m_deferredMinimap.insert(std::make_pair(*cit, entity.entityId));
+			Relevancy::countDeferred();
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CGameRules::FlushDeferredMinimap(bool all)
+{
+	std::set<std::pair<int, EntityId> >::iterator dit=m_deferredMinimap.begin();
+	while (dit!=m_deferredMinimap.end())
+	{
+		int channelId=dit->first;
+		EntityId entityId=dit->second;
+		if (!all && !Relevancy::isInterested(channelId, entityId))
+		{
+			++dit;
+			continue;
+		}
+		m_deferredMinimap.erase(dit++);
+
+		// channel could have disconnected and the entity could have expired in the meantime
+		if (std::find(m_channelIds.begin(), m_channelIds.end(), channelId)==m_channelIds.end())
+			continue;
+		TMinimapIndex::const_iterator iit=m_minimapIndex.find(entityId);
+		if (iit==m_minimapIndex.end())
+			continue;
+		const SMinimapEntity &entity=m_minimap[iit->second];
+
+		GetGameObject()->InvokeRMIWithDependentObject(ClAddMinimapEntity(), AddMinimapEntityParams(entityId, GetMinimapLifetime(entity), entity.type), eRMI_ToClientChannel|eRMI_NoLocalCalls, entityId, channelId);
+	}
 }
 
 //------------------------------------------------------------------------
@@ -2707,6 +3001,7 @@ int CGameRules::RegisterHitMaterial(const char *materialName)
 	if (pSurfaceType)
 	{
 		m_hitMaterials.insert(THitMaterialMap::value_type(++m_hitMaterialIdGen, pSurfaceType->GetId()));
+		m_hitMaterialIds.insert(THitMaterialSurfaceMap::value_type(pSurfaceType->GetId(), m_hitMaterialIdGen));	// !!CryFire - added
 		return m_hitMaterialIdGen;
 	}
 	return 0;
@@ -2719,27 +3014,18 @@ int CGameRules::GetHitMaterialId(const char *materialName) const
 	if (!pSurfaceType)
 		return 0;
 
-	int id=pSurfaceType->GetId();
-
-	for (THitMaterialMap::const_iterator it=m_hitMaterials.begin(); it!=m_hitMaterials.end(); ++it)
-	{
-		if (it->second==id)
-			return it->first;
-	}
-
-	return 0;
+	return GetHitMaterialIdFromSurfaceId(pSurfaceType->GetId());	// !!CryFire - modded
 }
 
 //------------------------------------------------------------------------
 int CGameRules::GetHitMaterialIdFromSurfaceId(int surfaceId) const
 {
-	for (THitMaterialMap::const_iterator it=m_hitMaterials.begin(); it!=m_hitMaterials.end(); ++it)
-	{
-		if (it->second==surfaceId)
-			return it->first;
-	}
+	// !!CryFire - modded: called for every bullet hit, don't scan all materials
+	THitMaterialSurfaceMap::const_iterator it=m_hitMaterialIds.find(surfaceId);
+	if (it==m_hitMaterialIds.end())
+		return 0;
 
-	return 0;
+	return it->second;
 }
 
 //------------------------------------------------------------------------
@@ -2758,46 +3044,53 @@ ISurfaceType *CGameRules::GetHitMaterial(int id) const
 void CGameRules::ResetHitMaterials()
 {
 	m_hitMaterials.clear();
+	m_hitMaterialIds.clear();	// !!CryFire - added
 	m_hitMaterialIdGen=0;
 }
 
 //------------------------------------------------------------------------
 int CGameRules::RegisterHitType(const char *type)
 {
-	if (int id=GetHitTypeId(type))
-		return id;
-
-	m_hitTypes.insert(THitTypeMap::value_type(++m_hitTypeIdGen, type));
-	return m_hitTypeIdGen;
+	return m_hitTypes.registerType(type);	// !!CryFire - modded
 }
 
 //------------------------------------------------------------------------
 int CGameRules::GetHitTypeId(const char *type) const
 {
-	for (THitTypeMap::const_iterator it=m_hitTypes.begin(); it!=m_hitTypes.end(); ++it)
-	{
-		if (it->second==type)
-			return it->first;
-	}
+	return m_hitTypes.getId(type);	// !!CryFire - modded
+}
 
-	return 0;
+//-- !!CryFire - added ---------------------------------------------------
+int CGameRules::GetHitTypeId(const CCryName &type) const
+{
+	return m_hitTypes.getId(type);
+}
+
+int CGameRules::GetHitTypeId(const ItemString &type) const
+{
+#ifdef ITEM_USE_SHAREDSTRING
+	return GetHitTypeIdByAddress(type.c_str());
+#else
+	return GetHitTypeId(type.c_str());
+#endif
+}
+
+int CGameRules::GetHitTypeIdByAddress(const char *type) const
+{
+	return m_hitTypes.getIdByAddress(type);
 }
+//------------------------------------------------------------------------
 
 //------------------------------------------------------------------------
 const char *CGameRules::GetHitType(int id) const
 {
-	THitTypeMap::const_iterator it=m_hitTypes.find(id);
-	if (it==m_hitTypes.end())
-		return 0;
-
-	return it->second.c_str();
+	return m_hitTypes.getName(id);	// !!CryFire - modded
 }
 
 //------------------------------------------------------------------------
 void CGameRules::ResetHitTypes()
 {
-	m_hitTypes.clear();
-	m_hitTypeIdGen=0;
+	m_hitTypes.reset();	// !!CryFire - modded
 }
 
 //------------------------------------------------------------------------
@@ -2811,32 +3104,40 @@ void CGameRules::SendTextMessage(ETextMessageType type, const char *msg, unsigne
 // !!CryFire - modded: lets the spectators talk to the players
 bool CGameRules::CanReceiveChatMessage(EChatMessageType type, EntityId sourceId, EntityId targetId) const
 {
-	bool showSpectatorChat = gEnv->pConsole->GetCVar("cf_showspectatorchat")->GetIVal() == 1;
-
-  if (!showSpectatorChat) {
-	if(sourceId == targetId)
+	//-- !!CryFire - modded: the status is cached, see GetChatStatus ---
+	if (sourceId == targetId || g_pGameCVars->cf_showspectatorchat == 1)
 		return true;
 
-	bool sspec=!IsPlayerActivelyPlaying(sourceId);
-	bool sdead=IsDead(sourceId);
+	return ChatStatus::allows(GetChatStatus(sourceId), GetChatStatus(targetId));
+	//------
+}
 
-	bool tspec=!IsPlayerActivelyPlaying(targetId);
-	bool tdead=IsDead(targetId);
+//------------------------------------------------------------------------
+// !!CryFire - added
+uint8 CGameRules::GetChatStatus(EntityId entityId) const
+{
+	FlatHashMap<EntityId, uint8>::const_iterator it=m_chatStatus.find(entityId);
+	if (it!=m_chatStatus.end())
+		return it->second;
 
-	if(sdead != tdead)
-	{
-		//CryLog("Disallowing msg (dead): source %d, target %d, sspec %d, sdead %d, tspec %d, tdead %d", sourceId, targetId, sspec, sdead, tspec, tdead);
-		return false;
-	}
+	uint8 status=0;
+	if (!IsPlayerActivelyPlaying(entityId))
+		status|=ChatStatus::SPECTATOR;
+	if (IsDead(entityId))
+		status|=ChatStatus::DEAD;
+	m_chatStatus[entityId]=status;
 
-	if(!(tspec || (sspec==tspec)))
-	{
-		//CryLog("Disallowing msg (spec): source %d, target %d, sspec %d, sdead %d, tspec %d, tdead %d", sourceId, targetId, sspec, sdead, tspec, tdead);
-		return false;
-	}
-  }
-	//CryLog("Allowing msg: source %d, target %d, sspec %d, sdead %d, tspec %d, tdead %d", sourceId, targetId, sspec, sdead, tspec, tdead);
-	return true;
+	return status;
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CGameRules::InvalidateChatStatus(EntityId entityId)
+{
+	if (entityId)
+		m_chatStatus.erase(entityId);
+	else
+		m_chatStatus.clear();
 }
 
 //------------------------------------------------------------------------
@@ -2893,6 +3194,11 @@ void CGameRules::SendChatMessage(EChatMessageType type, EntityId sourceId, Entit
 
 	if (gEnv->bServer)
 	{
+		//-- !!CryFire - added: the source is evaluated once, the targets by their cached status ---
+		const bool showSpectatorChat = g_pGameCVars->cf_showspectatorchat == 1;
+		const uint8 sourceStatus = GetChatStatus(sourceId);
+		//------
+
 		switch(type)
 		{
 		case eChatToTarget:
@@ -2910,7 +3216,8 @@ void CGameRules::SendChatMessage(EChatMessageType type, EntityId sourceId, Entit
 				{
 					if (CActor *pActor=GetActorByChannelId(*it))
 					{
-						if (CanReceiveChatMessage(type, sourceId, pActor->GetEntityId()) && IsPlayerInGame(pActor->GetEntityId()))
+						EntityId id=pActor->GetEntityId();	// !!CryFire - modded
+						if ((showSpectatorChat || id==sourceId || ChatStatus::allows(sourceStatus, GetChatStatus(id))) && IsPlayerInGame(id))
 							GetGameObject()->InvokeRMIWithDependentObject(ClChatMessage(), params, eRMI_ToClientChannel, pActor->GetEntityId(), *it);
 					}
 				}
@@ -2929,7 +3236,7 @@ void CGameRules::SendChatMessage(EChatMessageType type, EntityId sourceId, Entit
 
 						for (TPlayers::const_iterator it=begin; it!=end; ++it)
 						{
-							if (CanReceiveChatMessage(type, sourceId, *it))
+							if (showSpectatorChat || *it==sourceId || ChatStatus::allows(sourceStatus, GetChatStatus(*it)))	// !!CryFire - modded
 								GetGameObject()->InvokeRMIWithDependentObject(ClChatMessage(), params, eRMI_ToClientChannel, *it, GetChannelId(*it));
 						}
 					}
@@ -3223,7 +3530,7 @@ void CGameRules::CmdDebugMinimap(IConsoleCmdArgs *pArgs)
 		for (TMinimap::const_iterator it=pGameRules->m_minimap.begin(); it!=pGameRules->m_minimap.end(); ++it)
 		{
 			IEntity *pEntity=gEnv->pEntitySystem->GetEntity(it->entityId);
-			CryLogAlways("  -> Entity %s  (eid: %d %08x  class: %s  lifetime: %.3f  type: %d)", pEntity->GetName(), pEntity->GetId(), pEntity->GetId(), pEntity->GetClass()->GetName(), it->lifetime, it->type);
+			CryLogAlways("  -> Entity %s  (eid: %d %08x  class: %s  lifetime: %.3f  type: %d)", pEntity->GetName(), pEntity->GetId(), pEntity->GetId(), pEntity->GetClass()->GetName(), pGameRules->GetMinimapLifetime(*it), it->type);
 		}
 	}
 }
@@ -3571,6 +3878,7 @@ void CGameRules::NextLevel()
 //------------------------------------------------------------------------
 void CGameRules::ResetEntities()
 {
+	InvalidateChatStatus(); // !!CryFire - added
 	g_pGame->GetWeaponSystem()->GetTracerManager().Reset();
 
 	ResetFrozen();
@@ -4038,12 +4346,12 @@ void CGameRules::GetMemoryStatistics(ICrySizer * s)
 	s->Add(*this);
 	s->AddContainer(m_channelIds);
 	s->AddContainer(m_teams);
-	s->AddContainer(m_entityteams);
+	m_entityteams.GetMemoryUsage(s);	// !!CryFire - modded
 	s->AddContainer(m_channelteams);
 	s->AddContainer(m_teamdefaultspawns);
 	s->AddContainer(m_playerteams);
 	s->AddContainer(m_hitMaterials);
-	s->AddContainer(m_hitTypes);
+	m_hitTypes.GetMemoryUsage(s);	// !!CryFire - modded, with the names
 	s->AddContainer(m_respawndata);
 	s->AddContainer(m_respawns);
 	s->AddContainer(m_removals);
@@ -4059,8 +4367,6 @@ void CGameRules::GetMemoryStatistics(ICrySizer * s)
 		s->Add(iter->first);
 	for (TPlayerTeamIdMap::iterator iter = m_playerteams.begin(); iter != m_playerteams.end(); ++iter)
 		s->AddContainer(iter->second);
-	for (THitTypeMap::iterator iter = m_hitTypes.begin(); iter != m_hitTypes.end(); ++iter)
-		s->Add(iter->second);
 	for (TTeamObjectiveMap::iterator iter = m_objectives.begin(); iter != m_objectives.end(); ++iter)
 		s->AddContainer(iter->second);
 	for (TSpawnGroupMap::iterator iter = m_spawnGroups.begin(); iter != m_spawnGroups.end(); ++iter)
@@ -4259,3 +4565,28 @@ void CGameRules::GetIPLater(INetChannel * channel, const char * playerName)
 	CF_Log(3, "getting IP of %s on channel %d", playerName, channelId);
 	AsyncTasks::addTask(asyncGetIPAddr, params, processIPAddr);	
 }
+
+//-- !!CryFire - added ---------------------------------------------------
+// the common parts of all CallScript and CallScriptReturn overloads, all of them are measured by one telemetry timer
+bool CGameRules::BeginScriptCall(IScriptTable *pScript, const char *name, uint64 &start)
+{
+	if (!pScript || pScript->GetValueType(name) != svtFunction)
+		return false;
+
+	start = __rdtsc();
+	m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
+	return true;
+}
+
+void CGameRules::EndScriptCall(uint64 start)
+{
+	m_pScriptSystem->EndCall();
+	RecordScriptCall(start);
+}
+
+void CGameRules::RecordScriptCall(uint64 start)
+{
+	static const uint timer = Telemetry::registerTimer("GameRules.CallScript");
+	Telemetry::record(timer, __rdtsc() - start);
+}
+//------------------------------------------------------------------------
@@ -25,8 +25,14 @@
 #include "Actor.h"
 #include "SynchedStorage.h"
 #include <queue>
+#include <set> // !!CryFire - added
+#include <FlatHashMap.h> // !!CryFire - added
+#include "CryFire/HitTypes.h" // !!CryFire - added
+#include "CryFire/ChatStatus.h" // !!CryFire - added
+#include "ItemString.h" // !!CryFire - added
 #include "Voting.h"
 #include "ShotValidator.h"
+#include "CryFire/Telemetry.h" // !!CryFire - added
 
 
 class CActor;
@@ -108,7 +114,7 @@ public:
 	typedef std::vector<EntityId>								TSpawnGroups;
 	typedef std::map<EntityId, TSpawnLocations>	TSpawnGroupMap;
 	typedef std::map<EntityId, int>							TBuildings;
-	typedef std::map<EntityId, CTimeValue>			TFrozenEntities;
+	typedef FlatHashMap<EntityId, CTimeValue>		TFrozenEntities;	// !!CryFire - modded
 
 	typedef struct SMinimapEntity
 	{
@@ -116,7 +122,8 @@ public:
 		SMinimapEntity(EntityId id, int typ, float time)
 			: entityId(id),
 			type(typ),
-			lifetime(time)
+			lifetime(time),
+			expireTime(0.0)	// !!CryFire - added
 		{
 		}
 
@@ -127,7 +134,8 @@ public:
 
 		EntityId		entityId;
 		int					type;
-		float				lifetime;
+		float				lifetime;		// !!CryFire - modded: lifetime as it was last set, 0 = forever, use GetMinimapLifetime for the remaining time
+		double			expireTime;	// !!CryFire - added: minimap clock time, when the entity expires
 	};
 	typedef std::vector<SMinimapEntity>				TMinimap;
 
@@ -202,6 +210,11 @@ public:
 	virtual void SendChatMessage(EChatMessageType type, EntityId sourceId, EntityId targetId, const char *msg);
 	virtual bool CanReceiveChatMessage(EChatMessageType type, EntityId sourceId, EntityId targetId) const;
 
+	//-- !!CryFire - added: chat routing, the status of every player is cached until it changes, see ChatStatus
+	uint8 GetChatStatus(EntityId entityId) const;
+	void InvalidateChatStatus(EntityId entityId=0);	// called when the health, spectator mode or team changes, 0 = all
+	//------
+
 	virtual void ForbiddenAreaWarning(bool active, int timer, EntityId targetId);
 
 	virtual void ResetGameTime();
@@ -280,6 +293,9 @@ public:
   virtual void StartVoting(CActor *pActor, EVotingState t, EntityId id, const char* param);
   virtual void Vote(CActor *pActor, bool yes);
   virtual void EndVoting(bool success);
+	// !!CryFire - added: starts a voting of a registered type on server, returns false if it cannot be started
+	bool StartVotingOfType(CActor *pActor, int type, EntityId id, const char* param);
+	void UpdateVoterCounts(int teamId);
 
 	//------------------------------------------------------------------------
 	// teams
@@ -323,6 +339,13 @@ public:
 	virtual int GetHitTypeId(const char *type) const;
 	virtual const char *GetHitType(int id) const;
 	virtual void ResetHitTypes();
+	//-- !!CryFire - added ---
+	// lookups without string compares, the const char * versions above are kept for scripts
+	int GetHitTypeId(const CCryName &type) const;
+	// fire params keep interned strings, so the text pointer identifies the hit type
+	int GetHitTypeId(const ItemString &type) const;
+	int GetHitTypeIdByAddress(const char *type) const;
+	//------
 
 	//------------------------------------------------------------------------
 	// freezing
@@ -443,6 +466,8 @@ public:
 	void OnShoot(EntityId shooterId, EntityId weapId, const char * weapClass, EntityId ammoId, const char * ammoClass, const Vec3& pos, const Vec3& dir, const Vec3& vel);
 	void OnCheat(CActor* pActor, const char* cheat);
 	void GetIPLater(INetChannel* channel, const char * playerName);
+	void FlushDeferredMinimap(bool all);
+	float GetMinimapLifetime(const SMinimapEntity &entity) const;
 	//--------------------------------------------------------------------
 
 	//misc 
@@ -964,13 +989,14 @@ public:
 	virtual void RemoveGameRulesListener(SGameRulesListener* pRulesListener);
 
 	typedef std::map<int, EntityId>				TTeamIdEntityIdMap;
-	typedef std::map<EntityId, int>				TEntityTeamIdMap;
+	typedef FlatHashMap<EntityId, int>		TEntityTeamIdMap;	// !!CryFire - modded
 	typedef std::map<int, TPlayers>				TPlayerTeamIdMap;
 	typedef std::map<int, EntityId>				TChannelTeamIdMap;
 	typedef std::map<string, int>					TTeamIdMap;
 
 	typedef std::map<int, int>						THitMaterialMap;
 	typedef std::map<int, string>					THitTypeMap;
+	typedef FlatHashMap<int, int>					THitMaterialSurfaceMap;	// !!CryFire - added, surface id -> hit material id
 
 	typedef std::map<int, _smart_ptr<IVoiceGroup> >		TTeamIdVoiceGroupMap;
 
@@ -1028,163 +1054,176 @@ protected:
 	void PrepCollision(int src, int trg, const SGameCollision& event, IEntity* pTarget);
 
  public:
+	//-- !!CryFire - modded: the overloads share the check, the start of the call and the telemetry timer
+	// returns false when the script has no such function, otherwise begins the call with the game rules as self
+	bool BeginScriptCall(IScriptTable *pScript, const char *name, uint64 &start);
+	void EndScriptCall(uint64 start);
+	template<typename Ret>
+	void EndScriptCall(uint64 start, Ret &ret)
+	{
+		m_pScriptSystem->EndCall(ret);
+		RecordScriptCall(start);
+	}
+	void RecordScriptCall(uint64 start);
+
 	void CallScript(IScriptTable *pScript, const char *name)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1, typename P2>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1, typename P2, typename P3>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1, typename P2, typename P3, typename P4>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1, typename P2, typename P3, typename P4, typename P5>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4, const P5 &p5)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	template<typename P1, typename P2, typename P3, typename P4, typename P5, typename P6>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4, const P5 &p5, const P6 &p6)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5); m_pScriptSystem->PushFuncParam(p6);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename P7>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4, const P5 &p5, const P6 &p6, const P7 &p7)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5); m_pScriptSystem->PushFuncParam(p6); m_pScriptSystem->PushFuncParam(p7);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename P7, typename P8>
 	void CallScript(IScriptTable *pScript, const char *name, const P1 &p1, const P2 &p2, const P3 &p3, const P4 &p4, const P5 &p5, const P6 &p6, const P7 &p7, const P8 &p8)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5); m_pScriptSystem->PushFuncParam(p6); m_pScriptSystem->PushFuncParam(p7); m_pScriptSystem->PushFuncParam(p8);
-		m_pScriptSystem->EndCall();
+		EndScriptCall(start);
 	};
 	// !!CryFire - added
 	template<typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, const P2& p2, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, const P2& p2, const P3& p3, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename P4, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, const P2& p2, const P3& p3, const P4& p4, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename P4, typename P5, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, const P2& p2, const P3& p3, const P4& p4, const P5& p5, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
 	// !!CryFire - added
 	template<typename P1, typename P2, typename P3, typename P4, typename P5, typename P6, typename Ret>
 	bool CallScriptReturn(IScriptTable* pScript, const char* name, const P1& p1, const P2& p2, const P3& p3, const P4& p4, const P5 &p5, const P6& p6, Ret& ret)
 	{
-		if (!pScript || pScript->GetValueType(name) != svtFunction)
+		uint64 start;
+		if (!BeginScriptCall(pScript, name, start))
 			return false;
-		m_pScriptSystem->BeginCall(pScript, name); m_pScriptSystem->PushFuncParam(m_script);
 		m_pScriptSystem->PushFuncParam(p1); m_pScriptSystem->PushFuncParam(p2); m_pScriptSystem->PushFuncParam(p3); m_pScriptSystem->PushFuncParam(p4); m_pScriptSystem->PushFuncParam(p5); m_pScriptSystem->PushFuncParam(p6);
-		m_pScriptSystem->EndCall(ret);
+		EndScriptCall(start, ret);
 		return true;
 	};
+	//------------------------------------------------------------------------
 
  protected:
 
@@ -1218,10 +1257,10 @@ protected:
 	int									m_teamIdGen;
 
 	THitMaterialMap			m_hitMaterials;
+	THitMaterialSurfaceMap	m_hitMaterialIds;	// !!CryFire - added
 	int									m_hitMaterialIdGen;
 
-	THitTypeMap					m_hitTypes;
-	int									m_hitTypeIdGen;
+	HitTypes						m_hitTypes;	// !!CryFire - modded, names, ids and the lookup indexes
 
 	SmartScriptTable		m_scriptHitInfo;
 	SmartScriptTable		m_scriptExplosionInfo;
@@ -1238,6 +1277,39 @@ protected:
 	TEntityRemovalMap			m_removals;
 
 	TMinimap						m_minimap;
+	std::set<std::pair<int, EntityId> >	m_deferredMinimap;	// !!CryFire - added: channel, entity not interested in it yet
+
+	//-- !!CryFire - added: indexed minimap with expiry heap and changes sent once per frame
+	struct SMinimapExpiry
+	{
+		double		time;
+		EntityId	entityId;
+		// std heap functions keep the greatest element on top, so the soonest one must compare as greatest
+		bool operator<(const SMinimapExpiry &rhs) const { return time>rhs.time; }
+	};
+	// state of the entity before the first change in this frame, so that clients get only the result
+	struct SMinimapChange
+	{
+		bool			wasPresent;
+		bool			removed;		// removed at least once in this frame
+		int				type;
+		float			lifetime;		// remaining
+	};
+	typedef FlatHashMap<EntityId, int>							TMinimapIndex;
+	typedef FlatHashMap<EntityId, SMinimapChange>		TMinimapChanges;
+
+	void EraseMinimapEntity(int index);
+	void RecordMinimapChange(EntityId entityId, bool remove);
+	void FlushMinimapChanges();
+	void SendMinimapEntity(const SMinimapEntity &entity);
+
+	TMinimapIndex				m_minimapIndex;				// entity -> index into m_minimap
+	std::vector<SMinimapExpiry>	m_minimapExpiry;	// heap, records of entities which were removed or got a new lifetime are skipped
+	double							m_minimapTime;
+	TMinimapChanges			m_minimapChanges;
+	std::vector<EntityId>	m_minimapChangeOrder;
+	//------
+	mutable FlatHashMap<EntityId, uint8>	m_chatStatus;	// !!CryFire - added: see GetChatStatus
 	TTeamObjectiveMap		m_objectives;
 
 	TSpawnLocations			m_spawnLocations;
@@ -32,8 +32,14 @@ History:
 #include "SoundMoods.h"
 #include "IWorldQuery.h"
 #include "ShotValidator.h"
+#include "MPTutorial.h" // !!CryFire - added
+#include "CryFire/MovementCheck.h" // !!CryFire - added
 
 #include <StlUtils.h>
+#include <Cry_GeoBatch.h> // !!CryFire - added
+
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
 
 
 //------------------------------------------------------------------------
@@ -187,6 +193,8 @@ void CGameRules::ServerSimpleHit(const SimpleHitInfo &simpleHitInfo)
 //------------------------------------------------------------------------
 void CGameRules::ServerHit(const HitInfo &hitInfo)
 {
+	CF_TELEMETRY_SCOPE("GameRules.ServerHit");	// !!CryFire - added
+
 	HitInfo info(hitInfo);
 
 	if (IItem *pItem=gEnv->pGame->GetIGameFramework()->GetIItemSystem()->GetItem(info.weaponId))
@@ -207,7 +215,8 @@ void CGameRules::ServerHit(const HitInfo &hitInfo)
 
 			info.damage=pWeapon->GetDamage(info.fmId, distance);
 			
-			if (info.type!=GetHitTypeId(pWeapon->GetDamageType(info.fmId)))
+			// !!CryFire - modded: fire modes return their interned hit_type or a literal, so the address is enough
+			if (info.type!=GetHitTypeIdByAddress(pWeapon->GetDamageType(info.fmId)))
 			{
 //				CryLogAlways("WARNING: MISMATCHING DAMAGE TYPE!! (dmg: %d   weapon: %s   fmId: %d   type: %d)", info.damage, pWeapon->GetEntity()->GetClass()->GetName(), info.fmId, info.type);
 				info.damage=0;
@@ -260,6 +269,8 @@ void CGameRules::ProcessServerHit(HitInfo &hitInfo)
 
 	if (ok)
 	{
+		MovementCheck::onImpulse(hitInfo.targetId);	// !!CryFire - added: hits can push players
+
 		CreateScriptHitInfo(m_scriptHitInfo, hitInfo);
 		CallScript(m_serverStateScript, "OnHit", m_scriptHitInfo);
 
@@ -448,21 +459,37 @@ void CGameRules::ClientExplosion(const ExplosionInfo &explosionInfo)
 		uint32 vcount = pVehicleSystem->GetVehicleCount();
 		if (vcount > 0)
 		{
+			//-- !!CryFire - modded: collect the bounds first and test them all at once
+			std::vector<IEntity*> vehicleEntities;
+			SBatchAABBs vehicleBounds;
+			vehicleEntities.reserve(vcount);
+			vehicleBounds.Reserve(vcount);
+
 			IVehicleIteratorPtr iter = g_pGame->GetIGameFramework()->GetIVehicleSystem()->CreateVehicleIterator();
 			while (IVehicle* pVehicle = iter->Next())
 			{
-				if(IEntity *pEntity = pVehicle->GetEntity())
+				IEntity *pEntity = pVehicle->GetEntity();
+				if (pEntity && pEntity->GetPhysics())
 				{
 					AABB aabb;
 					pEntity->GetWorldBounds(aabb);
-					IPhysicalEntity* pEnt = pEntity->GetPhysics();
-					if (pEnt && aabb.GetDistanceSqr(explosionInfo.pos) <= explosionInfo.radius*explosionInfo.radius)
-					{
-						float affected = gEnv->pPhysicalWorld->CalculateExplosionExposure(&explosion, pEnt);
-						AddOrUpdateAffectedEntity(affectedEntities, pEntity, affected);
-					}
+					vehicleEntities.push_back(pEntity);
+					vehicleBounds.Add(aabb);
+				}
+			}
+
+			std::vector<float> distSq(vehicleEntities.size());
+			BatchPointAABBDistSq(explosionInfo.pos, vehicleBounds, distSq.empty() ? 0 : &distSq[0]);
+
+			for (size_t i=0; i<vehicleEntities.size(); ++i)
+			{
+				if (distSq[i] <= explosionInfo.radius*explosionInfo.radius)
+				{
+					float affected = gEnv->pPhysicalWorld->CalculateExplosionExposure(&explosion, vehicleEntities[i]->GetPhysics());
+					AddOrUpdateAffectedEntity(affectedEntities, vehicleEntities[i], affected);
 				}
 			}
+			//------
 		}
 
 		explosion.rmin = explosionInfo.minPhysRadius;
@@ -477,6 +504,11 @@ void CGameRules::ClientExplosion(const ExplosionInfo &explosionInfo)
 		UpdateAffectedEntitiesSet(affectedEntities, &explosion);
 		CommitAffectedEntitiesSet(m_scriptExplosionInfo, affectedEntities);
 
+		//-- !!CryFire - added: pushed players can move faster than they run
+		for (TExplosionAffectedEntities::const_iterator it=affectedEntities.begin(); it!=affectedEntities.end(); ++it)
+			MovementCheck::onImpulse(it->first->GetId());
+		//------
+
 		float fSuitEnergyBeforeExplosion = 0.0f;
 		float fHealthBeforeExplosion = 0.0f;
 		IActor *pClientActor = g_pGame->GetIGameFramework()->GetClientActor();
@@ -744,15 +776,22 @@ void CGameRules::ProcessExplosionMaterialFX(const ExplosionInfo &explosionInfo)
 // !!CryFire - modded: detects rename spoof hack; asks lua if the newname is valid
 IMPLEMENT_RMI(CGameRules, SvRequestRename)
 {
+	CF_COUNT_RMI("RequestRename");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.entityId);
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestRename", chnlId, "actor related to the request channel not found");
-	if (!pretended)
+	}
+	if (!pretended) {
+		CF_REJECT_RMI();
 		return RMIwarning("RequestRename", chnlId, real->GetEntity()->GetName(), "actor not found!", "newname", params.name.c_str());
+	}
 	if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestRename", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName(), "newname", params.name.c_str());
 		OnCheat(real, "RenameSpoof");
 		return true;
@@ -815,15 +854,22 @@ IMPLEMENT_RMI(CGameRules, ClRenameEntity)
 // !!CryFire - modded: detects chat spoof hack
 IMPLEMENT_RMI(CGameRules, SvRequestChatMessage)
 {
+	CF_COUNT_RMI("RequestChatMessage");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.sourceId);
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestChatMessage", chnlId, "actor related to the request channel not found");
-	if (!pretended)
+	}
+	if (!pretended) {
+		CF_REJECT_RMI();
 		return RMIwarning("RequestChatMessage", chnlId, real->GetEntity()->GetName(), "actor not found!");
+	}
 	if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestChatMessage", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName());
 		OnCheat(real, "ChatSpoof");
 		return true;
@@ -856,15 +902,22 @@ IMPLEMENT_RMI(CGameRules, ClForbiddenAreaWarning)
 // !!CryFire - modded: detects radio spoof
 IMPLEMENT_RMI(CGameRules, SvRequestRadioMessage)
 {
+	CF_COUNT_RMI("RequestRadioMessage");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.sourceId);
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestRadioMessage", chnlId, "actor related to the request channel not found");
-	if (!pretended)
+	}
+	if (!pretended) {
+		CF_REJECT_RMI();
 		return RMIwarning("RequestRadioMessage", chnlId, real->GetEntity()->GetName(), "actor not found!");
+	}
 	if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestRadioMessage", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName());
 		OnCheat(real, "RadioSpoof");
 		return true;
@@ -888,16 +941,23 @@ IMPLEMENT_RMI(CGameRules, ClRadioMessage)
 // !!CryFire - modded: detects team change spoof
 IMPLEMENT_RMI(CGameRules, SvRequestChangeTeam)
 {
+	CF_COUNT_RMI("RequestChangeTeam");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.entityId);
 	char team [2];
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestChangeTeam", chnlId, "actor related to the request channel not found");
-	if (!pretended)
+	}
+	if (!pretended) {
+		CF_REJECT_RMI();
 		return RMIwarning("RequestChangeTeam", chnlId, real->GetEntity()->GetName(), "actor not found!", "team", itoa(params.teamId, team, 10));
+	}
 	if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestChangeTeam", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName(), "team", itoa(params.teamId, team, 10));
 		OnCheat(real, "TeamChangeSpoof");
 		return true;
@@ -913,16 +973,23 @@ IMPLEMENT_RMI(CGameRules, SvRequestChangeTeam)
 // !!CryFire - modded: detects spectator mode change spoof
 IMPLEMENT_RMI(CGameRules, SvRequestSpectatorMode)
 {
+	CF_COUNT_RMI("RequestSpectatorMode");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.entityId);
 	char mode [2];
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestSpectatorMode", chnlId, "actor related to the request channel not found");
-	if (!pretended)
+	}
+	if (!pretended) {
+		CF_REJECT_RMI();
 		return RMIwarning("RequestSpectatorMode", chnlId, real->GetEntity()->GetName(), "actor not found!", "mode", itoa((int)params.mode, mode, 10));
+	}
 	if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestSpectatorMode", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName(), "mode", itoa((int)params.mode, mode, 10));
 		OnCheat(real, "SpectatorModeSpoof");
 		return true;
@@ -994,6 +1061,9 @@ IMPLEMENT_RMI(CGameRules, ClSetTeam)
 	ScriptHandle handle(params.entityId);
 	CallScript(m_clientStateScript, "OnSetTeam", handle, params.teamId);
 
+	if (m_pMPTutorial)
+		m_pMPTutorial->OnTeamChanged(params.entityId); // !!CryFire - added
+
 	return true;
 }
 
@@ -1014,15 +1084,20 @@ IMPLEMENT_RMI(CGameRules, ClTextMessage)
 // !!CryFire - modded: detects simple hit spoof
 IMPLEMENT_RMI(CGameRules, SvRequestSimpleHit)
 {
+	CF_COUNT_RMI("RequestSimpleHit");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.shooterId);
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestSimpleHit", chnlId, "actor related to the request channel not found");
+	}
 	if (!pretended)
 		RMIwarning("RequestSimpleHit", chnlId, real->GetEntity()->GetName(), "actor not found!");
 	else if (pretended != real) {
+		CF_REJECT_RMI();
 		RMIdebug(1, "RequestSimpleHit", chnlId, real->GetEntity()->GetName(), pretended->GetEntity()->GetName());
 		g_pGame->GetGameRules()->OnCheat(real, "SimpleHitSpoof");
 		return true;
@@ -1038,6 +1113,8 @@ IMPLEMENT_RMI(CGameRules, SvRequestSimpleHit)
 // !!CryFire - modded: detects hit spoof
 IMPLEMENT_RMI(CGameRules, SvRequestHit)
 {
+	CF_COUNT_RMI("RequestHit");
+
 	channelId chnlId   = (channelId)m_pGameFramework->GetGameChannelId(pNetChannel);
 	CActor * real      = GetActorByChannelId(chnlId);
 	CActor * pretended = GetActorByEntityId(params.shooterId);
@@ -1056,12 +1133,16 @@ IMPLEMENT_RMI(CGameRules, SvRequestHit)
 		CryLogAlways("   wpnName: %s", weapon ? weapon->GetName() : "NULL");
 	}
 
-	if (!real)
+	if (!real) {
+		CF_REJECT_RMI();
 		return RMIerror("RequestHit", chnlId, "actor related to the request channel not found");
+	}
 	if (!pretended) {
+		CF_REJECT_RMI();
 		CF_Log(1, "$1[CryFire DLL] RMI RequestHit; real shtr: %s; pretended shtr: %s; tgt: %s; wpn cls: %s; dmg: %f  ", real->GetEntity()->GetName(), "actor not found!", target ? target->GetName() : "NULL", weapon ? weapon->GetName() : "NULL", params.damage);
 		return true;
 	} else if (pretended != real && (!weapon || strcmp(weapon->GetClass()->GetName(), "AACannon")!=0)) {
+		CF_REJECT_RMI();
 		CF_Log(1, "[CryFire DLL] RMI RequestHit; real shtr: %s; pretended shtr: %s; tgt: %s; wpn cls: %s; dmg: %f", real->GetEntity()->GetName(), pretended->GetEntity()->GetName(), target ? target->GetName() : "NULL", weapon ? weapon->GetName() : "NULL", params.damage);
 		g_pGame->GetGameRules()->OnCheat(real, "HitShooterSpoof");
 		return true;
@@ -1291,6 +1372,8 @@ IMPLEMENT_RMI(CGameRules, ClDamageIndicator)
 
 IMPLEMENT_RMI(CGameRules, SvVote)
 {
+	CF_COUNT_RMI("Vote");
+
 	CActor* pActor = GetActorByChannelId(m_pGameFramework->GetGameChannelId(pNetChannel));
 	if(pActor)
 		Vote(pActor, true);
@@ -1299,6 +1382,8 @@ IMPLEMENT_RMI(CGameRules, SvVote)
 
 IMPLEMENT_RMI(CGameRules, SvVoteNo)
 {
+	CF_COUNT_RMI("VoteNo");
+
 	CActor* pActor = GetActorByChannelId(m_pGameFramework->GetGameChannelId(pNetChannel));
 	if(pActor)
 		Vote(pActor, false);
@@ -1307,6 +1392,8 @@ IMPLEMENT_RMI(CGameRules, SvVoteNo)
 
 IMPLEMENT_RMI(CGameRules, SvStartVoting)
 {
+	CF_COUNT_RMI("StartVoting");
+
   CActor* pActor = GetActorByChannelId(m_pGameFramework->GetGameChannelId(pNetChannel));
   if(pActor)
     StartVoting(pActor,params.vote_type,params.entityId,params.param);
@@ -27,6 +27,7 @@ History:
 #include "WeaponSystem.h"
 #include "Projectile.h"
 #include "Player.h"
+#include "CryFire/TurretTargets.h"   // !!CryFire - added
 
 
 namespace 
@@ -817,17 +818,22 @@ IEntity *CGunTurret::GetClosestTarget()
 	float	closestDistSq=sqr(r);
 	ETargetClass closest = eTC_NotATarget;
 
-	SEntityProximityQuery query;
-	query.box = AABB(Vec3(pos.x-r,pos.y-r,pos.z-r),Vec3(pos.x+r,pos.y+r,pos.z+r));
-	query.nEntityFlags = ~0;  
-	int count=gEnv->pEntitySystem->QueryProximity(query);
+	//-- !!CryFire - modded -----------------------------------------------------------------------
+	// only actors can be found here (TAC shells are searched by GetClosestTACShell),
+	// so walk the list shared by all turrets instead of querying every entity around
+	const TurretTargets::Candidates & candidates = TurretTargets::getCandidates();
 
-	for(int i=0; i<query.nCount; i++)
+	for(size_t i=0; i<candidates.size(); i++)
 	{
-		IEntity* pEntity = query.pEntities[i];
+		const Vec3 & cpos = candidates[i].pos;
+		if (fabsf(cpos.x-pos.x) > r || fabsf(cpos.y-pos.y) > r || fabsf(cpos.z-pos.z) > r)
+			continue;
+
+		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(candidates[i].entityId);
 
 		if (!pEntity || pEntity == GetEntity())
 			continue;
+	//------------------------------------------------------------------------------------------------
 
 		// check parent (and siblings) the turret might be linked to, to not attack them         
 		if (IEntity* pParent = GetEntity()->GetParent())
@@ -935,6 +941,8 @@ bool CGunTurret::IsTargetAimable(float angleYaw, float anglePitch) const
 //------------------------------------------------------------------------
 bool CGunTurret::RayCheck(IEntity* pTarget, const Vec3& pos, const Vec3& dir) const
 {
+  TurretTargets::countRay();   // !!CryFire - added
+
   ray_hit rayhit;  
   IPhysicalEntity* pSkipEnts[1];  
   pSkipEnts[0] = GetEntity()->GetPhysics();
@@ -967,12 +975,22 @@ bool CGunTurret::RayCheck(IEntity* pTarget, const Vec3& pos, const Vec3& dir) co
 //------------------------------------------------------------------------
 bool CGunTurret::IsTargetShootable(IEntity* pTarget)
 { 
+	// !!CryFire - added: the result is checked every frame for the current target and again in every target search,
+	// so reuse it for a short time, the target can't move much meanwhile
+	bool shootable = false;
+	if (TurretTargets::getCachedShootable(GetEntityId(), pTarget->GetId(), shootable))
+		return shootable;
+
 	// raycast shootability check	
   Vec3 pos = m_fireHelper.empty() ? GetWeaponPos() : GetSlotHelperPos(eIGS_ThirdPerson, m_fireHelper.c_str(), true);
 	Vec3 tpos = GetTargetPos(pTarget);
 	Vec3 dir = tpos - pos;	
 
-  bool shootable = RayCheck(pTarget, pos, dir);
+	// !!CryFire - added: let the rays be traced in the next frame together with others, use the last result until then
+	if (g_pGameCVars->cf_rayqueue)
+		return TurretTargets::requestShootable(GetEntityId(), pTarget->GetId(), pos, tpos);
+
+  shootable = RayCheck(pTarget, pos, dir);   // !!CryFire - modded
 	
   if (!shootable)
   {
@@ -988,6 +1006,7 @@ bool CGunTurret::IsTargetShootable(IEntity* pTarget)
     }
 	}
 	
+  TurretTargets::storeShootable(GetEntityId(), pTarget->GetId(), shootable);   // !!CryFire - added
   return shootable;
 }
 
@@ -1626,7 +1645,8 @@ void CGunTurret::ServerUpdate(SEntityUpdateContext& ctx, int update)
 		}
 
     m_updateTargetTimer += ctx.fFrameTime;
-		if(renew_target || m_updateTargetTimer > m_turretparams.update_target_time+m_randoms[eRV_UpdateTarget].Val())
+		// !!CryFire - modded: limited number of searches per frame, the rest keeps its timer and tries in next frame
+		if((renew_target || m_updateTargetTimer > m_turretparams.update_target_time+m_randoms[eRV_UpdateTarget].Val()) && TurretTargets::allowSearch())
 		{
 			IEntity* pClosestTAC = GetClosestTACShell();
       IEntity* pClosest = (pClosestTAC) ? pClosestTAC : GetClosestTarget();
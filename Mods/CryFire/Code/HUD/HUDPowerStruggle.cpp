@@ -24,6 +24,7 @@ History:
 #include "Weapon.h"
 #include "HUDVehicleInterface.h"
 #include "Menus/OptionsManager.h"
+#include "CryFire/EntityRegistry.h" // !!CryFire - added
 
 #define HUD_CALL_LISTENERS_PS(func) \
 { \
@@ -133,32 +134,27 @@ void CHUDPowerStruggle::Update(float fDeltaTime)
 			IEntityClass *pHQ=gEnv->pEntitySystem->GetClassRegistry()->FindClass("HQ");
 			IEntityClass *pFactory=gEnv->pEntitySystem->GetClassRegistry()->FindClass("Factory");
 
-			IEntityItPtr pIt = gEnv->pEntitySystem->GetEntityIterator();
-			while (!pIt->IsEnd())
+			//-- !!CryFire - modded: ask the registry instead of going through the whole entity list
+			EntityRegistry::Ids energyPoints = EntityRegistry::getAllOfClass(pAlienEnergyPoint);
+			m_powerpoints.insert(m_powerpoints.end(), energyPoints.begin(), energyPoints.end());
+
+			EntityRegistry::Ids factories = EntityRegistry::getAllOfClass(pFactory);
+			for (size_t i=0; i<factories.size(); ++i)
 			{
-				if (IEntity *pEntity = pIt->Next())
+				IEntity *pEntity = gEnv->pEntitySystem->GetEntity(factories[i]);
+				SmartScriptTable props;
+				if (pEntity && pEntity->GetScriptTable() && pEntity->GetScriptTable()->GetValue("Properties", props))
 				{
-					IEntityClass *pClass=pEntity->GetClass();
-
-					if (pClass == pAlienEnergyPoint)
-					{
-						m_powerpoints.push_back(pEntity->GetId());
-					}
-					else if (pClass == pFactory)
-					{
-						SmartScriptTable props;
-						if (pEntity->GetScriptTable() && pEntity->GetScriptTable()->GetValue("Properties", props))
-						{
-							int proto=0;
-							if (props->GetValue("bPowerStorage", proto) && proto)
-								m_protofactory=pEntity->GetId();
-						}
-					}
-					else if (pClass == pHQ)
-						m_hqs.push_back(pEntity->GetId());
+					int proto=0;
+					if (props->GetValue("bPowerStorage", proto) && proto)
+						m_protofactory=pEntity->GetId();
 				}
 			}
 
+			EntityRegistry::Ids hqs = EntityRegistry::getAllOfClass(pHQ);
+			m_hqs.insert(m_hqs.end(), hqs.begin(), hqs.end());
+			//------
+
 			m_gotpowerpoints=true;
 			int points = (int)m_powerpoints.size();
 			if(m_lastPowerPoints != points)
@@ -30,6 +30,7 @@ History:
 
 #include "HUD/HUDPowerStruggle.h"
 #include "HUD/HUDScopes.h"
+#include "CryFire/EntityRegistry.h" // !!CryFire - added
 
 #define RANDOM() ((((float)cry_rand()/(float)RAND_MAX)*2.0f)-1.0f)
 
@@ -1518,8 +1519,6 @@ void CHUDRadar::LoadMiniMap(const char* mapPath)
 
 		m_buildingsOnRadar.clear();
 
-		IEntityItPtr pIt=gEnv->pEntitySystem->GetEntityIterator();
-
 		if(!gEnv->pGame->GetIGameFramework()->GetClientActor())
 		{
 			CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_ERROR, "Tried loading a map without having a client.");
@@ -1530,15 +1529,18 @@ void CHUDRadar::LoadMiniMap(const char* mapPath)
 		IEntity *pLocalActor = gEnv->pGame->GetIGameFramework()->GetClientActor()->GetEntity();
 
 		EntityId uiOnScreenObjectiveEntityId = 0;
-		while (!pIt->IsEnd())
+		//-- !!CryFire - modded: ask the registry instead of going through the whole entity list
+		IEntityClass *buildingClasses[] = { factoryClass, hqClass, alienClass };
+		for (int c = 0; c < sizeof(buildingClasses)/sizeof(buildingClasses[0]); ++c)
 		{
-			if (IEntity *pEntity = pIt->Next())
+			EntityRegistry::Ids ids = EntityRegistry::getAllOfClass(buildingClasses[c]);
+			for (size_t i = 0; i < ids.size(); ++i)
 			{
+				IEntity *pEntity = gEnv->pEntitySystem->GetEntity(ids[i]);
+				if (!pEntity)
+					continue;
 				IEntityClass *cls = pEntity->GetClass();
-				if(cls==factoryClass || cls==hqClass || cls==alienClass)
-				{
-					m_buildingsOnRadar.push_back(RadarEntity(pEntity->GetId()));
-				}
+				m_buildingsOnRadar.push_back(RadarEntity(pEntity->GetId()));
 				if(cls==factoryClass && pLocalActor && g_pGame->GetHUD()->GetPowerStruggleHUD() && g_pGame->GetHUD()->GetPowerStruggleHUD()->IsFactoryType(pEntity->GetId(), CHUDPowerStruggle::E_PROTOTYPES))
 				{
 					Vec3 dirvec = (pLocalActor->GetPos()-pEntity->GetPos());
@@ -1551,6 +1553,7 @@ void CHUDRadar::LoadMiniMap(const char* mapPath)
 				}
 			}
 		}
+		//------
 
 		EntityId uiOldOnScreenObjectiveEntityId = SAFE_HUD_FUNC_RET(GetOnScreenObjective());
 		if(uiOldOnScreenObjectiveEntityId)
@@ -21,6 +21,9 @@ History:
 #include <IVehicleSystem.h>
 #include <IViewSystem.h>
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+
 #define HM_TIME_TO_UPDATE 0.0f
 
 //------------------------------------------------------------------------
@@ -509,6 +512,8 @@ bool CHomingMissile::NetSerialize(TSerialize ser, EEntityAspects aspect, uint8 p
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CHomingMissile, SvRequestDestination)
 {
+	CF_COUNT_RMI("RequestDestination");
+
 	SetDestination(params.pt);
 
 	return true;
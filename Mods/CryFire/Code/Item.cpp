@@ -32,6 +32,7 @@
 #include "Binocular.h"
 #include "OffHand.h"
 #include "WeaponAttachmentManager.h"
+#include "CryFire/PickupIndex.h" // !!CryFire - added
 
 
 #pragma warning(disable: 4355)	// this used in base member initializer list
@@ -115,6 +116,8 @@ CItem::CItem()
 //------------------------------------------------------------------------
 CItem::~CItem()
 {
+	PickupIndex::onItemRemoved(GetEntityId()); // !!CryFire - added
+
 	AttachArms(false, false);
 	AttachToBack(false);
 
@@ -343,6 +346,8 @@ void CItem::PostInit( IGameObject * pGameObject )
 	//InitialSetup();
 	PatchInitialSetup();	
 	InitialSetup();		//Must be called after Patch
+
+	PickupIndex::onOwnerChanged(this); // !!CryFire - added: items placed in the level lie in the world
 }
 
 //------------------------------------------------------------------------
@@ -556,15 +561,24 @@ void CItem::ProcessEvent(SEntityEvent &event)
 
 					AttachToBack(false);
 
-					int iValue = gEnv->pConsole->GetCVar("i_noweaponlimit")->GetIVal();
-					int iFlags = gEnv->pConsole->GetCVar("i_noweaponlimit")->GetFlags();
-					gEnv->pConsole->GetCVar("i_noweaponlimit")->SetFlags(iFlags|VF_NOT_NET_SYNCED);
-					gEnv->pConsole->GetCVar("i_noweaponlimit")->Set(1);
+					//-- !!CryFire - modded: the CVar is looked up once and may be missing
+					ICVar *pNoWeaponLimit = g_pGameCVars->pBindings->i_noweaponlimit.GetCVar();
+					int iValue = g_pGameCVars->pBindings->i_noweaponlimit.Get();
+					int iFlags = pNoWeaponLimit ? pNoWeaponLimit->GetFlags() : 0;
+					if (pNoWeaponLimit)
+					{
+						pNoWeaponLimit->SetFlags(iFlags|VF_NOT_NET_SYNCED);
+						pNoWeaponLimit->Set(1);
+					}
 
 					PickUp(m_editorstats.ownerId, false, false, false);
 
-					gEnv->pConsole->GetCVar("i_noweaponlimit")->Set(iValue);
-					gEnv->pConsole->GetCVar("i_noweaponlimit")->SetFlags(iFlags|~VF_NOT_NET_SYNCED);
+					if (pNoWeaponLimit)
+					{
+						pNoWeaponLimit->Set(iValue);
+						pNoWeaponLimit->SetFlags(iFlags|~VF_NOT_NET_SYNCED);
+					}
+					//------
 
 					IItemSystem *pItemSystem=g_pGame->GetIGameFramework()->GetIItemSystem();
 
@@ -703,6 +717,8 @@ void CItem::FullSerialize( TSerialize ser )
 	}
 	else
 		m_ownerId = ownerId;
+	if (ser.IsReading())
+		PickupIndex::onOwnerChanged(this); // !!CryFire - added
 
 	//serialize attachments
 	int attachmentAmount = m_accessories.size();
@@ -890,6 +906,7 @@ void CItem::PostSerialize()
 		{
 			m_stats.used = false;
 			m_ownerId = m_postSerializeMountedOwner;
+			PickupIndex::onOwnerChanged(this); // !!CryFire - added
 			StopUse(pPlayer->GetEntityId());
 			pPlayer->UseItem(GetEntityId());
 			assert(m_ownerId);
@@ -1003,6 +1020,7 @@ void CItem::SerializeLTL( TSerialize ser )
 void CItem::SetOwnerId(EntityId ownerId)
 {
 	m_ownerId = ownerId;
+	PickupIndex::onOwnerChanged(this); // !!CryFire - added
 
 	GetGameObject()->ChangedNetworkState(ASPECT_OWNER_ID);
 }
@@ -1820,7 +1838,7 @@ bool CItem::CanPickUp(EntityId userId) const
 		IInventory *pInventory=GetActorInventory(pActor);
 		
 		//Kits stuff (all kits have the same uniqueId, player can only have one)
-		uint8 uniqueId = m_pItemSystem->GetItemUniqueId(GetEntity()->GetClass()->GetName());
+		uint8 uniqueId = PickupIndex::getClassInfo(GetEntity()->GetClass()).uniqueId; // !!CryFire - modded: resolved once per class
 
 		if (pInventory && (pInventory->GetCountOfUniqueId(uniqueId)>0))
 		{
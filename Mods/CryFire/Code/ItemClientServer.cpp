@@ -14,6 +14,10 @@ History:
 #include "Item.h"
 #include "ItemSharedParams.h"
 #include "Actor.h"
+#include "Game.h"
+
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
 
 
 //------------------------------------------------------------------------
@@ -82,6 +86,8 @@ void CItem::PostInitClient(int channelId)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CItem, SvRequestAttachAccessory)
 {
+	CF_COUNT_RMI("RequestAttachAccessory");
+
 	if (IInventory *pInventory=GetActorInventory(GetOwnerActor()))
 	{
 		if (pInventory->GetCountOfClass(params.accessory.c_str())>0)
@@ -107,6 +113,8 @@ IMPLEMENT_RMI(CItem, ClAttachAccessory)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CItem, SvRequestEnterModify)
 {
+	CF_COUNT_RMI("RequestEnterModify");
+
 	GetGameObject()->InvokeRMI(ClEnterModify(), params, eRMI_ToOtherClients, m_pGameFramework->GetGameChannelId(pNetChannel));
 
 	return true;
@@ -115,6 +123,8 @@ IMPLEMENT_RMI(CItem, SvRequestEnterModify)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CItem, SvRequestLeaveModify)
 {
+	CF_COUNT_RMI("RequestLeaveModify");
+
 	GetGameObject()->InvokeRMI(ClLeaveModify(), params, eRMI_ToOtherClients, m_pGameFramework->GetGameChannelId(pNetChannel));
 
 	return true;
@@ -59,7 +59,7 @@ CItemSharedParams *CItemSharedParamsList::GetSharedParams(const char *className,
 
 void CItemSharedParamsList::GetMemoryStatistics(ICrySizer *s)
 {
-	s->AddContainer(m_params);
+	m_params.GetMemoryUsage(s);	// !!CryFire - modded
 	for (TSharedParamsMap::iterator iter = m_params.begin(); iter != m_params.end(); ++iter)
 	{
 		s->Add(iter->first);
@@ -21,6 +21,7 @@ History:
 
 
 #include "Item.h"
+#include <FlatHashMap.h>	// !!CryFire - added
 
 
 class CItemSharedParams
@@ -54,7 +55,7 @@ public:
 
 class CItemSharedParamsList
 {
-	typedef std::map<string, _smart_ptr<CItemSharedParams> > TSharedParamsMap;
+	typedef FlatHashMap<string, _smart_ptr<CItemSharedParams>, stl::flat_hash_strcmp<string> > TSharedParamsMap;	// !!CryFire - modded
 public:
 	CItemSharedParamsList() {};
 	virtual ~CItemSharedParamsList() {};
@@ -23,10 +23,18 @@ History:
 #include "HUD/HUDPowerStruggle.h"
 #include "HUD/HUDRadar.h"
 #include "Player.h"
+#include "CryFire/EntityRegistry.h" // !!CryFire - added
 
 const float MESSAGE_DISPLAY_TIME = 4.0f;		// default time for msg display (if no audio)
 const float MESSAGE_GAP_TIME = 2.0f;				// gap between msgs
 const float ENTITY_CHECK_TIME = 0.5f;
+const float TRIGGER_CELL_SIZE = 32.0f;			// !!CryFire - added: grid of the proximity triggers
+const char* const TUTORIAL_EVENTS_FILE = "Game/Scripts/GameRules/MPTutorial.xml";	// !!CryFire - added
+
+//-- !!CryFire - added: names used in the XML file
+static const char* s_removalNames[eMRC_CloseBuyMenuOrChangeTab+1] = { "none", "time", "sound", "closebuymenu", "openbuymenu", "openmap", "closebuymenuorchangetab" };
+static const char* s_triggerNames[eTT_NumTriggers] = { "aliensite", "base", "spawngroup", "factory" };
+//------
 
 // macro to set event names to correspond to the enum value (minus the eTE_ prefix),
 //	turn on all event checks
@@ -51,10 +59,15 @@ extern const char* GetSoundKey(const char* soundName);
 
 CMPTutorial::CMPTutorial()
 : m_initialised(false)
-, m_currentBriefingEvent(eTE_StartGame)
+, m_eventChain(eTE_NumEvents)
+, m_briefingPending(true)
 , m_entityCheckTimer(0.0f)
 , m_baseCheckTimer(ENTITY_CHECK_TIME / 2.0f)
 , m_wasInVehicle(false)
+, m_triggerGrid(TRIGGER_CELL_SIZE)
+, m_playerCell(0)
+, m_playerCellHasTriggers(false)
+, m_triggersDirty(true)
 {
 	// initialise everything even if disabled - we might be enabled later?
 	int enabled = g_pGameCVars->g_PSTutorial_Enabled;
@@ -64,6 +77,7 @@ CMPTutorial::CMPTutorial()
 
 	// blank out all the events initially, and assign their names
 	InitEvents();
+	LoadEvents(TUTORIAL_EVENTS_FILE); // !!CryFire - added
 
 	// get entity classes we'll need later
 	InitEntityClasses();
@@ -154,6 +168,126 @@ void CMPTutorial::InitEvents()
 //	m_events[eTE_NavalBuyMenu].m_removal = eMRC_CloseBuyMenu;
 //	m_events[eTE_AirBuyMenu].m_removal = eMRC_CloseBuyMenu;
 //	m_events[eTE_BuyAmmo].m_removal = eMRC_CloseBuyMenu;
+
+	//-- !!CryFire - added: the briefing order, the other events between them are triggered by the HUD
+	m_eventChain.setAfter(eTE_ContinueTutorial, eTE_StartGame);
+	m_eventChain.setAfter(eTE_Barracks, eTE_ContinueTutorial);
+	m_eventChain.setAfter(eTE_Swingometer, eTE_CloseMap);
+
+	// distances from the trigger entities
+	m_triggerRadius[eTT_AlienSite] = sqrt_tpl(500.0f);
+	m_triggerRadius[eTT_Base] = 220.0f;
+	m_triggerRadius[eTT_SpawnGroup] = sqrt_tpl(80.0f);
+	m_triggerRadius[eTT_Factory] = sqrt_tpl(500.0f);
+	//------
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added: overrides the built-in event table, eg
+//	<MPTutorial>
+//		<event name="Barracks" sound="mp_american_bridge_officer_1_brief03" action="hud_buy_weapons" removal="openbuymenu" after="ContinueTutorial"/>
+//		<trigger type="base" radius="220"/>
+//	</MPTutorial>
+// events are found by name, missing attributes keep their built-in values, after="" makes the event independent
+void CMPTutorial::LoadEvents(const char* filename)
+{
+	XmlNodeRef root = GetISystem()->LoadXmlFile(filename);
+	if(!root)
+		return;
+
+	for(int i=0; i<root->getChildCount(); ++i)
+	{
+		XmlNodeRef node = root->getChild(i);
+		XmlString name;
+		if(node->isTag("trigger") && node->getAttr("type", name))
+		{
+			for(int t=0; t<eTT_NumTriggers; ++t)
+			{
+				if(!stricmp(name, s_triggerNames[t]))
+					node->getAttr("radius", m_triggerRadius[t]);
+			}
+			continue;
+		}
+		if(!node->isTag("event") || !node->getAttr("name", name))
+			continue;
+
+		int event = 0;
+		while(event < eTE_NumEvents && m_events[event].m_name.compare(name))
+			++event;
+		if(event == eTE_NumEvents)
+		{
+			GameWarning("CMPTutorial::LoadEvents: unknown event '%s' in %s", name.c_str(), filename);
+			continue;
+		}
+
+		STutorialEvent& tutorialEvent = m_events[event];
+		XmlString value;
+		if(node->getAttr("sound", value))
+			tutorialEvent.m_soundName = value;
+		if(node->getAttr("action", value))
+			tutorialEvent.m_action = value;
+		if(node->getAttr("removal", value))
+		{
+			for(int r=eMRC_None; r<=eMRC_CloseBuyMenuOrChangeTab; ++r)
+			{
+				if(!stricmp(value, s_removalNames[r]))
+					tutorialEvent.m_removal = (EMessageRemovalCondition)r;
+			}
+		}
+		if(node->getAttr("after", value))
+		{
+			m_eventChain.setAfter(event, eTE_NullEvent);
+			for(int e=0; e<eTE_NumEvents; ++e)
+			{
+				if(!m_events[e].m_name.compare(value) && e != event)
+					m_eventChain.setAfter(event, e);
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CMPTutorial::AddTriggers(const std::list<EntityId>& ids, ETutorialTrigger type)
+{
+	const float radius = m_triggerRadius[type];
+	for(std::list<EntityId>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+	{
+		IEntity* pEntity = gEnv->pEntitySystem->GetEntity(*it);
+		if(!pEntity)
+			continue;
+
+		STutorialTrigger trigger;
+		trigger.m_id = *it;
+		trigger.m_type = type;
+		trigger.m_pos = pEntity->GetWorldPos();
+		m_triggers.push_back(trigger);
+		m_triggerGrid.add(m_triggers.size()-1, trigger.m_pos, radius);
+	}
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added: ownership decides which events the triggers fire
+void CMPTutorial::OnTeamChanged(EntityId entityId)
+{
+	if(!m_initialised || m_triggersDirty)
+		return;
+
+	IActor* pClientActor = g_pGame->GetIGameFramework()->GetClientActor();
+	if(pClientActor && pClientActor->GetEntityId() == entityId)
+	{
+		m_triggersDirty = true;
+		return;
+	}
+
+	for(std::vector<STutorialTrigger>::const_iterator it = m_triggers.begin(); it != m_triggers.end(); ++it)
+	{
+		if(it->m_id == entityId)
+		{
+			m_triggersDirty = true;
+			return;
+		}
+	}
 }
 
 void CMPTutorial::InitEntityClasses()
@@ -351,7 +485,7 @@ void CMPTutorial::Update()
 
 	// update the text... must be done even if not enabled, to ensure the 'you may reenable...' 
 	//	message is shown correctly.
-	if(m_currentEvent.m_numChunks > 0)
+	if(m_currentEvent.m_currentChunk < m_currentEvent.m_numChunks-1)	// !!CryFire - modded: nothing to do after the last chunk
 	{
 		// calculate how far through the current sound we are
 		CTimeValue now = gEnv->pTimer->GetFrameStartTime();
@@ -406,38 +540,35 @@ void CMPTutorial::Update()
 			g_pGame->GetHUD()->RegisterListener(this);
 		}
 
-		// go through entity list and pull out the factories.
-		IEntityItPtr pIt = gEnv->pEntitySystem->GetEntityIterator();
-		while (!pIt->IsEnd())
-		{
-			if (IEntity * pEnt = pIt->Next())
-			{
-				if(pEnt->GetClass() == m_pHQClass)
-				{
-					m_baseList.push_back(pEnt->GetId());
-					//CryLog("Adding HQ %d to list: %d", pEnt->GetId(), m_baseList.size());
-				}
-				else if(pEnt->GetClass() == m_pAlienEnergyPointClass)
-				{
-					m_alienEnergyPointList.push_back(pEnt->GetId());
-					//CryLog("Adding AEP %d to list: %d", pEnt->GetId(), m_alienEnergyPointList.size());
-				}
-				else if(pEnt->GetClass() == m_pSpawnGroupClass)
-				{
-					m_spawnGroupList.push_back(pEnt->GetId());
-					//CryLog("Adding spawngroup %d to list: %d", pEnt->GetId(), m_spawnGroupList.size());
-				}
-				else if(pEnt->GetClass() == m_pFactoryClass)
-				{
-					m_factoryList.push_back(pEnt->GetId());
-					//CryLog("Adding Factory %d to list: %d", pEnt->GetId(), m_factoryList.size());
-				}
-			}
-		}
+		// pull out the factories.
+		//-- !!CryFire - modded: ask the registry instead of going through the whole entity list
+		EntityRegistry::Ids hqs = EntityRegistry::getAllOfClass(m_pHQClass);
+		m_baseList.insert(m_baseList.end(), hqs.begin(), hqs.end());
+		EntityRegistry::Ids energyPoints = EntityRegistry::getAllOfClass(m_pAlienEnergyPointClass);
+		m_alienEnergyPointList.insert(m_alienEnergyPointList.end(), energyPoints.begin(), energyPoints.end());
+		EntityRegistry::Ids spawnGroups = EntityRegistry::getAllOfClass(m_pSpawnGroupClass);
+		m_spawnGroupList.insert(m_spawnGroupList.end(), spawnGroups.begin(), spawnGroups.end());
+		EntityRegistry::Ids factories = EntityRegistry::getAllOfClass(m_pFactoryClass);
+		m_factoryList.insert(m_factoryList.end(), factories.begin(), factories.end());
+		//------
+
+		//-- !!CryFire - added: in the order CheckNearbyEntities tests them
+		AddTriggers(m_alienEnergyPointList, eTT_AlienSite);
+		AddTriggers(m_baseList, eTT_Base);
+		AddTriggers(m_spawnGroupList, eTT_SpawnGroup);
+		AddTriggers(m_factoryList, eTT_Factory);
+		//------
 	}
 
-	// first the briefing events. These are shown in order.
-	bool showPrompt = CheckBriefingEvents(pPlayer);
+	//-- !!CryFire - modded: the briefing events. The first one starts as soon as the player spawns,
+	//	the others are shown in order, as they are triggered with the events before them.
+	bool showPrompt = false;
+	if(m_briefingPending)
+	{
+		m_briefingPending = false;
+		showPrompt = TriggerEvent(eTE_StartGame);
+	}
+	//------
 
 	// player has been killed
 	if(pPlayer->GetHealth() <= 0)
@@ -452,12 +583,28 @@ void CMPTutorial::Update()
 		// enter prototype factory
 		// enter hostile factory
 		// find alien crash
-		m_entityCheckTimer -= gEnv->pTimer->GetFrameTime();
-		if(m_entityCheckTimer < 0.0f)
+		//-- !!CryFire - modded: only when the player enters another cell or something changes team,
+		//	and every so often while the player's cell has some triggers
+		const Vec3& playerPos = pPlayer->GetEntity()->GetWorldPos();
+		uint32 cell = m_triggerGrid.getCell(playerPos);
+		if(cell != m_playerCell || m_triggersDirty)
 		{
+			m_playerCell = cell;
+			m_playerCellHasTriggers = m_triggerGrid.hasTriggers(cell);
+			m_triggersDirty = false;
 			CheckNearbyEntities(pPlayer);
 			m_entityCheckTimer = ENTITY_CHECK_TIME;
 		}
+		else if(m_playerCellHasTriggers)
+		{
+			m_entityCheckTimer -= gEnv->pTimer->GetFrameTime();
+			if(m_entityCheckTimer < 0.0f)
+			{
+				CheckNearbyEntities(pPlayer);
+				m_entityCheckTimer = ENTITY_CHECK_TIME;
+			}
+		}
+		//------
 
 		// board vehicle and vehicle tutorials
 		CheckVehicles(pPlayer);
@@ -700,14 +847,28 @@ const char* CMPTutorial::GetKeyName(const char* action)
 	return "";
 }
 
-bool CMPTutorial::TriggerEvent(ETutorialEvent event)
+//-- !!CryFire - added: lets an event wait for display, unless it has been triggered already
+struct SWaitForEvent
 {
-	if(m_events[event].m_status != eMS_Checking)
-		return false;
+	STutorialEvent* m_events;
 
-	m_events[event].m_status = eMS_Waiting;
+	SWaitForEvent(STutorialEvent* events) : m_events(events) {}
 
-	return true;
+	bool operator()(int event)
+	{
+		if(m_events[event].m_status != eMS_Checking)
+			return false;
+		m_events[event].m_status = eMS_Waiting;
+		return true;
+	}
+};
+//------
+
+bool CMPTutorial::TriggerEvent(ETutorialEvent event)
+{
+	// !!CryFire - modded: the events which follow this one are triggered with it
+	SWaitForEvent wait(m_events);
+	return m_eventChain.trigger(event, wait);
 }
 
 void CMPTutorial::ForceTriggerEvent(IConsoleCmdArgs* pArgs)
@@ -740,7 +901,8 @@ void CMPTutorial::ResetAllEvents(IConsoleCmdArgs* args)
 		{
 			pTutorial->m_events[i].m_status = eMS_Checking;
 		}
-		pTutorial->m_currentBriefingEvent = eTE_FIRST_BRIEFING;
+		pTutorial->m_briefingPending = true;	// !!CryFire - modded
+		pTutorial->m_triggersDirty = true;	// !!CryFire - added
 	}
 }
 
@@ -757,72 +919,6 @@ void CMPTutorial::EnableTutorialMode(bool enable)
 	m_enabled = enable;
 }
 
-bool CMPTutorial::CheckBriefingEvents(const CPlayer* pPlayer)
-{
-	bool showPrompt = false;
-
-	if(m_currentBriefingEvent < eTE_FIRST_BRIEFING 
-		|| m_currentBriefingEvent > eTE_LAST_BRIEFING
-		|| m_events[m_currentBriefingEvent].m_status != eMS_Checking)
-		return showPrompt;
-
-	switch(m_currentBriefingEvent)
-	{
-	case eTE_StartGame:
-		// trigger as soon as player spawns for the first time. Must be a better way than the state id?
-		if(pPlayer->GetSpectatorMode() == 0 && g_pGame->GetGameRules()->GetCurrentStateId() == 3)
-		{
-			showPrompt = TriggerEvent(m_currentBriefingEvent);
-			m_currentBriefingEvent = eTE_ContinueTutorial;
-		}
-		break;
-
-	case eTE_ContinueTutorial:
-		// trigger right after previous, so long as 'end tutorial' hasn't been pressed. (if it has, tutorial will be disabled)
-		if(m_events[eTE_StartGame].m_status != eMS_Checking)
-		{
-			showPrompt = TriggerEvent(m_currentBriefingEvent);
-			m_currentBriefingEvent = eTE_Barracks;
-		}
-		break;
-
-	case eTE_Barracks:
-		// trigger 3s after previous ones dismissed
-		if(m_events[eTE_ContinueTutorial].m_status != eMS_Checking)
-		{
-			showPrompt = TriggerEvent(m_currentBriefingEvent);
-			m_currentBriefingEvent = eTE_CloseBarracksBuyMenu;
-		}
-		break;
-
-	case eTE_CloseBarracksBuyMenu:
-		// trigger when player closes buy menu in barracks. This is triggered by the HUD so doesn't need checking here.
-		m_currentBriefingEvent = eTE_OpenMap;
-		break;
-
-	case eTE_OpenMap:
-		// trigger when player opens map for first time. This is triggered by the HUD so doesn't need checking here.
-		m_currentBriefingEvent = eTE_CloseMap;
-		break;
-
-	case eTE_CloseMap:
-		// trigger when player closes map. This is triggered by the HUD so doesn't need checking here.
-		m_currentBriefingEvent = eTE_Swingometer;
-		break;
-
-	case eTE_Swingometer:
-		// triggered after close map message
-		if(m_events[eTE_CloseMap].m_status != eMS_Checking)
-		{
-			showPrompt = TriggerEvent(m_currentBriefingEvent);
-			m_currentBriefingEvent = eTE_NullEvent;
-		}
-		break;
-	};
-
-	return showPrompt;
-}
-
 bool CMPTutorial::CheckNearbyEntities(const CPlayer *pPlayer)
 {
 	FUNCTION_PROFILER(GetISystem(), PROFILE_GAME);
@@ -857,30 +953,34 @@ bool CMPTutorial::CheckNearbyEntities(const CPlayer *pPlayer)
 	Vec3 playerPos = pPlayer->GetEntity()->GetWorldPos();
 	int playerTeam = g_pGame->GetGameRules()->GetTeam(pPlayer->GetEntityId());
 
-	// rewritten to avoid iterating through the entity list: cached lists of HQ / energy point / spawn groups
+	//-- !!CryFire - modded: only the triggers listed in the player's cell are tested for distance
+	const std::vector<int>& cell = m_triggerGrid.getTriggers(m_playerCell);
+
 	bool allCrashSites = true;	// does the player's team own all crash sites
 	bool PTFactory = false;			// does the player's team own the PT factory
 	bool nearCrashSite = false;	// is the player near a crash site
 	for(std::list<EntityId>::iterator it = m_alienEnergyPointList.begin(); it != m_alienEnergyPointList.end(); ++it)
 	{
-		EntityId eid = *it;
-
 		// check team 
-		if(playerTeam != g_pGame->GetGameRules()->GetTeam(eid))
+		if(playerTeam != g_pGame->GetGameRules()->GetTeam(*it))
 			allCrashSites = false;
+	}
+
+	for(size_t i = 0; i < cell.size(); ++i)
+	{
+		const STutorialTrigger& trigger = m_triggers[cell[i]];
+		if(trigger.m_type != eTT_AlienSite)
+			continue;
 
-		IEntity* pEnt = gEnv->pEntitySystem->GetEntity(eid);
-		if(pEnt)
+		float distanceSq = (trigger.m_pos - playerPos).GetLengthSquared();
+		float radius = m_triggerRadius[eTT_AlienSite];
+		if(distanceSq < radius*radius && g_pGame->GetGameRules()->GetTeam(trigger.m_id) == playerTeam)
 		{
-			Vec3 vec = pEnt->GetWorldPos() - playerPos;
-			float distanceSq = vec.GetLengthSquared();
-			if(distanceSq < 500.0f && g_pGame->GetGameRules()->GetTeam(pEnt->GetId()) == playerTeam)
-			{
-				showPrompt = TriggerEvent(eTE_CaptureAlienSite);
-				nearCrashSite = true;
-			}
+			showPrompt = TriggerEvent(eTE_CaptureAlienSite);
+			nearCrashSite = true;
 		}
 	}
+	//------
 
 	if(m_events[eTE_AllAliensNoPrototype].m_status == eMS_Checking
 		|| m_events[eTE_AlienNoPrototype].m_status == eMS_Checking)
@@ -916,84 +1016,60 @@ bool CMPTutorial::CheckNearbyEntities(const CPlayer *pPlayer)
 		}
 	}
 
-	if(!showPrompt && m_events[eTE_ApproachEnemyBase].m_status == eMS_Checking)
+	//-- !!CryFire - modded: one type of triggers after another, until one of them shows a prompt
+	for(int type = eTT_Base; type < eTT_NumTriggers && !showPrompt; ++type)
 	{
-		std::list<EntityId>::iterator it = m_baseList.begin();
-		for(; it != m_baseList.end(); ++it)
+		if(type == eTT_Base && m_events[eTE_ApproachEnemyBase].m_status != eMS_Checking)
+			continue;
+		if(type == eTT_SpawnGroup && m_events[eTE_SpawnBunker].m_status != eMS_Checking)
+			continue;
+
+		const float radius = m_triggerRadius[type];
+		for(size_t i = 0; i < cell.size(); ++i)
 		{
-			IEntity* pEnt = gEnv->pEntitySystem->GetEntity(*it);
-			if(pEnt)
+			const STutorialTrigger& trigger = m_triggers[cell[i]];
+			if(trigger.m_type != type || (trigger.m_pos - playerPos).GetLengthSquared() >= radius*radius)
+				continue;
+
+			int team = g_pGame->GetGameRules()->GetTeam(trigger.m_id);
+			if(type == eTT_Base)
 			{
-				Vec3 vec = pEnt->GetWorldPos() - playerPos;
-				float distanceSq = vec.GetLengthSquared();
-				int team = g_pGame->GetGameRules()->GetTeam(pEnt->GetId());
 				if(team != playerTeam)
-				{
-					if(distanceSq < 48400.0f)	// 220m distance
-						showPrompt = TriggerEvent(eTE_ApproachEnemyBase);
-				}
+					showPrompt = TriggerEvent(eTE_ApproachEnemyBase);
 			}
-		}
-	}
-
-	if(!showPrompt && m_events[eTE_SpawnBunker].m_status == eMS_Checking)
-	{
-		std::list<EntityId>::iterator it = m_spawnGroupList.begin();
-		for(; it != m_spawnGroupList.end(); ++it)
-		{
-			IEntity* pEnt = gEnv->pEntitySystem->GetEntity(*it);
-			if(pEnt)
+			else if(type == eTT_SpawnGroup)
 			{
-				Vec3 vec = pEnt->GetWorldPos() - playerPos;
-				float distanceSq = vec.GetLengthSquared();
-				if(distanceSq <= 80.0f)
-				{
-					if(g_pGame->GetGameRules()->GetTeam(pEnt->GetId()) == 0)
-						showPrompt = TriggerEvent(eTE_SpawnBunker);
-				}
+				if(team == 0)
+					showPrompt = TriggerEvent(eTE_SpawnBunker);
 			}
-		}
-	}
-
-	if(!showPrompt)
-	{
-		std::list<EntityId>::iterator it = m_factoryList.begin();
-		for(; it != m_factoryList.end(); ++it)
-		{
-			IEntity* pEnt = gEnv->pEntitySystem->GetEntity(*it);
-			if(pEnt)
+			else
 			{
-				Vec3 vec = pEnt->GetWorldPos() - playerPos;
-				float distanceSq = vec.GetLengthSquared();
-				if(distanceSq < 500.0f)
+				// prompt depends on team and factory type
+				bool inPrototypeFactory = g_pGame->GetHUD()->GetPowerStruggleHUD()->IsFactoryType(trigger.m_id, CHUDPowerStruggle::E_PROTOTYPES);
+				if(team == 0)
 				{
-					// prompt depends on team and factory type
-					bool inPrototypeFactory = g_pGame->GetHUD()->GetPowerStruggleHUD()->IsFactoryType(pEnt->GetId(), CHUDPowerStruggle::E_PROTOTYPES);
-					int team = g_pGame->GetGameRules()->GetTeam(pEnt->GetId());
-					if(team == 0)
-					{
-						showPrompt = TriggerEvent(eTE_NeutralFactory);
-					}
-					else if(team != playerTeam)
-					{
-						showPrompt = TriggerEvent(eTE_EnterHostileFactory);
-					}
-					else // team == playerTeam
-					{
-						// don't show the capture event until neutral message has been shown -
-						//	prevents displaying it for factories you already own
-						if(m_events[eTE_NeutralFactory].m_status != eMS_Checking)
-							showPrompt = TriggerEvent(eTE_CaptureFactory);
+					showPrompt = TriggerEvent(eTE_NeutralFactory);
+				}
+				else if(team != playerTeam)
+				{
+					showPrompt = TriggerEvent(eTE_EnterHostileFactory);
+				}
+				else // team == playerTeam
+				{
+					// don't show the capture event until neutral message has been shown -
+					//	prevents displaying it for factories you already own
+					if(m_events[eTE_NeutralFactory].m_status != eMS_Checking)
+						showPrompt = TriggerEvent(eTE_CaptureFactory);
 
-						if(inPrototypeFactory)
-						{
-							showPrompt |= TriggerEvent(eTE_EnterPrototypeFactory);
-						}
+					if(inPrototypeFactory)
+					{
+						showPrompt |= TriggerEvent(eTE_EnterPrototypeFactory);
 					}
 				}
 			}
 		}
 	}
+	//------
 
 	return showPrompt;
 }
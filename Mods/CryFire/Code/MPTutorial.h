@@ -9,6 +9,9 @@ Description: MP Tutorial for PowerStruggle
 -------------------------------------------------------------------------
 History:
 - 12:03:2007: Created by Steve Humphreys
+- !!CryFire: event driven - the briefing is chained in the event table, which can be
+  changed in an XML file, proximity triggers are kept in a grid and checked when
+  the player enters another cell or one of them changes team
 
 *************************************************************************/
 
@@ -18,6 +21,8 @@ History:
 #pragma once
 
 #include "HUD/HUD.h"
+#include "CryFire/TriggerGrid.h" // !!CryFire - added
+#include "CryFire/EventChain.h" // !!CryFire - added
 
 class CPlayer;
 
@@ -127,6 +132,25 @@ struct STutorialEvent
 	EMessageStatus m_status;	// current status of this message
 };
 
+//-- !!CryFire - added: entities which trigger events when the player comes near them
+enum ETutorialTrigger
+{
+	eTT_AlienSite = 0,
+	eTT_Base,
+	eTT_SpawnGroup,
+	eTT_Factory,
+
+	eTT_NumTriggers,
+};
+
+struct STutorialTrigger
+{
+	EntityId m_id;
+	ETutorialTrigger m_type;
+	Vec3 m_pos;							// these entities don't move
+};
+//------
+
 // chunk of an event (audio is one event, text is sometimes split if too long)
 struct STutorialTextChunk
 {
@@ -194,14 +218,18 @@ public:
 	bool TriggerEvent(ETutorialEvent event);
 	void EnableTutorialMode(bool enable);
 	bool IsEnabled() const			{ return m_enabled; }
+	void OnTeamChanged(EntityId entityId);	// !!CryFire - added: called by the game rules
 
 	void Update();
 
 private:
 	void InitEvents();
 	void InitEntityClasses();
+	//-- !!CryFire - added
+	void LoadEvents(const char* filename);
+	void AddTriggers(const std::list<EntityId>& ids, ETutorialTrigger type);
+	//------
 
-	bool CheckBriefingEvents(const CPlayer* pPlayer);
 	bool CheckNearbyEntities(const CPlayer* pPlayer);
 	bool CheckVehicles(const CPlayer* pPlayer);
 	bool CheckBases(const CPlayer* pPlayer);
@@ -220,7 +248,8 @@ private:
 	bool m_wasInVehicle;
 
 	STutorialEvent m_events[eTE_NumEvents];
-	ETutorialEvent m_currentBriefingEvent;
+	EventChain m_eventChain;					// !!CryFire - added: events triggered together with the event they follow (briefing order)
+	bool m_briefingPending;						// !!CryFire - modded: the rest of the briefing follows eTE_StartGame, see m_eventChain
 	float m_entityCheckTimer;					// only check nearby entities every so often
 	float m_baseCheckTimer;						// only check bases every so often
 
@@ -241,6 +270,15 @@ private:
 	std::list<EntityId> m_spawnGroupList;
 	std::list<EntityId> m_alienEnergyPointList;
 	std::list<EntityId> m_factoryList;
+
+	//-- !!CryFire - added: the triggers are listed in every grid cell their radius overlaps
+	std::vector<STutorialTrigger> m_triggers;
+	TriggerGrid m_triggerGrid;				// cell -> indices into m_triggers, ordered by type
+	float m_triggerRadius[eTT_NumTriggers];
+	uint32 m_playerCell;
+	bool m_playerCellHasTriggers;			// the player stays in a cell with triggers, check them every ENTITY_CHECK_TIME
+	bool m_triggersDirty;							// the player moved to another cell or something changed team
+	//------
 };
 
 
@@ -483,7 +483,7 @@ void CMelee::Hit(const Vec3 &pt, const Vec3 &dir, const Vec3 &normal, IPhysicalE
 
 			HitInfo info(m_pWeapon->GetOwnerId(), pTarget->GetId(), m_pWeapon->GetEntityId(),
 				m_pWeapon->GetFireModeIdx(GetName()), 0.0f, pGameRules->GetHitMaterialIdFromSurfaceId(surfaceIdx), partId,
-				pGameRules->GetHitTypeId(m_meleeparams.hit_type.c_str()), pt, dir, normal);
+				pGameRules->GetHitTypeId(m_meleeparams.hit_type), pt, dir, normal);
 
 			info.remote = remote;
 			if (!remote)
@@ -2990,6 +2990,10 @@ void CFlashMenuObject::OnPostUpdate(float fDeltaTime)
 		UpdateRatio();
 	}
 
+	// !!CryFire - added: server browser changes are pushed to the lobby once per frame
+	if(m_multiplayerMenu)
+		m_multiplayerMenu->OnUpdate();
+
 	if(m_bLoadingDone && !g_pGameCVars->hud_startPaused)
 	{
 		CloseWaitingScreen();
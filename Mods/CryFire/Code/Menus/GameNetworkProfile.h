@@ -18,6 +18,7 @@ History:
 #pragma once
 
 #include "INetworkService.h"
+#include <FlatHashMap.h> // !!CryFire - added
 
 class CMPHub;
 
@@ -122,6 +123,56 @@ struct SStoredServer
 	void Serialize(struct IStoredSerialize* ser);
 };
 
+//-- !!CryFire - added ---
+// Summary
+//  Favourite/recent servers by ip:port, every browsed server is checked against them.
+//  Counts duplicates, so it stays in sync with a vector of SStoredServer.
+class CStoredServerSet
+{
+public:
+  void  Add(uint ip, ushort port)
+  {
+    ++m_keys[Key(ip,port)];
+  }
+
+  void  Remove(uint ip, ushort port)
+  {
+    TKeyMap::iterator it = m_keys.find(Key(ip,port));
+    if(it != m_keys.end() && --it->second <= 0)
+      m_keys.erase(it->first);
+  }
+
+  bool  Contains(uint ip, ushort port)const
+  {
+    return m_keys.count(Key(ip,port)) != 0;
+  }
+
+  void  Assign(const std::vector<SStoredServer>& servers)
+  {
+    m_keys.clear();
+    for(int i=0;i<servers.size();++i)
+      Add(servers[i].ip,servers[i].port);
+  }
+
+private:
+  struct SKeyHash
+  {
+    size_t operator()(uint64 key)const
+    {
+      return stl::flat_hash<uint64>::flat_hash_mix(size_t(key ^ (key>>32)));
+    }
+  };
+  typedef FlatHashMap<uint64, int, SKeyHash> TKeyMap;
+
+  static uint64 Key(uint ip, ushort port)
+  {
+    return (uint64(ip)<<16) | port;
+  }
+
+  TKeyMap m_keys;
+};
+//------
+
 static const char* AUTO_INVITE_TEXT  = "Crysis auto generated invitation";
 
 class CGameNetworkProfile
@@ -485,6 +485,13 @@ void CMPHub::OnUIEvent(const SUIEvent& event)
   }
 }
 
+// !!CryFire - added
+void CMPHub::OnUpdate()
+{
+  if(m_menu.get())
+    m_menu->OnUpdate();
+}
+
 void CMPHub::SetCurrentFlashScreen(IFlashPlayer* screen, bool ingame)
 {
 	if(m_currentScreen && !screen)
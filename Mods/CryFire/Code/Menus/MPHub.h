@@ -225,6 +225,7 @@ public:
   ~CMPHub();
   bool HandleFSCommand(const char* pCmd, const char* pArgs);//Flash does it
   void OnUIEvent(const SUIEvent& event);//game does it
+  void OnUpdate();//every frame, !!CryFire - added
   void SetCurrentFlashScreen(IFlashPlayer* current_screen, bool ingame);
   void ConnectFailed(EDisconnectionCause cause, const char * description);
   void OnLoginSuccess(const char* nick);
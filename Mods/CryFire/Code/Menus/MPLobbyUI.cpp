@@ -17,6 +17,8 @@ History:
 #include "OptionsManager.h"
 #include "GameNetworkProfile.h"
 #include "GameCVars.h"
+#include "CryFire/SlotIndex.h" // !!CryFire - added
+#include "CryFire/ServerSelection.h" // !!CryFire - added
 
 static const char* MPPath = "_root.Root.MainMenu.MultiPlayer.\0";
 
@@ -96,48 +98,41 @@ struct CMPLobbyUI::SServerFilter
     return m_on;
   }
 
+  //-- !!CryFire - modded: the decision is in CryFire/ServerSelection, so it can be tested
   bool  Filter(const SServerInfo& i)const
   {
-		if( !m_on )
-			return true;
-    if( !m_gamemode.empty() && i.m_gameType != m_gamemode)
-      return false;
-    if( !m_mapname.empty())
-    {
-      static std::string a;
-      a.resize(i.m_mapName.size());
-      for(int k=0;k<a.size();++k)
-        a[k] = char(tolower(i.m_mapName[k]));
-      const char* f = strstr(a.c_str(),m_mapname.c_str());
-      if(f==0)
-        return false;
-    }
-    if( m_minping!=0 && i.m_ping > m_minping )
-      return false;
-    if( m_notfull && i.m_maxPlayers == i.m_numPlayers)
-      return false;
-    if( m_notempty && i.m_numPlayers == 0)
-      return false;
-    if( m_notprivate && i.m_private )
-      return false;
-    //if( m_notcustomized && i.m_custom )
-    //  return false;
-    //if( m_autoteambalance && i.m_autoteambalance )
-    //  return false;
-    if( m_anticheat && !i.m_anticheat )
-      return false;
-    if( m_friendlyfire && !i.m_friendlyfire )
-      return false;
-    if( m_gamepadsonly && !i.m_gamepadsonly )
-      return false;
-    if( m_novoicecomms && i.m_voicecomm )
-      return false;
-    if( m_dedicated && !i.m_dedicated )
-      return false;
-    if( m_dx10 && !i.m_dx10 )
-      return false;
-    return true;
+    ServerSelection::Filter filter;
+    filter.on = m_on;
+    filter.gameMode = m_gamemode.c_str();
+    filter.mapName = m_mapname.c_str();
+    filter.maxPing = m_minping;
+    filter.notFull = m_notfull;
+    filter.notEmpty = m_notempty;
+    filter.notPrivate = m_notprivate;
+    filter.antiCheat = m_anticheat;
+    filter.friendlyFire = m_friendlyfire;
+    filter.gamepadsOnly = m_gamepadsonly;
+    filter.noVoiceComms = m_novoicecomms;
+    filter.dedicated = m_dedicated;
+    filter.dx10 = m_dx10;
+
+    ServerSelection::LobbyServer server;
+    server.gameType = i.m_gameType.c_str();
+    server.mapName = i.m_mapName.c_str();
+    server.ping = i.m_ping;
+    server.numPlayers = i.m_numPlayers;
+    server.maxPlayers = i.m_maxPlayers;
+    server.isPrivate = i.m_private;
+    server.antiCheat = i.m_anticheat;
+    server.friendlyFire = i.m_friendlyfire;
+    server.gamepadsOnly = i.m_gamepadsonly;
+    server.voiceComm = i.m_voicecomm;
+    server.dedicated = i.m_dedicated;
+    server.dx10 = i.m_dx10;
+
+    return ServerSelection::passesFilter(filter, server);
   }
+  //------
 
   bool HandleFSCommand(EGsUiCommand cmd, const char* pArgs);
 
@@ -202,6 +197,9 @@ struct CMPLobbyUI::SServerFilter
 
 };
 
+//-- !!CryFire - modded: servers are found by id in a SlotIndex and keep their index when
+// other servers are removed (the slot is freed and reused), the browser changes are collected
+// per server and pushed to Flash once per frame by CMPLobbyUI::FlushServerUpdates
 struct SMPServerList
 {
   typedef std::vector<CMPLobbyUI::SServerInfo> ServerInfoVector;
@@ -216,11 +214,71 @@ struct SMPServerList
     m_sorttype(eST_ascending),
     m_dirty(false),
     m_selectedServer(-1),
-    m_displayMode(0)
+    m_displayMode(0),
+    m_structureChanged(false)
   {
 
   }
 
+  bool IsFree(int idx)const
+  {
+    return m_slots.isFree(idx);
+  }
+
+  void MarkChanged(int idx)
+  {
+    m_slots.markChanged(idx);
+  }
+
+  // whether the server belongs to m_all in the current display mode
+  bool IsListed(int idx, const CMPLobbyUI::SServerFilter* filter)const
+  {
+    if(IsFree(idx))
+      return false;
+    if(m_displayMode==1 && std::find(m_favorites.begin(),m_favorites.end(),idx)==m_favorites.end())
+      return false;
+    if(m_displayMode==2 && std::find(m_recent.begin(),m_recent.end(),idx)==m_recent.end())
+      return false;
+    return !filter || filter->Filter(m_allServers[idx]);
+  }
+
+  bool IsServerShown(int idx)const
+  {
+    int end = min(int(m_all.size()),m_startIndex+m_visibleCount);
+    for(int i=m_startIndex;i<end;++i)
+      if(m_all[i] == idx)
+        return true;
+    return false;
+  }
+
+  // clears the changes, returns true if the shown part of the list has to be redrawn,
+  // the list is filtered and sorted again only if a changed server has to move in/out of it
+  // or its sort key moved it out of order, a changed ping mostly doesn't
+  bool FlushChanges(const CMPLobbyUI::SServerFilter* filter)
+  {
+    const std::vector<int>& changed = m_slots.getChanged();
+    if(changed.empty() && !m_structureChanged)
+      return false;
+    if(m_structureChanged)
+      m_dirty = true;
+    else
+    {
+      m_slots.getPositions(m_all,m_positions);
+      for(int i=0;i<changed.size() && !m_dirty;++i)
+        if((m_positions[changed[i]] != SlotIndex::NONE) != IsListed(changed[i],filter))
+          m_dirty = true;
+      if(!m_dirty && m_sortcolumn != eSC_none && !m_slots.isStillSorted(m_all,m_positions,SSort(*this)))
+        m_dirty = true;
+    }
+    bool redraw = m_dirty;
+    for(int i=0;i<changed.size() && !redraw;++i)
+      if(IsServerShown(changed[i]))
+        redraw = true;
+    m_slots.clearChanges();
+    m_structureChanged = false;
+    return redraw;
+  }
+
   void AddToVisible(int idx)
   {
     m_all.push_back(idx);
@@ -273,8 +331,17 @@ struct SMPServerList
 
   void AddServer(const CMPLobbyUI::SServerInfo& srv)
   {
-    int idx = m_allServers.size();
-    m_allServers.push_back(srv);
+    if(GetServerIdxById(srv.m_serverId) != -1)
+    {
+      UpdateServer(srv);
+      return;
+    }
+
+    int idx = m_slots.add(srv.m_serverId);
+    if(idx < m_allServers.size())
+      m_allServers[idx] = srv;
+    else
+      m_allServers.push_back(srv);
 
     if(srv.m_favorite)
     {
@@ -287,6 +354,7 @@ struct SMPServerList
     if(m_displayMode == 0)
       AddToVisible(idx);
     m_dirty = true;
+    m_structureChanged = true;
   }
 
   void UpdateServer(const CMPLobbyUI::SServerInfo& srv)
@@ -304,6 +372,7 @@ struct SMPServerList
           RemoveFromFavorites(idx);
         else
           AddToFavorites(idx);
+        m_structureChanged = true;
       }
 
       if(srv.m_recent != m_allServers[idx].m_recent)
@@ -312,11 +381,13 @@ struct SMPServerList
           RemoveFromRecent(idx);
         else
           AddToRecent(idx);
+        m_structureChanged = true;
       }
     
       m_allServers[idx] = srv;
       
       m_allServers[idx].m_ping = ping;
+      MarkChanged(idx);
     }
   }
 
@@ -326,6 +397,7 @@ struct SMPServerList
     if(idx != -1)
     {
       m_allServers[idx].m_ping = ping;
+      MarkChanged(idx);
     }
   }
 
@@ -334,19 +406,21 @@ struct SMPServerList
     int idx = GetServerIdxById(id);
     if(idx != -1)
     {
-      m_allServers.erase(m_allServers.begin()+idx);
+      m_slots.remove(id);
       RemoveFromVisible(idx);
       stl::find_and_erase(m_favorites,idx);
       stl::find_and_erase(m_recent,idx);
+      if(m_selectedServer == idx)
+        ClearSelection();
+      m_allServers[idx] = CMPLobbyUI::SServerInfo();
+      m_dirty = true;
+      m_structureChanged = true;
     }
   }
 
-  int GetServerIdxById(int id)
+  int GetServerIdxById(int id)const
   {
-    for(uint32 i=0;i<m_allServers.size();i++)
-      if(m_allServers[i].m_serverId == id)
-        return i;
-    return -1;
+    return m_slots.find(id);
   }
 
   bool    SetScrollPos(double fr)
@@ -386,6 +460,8 @@ struct SMPServerList
     m_favorites.resize(0);
     m_all.resize(0);
     m_allServers.resize(0);
+    m_slots.clear();
+    m_structureChanged = false;
     m_startIndex = 0;
     m_selectedServer = -1;
   }
@@ -396,9 +472,10 @@ struct SMPServerList
     switch(mode)
     {
     case 0:
-      m_all.resize(m_allServers.size());
+      m_all.resize(0);
       for(int i=0;i<m_allServers.size();++i)
-        m_all[i] = i;
+        if(!IsFree(i))
+          m_all.push_back(i);
       m_dirty = true;
       break;
     case 1:
@@ -497,7 +574,7 @@ struct SMPServerList
     case 0:
       {
         for(int i=0;i<m_allServers.size();++i)
-          if(filter->Filter(m_allServers[i]))
+          if(!IsFree(i) && filter->Filter(m_allServers[i]))
             m_all.push_back(i);
       }
       break;
@@ -579,7 +656,8 @@ struct SMPServerList
     const CMPLobbyUI::SServerInfo &sel = GetSelectedServer(); 
     for(int i=0;i<m_allServers.size();++i)
     {
-      if(m_allServers[i].m_publicIP == sel.m_publicIP &&
+      if(!IsFree(i) &&
+         m_allServers[i].m_publicIP == sel.m_publicIP &&
          m_allServers[i].m_hostPort == sel.m_hostPort &&
          m_allServers[i].m_favorite != fav)
       {
@@ -600,6 +678,9 @@ struct SMPServerList
   bool                m_updateCompleted;
 
   ServerInfoVector    m_allServers;
+  SlotIndex           m_slots;        // server id -> index in m_allServers, servers changed since the last flush
+  std::vector<int>    m_positions;    // index in m_all of every server, only for FlushChanges
+  bool                m_structureChanged;
   //server list info
   int                 m_displayMode;
   int                 m_startIndex;
@@ -611,6 +692,7 @@ struct SMPServerList
   ESortColumn         m_sortcolumn;
   ESortType           m_sorttype;
 };
+//------
 
 ESortColumn         gSortColumn = eSC_none;
 ESortType           gSortType = eST_ascending;
@@ -1311,6 +1393,23 @@ void  CMPLobbyUI::UpdatePing(int id, int ping)//applies sorting
   m_serverlist->UpdatePing(id,ping);
 }
 
+// !!CryFire - added
+CMPLobbyUI::SServerInfo* CMPLobbyUI::EditServer(int id)
+{
+  int idx = m_serverlist->GetServerIdxById(id);
+  if(idx==-1)
+    return 0;
+  m_serverlist->MarkChanged(idx);
+  return &m_serverlist->m_allServers[idx];
+}
+
+// !!CryFire - added
+void  CMPLobbyUI::FlushServerUpdates()
+{
+  if(m_serverlist->FlushChanges(m_filter.get()))
+    DisplayServerList();
+}
+
 void  CMPLobbyUI::RemoveServer(int id)
 {
   if(m_serverlist->m_selectedServer!=-1 && m_serverlist->GetSelectedServer().m_serverId == id)
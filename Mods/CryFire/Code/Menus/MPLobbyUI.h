@@ -184,6 +184,8 @@ public:
   void  ClearSelection();
   bool  GetSelectedServer(SServerInfo& srv);  
   bool  GetServer(int id, SServerInfo& srv);
+  SServerInfo* EditServer(int id);//!!CryFire - added: marks the server changed, valid until the next AddServer
+  void  FlushServerUpdates();//!!CryFire - added: redraws the list once if the changed servers are shown
   void  FinishUpdate();
   void  StartUpdate();
   void  SetUpdateProgress(int done, int total);
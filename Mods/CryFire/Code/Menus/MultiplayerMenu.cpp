@@ -84,6 +84,51 @@ gServerKeyNames[] = {
 											{eSIK_modVersion,"modversion"}
                     };
 
+//-- !!CryFire - added ---
+// the browser reports every key of every server by name, KEY_BY_VALUE compared it with the whole table
+struct SServerKeyNameEqual
+{
+  bool operator()(const char* a, const char* b)const
+  {
+    return strcmp(a,b)==0;
+  }
+};
+
+static EServerInfoKey GetServerInfoKey(const char* name)
+{
+  typedef FlatHashMap<const char*, EServerInfoKey, stl::flat_hash_strcmp<const char*>, SServerKeyNameEqual> TServerKeyMap;
+  static TServerKeyMap keys;
+  if(keys.empty())
+  {
+    for(int i=1;i<sizeof(gServerKeyNames)/sizeof(gServerKeyNames[0]);++i)
+      keys[gServerKeyNames[i].value] = gServerKeyNames[i].key;
+  }
+  TServerKeyMap::const_iterator it = keys.find(name);
+  return it != keys.end() ? it->second : eSIK_unknown;
+}
+
+// keys shown in the server list
+static bool IsBasicKey(EServerInfoKey key)
+{
+  switch(key)
+  {
+  case eSIK_hostname:
+  case eSIK_mapname:
+  case eSIK_numplayers:
+  case eSIK_maxplayers:
+  case eSIK_gametype:
+  case eSIK_anticheat:
+  case eSIK_gamepadsonly:
+  case eSIK_private:
+  case eSIK_dx10:
+  case eSIK_modName:
+  case eSIK_modVersion:
+    return true;
+  }
+  return false;
+}
+//------
+
 
 enum EChannelKey
 {
@@ -225,19 +270,9 @@ struct CMultiPlayerMenu::SGSBrowser : public IServerListener
 		si.m_ping         = 10000;
 		si.m_modName			= info->m_modName;
 		si.m_modVersion		= info->m_modVersion;
-    for(int i=0;i<m_menu->m_favouriteServers.size();++i)
-    {
-      SStoredServer &srv = m_menu->m_favouriteServers[i];
-      if(srv.ip == si.m_publicIP && srv.port == si.m_hostPort)
-        si.m_favorite = true;
-    }
-
-    for(int i=0;i<m_menu->m_recentServers.size();++i)
-    {
-      SStoredServer &srv = m_menu->m_recentServers[i];
-      if(srv.ip == si.m_publicIP && srv.port == si.m_hostPort)
-        si.m_recent = true;
-    }
+    // !!CryFire - modded: hashed lookup, was a scan of both lists for every server
+    si.m_favorite = m_menu->m_favouriteSet.Contains(si.m_publicIP,si.m_hostPort);
+    si.m_recent = m_menu->m_recentSet.Contains(si.m_publicIP,si.m_hostPort);
 		
 		si.m_canjoin = (m_dx10 || (!si.m_dx10)) && (m_version.empty() || m_version == si.m_gameVersion) && (m_modName==si.m_modName) && (m_modVersion==si.m_modVersion);
 
@@ -259,62 +294,56 @@ struct CMultiPlayerMenu::SGSBrowser : public IServerListener
 
   virtual void UpdateValue(const int id,const char* name,const char* value)
   {
-    EServerInfoKey key = KEY_BY_VALUE(CONST_TEMP_STRING(name),gServerKeyNames);
+    EServerInfoKey key = GetServerInfoKey(name); // !!CryFire - modded
 
-    CMPLobbyUI::SServerInfo si;
-    if(m_menu->m_ui->GetServer(id,si))
+    //-- !!CryFire - modded: the server is changed in place and marked, the list is pushed to Flash once per frame
+    CMPLobbyUI::SServerInfo* si = IsBasicKey(key) ? m_menu->m_ui->EditServer(id) : 0;
+    if(si)
     {
-      bool basic = true;
       switch(key)
       {
       case eSIK_hostname:
-        si.m_hostName = value;
+        si->m_hostName = value;
         break;
       case eSIK_mapname:
-        si.m_mapName = value;
+        si->m_mapName = value;
         break;
       case eSIK_numplayers:
-				si.m_numPlayers = atoi(value);
-				if(si.m_numPlayers)
-					m_details.m_players.resize(si.m_numPlayers);
+				si->m_numPlayers = atoi(value);
+				if(si->m_numPlayers)
+					m_details.m_players.resize(si->m_numPlayers);
         break;
       case eSIK_maxplayers:
-        si.m_maxPlayers = atoi(value);
+        si->m_maxPlayers = atoi(value);
         break;
       case eSIK_gametype:
-        si.m_gameTypeName = GetGameType(value);
-        si.m_gameType = value;
+        si->m_gameTypeName = GetGameType(value);
+        si->m_gameType = value;
         break;
       case eSIK_official:
-				//si.m_official = atoi(value)!=0;
+				//si->m_official = atoi(value)!=0;
         break;
       case eSIK_anticheat:
-        si.m_anticheat = atoi(value)!=0;
+        si->m_anticheat = atoi(value)!=0;
         break;
 			case eSIK_gamepadsonly:
-				si.m_gamepadsonly = atoi(value)!=0;
+				si->m_gamepadsonly = atoi(value)!=0;
 				break;
       case eSIK_private:
-        si.m_private = atoi(value)!=0;
+        si->m_private = atoi(value)!=0;
         break;
 			case eSIK_dx10:
-				si.m_dx10 = atoi(value)!=0;
+				si->m_dx10 = atoi(value)!=0;
 				break;
 			case eSIK_modName:
-				si.m_modName = value;
+				si->m_modName = value;
 				break;
 			case eSIK_modVersion:
-				si.m_modVersion = value;
+				si->m_modVersion = value;
 				break;
-      default:
-        basic = false;
-      }
-
-      if(basic)
-      {
-        m_menu->m_ui->UpdateServer(si);
       }
     }
+    //------
 
     if(id != m_pendingUpdate)
       return;
@@ -366,8 +395,7 @@ struct CMultiPlayerMenu::SGSBrowser : public IServerListener
     if(playerNum>=m_details.m_players.size())
       return;
     CMPLobbyUI::SServerDetails::SPlayerDetails& pl = m_details.m_players[playerNum];
-    string val(name);
-    EServerInfoKey key = KEY_BY_VALUE(CONST_TEMP_STRING(val),gServerKeyNames);
+    EServerInfoKey key = GetServerInfoKey(name); // !!CryFire - modded
     switch(key)
     {
     case eSIK_playerName:
@@ -646,6 +674,7 @@ struct CMultiPlayerMenu::SGSNetworkProfile : public INProfileUI
     s.ip = ip;
     s.port = port;
     m_menu->m_favouriteServers.push_back(s);
+    m_menu->m_favouriteSet.Add(ip,port); // !!CryFire - added
   }
 
   virtual void AddRecentServer(uint ip, ushort port)
@@ -654,6 +683,7 @@ struct CMultiPlayerMenu::SGSNetworkProfile : public INProfileUI
     s.ip = ip;
     s.port = port;
     m_menu->m_recentServers.push_back(s);
+    m_menu->m_recentSet.Add(ip,port); // !!CryFire - added
   }
 
 	int                         m_selectedBuddy;
@@ -997,6 +1027,12 @@ void CMultiPlayerMenu::OnUIEvent(const SUIEvent& event)
 	}
 }
 
+// !!CryFire - added
+void CMultiPlayerMenu::OnUpdate()
+{
+  m_ui->FlushServerUpdates();
+}
+
 void    CMultiPlayerMenu::UpdateServerList()
 {
   switch(m_ui->GetCurTab())
@@ -1316,6 +1352,7 @@ void CMultiPlayerMenu::CUI::OnAddFavorite()
 	if(GetSelectedServer(svr))
 	{
 		m_menu->m_favouriteServers.push_back(SStoredServer(svr.m_publicIP,svr.m_hostPort));
+		m_menu->m_favouriteSet.Add(svr.m_publicIP,svr.m_hostPort); // !!CryFire - added
 		m_menu->m_profile->AddFavoriteServer(svr.m_publicIP,svr.m_hostPort);
 	}
 }
@@ -1325,7 +1362,8 @@ void CMultiPlayerMenu::CUI::OnRemoveFavorite()
 	SServerInfo svr;
 	if(GetSelectedServer(svr))
 	{
-		stl::find_and_erase(m_menu->m_favouriteServers,SStoredServer(svr.m_publicIP,svr.m_hostPort));
+		if(stl::find_and_erase(m_menu->m_favouriteServers,SStoredServer(svr.m_publicIP,svr.m_hostPort)))
+			m_menu->m_favouriteSet.Remove(svr.m_publicIP,svr.m_hostPort); // !!CryFire - added
 		m_menu->m_profile->RemoveFavoriteServer(svr.m_publicIP,svr.m_hostPort);
 	}
 }
@@ -1339,6 +1377,7 @@ void CMultiPlayerMenu::CUI::JoinSelectedServer()
 		srv.ip = si.m_publicIP;
 		srv.port = si.m_hostPort;
 		m_menu->m_recentServers.push_back(srv);
+		m_menu->m_recentSet.Add(si.m_publicIP,si.m_hostPort); // !!CryFire - added
 		if(si.m_private)
 		{
 			m_menu->m_hub->CloseLoadingDlg();
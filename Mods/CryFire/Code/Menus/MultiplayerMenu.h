@@ -23,7 +23,7 @@ struct  IServerBrowser;
 struct  INetworkChat;
 class   CGameNetworkProfile;
 #include "MPLobbyUI.h"
-struct  SStoredServer;
+#include "GameNetworkProfile.h" // !!CryFire - modded: was a forward declaration of SStoredServer
 
 class CMultiPlayerMenu
 {
@@ -39,6 +39,7 @@ public:
 	~CMultiPlayerMenu();
 	bool HandleFSCommand(EGsUiCommand cmd, const char* pArgs);
   void OnUIEvent(const SUIEvent& event);
+  void OnUpdate(); // !!CryFire - added: pushes the server list changes of this frame to Flash
 private:
   void    DisplayServerList();
   void    SetServerListPos(double sb_pos);
@@ -61,6 +62,8 @@ private:
   bool                        m_lan;
   std::vector<SStoredServer>  m_favouriteServers;
   std::vector<SStoredServer>  m_recentServers;
+  CStoredServerSet            m_favouriteSet; // !!CryFire - added: same servers as the vectors, by ip:port
+  CStoredServerSet            m_recentSet;    // !!CryFire - added
   CMPHub*                     m_hub;
 	bool												m_joiningServer;
   
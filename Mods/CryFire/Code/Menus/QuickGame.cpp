@@ -21,6 +21,7 @@ History:
 #include "GameCVars.h"
 #include "MPHub.h"
 #include "GameNetworkProfile.h"
+#include "CryFire/ServerSelection.h" // !!CryFire - added
 
 class CQuickGameDlg : public CMPHub::CDialog
 {
@@ -194,18 +195,7 @@ struct CQuickGame::SQGServerList : public IServerListener
     srv.mode = info->m_gameType;
     srv.name = info->m_hostName;
 		srv.country = info->m_country;
-		srv.fav = false;
-		if(m_preferFav)
-		{
-			for(int i = 0; i<m_favorites.size(); ++i)
-			{
-				if(info->m_publicIP == m_favorites[i].ip && info->m_hostPort == m_favorites[i].port)
-				{
-					srv.fav = true;
-					break;
-				}
-			}
-		}
+		srv.fav = m_preferFav && m_favoriteSet.Contains(info->m_publicIP,info->m_hostPort); // !!CryFire - modded: was a scan of m_favorites
 
     if(!m_mapName.empty())
     {
@@ -221,51 +211,57 @@ struct CQuickGame::SQGServerList : public IServerListener
       if(idx != -1)
         m_servers[idx] = srv;
     }
-    else
+    else if(Find(id) == -1)
+    {
+      m_index[id] = m_servers.size(); // !!CryFire - added
       m_servers.push_back(srv);
+    }
   }
 
-  int Find(int id)
+  // !!CryFire - modded: hashed, was a scan of m_servers
+  int Find(int id)const
   {
-    for(int i=0;i<m_servers.size();++i)
-    {
-      if(m_servers[i].id == id)
-      {
-        return i;
-      }
-    }
-    return -1;
+    FlatHashMap<int,int>::const_iterator it = m_index.find(id);
+    return it != m_index.end() ? it->second : -1;
   }
 
+  //-- !!CryFire - modded: the score is computed by CryFire/ServerSelection, so it can be tested
   void ComputeScore(SRatedServer& svr)
   {
-    svr.score = ((128-min(127u,svr.players))<<10) + min(1023u, svr.ping);
-    if(svr.ping > m_ping1)
-      svr.score += 1<<20;
-
-    if(svr.players < (svr.maxplayers/2))
-      svr.score += 1<<21;
-		if(m_preferCountry)
-		{
-			if(svr.country == m_country)
-				svr.score += 1<<22;
-		}
-		if(svr.ping > m_ping2)
-			svr.score += 1<<23;
-		if(m_preferFav)
-		{
-			if(!svr.fav)
-				svr.score += 1<<24;
-		}
-    if(!svr.mapmatch)
-      svr.score += 1<<25;
+    ServerSelection::QuickGamePreferences preferences;
+    preferences.ping1 = m_ping1;
+    preferences.ping2 = m_ping2;
+    preferences.preferCountry = m_preferCountry;
+    preferences.country = m_country.c_str();
+    preferences.preferFavorites = m_preferFav;
+
+    ServerSelection::QuickGameServer server;
+    server.players = svr.players;
+    server.maxPlayers = svr.maxplayers;
+    server.ping = svr.ping;
+    server.country = svr.country.c_str();
+    server.favorite = svr.fav;
+    server.mapMatch = svr.mapmatch;
+
+    svr.score = ServerSelection::quickGameScore(server, preferences);
   }
+  //------
 
   virtual void RemoveServer(const int id)
   {
     int idx = Find(id);
     if(idx!=-1)
-      m_servers.erase(m_servers.begin()+idx);
+    {
+      //-- !!CryFire - modded: the order doesn't matter until the servers are sorted, move the last one here
+      m_index.erase(id);
+      if(idx != m_servers.size()-1)
+      {
+        m_servers[idx] = m_servers.back();
+        m_index[m_servers[idx].id] = idx;
+      }
+      m_servers.pop_back();
+      //------
+    }
   }
 
   virtual void UpdatePing(const int id,const int ping)
@@ -314,6 +310,9 @@ struct CQuickGame::SQGServerList : public IServerListener
 			}
 
       std::sort(m_servers.begin(),m_servers.end());
+      // !!CryFire - added: keep the index valid after sorting
+      for(int i=0;i<m_servers.size();++i)
+        m_index[m_servers[i].id] = i;
     }
 
     m_qg->m_browser->Stop();
@@ -366,8 +365,10 @@ struct CQuickGame::SQGServerList : public IServerListener
   void Reset()
   {
     m_servers.resize(0);
+    m_index.clear(); // !!CryFire - added
   }
   std::vector<SRatedServer> m_servers;
+  FlatHashMap<int,int>      m_index; // !!CryFire - added: server id -> index in m_servers
   string                    m_gameMode;
   string                    m_mapName;
 	string										m_ver;
@@ -379,6 +380,7 @@ struct CQuickGame::SQGServerList : public IServerListener
   uint											m_ping1;
   uint											m_ping2;
 	std::vector<SStoredServer>m_favorites;
+	CStoredServerSet          m_favoriteSet; // !!CryFire - added
   CQuickGame*               m_qg;
 };
 
@@ -433,6 +435,7 @@ void CQuickGame::StartSearch(CMPHub* hub)
 	{
 		if(!m_ui->GetFavorites(m_list->m_favorites))
 			m_list->m_preferFav = false;
+		m_list->m_favoriteSet.Assign(m_list->m_favorites); // !!CryFire - added
 	}
 
   m_searching = true;
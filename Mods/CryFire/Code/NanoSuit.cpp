@@ -23,6 +23,7 @@
 #include "SoundMoods.h"
 #include "WeaponSystem.h"
 #include "OffHand.h"
+#include "CryFire/Telemetry.h"	// !!CryFire - added
 
 #include <ISound.h>
 #include <ISerialize.h>
@@ -213,6 +214,7 @@ void SNanoCloak::Update(CNanoSuit *pNano)
 CNanoSuit::CNanoSuit()
 : m_pGameFramework(0)
 , m_pNanoMaterial(0)
+, m_netEnergy(NANOSUIT_ENERGY, NANOSUIT_ENERGY_NET_STEP)	// !!CryFire - added
 , m_activationTime(0.0f)
 , m_invulnerabilityTimeout(0.0f)
 , m_invulnerable(false)
@@ -350,6 +352,8 @@ void CNanoSuit::SetCloakLevel(ENanoCloakMode mode)
 
 void CNanoSuit::Update(float frameTime)
 {
+	CF_TELEMETRY_SCOPE("NanoSuit.Update");	// !!CryFire - added
+
 	if (!m_pOwner || m_pOwner->GetHealth()<=0 || m_pOwner->IsFrozen())
 		return;
 
@@ -413,7 +417,18 @@ void CNanoSuit::Update(float frameTime)
 	float recharge = 0.0f;
 	float rechargeTime = 20.0f;
 
-	const SPlayerStats stats = *(static_cast<SPlayerStats*>(m_pOwner->GetActorStats()));
+	const SPlayerStats &stats = *(static_cast<SPlayerStats*>(m_pOwner->GetActorStats()));	// !!CryFire - modded: was copied every frame
+
+	//-- !!CryFire - added ---
+	// a full suit of a player who isn't doing anything has nothing to recompute,
+	// only the slots follow the desired values
+	if (IsIdle(stats, currentHealth, maxHealth))
+	{
+		m_now = gEnv->pTimer->GetFrameStartTime().GetMilliSeconds();
+		Balance(m_energy);
+		return;
+	}
+	//------
 
 	if (isAI)
 		rechargeTime=g_pGameCVars->g_AiSuitEnergyRechargeTime;
@@ -551,8 +566,7 @@ void CNanoSuit::Update(float frameTime)
 
 	if (m_energy!=m_lastEnergy)
 	{
-		if (isServer)
-			m_pOwner->GetGameObject()->ChangedNetworkState(CPlayer::ASPECT_NANO_SUIT_ENERGY);
+		MarkEnergyChanged(m_energy);	// !!CryFire - modded: quantized and coalesced with SetSuitEnergy
 
 		// call listeners on nano energy change
 		if (m_listeners.empty() == false)
@@ -613,8 +627,7 @@ void CNanoSuit::Balance(float energy)
 void CNanoSuit::SetSuitEnergy(float value, bool playerInitiated /* = false */)
 {
 	value = clamp(value, 0.0f, NANOSUIT_ENERGY);
-	if (m_pOwner && value!=m_energy && gEnv->bServer)
-		m_pOwner->GetGameObject()->ChangedNetworkState(CPlayer::ASPECT_NANO_SUIT_ENERGY);
+	MarkEnergyChanged(value);	// !!CryFire - modded
 
 	if (!gEnv->bMultiplayer)
 	{
@@ -1638,8 +1651,34 @@ void CNanoSuit::ResetEnergy()
 		m_slots[i].realVal = m_slots[i].desiredVal;
 
 	if (m_pOwner && gEnv->bServer)
+	{
+		m_netEnergy.setSent(m_energy);	// !!CryFire - added
+		m_pOwner->GetGameObject()->ChangedNetworkState(CPlayer::ASPECT_NANO_SUIT_ENERGY);
+	}
+}
+
+//-- !!CryFire - added ---
+// Only on a dedicated server, where nobody sees the motion blur and hears the suit sounds.
+// Everything that Update would change is either at its limit or not running.
+bool CNanoSuit::IsIdle(const SPlayerStats &stats, int32 health, int32 maxHealth) const
+{
+	if (!gEnv->bServer || !gEnv->pSystem->IsDedicated())
+		return false;
+
+	return m_energy >= NANOSUIT_ENERGY && m_lastEnergy == m_energy
+		&& health >= maxHealth
+		&& !m_cloak.m_active
+		&& !stats.bSprinting && !m_bWasSprinting
+		&& m_energyRechargeDelay <= 0.0f && m_healthRegenDelay <= 0.0f;
+}
+
+// quantized by NANOSUIT_ENERGY_NET_STEP, see SuitEnergySync
+void CNanoSuit::MarkEnergyChanged(float value)
+{
+	if (m_pOwner && gEnv->bServer && m_netEnergy.update(value))
 		m_pOwner->GetGameObject()->ChangedNetworkState(CPlayer::ASPECT_NANO_SUIT_ENERGY);
 }
+//------
 
 
 void CNanoSuit::GetMemoryStatistics(ICrySizer * s)
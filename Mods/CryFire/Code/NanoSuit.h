@@ -19,9 +19,12 @@
 # pragma once
 #endif
 
+#include "CryFire/SuitEnergySync.h" // !!CryFire - added
+
 static const float NANOSUIT_ENERGY								= 200.0f;
 static const float NANOSUIT_HEALTH_REGEN_INTERVAL	= 1.0f;
 static const float NANOSUIT_MAXIMUM_HEALTH_REGEN	= 40.0f;
+static const float NANOSUIT_ENERGY_NET_STEP				= 1.0f;	// !!CryFire - added: smaller energy changes are not marked for the network
 
 enum ENanoSlot
 {
@@ -264,6 +267,10 @@ private:
 	bool SetAllSlots(float armor, float strength, float speed);
 	int  GetButtonFromMode(ENanoMode mode);
 	void UpdateSprinting(float &recharge, const SPlayerStats &stats, float frametime);
+	//-- !!CryFire - added ---
+	bool IsIdle(const SPlayerStats &stats, int32 health, int32 maxHealth) const;
+	void MarkEnergyChanged(float value);
+	//------
 
 	IGameFramework *m_pGameFramework;
 	
@@ -277,6 +284,7 @@ private:
 	// basic variables
 	float m_energy;
 	float m_lastEnergy;
+	SuitEnergySync m_netEnergy;	// !!CryFire - added: energy when the network aspect was marked the last time
 	float m_energyRechargeRate;
 	float m_healthAccError;
 	float m_healthRegenRate;
@@ -7,6 +7,7 @@
 #include "Player.h"
 #include "Game.h"
 #include "GameCVars.h"
+#include "CryFire/NetStats.h" // !!CryFire - added: network traffic accounting
 
 
 /*
@@ -45,6 +46,7 @@ static Vec3 HermiteInterpolate( float s, const Vec3& p1, const Vec3& t1, const V
 
 CNetPlayerInput::CNetPlayerInput( CPlayer * pPlayer ) : m_pPlayer(pPlayer)
 {
+	Quantize( m_curInput, m_lastSentInput ); // !!CryFire - added
 }
 
 void CNetPlayerInput::PreUpdate()
@@ -187,7 +189,7 @@ void CNetPlayerInput::Update()
 		m_curInput.sprint=m_curInput.leanl=m_curInput.leanr=false;
 		m_curInput.stance=STANCE_NULL;
 
-		m_pPlayer->GetGameObject()->ChangedNetworkState( INPUT_ASPECT );
+		MarkInputChanged(); // !!CryFire - modded
 	}
 }
 
@@ -215,7 +217,7 @@ void CNetPlayerInput::Reset()
 
 	DoSetState(i);
 
-	m_pPlayer->GetGameObject()->ChangedNetworkState(IPlayerInput::INPUT_ASPECT);
+	MarkInputChanged(); // !!CryFire - modded
 }
 
 void CNetPlayerInput::DisableXI(bool disabled)
@@ -226,7 +228,26 @@ void CNetPlayerInput::DisableXI(bool disabled)
 void CNetPlayerInput::DoSetState(const SSerializedPlayerInput& input )
 {
 	m_curInput = input;
-	m_pPlayer->GetGameObject()->ChangedNetworkState( INPUT_ASPECT );
+	//-- !!CryFire - modded: don't resend the input, when the change is below the quantization step
+	if (gEnv->bServer && g_pGameCVars->cf_input_quantize)
+	{
+		SQuantizedInput quantized;
+		Quantize( m_curInput, quantized );
+		if (quantized == m_lastSentInput)
+		{
+			NetStats::onInputSkipped( m_pPlayer->GetChannelId() );
+		}
+		else
+		{
+			m_lastSentInput = quantized;
+			m_pPlayer->GetGameObject()->ChangedNetworkState( INPUT_ASPECT );
+		}
+	}
+	else
+	{
+		m_pPlayer->GetGameObject()->ChangedNetworkState( INPUT_ASPECT );
+	}
+	//------------------------------------------------------------------------
 
 	CMovementRequest moveRequest;
 	moveRequest.SetStance( (EStance)m_curInput.stance );
@@ -273,3 +294,17 @@ void CNetPlayerInput::DoSetState(const SSerializedPlayerInput& input )
 		pPD->AddDirection( wp, 1.5f, m_curInput.lookDirection, ColorF(0,1,0,1), 1.0f );
 	}
 }
+
+//-- !!CryFire - added ---------------------------------------------------
+// error bounds are documented in CryFire/InputQuantizer.h
+void CNetPlayerInput::Quantize( const SSerializedPlayerInput& input, SQuantizedInput& quantized )
+{
+	quantized.quantize( input, g_pGameCVars->cf_input_move_bits, g_pGameCVars->cf_input_yaw_bits, g_pGameCVars->cf_input_pitch_bits );
+}
+
+void CNetPlayerInput::MarkInputChanged()
+{
+	Quantize( m_curInput, m_lastSentInput );
+	m_pPlayer->GetGameObject()->ChangedNetworkState( INPUT_ASPECT );
+}
+//------------------------------------------------------------------------
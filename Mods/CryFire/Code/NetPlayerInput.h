@@ -8,6 +8,7 @@
 #pragma once
 
 #include "IPlayerInput.h"
+#include "CryFire/InputQuantizer.h" // !!CryFire - added
 
 class CPlayer;
 
@@ -46,6 +47,14 @@ private:
 
 	void DoSetState( const SSerializedPlayerInput& input );
 
+	//-- !!CryFire - added ---------------------------------------------------
+	// server marks the aspect dirty only when the quantized input changes since the last time it was marked
+	static void Quantize( const SSerializedPlayerInput& input, SQuantizedInput& quantized );
+	void MarkInputChanged();
+
+	SQuantizedInput m_lastSentInput;
+	//------------------------------------------------------------------------
+
 	CTimeValue m_lastUpdate;
 
 	struct SPrevPos
@@ -26,6 +26,7 @@ History:
 #include "HUD/HUDCrosshair.h"
 #include "WeaponSystem.h"
 #include "Projectile.h"
+#include "CryFire/PickupIndex.h" // !!CryFire - added
 
 #define KILL_NPC_TIMEOUT	7.25f
 #define TIME_TO_UPDATE_CH 0.25f
@@ -705,23 +706,12 @@ void COffHand::UpdateCrosshairUsabilitySP()
 				else if(pItem)
 				{
 					CryFixedStringT<128> itemName = "@";
-					itemName.append(pItem->GetEntity()->GetClass()->GetName());
-					if(!strcmp(pItem->GetEntity()->GetClass()->GetName(), "CustomAmmoPickup"))
-					{
-						SmartScriptTable props;
-						if (pItem->GetEntity()->GetScriptTable() && pItem->GetEntity()->GetScriptTable()->GetValue("Properties", props))
-						{
-							const char *name = NULL;
-							props->GetValue("AmmoName", name);
-							itemName = "@";
-							itemName.append(name);
-						}
-					}
+					itemName.append(PickupIndex::getShownName(pItem->GetEntity())); // !!CryFire - modded: resolved once per item
 
 					if(pItem->GetIWeapon())
 					{
 						IEntityClass *pItemClass = pItem->GetEntity()->GetClass();
-						bool isSocom = strcmp(pItemClass->GetName(),"SOCOM")?false:true;
+						bool isSocom = PickupIndex::getClassInfo(pItemClass).dualWield; // !!CryFire - modded
 						IItem *pCurrentItem = g_pGame->GetIGameFramework()->GetIItemSystem()->GetItem(pPlayer->GetInventory()->GetItemByClass(pItemClass));
 						if((!isSocom && pCurrentItem) ||
 								(isSocom && pCurrentItem && pCurrentItem->IsDualWield()))
@@ -734,7 +724,8 @@ void COffHand::UpdateCrosshairUsabilitySP()
 						else
 						{
 							int typ = CanPerformPickUp(GetOwnerActor(),NULL,true);
-							if(m_preHeldEntityId && !pPlayer->CheckInventoryRestrictions(m_pEntitySystem->GetEntity(m_preHeldEntityId)->GetClass()->GetName()))
+							IEntity *pPreHeldEntity = m_pEntitySystem->GetEntity(m_preHeldEntityId); // !!CryFire - modded: only classes under the weapon limit are checked
+							if(pPreHeldEntity && PickupIndex::getClassInfo(pPreHeldEntity->GetClass()).checkLimit && !pPlayer->CheckInventoryRestrictions(pPreHeldEntity->GetClass()->GetName()))
 							{
 								IItem *pExchangedItem = GetExchangeItem(pPlayer);
 								if(pExchangedItem)
@@ -810,22 +801,12 @@ void COffHand::UpdateCrosshairUsabilityMP()
 				
 				if(CItem *pItem = static_cast<CItem*>(m_pItemSystem->GetItem(m_crosshairId)))
 				{
-					CryFixedStringT<128> itemName = pItem->GetEntity()->GetClass()->GetName();
-					if(!strcmp(itemName.c_str(), "CustomAmmoPickup"))
-					{
-						SmartScriptTable props;
-						if (pItem->GetEntity()->GetScriptTable() && pItem->GetEntity()->GetScriptTable()->GetValue("Properties", props))
-						{
-							const char *name = NULL;
-							props->GetValue("AmmoName", name);
-							itemName = name;
-						}
-					}
+					CryFixedStringT<128> itemName = PickupIndex::getShownName(pItem->GetEntity()); // !!CryFire - modded: resolved once per item
 
 					if(pItem->GetIWeapon())
 					{
 						IEntityClass *pItemClass = pItem->GetEntity()->GetClass();
-						bool isSocom = strcmp(pItemClass->GetName(),"SOCOM")?false:true;
+						bool isSocom = PickupIndex::getClassInfo(pItemClass).dualWield; // !!CryFire - modded
 						IItem *pCurrentItem = g_pGame->GetIGameFramework()->GetIItemSystem()->GetItem(pPlayer->GetInventory()->GetItemByClass(pItemClass));
 						if((!isSocom && pCurrentItem) ||
 							(isSocom && pCurrentItem && pCurrentItem->IsDualWield()))
@@ -838,7 +819,8 @@ void COffHand::UpdateCrosshairUsabilityMP()
 						else
 						{
 							int typ = CanPerformPickUp(GetOwnerActor(),NULL,true);
-							if(m_preHeldEntityId && !pPlayer->CheckInventoryRestrictions(m_pEntitySystem->GetEntity(m_preHeldEntityId)->GetClass()->GetName()))
+							IEntity *pPreHeldEntity = m_pEntitySystem->GetEntity(m_preHeldEntityId); // !!CryFire - modded: only classes under the weapon limit are checked
+							if(pPreHeldEntity && PickupIndex::getClassInfo(pPreHeldEntity->GetClass()).checkLimit && !pPlayer->CheckInventoryRestrictions(pPreHeldEntity->GetClass()->GetName()))
 							{
 								IItem *pExchangedItem = GetExchangeItem(pPlayer);
 								if(pExchangedItem)
@@ -2052,41 +2034,25 @@ int COffHand::CheckItemsInProximity(Vec3 pos, Vec3 dir, bool getEntityInfo)
 	float sizeZup = 0.5f;
 	float sizeZdown = 1.75f;
 
-	SEntityProximityQuery query;
-	query.box = AABB(Vec3(pos.x-sizeX,pos.y-sizeY,pos.z-sizeZdown),
+	//-- !!CryFire - modded: only items lying in the world are tested, was every entity in the box
+	AABB box(Vec3(pos.x-sizeX,pos.y-sizeY,pos.z-sizeZdown),
 		Vec3(pos.x+sizeX,pos.y+sizeY,pos.z+sizeZup));
-	query.nEntityFlags = ~0; // Filter by entity flag.
 
-	float minDstSqr = 0.2f;
+	static PickupIndex::Hits hits;
+	PickupIndex::queryCone(box, pos, dir, 0.2f, hits);
+
 	EntityId nearItemId = 0;
-	int count=gEnv->pEntitySystem->QueryProximity(query);
-	for(int i=0; i<query.nCount; i++)
+	for(int i=0; i<hits.size(); i++)
 	{
-		EntityId id=query.pEntities[i]->GetId();
-
-		if (CItem *pItem=static_cast<CItem*>(m_pItemSystem->GetItem(id)))
+		// nearest to the aim first
+		CItem *pItem=static_cast<CItem*>(m_pItemSystem->GetItem(hits[i].id));
+		if (pItem && pItem->GetOwnerId()!=GetOwnerId() && pItem->CanPickUp(GetOwnerId()))
 		{
-			if (pItem->GetOwnerId()!=GetOwnerId())
-			{
-				Line line(pos,dir);
-				AABB bbox;
-				pItem->GetEntity()->GetWorldBounds(bbox);
-				Vec3 itemPos = bbox.GetCenter();
-				if (dir.Dot(itemPos-pos)>0.0f)
-				{
-					float dstSqr = LinePointDistanceSqr(line,itemPos);
-					if(dstSqr<0.2f)
-					{
-						if((dstSqr<minDstSqr) && pItem->CanPickUp(GetOwnerId()))
-						{
-							minDstSqr = dstSqr;
-							nearItemId = id;
-						}
-					}
-				}
-			}
+			nearItemId = hits[i].id;
+			break;
 		}
 	}
+	//------
 
 	if(IEntity* pEntity = m_pEntitySystem->GetEntity(nearItemId))
 	{
@@ -2430,17 +2396,7 @@ void COffHand::StartPickUpItem()
 	{
 		if(!pItem->CheckAmmoRestrictions(pPlayer->GetEntityId()))
 		{
-			CryFixedStringT<128> itemName = pItem->GetEntity()->GetClass()->GetName();
-			if(!stricmp(itemName.c_str(), "CustomAmmoPickup"))
-			{
-				SmartScriptTable props;
-				if (pItem->GetEntity()->GetScriptTable() && pItem->GetEntity()->GetScriptTable()->GetValue("Properties", props))
-				{
-					const char *name = NULL;
-					if(props->GetValue("AmmoName", name))
-						itemName = name;
-				}
-			}
+			CryFixedStringT<128> itemName = PickupIndex::getShownName(pItem->GetEntity()); // !!CryFire - modded
 			if(g_pGame->GetHUD())
 			{
 				CryFixedStringT<128> temp = "@";
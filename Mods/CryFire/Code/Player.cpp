@@ -69,6 +69,9 @@ History:
 #include "Binocular.h"
 #include "SoundMoods.h"
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+
 // enable this to check nan's on position updates... useful for debugging some weird crashes
 #define ENABLE_NAN_CHECK
 
@@ -2061,17 +2064,18 @@ void CPlayer::UpdateScriptStats(SmartScriptTable &rTable)
 	m_stats.firstPersonBody.SetDirtyValue(stats, "firstPersonBody");
 	m_stats.isOnLadder.SetDirtyValue(stats, "isOnLadder");
 
-	stats.SetValue("gravityBoots",GravityBootsOn());
+	m_scriptStats.set("gravityBoots",GravityBootsOn()); // !!CryFire - modded
 	m_stats.inFreefall.SetDirtyValue(stats, "inFreeFall");
 
 	//nanosuit stats
 	//FIXME:create a CNanoSuit::GetStats instead?
 	//stats.SetValue("nanoSuitHeal", (m_pNanoSuit)?m_pNanoSuit->GetHealthRegenRate():0);
-	stats.SetValue("nanoSuitArmor",(m_pNanoSuit)?m_pNanoSuit->GetSlotValue(NANOSLOT_ARMOR):0);
-	stats.SetValue("nanoSuitStrength", (m_pNanoSuit)?m_pNanoSuit->GetSlotValue(NANOSLOT_STRENGTH):0);
+	// !!CryFire - modded: written only when changed
+	m_scriptStats.set("nanoSuitArmor",(m_pNanoSuit)?m_pNanoSuit->GetSlotValue(NANOSLOT_ARMOR):0.0f);
+	m_scriptStats.set("nanoSuitStrength", (m_pNanoSuit)?m_pNanoSuit->GetSlotValue(NANOSLOT_STRENGTH):0.0f);
 	//stats.SetValue("cloakState",(m_pNanoSuit)?m_pNanoSuit->GetCloak()->GetState():0);	
 	//stats.SetValue("visualDamp",(m_pNanoSuit)?m_pNanoSuit->GetCloak()->GetVisualDamp():0);
-	stats.SetValue("soundDamp",(m_pNanoSuit)?m_pNanoSuit->GetCloak()->GetSoundDamp():0);
+	m_scriptStats.set("soundDamp",(m_pNanoSuit)?m_pNanoSuit->GetCloak()->GetSoundDamp():0.0f);
 	//stats.SetValue("heatDamp",(m_pNanoSuit)?m_pNanoSuit->GetCloak()->GetHeatDamp():0);
 }
 
@@ -3284,7 +3288,7 @@ void CPlayer::Kill()
 
 	// notify any claymores/mines that this player has died
 	//	(they will be removed 30s later)
-	if (gEnv->pConsole->GetCVar("cf_removeexplosives")->GetIVal() == 1)
+	if (g_pGameCVars->cf_removeexplosives == 1) // !!CryFire - modded
 		RemoveAllExplosives(EXPLOSIVE_REMOVAL_TIME);
 
 	CActor::Kill();
@@ -4089,6 +4093,28 @@ bool CPlayer::NetSerialize( TSerialize ser, EEntityAspects aspect, uint8 profile
 
 		ser.Value("VehicleViewRotation", m_vehicleViewDir, 'dir0');
 	}
+
+	//-- !!CryFire - added: network traffic accounting -------------------
+	// only an estimate, the uncompressed size of the values serialized above, keep it in sync with them,
+	// the input comes from the owning client, so it's sent only to the others
+	if (gEnv->bServer && ser.IsWriting())
+	{
+		uint estimatedSize = 0;
+		if (aspect == ASPECT_HEALTH)
+			estimatedSize += sizeof(float) + sizeof(bool) + sizeof(float);
+		if (aspect == ASPECT_CURRENT_ITEM)
+			estimatedSize += sizeof(bool) + sizeof(EntityId);
+		if (aspect == ASPECT_NANO_SUIT_SETTING)
+			estimatedSize += sizeof(uint8);
+		if (aspect == ASPECT_NANO_SUIT_ENERGY)
+			estimatedSize += sizeof(float) + sizeof(bool) + sizeof(float);
+		if (aspect == IPlayerInput::INPUT_ASPECT)
+			estimatedSize += sizeof(uint8) + 2*sizeof(Vec3) + 3*sizeof(bool) + sizeof(Vec3);
+		if (estimatedSize)
+			NetStats::onAspectSerialized(aspect, estimatedSize, aspect == IPlayerInput::INPUT_ASPECT ? GetChannelId() : 0);
+	}
+	//--------------------------------------------------------------------
+
 	return true;
 }
 
@@ -5118,6 +5144,12 @@ void CPlayer::SetSpectatorMode(uint8 mode, EntityId targetId)
 		if(mode == CActor::eASM_Follow)
 			MoveToSpectatorTargetPosition();
 	}
+
+	// !!CryFire - added: spectators are dead, both decide who hears the chat of this player
+	if (oldSpectatorMode!=mode)
+		if (CGameRules *pGameRules=g_pGame->GetGameRules())
+			pGameRules->InvalidateChatStatus(GetEntityId());
+
 	/*
 	// switch on/off spectator HUD
 	if (IsClient())
@@ -5672,6 +5704,8 @@ void CPlayer::LeaveLadder(ELadderActionType reason)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestGrabOnLadder)
 {
+	CF_COUNT_RMI("RequestGrabOnLadder");
+
 	if(IsLadderUsable() && m_stats.ladderTop.IsEquivalent(params.topPos) && m_stats.ladderBottom.IsEquivalent(params.bottomPos))
 	{
 		GrabOnLadder(static_cast<ELadderActionType>(params.reason));
@@ -5682,6 +5716,8 @@ IMPLEMENT_RMI(CPlayer, SvRequestGrabOnLadder)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestLeaveLadder)
 {
+	CF_COUNT_RMI("RequestLeaveLadder");
+
 	if(m_stats.isOnLadder)
 	{
 		if(m_stats.ladderTop.IsEquivalent(params.topPos) && m_stats.ladderBottom.IsEquivalent(params.bottomPos))
@@ -6330,6 +6366,8 @@ bool CPlayer::IsSprinting()
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestUnfreeze)
 {
+	CF_COUNT_RMI("RequestUnfreeze");
+
 	if (params.delta>0.0f && params.delta <=1.0f && GetHealth()>0)
 	{
 		SetFrozenAmount(m_frozenAmount-params.delta);
@@ -6346,6 +6384,8 @@ IMPLEMENT_RMI(CPlayer, SvRequestUnfreeze)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestHitAssistance)
 {
+	CF_COUNT_RMI("RequestHitAssistance");
+
 	m_bHasAssistance=params.assistance;
 	return true;
 }
@@ -6387,6 +6427,8 @@ IMPLEMENT_RMI(CPlayer, ClJump)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestJump)
 {
+	CF_COUNT_RMI("RequestJump");
+
 	GetGameObject()->InvokeRMI(ClJump(), params, eRMI_ToOtherClients|eRMI_NoLocalCalls, m_pGameFramework->GetGameChannelId(pNetChannel));
 	GetGameObject()->Pulse('bang');
 
@@ -6409,6 +6451,8 @@ IMPLEMENT_RMI(CPlayer, SvRequestJump)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CPlayer, SvRequestParachute)
 {
+	CF_COUNT_RMI("RequestParachute");
+
 	if (!IsClient() && m_parachuteEnabled && (m_stats.inFreefall.Value()==1))
 	{
 		ChangeParachuteState(3);
@@ -941,6 +941,41 @@ void CPlayerMovement::ProcessParachute()
 
 //-----------------------------------------------------------------------------------------------
 //-----------------------------------------------------------------------------------------------
+//-- !!CryFire - added ---
+// The same multipliers as ProcessOnGroundOrJumping with AdjustMovementForEnvironment, ProcessSwimming
+// and ProcessMovementOnLadder, each at its maximum, so it stays an upper bound, when they change.
+float CPlayerMovement::GetMaxSpeed(CPlayer& player)
+{
+	const SPlayerStats& stats = player.m_stats;
+	if (player.GetHealth() <= 0 || player.GetSpectatorMode() || player.GetLinkedVehicle() || stats.isRagDoll || stats.isFrozen
+	    || stats.inZeroG || stats.inFreefall || stats.flyMode || player.GetEntity()->GetParent())
+		return 0.0f;
+
+	CNanoSuit* pSuit = player.GetNanoSuit();
+	float suitSprintMult = pSuit ? max(1.0f, pSuit->GetSprintMultiplier(false)) : 1.0f;
+
+	if (stats.isOnLadder)
+		return player.GetStanceMaxSpeed(STANCE_STAND) * 0.5f * max(1.2f, suitSprintMult * 0.5f);
+
+	if (player.ShouldSwim())
+	{
+		float sprintMult = max(g_pGameCVars->pl_swimNormalSprintSpeedMul, g_pGameCVars->pl_swimSpeedSprintSpeedMul);
+		sprintMult *= max(1.0f, g_pGameCVars->pl_swimUpSprintSpeedMul);
+		return g_pGameCVars->pl_swimBaseSpeed * sprintMult;
+	}
+
+	float nanoSpeedMul = 1.0f;
+	if (pSuit)
+	{
+		if (gEnv->bMultiplayer)
+			nanoSpeedMul = pSuit->GetMode() == NANOMODE_SPEED ? max(1.3f, 1.0f + pSuit->GetSlotValue(NANOSLOT_SPEED) * 0.01f * 0.5f) : 1.0f;
+		else
+			nanoSpeedMul = 1.0f + max(100.0f, pSuit->GetSlotValue(NANOSLOT_SPEED)) * 0.01f;
+	}
+	return player.GetStanceMaxSpeed(STANCE_STAND) * player.m_params.sprintMultiplier * suitSprintMult * nanoSpeedMul;
+}
+//------
+
 void CPlayerMovement::ProcessOnGroundOrJumping(CPlayer& player)
 {
 	//process movement
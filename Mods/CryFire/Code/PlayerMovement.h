@@ -19,6 +19,10 @@ public:
 	void Process( CPlayer& player );
 	void Commit( CPlayer& player );
 
+	// !!CryFire - added: the highest horizontal speed, which the movement can request for the player now,
+	// 0 if it isn't bounded by the player movement (vehicle, zero gravity, free fall, ...)
+	static float GetMaxSpeed( CPlayer& player );
+
 private:
 	const float m_frameTime;
 	const SPlayerParams& m_params;
@@ -27,7 +27,9 @@
 #include "HUD/HUD.h"
 #include "HUD/HUDRadar.h"
 
-CSPAnalyst::CSPAnalyst() : m_bEnabled(false), m_bChainLoad(false), m_fUpdateTimer(0.0f), m_iTimesFired(0)
+#include <ctime> // !!CryFire - added
+
+CSPAnalyst::CSPAnalyst() : m_bEnabled(false), m_bChainLoad(false), m_fUpdateTimer(0.0f)
 {
 	IGameFramework* pGF = g_pGame->GetIGameFramework();
 	pGF->GetILevelSystem()->AddListener(this);
@@ -36,7 +38,7 @@ CSPAnalyst::CSPAnalyst() : m_bEnabled(false), m_bChainLoad(false), m_fUpdateTime
 
 CSPAnalyst::~CSPAnalyst()
 {
-	WriteXML();
+	GameplayRecorder::terminate(); // !!CryFire - modded
 	IGameFramework* pGF = g_pGame->GetIGameFramework();
 	if (m_bEnabled)
 		pGF->GetIGameplayRecorder()->UnregisterListener(this);
@@ -61,21 +63,21 @@ void CSPAnalyst::Enable(bool bEnable)
 
 void CSPAnalyst::OnPostUpdate(float fDeltaTime)
 {
-	if(!m_bEnabled)
-		return;
-
-	if(g_pGameCVars->g_spRecordGameplay)
+	// !!CryFire - modded: the recording doesn't depend on the SP analysis, the server records all players
+	if(g_pGameCVars->g_spRecordGameplay && gEnv->bServer)
 	{
-		if(!m_recordingData)
+		if(!GameplayRecorder::isRecording())
 			StartRecording();
 
 		m_fUpdateTimer += fDeltaTime;
 		if(m_fUpdateTimer >= g_pGameCVars->g_spGameplayRecorderUpdateRate)
 		{
-			RecordGameplayFrame();
+			GameplayRecorder::recordFrame((gEnv->pTimer->GetFrameStartTime()-m_gameAnalysis.levelStartTime).GetSeconds());
 			m_fUpdateTimer = 0.0f;
 		}
 	}
+	else if(GameplayRecorder::isRecording())
+		GameplayRecorder::stop();
 }
 
 bool CSPAnalyst::IsPlayer(EntityId entityId) const
@@ -128,69 +130,7 @@ void CSPAnalyst::OnGameplayEvent(IEntity *pEntity, const GameplayEvent &event)
 		}
 		// called in SP as well
 		break;
-	case eGE_ItemSelected:
-	case eGE_ItemPickedUp:
-	case eGE_ItemDropped:
-		{
-			if(event.extra)
-			{
-				EntityId entityId = EntityId((int)(event.extra));
-				if(IItem* pItem = g_pGame->GetIGameFramework()->GetIItemSystem()->GetItem(entityId))
-				{
-					if(event.event == eGE_ItemSelected)
-						WriteValue("event.itemSelected", string(pItem->GetEntity()->GetClass()->GetName()));
-					else if(event.event == eGE_ItemPickedUp)
-						WriteValue("event.itemPickedUp", string(pItem->GetEntity()->GetClass()->GetName()));
-					else if(event.event == eGE_ItemDropped)
-						WriteValue("event.itemDropped", string(pItem->GetEntity()->GetClass()->GetName()));
-				}
-			}
-		}
-		break;
-	case eGE_EnteredVehicle:
-		{
-			if(event.extra)
-			{
-				EntityId entityId = EntityId((int)(event.extra));
-				if(IVehicle *pVehicle = g_pGame->GetIGameFramework()->GetIVehicleSystem()->GetVehicle(entityId))
-					WriteValue("EnteredVehicle", pVehicle->GetEntity()->GetClass()->GetName());
-				else
-					WriteValue("EnteredVehicle", int(entityId));
-			}
-		}
-		break;
-	case eGE_LeftVehicle:
-		{
-			if(event.extra)
-			{
-				EntityId entityId = EntityId((int)(event.extra));
-				if(IVehicle *pVehicle = g_pGame->GetIGameFramework()->GetIVehicleSystem()->GetVehicle(entityId))
-					WriteValue("EnteredVehicle", pVehicle->GetEntity()->GetClass()->GetName());
-				else
-					WriteValue("EnteredVehicle", int(entityId));
-			}
-		}
-		break;
-	case eGE_WeaponShot:
-		{
-			if(g_pGameCVars->g_spRecordGameplay && m_bEnabled)
-				m_iTimesFired++;
-		}
-		break;
-	case eGE_WeaponReload:
-		{
-			WriteValue("WeaponReload", int(eGE_WeaponReload));
-		}
-		break;
-	case eGE_Death:
-		{
-			WriteValue("PlayerDeath", int(eGE_Death));
-		}
-	case eGE_Disconnected:
-		{
-			WriteValue("GameDisconnected", int(eGE_Disconnected));
-		}
-		break;
+	// !!CryFire - modded: items, vehicles, shots, reloads and deaths are recorded by GameplayRecorder
 	case eGE_GameEnd:
 		{
 			int a = 0;
@@ -257,7 +197,7 @@ void CSPAnalyst::OnLoadingStart(ILevelInfo *pLevelInfo)
 	if (pLevelInfo == 0)
 		return;
 
-	WriteXML(); //close old record
+	GameplayRecorder::stop(); //close old record // !!CryFire - modded
 
 	// when we load 'Island' the Game starts
 	if (stricmp(pLevelInfo->GetName(), "island") == 0 || !m_bChainLoad)
@@ -272,7 +212,7 @@ void CSPAnalyst::OnLoadingStart(ILevelInfo *pLevelInfo)
 
 void CSPAnalyst::OnLoadingComplete(ILevel *pLevel)
 {
-	if(g_pGameCVars->g_spRecordGameplay)
+	if(g_pGameCVars->g_spRecordGameplay && gEnv->bServer) // !!CryFire - modded
 		StartRecording();
 }
 
@@ -288,12 +228,12 @@ void CSPAnalyst::OnSaveGame(ISaveGame* pSaveGame)
 	pSaveGame->AddMetadata("sp_levelPlayTime", (int)((now-m_gameAnalysis.levelStartTime).GetSeconds()));
 	pSaveGame->AddMetadata("sp_gamePlayTime", (int)((now-m_gameAnalysis.gameStartTime).GetSeconds()));
 
-	WriteValue("event.gameSaved", pSaveGame->GetFileName());
+	GameplayRecorder::recordEvent(GameplayRecorder::eGameSaved, 0, pSaveGame->GetFileName()); // !!CryFire - modded
 }
 
 void CSPAnalyst::OnLoadGame(ILoadGame* pLoadGame)
 {
-	WriteValue("event.gameLoaded", pLoadGame->GetFileName());
+	GameplayRecorder::recordEvent(GameplayRecorder::eGameLoaded, 0, pLoadGame->GetFileName()); // !!CryFire - modded
 }
 
 void CSPAnalyst::OnLevelEnd(const char *nextLevel)
@@ -305,164 +245,14 @@ void CSPAnalyst::StartRecording()
 {
 	if(g_pGame->GetIGameFramework()->IsGameStarted())
 	{
-		m_recordingFileName = string("GameplayRecord_");
-		m_recordingFileName.append(g_pGame->CreateSaveGameName());
-		m_recordingData = GetISystem()->CreateXmlNode(m_recordingFileName.c_str());
-		m_frameCount = 0;
-	}
-}
-
-void CSPAnalyst::RecordGameplayFrame()
-{
-	if(!m_recordingData)
-		return;
-
-	m_currentRecordingSection = GetISystem()->CreateXmlNode("frame");
-	m_frameCount++;
-	if(!m_currentRecordingSection)
-		m_recordingData = m_currentRecordingSection;
-	else
-		m_recordingData->addChild(m_currentRecordingSection);
-
-	WriteValue("nr", m_frameCount);
-	WriteValue("time", (gEnv->pTimer->GetFrameStartTime()-m_gameAnalysis.levelStartTime).GetSeconds());
-
-	if(CPlayer *pPlayer = static_cast<CPlayer*>(g_pGame->GetIGameFramework()->GetClientActor()))
-	{
-		WriteValue("stats.posX", pPlayer->GetEntity()->GetWorldPos().x);
-		WriteValue("stats.posY", pPlayer->GetEntity()->GetWorldPos().y);
-		WriteValue("stats.posZ", pPlayer->GetEntity()->GetWorldPos().z);
-
-		WriteValue("stats.health", pPlayer->GetHealth());
-		WriteValue("stats.kills", m_gameAnalysis.player.kills);
-		WriteValue("stats.weapon", pPlayer->GetCurrentItem()?pPlayer->GetCurrentItem()->GetEntity()->GetClass()->GetName():"none");
-
-		if(CNanoSuit *pSuit = pPlayer->GetNanoSuit())
-		{
-			WriteValue("suit.energy", pSuit->GetSuitEnergy());
-			WriteValue("suit.mode", int(pSuit->GetMode()));
-
-			WriteValue("player.nightvision", pSuit->IsNightVisionEnabled()?"on":"off");
-		}
-
-		WriteValue("player.timesFired", m_iTimesFired);
-		m_iTimesFired = 0;
-
-		if(CHUDRadar *pRadar = g_pGame->GetHUD()->GetRadar())
-		{
-			//WriteValue("player.scopeBinocs", g_pGame->GetHUD()->GetScopes()->IsBinocularsShown()?"on":"off");
-
-			const std::vector<EntityId>* pEntities = pRadar->GetNearbyEntities();
-			int enemyAI, enemyAIAlerted, enemyAIAttacking, enemyAIInVehicle;
-			enemyAI = enemyAIAlerted = enemyAIAttacking = enemyAIInVehicle = 0;
-			int allAI = 0;
-			for(int i = 0; i < pEntities->size(); ++i)
-			{
-				EntityId id = (*pEntities)[i];
-				if(IActor *pActor = g_pGame->GetIGameFramework()->GetIActorSystem()->GetActor(id))
-				{
-					allAI++;
-					IAIObject *pAI = pActor->GetEntity()->GetAI();
-					if(pAI && pAI->IsHostile(pPlayer->GetEntity()->GetAI(), false))
-					{
-						enemyAI++;
-						IUnknownProxy *pAIProxy = pAI->GetProxy();
-						if(pAIProxy)
-						{
-							int alertness = pAIProxy->GetAlertnessState();
-							if(alertness == 1)
-								enemyAIAlerted++;
-							else if(alertness > 1)
-								enemyAIAttacking++;
-
-							if(pAIProxy->GetLinkedVehicleEntityId())
-								enemyAIInVehicle++;
-						}
-					}
-				}
-			}
-
-			WriteValue("ai.all", allAI);
-			WriteValue("ai.alertness", pRadar->GetStealthValue());
-			WriteValue("ai.proximity", enemyAI);
-			WriteValue("ai.proximityAlerted", enemyAIAlerted);
-			WriteValue("ai.proximityAttacking", enemyAIAttacking);
-			WriteValue("ai.proximityVehicle", enemyAIInVehicle);
-		}
-
-		if(IVehicle *pVehicle = pPlayer->GetLinkedVehicle())
-		{
-			WriteValue("vehicle.used", pVehicle->GetEntity()->GetClass()->GetName());
-			WriteValue("vehicle.damage", pVehicle->GetDamageRatio(true));
-		}
-		else
-		{
-			WriteValue("vehicle.used", 0);
-			WriteValue("vehicle.damage", 0);
-		}
-	}
-}
-
-void CSPAnalyst::WriteXML()
-{
-	if(m_recordingData)
-	{
-		const string xmlHeader("<?xml version=\"1.0\"?>\n<?mso-application progid=\"Excel.Sheet\"?>\n");
-
-		char path[256];
-		CryGetCurrentDirectory(256, path);
-		string filename(path);
-		filename.append("\\");
-		filename.append(m_recordingFileName);
-		filename.append(".xml");
-
-		FILE *pFile = gEnv->pCryPak->FOpen(filename,"wb");
-		if (pFile)
-		{
-			_smart_ptr<IXmlStringData> pXmlStrData = m_recordingData->getXMLData( 6000000 );
-			gEnv->pCryPak->FWrite((void*)xmlHeader.c_str(), xmlHeader.size(), 1, pFile);
-			gEnv->pCryPak->FWrite((void*)pXmlStrData->GetString(), pXmlStrData->GetStringLength(), 1, pFile);
-			gEnv->pCryPak->FClose(pFile);
-		}
-		m_recordingData = NULL;
-		m_currentRecordingSection = NULL;
-	}
-}
-
-void CSPAnalyst::WriteToSection(const char* name, int value)
-{
-	if(m_currentRecordingSection)
-	{
-		char buffer[32];
-		itoa(value, buffer, 10);
-		m_currentRecordingSection->setAttr(name, string(buffer));
+		// !!CryFire - modded: one binary file per level and start, cf_convertrecord converts it
+		const char* levelName = g_pGame->GetIGameFramework()->GetLevelName();
+		time_t now = time(NULL);
+		char date[32];
+		strftime(date, sizeof(date), "%Y%m%d_%H%M%S", localtime(&now));
+		string fileName;
+		fileName.Format("GameplayRecord_%s_%s.cfr", levelName ? PathUtil::GetFileName(levelName).c_str() : "none", date);
+		GameplayRecorder::start(fileName.c_str());
+		m_fUpdateTimer = 0.0f;
 	}
 }
-
-void CSPAnalyst::WriteToSection(const char* name, const char* value)
-{
-	WriteToSection(name, string(value));
-}
-
-void CSPAnalyst::WriteToSection(const char* name, string value)
-{
-	if(m_currentRecordingSection)
-		m_currentRecordingSection->setAttr(name, value);
-}
-
-void CSPAnalyst::WriteToSection(const char* name, float value)
-{
-	if(m_currentRecordingSection)
-	{
-		int high = (int)value;
-		int low = int((value-(float)high)*1000.0f);
-		char highbuffer[16];
-		itoa(high, highbuffer, 10);
-		char lowbuffer[16];
-		itoa(low, lowbuffer, 10);
-		string floatAsString(highbuffer);
-		floatAsString.append(".");
-		floatAsString.append(lowbuffer);
-		m_currentRecordingSection->setAttr(name, floatAsString);
-	}
-}
\ No newline at end of file
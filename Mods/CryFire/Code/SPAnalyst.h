@@ -25,6 +25,7 @@
 #include <IGameplayRecorder.h>
 #include <ILevelSystem.h>
 #include <SerializeFwd.h>
+#include "CryFire/GameplayRecorder.h" // !!CryFire - added
 
 struct ISaveGame;
 
@@ -61,7 +62,7 @@ public:
 	virtual void OnActionEvent(const SActionEvent& event) {};
 	// ~IGameFrameworkListener
 
-	ILINE void StopRecording() {WriteXML();}
+	ILINE void StopRecording() {GameplayRecorder::stop();} // !!CryFire - modded
 	ILINE int GetTimePlayed() { return (int)((gEnv->pTimer->GetFrameStartTime()-m_gameAnalysis.levelStartTime).GetSeconds()); }
 
 protected:
@@ -99,19 +100,9 @@ protected:
 
 private:
 
-	//************** XML recording
+	//************** gameplay recording
+	// !!CryFire - modded: the XML document is replaced by GameplayRecorder, which streams into a file
 	void StartRecording();
-	void WriteXML();
-	void RecordGameplayFrame();
-	template<class T> void WriteValue(const char* name, T value)
-	{
-		if(m_recordingData)
-			WriteToSection(name, value);
-	}
-	void WriteToSection(const char* name, int value);
-	void WriteToSection(const char* name, float value);
-	void WriteToSection(const char* name, const char* value);
-	void WriteToSection(const char* name, string value);
 	//***************
 
 protected:
@@ -119,12 +110,8 @@ protected:
 	bool m_bChainLoad;
 	GameAnalysis m_gameAnalysis;
 
-	//XML recording helpers
-	XmlNodeRef	m_recordingData, m_currentRecordingSection;
-	string			m_recordingFileName;
+	//recording helpers
 	float				m_fUpdateTimer;
-	int					m_iTimesFired;
-	int					m_frameCount;
 };
 
 #endif // #define __SPANALYST_H__
\ No newline at end of file
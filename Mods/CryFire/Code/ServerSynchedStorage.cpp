@@ -15,6 +15,24 @@ History:
 #include "ClientSynchedStorage.h"
 #include "Game.h"
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+// !!CryFire - added: deferring values of far entities
+#include "CryFire/Relevancy.h"
+
+static uint GetRawMessageSize(const TSynchedValue &value, bool entity)
+{
+	uint size = sizeof(TSynchedKey) + (entity ? sizeof(EntityId) : 0);
+	switch (value.GetType())
+	{
+	case eSVT_Bool:			return size + sizeof(bool);
+	case eSVT_Float:		return size + sizeof(float);
+	case eSVT_Int:			return size + sizeof(int);
+	case eSVT_EntityId:	return size + sizeof(EntityId);
+	case eSVT_String:		return size + value.GetPtr<string>()->length() + 1;
+	}
+	return size;
+}
 
 void CServerSynchedStorage::Reset()
 {
@@ -57,6 +75,11 @@ void CServerSynchedStorage::ResetChannel(int channelId)
 		eit = next;
 	}
 
+	// !!CryFire - added
+	std::set<SChannelEntityQueueEnt>::iterator dit=m_deferredEntityQueue.lower_bound(SChannelEntityQueueEnt(channelId, 0, 0));
+	while (dit != m_deferredEntityQueue.end() && dit->channel == channelId)
+		m_deferredEntityQueue.erase(dit++);
+
 	if (SChannel *pChannel = GetChannel(channelId))
 	{
 		if (pChannel->pNetChannel)
@@ -83,10 +106,46 @@ void CServerSynchedStorage::AddToGlobalQueue(TSynchedKey key)
 //------------------------------------------------------------------------
 void CServerSynchedStorage::AddToEntityQueue(EntityId entityId, TSynchedKey key)
 {
+	//-- !!CryFire - modded: channels not interested in the entity get the value later
+	InterestSet interest(entityId);
 	for (TChannelMap::iterator it=m_channels.begin(); it!=m_channels.end(); ++it)
 	{
-		if (!it->second.local)
+		if (it->second.local)
+			continue;
+
+		SChannelEntityQueueEnt ent(it->first, entityId, key);
+		if (interest.contains(it->first))
+		{
+			m_deferredEntityQueue.erase(ent);
 			AddToEntityQueueFor(it->first, entityId, key);
+			Relevancy::countImmediate();
+		}
+		else
+		{
+			m_deferredEntityQueue.insert(ent);
+			Relevancy::countDeferred();
+		}
+	}
+	//------------------------------------------------------------------------
+}
+
+//------------------------------------------------------------------------
+// !!CryFire - added
+void CServerSynchedStorage::FlushDeferredEntities(bool all)
+{
+	std::set<SChannelEntityQueueEnt>::iterator it=m_deferredEntityQueue.begin();
+	while (it != m_deferredEntityQueue.end())
+	{
+		if (!all && !Relevancy::isInterested(it->channel, it->entity))
+		{
+			++it;
+			continue;
+		}
+
+		TSynchedValue value;
+		if (GetEntityValue(it->entity, it->key, value))	// could have been removed in the meantime
+			AddToEntityQueueFor(it->channel, it->entity, it->key);
+		m_deferredEntityQueue.erase(it++);
 	}
 }
 
@@ -128,7 +187,10 @@ void CServerSynchedStorage::AddToChannelQueue(int channelId, TSynchedKey key)
 	}
 
 	if (pMsg)
+	{
 		pChannel->pNetChannel->SubstituteSendable(pMsg, 1, &pChannel->lastOrderedMessage, &msgHdl);
+		NetStats::onSynchedMessage(channelId, GetRawMessageSize(value, false)); // !!CryFire - added
+	}
 	else
 	{
 		assert(!"Invalid type!");
@@ -173,7 +235,10 @@ void CServerSynchedStorage::AddToGlobalQueueFor(int channelId, TSynchedKey key)
 	}
 
 	if (pMsg)
+	{
 		pChannel->pNetChannel->SubstituteSendable(pMsg, 1, &pChannel->lastOrderedMessage, &msgHdl);
+		NetStats::onSynchedMessage(channelId, GetRawMessageSize(value, false)); // !!CryFire - added
+	}
 	else
 	{
 		assert(!"Invalid type!");
@@ -218,7 +283,10 @@ void CServerSynchedStorage::AddToEntityQueueFor(int channelId, EntityId entityId
 	}
 
 	if (pMsg)
+	{
 		pChannel->pNetChannel->SubstituteSendable(pMsg, 1, &pChannel->lastOrderedMessage, &msgHdl);
+		NetStats::onSynchedMessage(channelId, GetRawMessageSize(value, true)); // !!CryFire - added
+	}
 	else
 	{
 		assert(!"Invalid type!");
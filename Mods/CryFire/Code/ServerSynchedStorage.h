@@ -23,6 +23,7 @@ History:
 #include "ClientSynchedStorage.h"
 
 #include <deque>
+#include <set>
 
 
 class CServerSynchedStorage:
@@ -55,6 +56,9 @@ public:
 	
 	virtual void FullSynch(int channelId, bool reset);
 
+	// !!CryFire - added: sends deferred entity values, which became interesting for their channel, or all of them
+	void FlushDeferredEntities(bool all);
+
 	virtual void OnClientConnect(int channelId);
 	virtual void OnClientDisconnect(int channelId, bool onhold);
 	virtual void OnClientEnteredGame(int channelId);
@@ -129,6 +133,9 @@ protected:
 
 	TChannelMap							m_channels;
 
+	// !!CryFire - added: entity values not sent yet, because the channel is not interested in the entity
+	std::set<SChannelEntityQueueEnt>	m_deferredEntityQueue;
+
 	CCryMutex								m_mutex;
 };
 
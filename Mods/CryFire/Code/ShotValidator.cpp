@@ -13,6 +13,8 @@ History:
 #include "StdAfx.h"
 #include "ShotValidator.h"
 #include "GameRules.h"
+#include "CryFire/Jobs.h"	// !!CryFire - added
+#include "CryFire/Telemetry.h"	// !!CryFire - added
 
 
 //------------------------------------------------------------------------
@@ -176,7 +178,28 @@ void CShotValidator::Update()
 {
 	FUNCTION_PROFILER(GetISystem(), PROFILE_GAME);
 
-	CTimeValue now=gEnv->pTimer->GetFrameStartTime();
+	Expire(gEnv->pTimer->GetFrameStartTime());	// !!CryFire - modded
+}
+
+//-- !!CryFire - added ---------------------------------------------------
+void CShotValidator::AddUpdateJob()
+{
+	// if the job is postponed to the next frame, it just uses the newer time
+	m_expireTime=gEnv->pTimer->GetFrameStartTime();
+	Jobs::add("ShotValidator::Expire", ExpireJob, this, Jobs::eDeferrable);
+}
+
+void CShotValidator::ExpireJob(void *pValidator)
+{
+	CShotValidator *pThis=static_cast<CShotValidator *>(pValidator);
+	pThis->Expire(pThis->m_expireTime);
+}
+//------------------------------------------------------------------------
+
+//------------------------------------------------------------------------
+void CShotValidator::Expire(const CTimeValue &now)
+{
+	CF_TELEMETRY_SCOPE("ShotValidator.Update");	// !!CryFire - added: runs in a worker job, when cf_jobs is on
 
 	TChannelShots::iterator csend=m_shots.end();
 	for (TChannelShots::iterator csit=m_shots.begin(); csit!=csend; ++csit)
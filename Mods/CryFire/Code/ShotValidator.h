@@ -73,6 +73,7 @@ public:
 
 	void Reset();
 	void Update();
+	void AddUpdateJob();	// !!CryFire - added: does the same as Update, but on a worker thread
 
 	void Connected(int channelId);
 	void Disconnected(int channelId);
@@ -84,6 +85,13 @@ private:
 
 	void DeclareExpired(int channelId, const HitInfo &hit);
 
+	//-- !!CryFire - added ---
+	// removes expired shots and hits, touches only the containers of the validator
+	void Expire(const CTimeValue &now);
+	static void ExpireJob(void *pValidator);
+	CTimeValue					m_expireTime;
+	//------
+
 	CGameRules					*m_pGameRules;
 	IItemSystem					*m_pItemSystem;
 	IGameFramework			*m_pGameFramework;
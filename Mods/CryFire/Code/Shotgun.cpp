@@ -315,7 +315,7 @@ bool CShotgun::Shoot(bool resetAnimation, bool autoreload/* =true */, bool noSou
 		if (pAmmo)
 		{
 			dir = ApplySpread(fdir, m_shotgunparams.spread);      
-      int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type.c_str());			
+      int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type);			
       
 			pAmmo->SetParams(m_pWeapon->GetOwnerId(), m_pWeapon->GetHostId(), m_pWeapon->GetEntityId(), m_pWeapon->GetFireModeIdx(GetName()),
 				m_shotgunparams.pelletdamage, hitTypeId);
@@ -432,7 +432,7 @@ void CShotgun::NetShootEx(const Vec3 &pos, const Vec3 &dir, const Vec3 &vel, con
 		if (pAmmo)
 		{
 			pdir = ApplySpread(dir, m_shotgunparams.spread);
-      int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type.c_str());			
+      int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type);			
 
 			pAmmo->SetParams(m_pWeapon->GetOwnerId(), m_pWeapon->GetHostId(), m_pWeapon->GetEntityId(), m_pWeapon->GetFireModeIdx(GetName()),
 				m_shotgunparams.pelletdamage, hitTypeId);
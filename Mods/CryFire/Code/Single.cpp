@@ -28,6 +28,7 @@ History:
 #include <IMaterialEffects.h>
 #include "GameRules.h"
 #include <Cry_GeoDistance.h>
+#include <Cry_GeoBatch.h> // !!CryFire - added
 
 #include "IronSight.h"
 
@@ -1246,10 +1247,10 @@ bool CSingle::CrosshairAssistAiming(const Vec3& firingPos, Vec3& firingDir, ray_
   const CCamera& cam = gEnv->pRenderer->GetCamera();
   Lineseg lineseg(cam.GetPosition(), cam.GetPosition()+m_fireparams.crosshair_assist_range*cam.GetViewdir());  
   
-  float t = 0.f;  
   AABB bounds;
   int debugY = 100;
   std::vector<IEntity*> ents;
+  SBatchPoints centers;	// !!CryFire - added
     
   const std::vector<EntityId> *pEntities = g_pGame->GetHUD()->GetRadar()->GetNearbyEntities();
   for(int i=0,n=pEntities->size(); i<n; ++i)  
@@ -1271,12 +1272,25 @@ bool CSingle::CrosshairAssistAiming(const Vec3& firingPos, Vec3& firingDir, ray_
     pEntity->GetLocalBounds(bounds);
     
     // sufficient for entities of interest
-    if (bounds.GetVolume() > 1000.f || Distance::Point_LinesegSq(pEntity->GetWorldTM()*bounds.GetCenter(), lineseg, t) > sqr(10.f)) 
+    if (bounds.GetVolume() > 1000.f) 
       continue;
 
     ents.push_back(pEntity);
+    centers.Add(pEntity->GetWorldTM()*bounds.GetCenter());	// !!CryFire - added
   }
 
+  //-- !!CryFire - added: distances from the line of view are computed for all candidates at once
+  std::vector<float> distSq(ents.size()+1);
+  BatchPointSegmentDistSq(centers, lineseg, &distSq[0]);
+  int numClose = 0;
+  for (int i=0,n=ents.size(); i<n; ++i)
+  {
+    if (distSq[i] <= sqr(10.f))
+      ents[numClose++] = ents[i];
+  }
+  ents.resize(numClose);
+  //------
+
   if (ents.empty())
     return false;
 
@@ -1509,7 +1523,7 @@ bool CSingle::Shoot(bool resetAnimation, bool autoreload, bool noSound)
 			damage = m_fireparams.ai_vs_player_damage;
 
 		pAmmo->SetParams(m_pWeapon->GetOwnerId(), m_pWeapon->GetHostId(), m_pWeapon->GetEntityId(), m_pWeapon->GetFireModeIdx(GetName()),
-			(int)damage, pGameRules->GetHitTypeId(m_fireparams.hit_type.c_str()));
+			(int)damage, pGameRules->GetHitTypeId(m_fireparams.hit_type));
 		pAmmo->SetSequence(m_pWeapon->GenerateShootSeqN());
 		// this must be done after owner is set
 		pAmmo->InitWithAI();
@@ -2825,7 +2839,7 @@ void CSingle::NetShootEx(const Vec3 &pos, const Vec3 &dir, const Vec3 &vel, cons
 		if (m_fireparams.track_projectiles && gEnv->bServer)
 			pAmmo->SetTracked(true);
 
-    int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type.c_str());			
+    int hitTypeId = g_pGame->GetGameRules()->GetHitTypeId(m_fireparams.hit_type);			
 		pAmmo->SetParams(m_pWeapon->GetOwnerId(), m_pWeapon->GetHostId(), m_pWeapon->GetEntityId(), m_pWeapon->GetFireModeIdx(GetName()),
 			m_fireparams.damage, hitTypeId);
 		
@@ -20,6 +20,7 @@ History:
 
 
 #include <ConfigurableVariant.h>
+#include <FlatHashMap.h>	// !!CryFire - added
 #include <INetwork.h>
 #include <IGameFramework.h>
 
@@ -54,7 +55,7 @@ public:
 	CSynchedStorage(): m_pGameFramework(0) {};
 	virtual ~CSynchedStorage() {};
 
-	typedef std::map<TSynchedKey, TSynchedValue>																							TStorage;
+	typedef FlatHashMap<TSynchedKey, TSynchedValue>																						TStorage;	// !!CryFire - modded: looked up on every synched value access
 	typedef std::map<EntityId, TStorage>																											TEntityStorageMap;
 	typedef std::map<int, TStorage>																														TChannelStorageMap;
 
@@ -0,0 +1,84 @@
+//================================================================================
+// File:    Code/Tests/Benchmark.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Wall clock and repeatable random numbers for the benchmarks
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef BENCHMARK_INCLUDED
+#define BENCHMARK_INCLUDED
+
+
+#include <windows.h>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* The benchmarks are not pass/fail tests of the speed, they print the times for comparing builds
+   and their checks only verify, that the compared variants computed the same results. */
+class Stopwatch {
+
+  public:
+
+	Stopwatch()  { restart(); }
+
+	void restart()  { QueryPerformanceCounter( &start ); }
+
+	float elapsedMs() const
+	{
+		LARGE_INTEGER now, frequency;
+		QueryPerformanceCounter( &now );
+		QueryPerformanceFrequency( &frequency );
+		return (float)(now.QuadPart - start.QuadPart) * 1000.0f / (float)frequency.QuadPart;
+	}
+
+  protected:
+
+	LARGE_INTEGER start;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+/* deterministic pseudo-random numbers, the same sequence on every run and platform */
+class BenchmarkRandom {
+
+  public:
+
+	BenchmarkRandom( uint seed = 1 ) : state(seed) {}
+
+	uint next()
+	{
+		state = state * 1664525u + 1013904223u;
+		return state >> 8;
+	}
+	/* uniformly in [min, max) */
+	float range( float min, float max )
+	{
+		return min + (max - min) * (float)(next() & 0xFFFF) / 65536.0f;
+	}
+
+  protected:
+
+	uint state;
+
+};
+
+
+#endif // BENCHMARK_INCLUDED
@@ -0,0 +1,82 @@
+//================================================================================
+// File:    Code/Tests/ChatStatusTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the chat routing between dead, spectating and playing players
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/ChatStatus.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static const byte PLAYING = 0;
+static const byte SPECTATING = ChatStatus::SPECTATOR;
+static const byte DEAD = ChatStatus::DEAD;
+static const byte DEAD_SPECTATING = ChatStatus::SPECTATOR | ChatStatus::DEAD;
+
+/* the rules of the original CGameRules::CanReceiveChatMessage, which the bit operations replaced:
+   the source and the target must both be dead or both alive and a player only hears players */
+static const struct {
+	byte source;
+	byte target;
+	bool allowed;
+} chatTable [] = {
+	{ PLAYING,         PLAYING,         true  },
+	{ PLAYING,         SPECTATING,      true  },
+	{ PLAYING,         DEAD,            false },
+	{ PLAYING,         DEAD_SPECTATING, false },
+	{ SPECTATING,      PLAYING,         false },
+	{ SPECTATING,      SPECTATING,      true  },
+	{ SPECTATING,      DEAD,            false },
+	{ SPECTATING,      DEAD_SPECTATING, false },
+	{ DEAD,            PLAYING,         false },
+	{ DEAD,            SPECTATING,      false },
+	{ DEAD,            DEAD,            true  },
+	{ DEAD,            DEAD_SPECTATING, true  },
+	{ DEAD_SPECTATING, PLAYING,         false },
+	{ DEAD_SPECTATING, SPECTATING,      false },
+	{ DEAD_SPECTATING, DEAD,            false },
+	{ DEAD_SPECTATING, DEAD_SPECTATING, true  },
+};
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(ChatStatus_allCombinations)
+{
+	CHECK_EQUAL( 16u, sizeof(chatTable) / sizeof(chatTable[0]) );
+	for (uint i = 0; i < sizeof(chatTable) / sizeof(chatTable[0]); i++)
+		CHECK_EQUAL( chatTable[i].allowed, ChatStatus::allows( chatTable[i].source, chatTable[i].target ) );
+}
+
+UNIT_TEST(ChatStatus_matchesOriginalRules)
+{
+	for (byte source = 0; source < 4; source++) {
+		for (byte target = 0; target < 4; target++) {
+			bool sourceSpec = (source & ChatStatus::SPECTATOR) != 0;
+			bool sourceDead = (source & ChatStatus::DEAD) != 0;
+			bool targetSpec = (target & ChatStatus::SPECTATOR) != 0;
+			bool targetDead = (target & ChatStatus::DEAD) != 0;
+			bool allowed = sourceDead == targetDead && (targetSpec || sourceSpec == targetSpec);
+			CHECK_EQUAL( allowed, ChatStatus::allows( source, target ) );
+		}
+	}
+}
@@ -0,0 +1,79 @@
+//================================================================================
+// File:    Code/Tests/EngineStubs.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Symbols of the engine and the game the tested code links against
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "CryFire/Logging.h"
+#include "FakeTimer.h"
+
+#include <CryName.h>
+#include <cstdlib>
+
+// CryMemoryManager.h redirects these to CryModule* in non-debug builds
+#undef malloc
+#undef calloc
+#undef realloc
+#undef free
+
+
+//----------------------------------------------------------------------------------------------------
+// the tests don't load CrySystem, the module heap is the CRT heap and the global environment has only
+// the timer and the name table, the tested code must not touch anything else in gEnv, g_pGame or g_pGameCVars
+
+extern "C" {
+	void * CryModuleMalloc( size_t size ) throw()                  { return malloc( size ); }
+	void * CryModuleCalloc( size_t num, size_t size ) throw()      { return calloc( num, size ); }
+	void * CryModuleRealloc( void * memblock, size_t size ) throw() { return realloc( memblock, size ); }
+	void   CryModuleFree( void * ptr ) throw()                     { free( ptr ); }
+}
+
+FakeTimer & FakeTimer::get()
+{
+	static FakeTimer timer;
+	return timer;
+}
+
+static SSystemGlobalEnvironment * createEnvironment()
+{
+	static SSystemGlobalEnvironment env;   // zeroed
+	env.pTimer = &FakeTimer::get();
+#ifndef USE_STATIC_NAME_TABLE
+	env.pNameTable = new CNameTable();   // never freed, names can be released by static destructors
+#endif
+	env.bServer = true;
+	env.bMultiplayer = true;
+	return &env;
+}
+
+SSystemGlobalEnvironment * gEnv = createEnvironment();
+class CGame;
+CGame * g_pGame = NULL;
+SCVars * g_pGameCVars = NULL;
+
+//----------------------------------------------------------------------------------------------------
+// logging goes nowhere
+
+void CF_Log( uint level, const char * format, ... ) {}
+void CF_LogError( const char * format, ... ) {}
+void CF_AsyncLog( uint level, const char * format, ... ) {}
+void CF_AsyncError( const char * format, ... ) {}
@@ -0,0 +1,206 @@
+//================================================================================
+// File:    Code/Tests/EntityRegistryTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the index of entities by class, driven by a fake entity system
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "FakeEntitySystem.h"
+
+#include "CryFire/EntityRegistry.h"
+
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------------------------------
+/* a Power Struggle map with a few buildings among thousands of other entities */
+static const EntityId NUM_ENTITIES = 10000;
+
+static FakeEntityClass hqClass( "HQ" );
+static FakeEntityClass factoryClass( "Factory" );
+static FakeEntityClass otherClass( "BasicEntity" );
+
+static IEntityClass * classOf( EntityId id )
+{
+	if (id % 1000 == 0)
+		return &hqClass;
+	if (id % 100 == 0)
+		return &factoryClass;
+	return &otherClass;
+}
+
+/* installs the fake entity system into gEnv for the time of a test */
+struct RegistryScope {
+	FakeEntitySystem system;
+	RegistryScope()   { gEnv->pEntitySystem = &system; }
+	~RegistryScope()  { EntityRegistry::terminate(); gEnv->pEntitySystem = NULL; }
+};
+
+static EntityRegistry::Ids sorted( EntityRegistry::Ids ids )
+{
+	std::sort( ids.begin(), ids.end() );
+	return ids;
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(EntityRegistry_indexesExistingAndSpawnedEntities)
+{
+	RegistryScope scope;
+	// the first half exists before the registry, the second half is spawned later
+	for (EntityId id = 1; id <= NUM_ENTITIES / 2; id++)
+		scope.system.spawn( id, classOf( id ) );
+	EntityRegistry::initialize();
+	CHECK_EQUAL( 1u, scope.system.getNumSinks() );
+	for (EntityId id = NUM_ENTITIES / 2 + 1; id <= NUM_ENTITIES; id++)
+		scope.system.spawn( id, classOf( id ) );
+
+	CHECK_EQUAL( (uint)NUM_ENTITIES, EntityRegistry::getCount() );
+	EntityRegistry::Ids hqs = sorted( EntityRegistry::getAllOfClass( &hqClass ) );
+	CHECK_EQUAL( 10u, (uint)hqs.size() );
+	for (uint i = 0; i < hqs.size(); i++)
+		CHECK_EQUAL( (EntityId)((i + 1) * 1000), hqs[i] );
+	CHECK_EQUAL( 90u, (uint)EntityRegistry::getAllOfClass( &factoryClass ).size() );
+	CHECK_EQUAL( 9900u, (uint)EntityRegistry::getAllOfClass( &otherClass ).size() );
+	CHECK( EntityRegistry::getAllOfClass( (IEntityClass *)NULL ).empty() );
+
+	EntityRegistry::terminate();
+	CHECK_EQUAL( 0u, scope.system.getNumSinks() );
+}
+
+UNIT_TEST(EntityRegistry_removalsThroughTheSink)
+{
+	RegistryScope scope;
+	EntityRegistry::initialize();
+	for (EntityId id = 1; id <= NUM_ENTITIES; id++)
+		scope.system.spawn( id, classOf( id ) );
+
+	// every removal moves the last id of the class into the hole, so the remaining ones must stay findable
+	for (EntityId id = 100; id <= NUM_ENTITIES; id += 200)
+		scope.system.remove( id );
+	for (EntityId id = 1; id <= NUM_ENTITIES; id += 2)
+		scope.system.remove( id );
+
+	CHECK_EQUAL( (uint)(NUM_ENTITIES / 2 - 50), EntityRegistry::getCount() );
+	EntityRegistry::Ids factories = sorted( EntityRegistry::getAllOfClass( &factoryClass ) );
+	CHECK_EQUAL( 40u, (uint)factories.size() );
+	for (uint i = 0; i < factories.size(); i++) {
+		CHECK( factories[i] % 200 == 0 && factories[i] % 1000 != 0 );
+		CHECK( scope.system.GetEntity( factories[i] ) != NULL );
+	}
+	CHECK_EQUAL( 10u, (uint)EntityRegistry::getAllOfClass( &hqClass ).size() );
+	CHECK_EQUAL( 4900u, (uint)EntityRegistry::getAllOfClass( &otherClass ).size() );
+}
+
+UNIT_TEST(EntityRegistry_idReusedByAnotherClass)
+{
+	RegistryScope scope;
+	EntityRegistry::initialize();
+	for (EntityId id = 1; id <= NUM_ENTITIES; id++)
+		scope.system.spawn( id, classOf( id ) );
+
+	// the removal of the factory is missed and its id is given to a HQ
+	scope.system.removeSilently( 500 );
+	scope.system.spawn( 500, &hqClass );
+
+	EntityRegistry::Ids factories = EntityRegistry::getAllOfClass( &factoryClass );
+	EntityRegistry::Ids hqs = EntityRegistry::getAllOfClass( &hqClass );
+	CHECK_EQUAL( 89u, (uint)factories.size() );
+	CHECK( std::find( factories.begin(), factories.end(), 500 ) == factories.end() );
+	CHECK_EQUAL( 11u, (uint)hqs.size() );
+	CHECK( std::find( hqs.begin(), hqs.end(), 500 ) != hqs.end() );
+	CHECK_EQUAL( (uint)NUM_ENTITIES, EntityRegistry::getCount() );
+
+	// a repeated spawn of the same entity doesn't add it twice
+	scope.system.spawn( 500, &hqClass );
+	CHECK_EQUAL( 11u, (uint)EntityRegistry::getAllOfClass( &hqClass ).size() );
+}
+
+UNIT_TEST(EntityRegistry_purgesStaleIds)
+{
+	RegistryScope scope;
+	EntityRegistry::initialize();
+	for (EntityId id = 1; id <= NUM_ENTITIES; id++)
+		scope.system.spawn( id, classOf( id ) );
+
+	// the entity system was reset without telling the sinks
+	for (EntityId id = 1; id <= NUM_ENTITIES; id++)
+		if (id % 3 != 0)
+			scope.system.removeSilently( id );
+
+	EntityRegistry::Ids hqs = sorted( EntityRegistry::getAllOfClass( &hqClass ) );
+	CHECK_EQUAL( 3u, (uint)hqs.size() );
+	CHECK_EQUAL( 3000u, hqs[0] );
+	CHECK_EQUAL( 9000u, hqs[2] );
+	EntityRegistry::Ids others = EntityRegistry::getAllOfClass( &otherClass );
+	CHECK_EQUAL( 3300u, (uint)others.size() );
+	for (uint i = 0; i < others.size(); i++)
+		CHECK( others[i] % 3 == 0 );
+	// the factories weren't asked for yet, so their stale ids are still counted
+	CHECK_EQUAL( 3u + 3300u + 90u, EntityRegistry::getCount() );
+	CHECK_EQUAL( 30u, (uint)EntityRegistry::getAllOfClass( &factoryClass ).size() );
+	CHECK_EQUAL( 3u + 3300u + 30u, EntityRegistry::getCount() );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* spawns a bunch of entities of new classes for every visited entity */
+struct SpawnNewClasses {
+	FakeEntitySystem & system;
+	std::vector<FakeEntityClass *> & classes;
+	EntityId nextId;
+	uint visited;
+	SpawnNewClasses( FakeEntitySystem & system, std::vector<FakeEntityClass *> & classes )
+		: system(system), classes(classes), nextId(NUM_ENTITIES + 1), visited(0) {}
+	void operator()( IEntity * pEntity )
+	{
+		visited++;
+		for (int i = 0; i < 10; i++) {
+			classes.push_back( new FakeEntityClass( "New" ) );
+			system.spawn( nextId++, classes.back() );
+		}
+	}
+};
+
+UNIT_TEST(EntityRegistry_listsSurviveSpawnsOfNewClasses)
+{
+	RegistryScope scope;
+	EntityRegistry::initialize();
+	for (EntityId id = 1; id <= NUM_ENTITIES; id++)
+		scope.system.spawn( id, classOf( id ) );
+
+	// every new class is inserted into the map of classes, which grows and moves the lists,
+	// while the callers are going through theirs
+	EntityRegistry::Ids factories = EntityRegistry::getAllOfClass( &factoryClass );
+	std::vector<FakeEntityClass *> newClasses;
+	SpawnNewClasses spawner( scope.system, newClasses );
+	EntityRegistry::forEachOfClass( &hqClass, spawner );
+
+	CHECK_EQUAL( 10u, spawner.visited );
+	CHECK_EQUAL( 100u, (uint)newClasses.size() );
+	CHECK( sorted( factories ) == sorted( EntityRegistry::getAllOfClass( &factoryClass ) ) );
+	CHECK_EQUAL( 10u, (uint)EntityRegistry::getAllOfClass( &hqClass ).size() );
+	CHECK_EQUAL( 1u, (uint)EntityRegistry::getAllOfClass( newClasses.back() ).size() );
+	CHECK_EQUAL( (uint)NUM_ENTITIES + 100u, EntityRegistry::getCount() );
+
+	EntityRegistry::terminate();
+	for (uint i = 0; i < newClasses.size(); i++)
+		delete newClasses[i];
+}
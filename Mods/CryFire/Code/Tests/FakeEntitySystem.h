@@ -0,0 +1,295 @@
+//================================================================================
+// File:    Code/Tests/FakeEntitySystem.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Entity system with only spawning, removing and finding of entities
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef FAKE_ENTITY_SYSTEM_INCLUDED
+#define FAKE_ENTITY_SYSTEM_INCLUDED
+
+
+#include <IEntitySystem.h>
+#include <ISerialize.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* only the name works */
+class FakeEntityClass : public IEntityClass {
+
+  public:
+
+	FakeEntityClass( const char * name ) : name(name) {}
+
+	virtual void Release()  {}
+	virtual const char* GetName() const  { return name.c_str(); }
+	virtual uint32 GetFlags() const  { return 0; }
+	virtual void SetFlags( uint32 nFlags )  {}
+	virtual const char* GetScriptFile() const  { return NULL; }
+	virtual IEntityScript* GetIEntityScript() const  { return NULL; }
+	virtual bool LoadScript( bool bForceReload )  { return false; }
+	virtual UserProxyCreateFunc GetUserProxyCreateFunc() const  { return UserProxyCreateFunc(); }
+	virtual void* GetUserProxyData() const  { return NULL; }
+	virtual void SetUserProxyCreateFunc( UserProxyCreateFunc pFunc,void *pUserData=NULL )  {}
+	virtual int GetEventCount()  { return 0; }
+	virtual SEventInfo GetEventInfo( int nIndex )  { return SEventInfo(); }
+	virtual bool FindEventInfo( const char *sEvent,SEventInfo &event )  { return false; }
+
+  protected:
+
+	std::string name;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+/* only the id and the class work, the rest returns nothing or the identity */
+class FakeEntity : public IEntity {
+
+  public:
+
+	FakeEntity( EntityId id = 0, IEntityClass * pClass = NULL )
+		: id(id), pClass(pClass), tm(IDENTITY), pos(ZERO), rotation(IDENTITY), scale(1, 1, 1) {}
+
+	virtual EntityId GetId() const  { return id; }
+	virtual EntityGUID GetGuid() const  { return 0; }
+	virtual IEntityClass* GetClass() const  { return pClass; }
+	virtual IEntityArchetype* GetArchetype()  { return NULL; }
+	virtual void SetFlags( uint32 flags )  {}
+	virtual uint32 GetFlags() const  { return 0; }
+	virtual void AddFlags( uint32 flagsToAdd )  {}
+	virtual void ClearFlags( uint32 flagsToClear )  {}
+	virtual bool CheckFlags( uint32 flagsToCheck ) const  { return false; }
+	virtual bool IsGarbage() const  { return false; }
+	virtual void SetName( const char *sName )  {}
+	virtual const char* GetName() const  { return NULL; }
+	virtual const char* GetEntityTextDescription() const  { return NULL; }
+	virtual void SerializeXML( XmlNodeRef &entityNode,bool bLoading )  {}
+	virtual void AttachChild( IEntity *pChildEntity,int nAttachFlags=0 )  {}
+	virtual void DetachAll( int nDetachFlags=0 )  {}
+	virtual void DetachThis( int nDetachFlags=0,int nWhyFlags=0 )  {}
+	virtual int GetChildCount() const  { return 0; }
+	virtual IEntity* GetChild( int nIndex ) const  { return NULL; }
+	virtual IEntity* GetParent() const  { return NULL; }
+	virtual void SetWorldTM( const Matrix34 &tm,int nWhyFlags=0 )  {}
+	virtual void SetLocalTM( const Matrix34 &tm,int nWhyFlags=0 )  {}
+	virtual const Matrix34& GetWorldTM() const  { return tm; }
+	virtual Matrix34 GetLocalTM() const  { return Matrix34(); }
+	virtual void GetWorldBounds( AABB &bbox )  {}
+	virtual void GetLocalBounds( AABB &bbox )  {}
+	virtual void SetPos( const Vec3 &vPos,int nWhyFlags=0 )  {}
+	virtual const Vec3& GetPos() const  { return pos; }
+	virtual void SetRotation( const Quat &qRotation,int nWhyFlags=0 )  {}
+	virtual const Quat& GetRotation() const  { return rotation; }
+	virtual void SetScale( const Vec3 &vScale,int nWhyFlags=0 )  {}
+	virtual const Vec3& GetScale() const  { return scale; }
+	virtual void SetPosRotScale( const Vec3 &vPos,const Quat &qRotation,const Vec3 &vScale,int nWhyFlags=0 )  {}
+	virtual Vec3 GetWorldPos() const  { return Vec3(); }
+	virtual Ang3 GetWorldAngles() const  { return Ang3(); }
+	virtual Quat GetWorldRotation() const  { return Quat(); }
+	virtual void Activate( bool bActive )  {}
+	virtual bool IsActive() const  { return false; }
+	virtual void PrePhysicsActivate( bool bActive )  {}
+	virtual bool IsPrePhysicsActive()  { return false; }
+	virtual void Serialize( TSerialize serializer, int nFlags=0 )  {}
+	virtual bool SendEvent( SEntityEvent &event )  { return false; }
+	virtual void SetTimer( int nTimerId,int nMilliSeconds )  {}
+	virtual void KillTimer( int nTimerId )  {}
+	virtual void Hide( bool bHide )  {}
+	virtual bool IsHidden() const  { return false; }
+	virtual void Invisible( bool bInvisible )  {}
+	virtual bool IsInvisible() const  { return false; }
+	virtual CSmartObject* GetSmartObject() const  { return NULL; }
+	virtual void SetSmartObject( CSmartObject* pSmartObject )  {}
+	virtual IAIObject* GetAI()  { return NULL; }
+	virtual bool RegisterInAISystem( unsigned short type, const AIObjectParameters &params )  { return false; }
+	virtual void SetUpdatePolicy( EEntityUpdatePolicy eUpdatePolicy )  {}
+	virtual EEntityUpdatePolicy GetUpdatePolicy() const  { return ENTITY_UPDATE_NEVER; }
+	virtual IEntityProxy* GetProxy( EEntityProxy proxy ) const  { return NULL; }
+	virtual void SetProxy( EEntityProxy proxy, IEntityProxy *pProxy )  {}
+	virtual IEntityProxy* CreateProxy( EEntityProxy proxy )  { return NULL; }
+	virtual void Physicalize( SEntityPhysicalizeParams &params )  {}
+	virtual IPhysicalEntity* GetPhysics() const  { return NULL; }
+	virtual int PhysicalizeSlot( int slot, SEntityPhysicalizeParams &params )  { return 0; }
+	virtual void UnphysicalizeSlot( int slot )  {}
+	virtual void UpdateSlotPhysics( int slot )  {}
+	virtual void SetPhysicsState( XmlNodeRef & physicsState )  {}
+	virtual void SetMaterial( IMaterial *pMaterial )  {}
+	virtual IMaterial* GetMaterial()  { return NULL; }
+	virtual bool IsSlotValid( int nIndex ) const  { return false; }
+	virtual void FreeSlot( int nIndex )  {}
+	virtual int GetSlotCount() const  { return 0; }
+	virtual bool GetSlotInfo( int nIndex,SEntitySlotInfo &slotInfo ) const  { return false; }
+	virtual const Matrix34& GetSlotWorldTM( int nSlot ) const  { return tm; }
+	virtual const Matrix34& GetSlotLocalTM( int nSlot, bool bRelativeToParent ) const  { return tm; }
+	virtual void SetSlotLocalTM( int nSlot,const Matrix34 &localTM,int nWhyFlags=0 )  {}
+	virtual bool SetParentSlot( int nParentIndex,int nChildIndex )  { return false; }
+	virtual void SetSlotMaterial( int nSlot,IMaterial *pMaterial )  {}
+	virtual void SetSlotFlags( int nSlot,uint32 nFlags )  {}
+	virtual uint32 GetSlotFlags( int nSlot ) const  { return 0; }
+	virtual bool ShouldUpdateCharacter( int nSlot ) const  { return false; }
+	virtual ICharacterInstance* GetCharacter( int nSlot )  { return NULL; }
+	virtual int SetCharacter( ICharacterInstance *pCharacter, int nSlot )  { return 0; }
+	virtual IStatObj* GetStatObj( int nSlot )  { return NULL; }
+	virtual IParticleEmitter* GetParticleEmitter( int nSlot )  { return NULL; }
+	virtual int SetStatObj( IStatObj *pStatObj, int nSlot,bool bUpdatePhysics, float mass=-1.0f )  { return 0; }
+	virtual int LoadGeometry( int nSlot,const char *sFilename,const char *sGeomName=NULL,int nLoadFlags=0 )  { return 0; }
+	virtual int LoadCharacter( int nSlot,const char *sFilename,int nLoadFlags=0 )  { return 0; }
+	virtual int LoadParticleEmitter( int nSlot, IParticleEffect* pEffect, SpawnParams const* params = NULL, bool bPrime = false, bool bSerialize = false )  { return 0; }
+	virtual int SetParticleEmitter( int nSlot, IParticleEmitter* pEmitter, bool bSerialize = false )  { return 0; }
+	virtual int LoadLight( int nSlot,CDLight *pLight )  { return 0; }
+	virtual int LoadCloud( int nSlot,const char *sCloudFilename )  { return 0; }
+	virtual int LoadFogVolume( int nSlot, const SFogVolumeProperties& properties )  { return 0; }
+	virtual void InvalidateTM( int nWhyFlags=0 )  {}
+	virtual void EnablePhysics( bool enable )  {}
+	virtual IEntityLink* GetEntityLinks()  { return NULL; }
+	virtual IEntityLink* AddEntityLink( const char *sLinkName,EntityId entityId )  { return NULL; }
+	virtual void RemoveEntityLink( IEntityLink* pLink )  {}
+	virtual void RemoveAllEntityLinks()  {}
+	virtual IEntity * UnmapAttachedChild( int &partId )  { return NULL; }
+	virtual bool IsInitialized() const  { return true; }
+
+  protected:
+
+	EntityId id;
+	IEntityClass * pClass;
+	Matrix34 tm;
+	Vec3 pos;
+	Quat rotation;
+	Vec3 scale;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+/* goes through a copy of the list of entities made when it was created */
+class FakeEntityIt : public IEntityIt {
+
+  public:
+
+	FakeEntityIt() : refs(0), position(0) {}
+
+	virtual void AddRef()  { refs++; }
+	virtual void Release()  { if (--refs <= 0) delete this; }
+	virtual bool IsEnd()  { return position >= entities.size(); }
+	virtual IEntity * Next()  { return IsEnd() ? NULL : entities[position++]; }
+	virtual IEntity * This()  { return IsEnd() ? NULL : entities[position]; }
+	virtual void MoveFirst()  { position = 0; }
+
+	std::vector<IEntity *> entities;
+
+  protected:
+
+	int refs;
+	uint position;
+
+};
+
+//----------------------------------------------------------------------------------------------------
+/* Entities are spawned and removed by the test, which tells the sinks about it like the real entity
+   system does. The rest of the system does nothing. */
+class FakeEntitySystem : public IEntitySystem {
+
+  public:
+
+	void spawn( EntityId id, IEntityClass * pClass )
+	{
+		FakeEntity & entity = entities[id] = FakeEntity( id, pClass );
+		SEntitySpawnParams params;
+		params.id = id;
+		params.pClass = pClass;
+		for (uint i = 0; i < sinks.size(); i++)
+			sinks[i]->OnSpawn( &entity, params );
+	}
+	void remove( EntityId id )
+	{
+		std::map<EntityId, FakeEntity>::iterator it = entities.find( id );
+		if (it == entities.end())
+			return;
+		for (uint i = 0; i < sinks.size(); i++)
+			sinks[i]->OnRemove( &it->second );
+		entities.erase( it );
+	}
+	/* removes the entity without telling the sinks, like a reset of the level does */
+	void removeSilently( EntityId id )  { entities.erase( id ); }
+	uint getNumSinks() const  { return sinks.size(); }
+
+	virtual void Release()  {}
+	virtual void PrePhysicsUpdate()  {}
+	virtual void Update()  {}
+	virtual void Reset()  {}
+	virtual void DeletePendingEntities()  {}
+	virtual IEntityClassRegistry* GetClassRegistry()  { return NULL; }
+	virtual IEntity* SpawnEntity( SEntitySpawnParams &params,bool bAutoInit=true )  { return NULL; }
+	virtual bool InitEntity( IEntity* pEntity,SEntitySpawnParams &params )  { return false; }
+	virtual IEntity* GetEntity( EntityId id ) const
+	{
+		std::map<EntityId, FakeEntity>::const_iterator it = entities.find( id );
+		return it != entities.end() ? const_cast<FakeEntity *>( &it->second ) : NULL;
+	}
+	virtual IEntity* FindEntityByName( const char *sEntityName ) const  { return NULL; }
+	virtual void ReserveEntityId( const EntityId id )  {}
+	virtual void RemoveEntity( EntityId entity,bool bForceRemoveNow=false )  {}
+	virtual uint32 GetNumEntities() const  { return (uint32)entities.size(); }
+	virtual IEntityIt * GetEntityIterator()
+	{
+		FakeEntityIt * pIt = new FakeEntityIt;
+		for (std::map<EntityId, FakeEntity>::iterator it = entities.begin(); it != entities.end(); ++it)
+			pIt->entities.push_back( &it->second );
+		return pIt;
+	}
+	virtual void SendEventToAll( SEntityEvent &event )  {}
+	virtual int QueryProximity( SEntityProximityQuery &query )  { return 0; }
+	virtual void ResizeProximityGrid( int nWidth,int nHeight )  {}
+	virtual int GetPhysicalEntitiesInBox( const Vec3 &origin, float radius, IPhysicalEntity **&pList, int physFlags = (1<<1)|(1<<2)|(1<<3)|(1<<4) ) const  { return 0; }
+	virtual IEntity* GetEntityFromPhysics( struct IPhysicalEntity *pPhysEntity ) const  { return NULL; }
+	virtual void AddSink( IEntitySystemSink *sink )  { sinks.push_back( sink ); }
+	virtual void RemoveSink( IEntitySystemSink *sink )  { sinks.erase( std::remove( sinks.begin(), sinks.end(), sink ), sinks.end() ); }
+	virtual void PauseTimers( bool bPause,bool bResume=false )  {}
+	virtual bool IsIDUsed( EntityId nID ) const  { return entities.count( nID ) != 0; }
+	virtual void GetMemoryStatistics( ICrySizer *pSizer )  {}
+	virtual ISystem* GetSystem() const  { return NULL; }
+	virtual void LoadEntities( XmlNodeRef &objectsNode )  {}
+	virtual void AddEntityEventListener( EntityId nEntity,EEntityEvent event,IEntityEventListener *pListener )  {}
+	virtual void RemoveEntityEventListener( EntityId nEntity,EEntityEvent event,IEntityEventListener *pListener )  {}
+	virtual EntityId FindEntityByGuid( const EntityGUID &guid ) const  { return 0; }
+	virtual CAreaManager* GetAreaManager() const  { return NULL; }
+	virtual IBreakableManager* GetBreakableManager() const  { return NULL; }
+	virtual IEntityArchetype* LoadEntityArchetype( const char *sArchetype )  { return NULL; }
+	virtual IEntityArchetype* CreateEntityArchetype( IEntityClass *pClass,const char *sArchetype )  { return NULL; }
+	virtual void Serialize( TSerialize ser )  {}
+	virtual void SetNextSpawnId( EntityId id )  {}
+	virtual void ResetAreas()  {}
+	virtual void DumpEntities()  {}
+	virtual void LockSpawning( bool lock )  {}
+
+  protected:
+
+	std::map<EntityId, FakeEntity> entities;
+	std::vector<IEntitySystemSink *> sinks;
+
+};
+
+
+#endif // FAKE_ENTITY_SYSTEM_INCLUDED
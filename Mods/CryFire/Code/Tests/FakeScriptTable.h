@@ -0,0 +1,92 @@
+//================================================================================
+// File:    Code/Tests/FakeScriptTable.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Script table of the tests, keeps the values in a map and counts writes
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef FAKE_SCRIPT_TABLE_INCLUDED
+#define FAKE_SCRIPT_TABLE_INCLUDED
+
+
+#include <IScriptSystem.h>
+
+#include <map>
+#include <string>
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* only named values work, the rest of the table does nothing, it's never released by the tested code */
+class FakeScriptTable : public IScriptTable {
+
+  public:
+
+	FakeScriptTable() : numWrites(0) {}
+
+	/* what a script would do, it isn't counted as a write */
+	void scriptWrite( const char * key, const ScriptAnyValue & value )  { values[key] = value; }
+	float getNumber( const char * key )  { return values[key].number; }
+	bool getBool( const char * key )     { return values[key].b; }
+
+	virtual void SetValueAny( const char * sKey, const ScriptAnyValue & any, bool bChain = false )
+	{
+		values[sKey] = any;
+		numWrites++;
+	}
+	virtual bool GetValueAny( const char * sKey, ScriptAnyValue & any, bool bChain = false )
+	{
+		std::map<std::string, ScriptAnyValue>::iterator it = values.find( sKey );
+		if (it == values.end())
+			return false;
+		any = it->second;
+		return true;
+	}
+
+	virtual IScriptSystem * GetScriptSystem() const  { return NULL; }
+	virtual void AddRef()  {}
+	virtual void Release()  {}
+	virtual void Delegate( IScriptTable * pObj )  {}
+	virtual void * GetUserDataValue()  { return NULL; }
+	virtual bool BeginSetGetChain()  { return true; }
+	virtual void EndSetGetChain()  {}
+	virtual ScriptVarType GetValueType( const char * sKey )  { return svtNull; }
+	virtual ScriptVarType GetAtType( int nIdx )  { return svtNull; }
+	virtual void SetAtAny( int nIndex, const ScriptAnyValue & any )  {}
+	virtual bool GetAtAny( int nIndex, ScriptAnyValue & any )  { return false; }
+	virtual Iterator BeginIteration()  { Iterator iter; iter.sKey = NULL; iter.nKey = -1; iter.nInternal = 0; return iter; }
+	virtual bool MoveNext( Iterator & iter )  { return false; }
+	virtual void EndIteration( const Iterator & iter )  {}
+	virtual void Clear()  { values.clear(); }
+	virtual int Count()  { return 0; }
+	virtual bool Clone( IScriptTable * pSrcTable, bool bDeepCopy = false )  { return false; }
+	virtual void Dump( IScriptTableDumpSink * p )  {}
+	virtual bool AddFunction( const SUserFunctionDesc & fd )  { return false; }
+
+	uint numWrites;
+
+  protected:
+
+	std::map<std::string, ScriptAnyValue> values;
+
+};
+
+
+#endif // FAKE_SCRIPT_TABLE_INCLUDED
@@ -0,0 +1,70 @@
+//================================================================================
+// File:    Code/Tests/FakeTimer.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Timer of the tests, the time moves only when a test says so
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#ifndef FAKE_TIMER_INCLUDED
+#define FAKE_TIMER_INCLUDED
+
+
+#include <ITimer.h>
+#include <ISerialize.h>
+#include <TimeValue.h>
+
+
+//----------------------------------------------------------------------------------------------------
+/* EngineStubs.cpp installs it as gEnv->pTimer, frame start time and async time are the same */
+class FakeTimer : public ITimer {
+
+  public:
+
+	static FakeTimer & get();
+	static void setTime( float seconds )   { get().now.SetSeconds( seconds ); }
+	static void advance( float seconds )   { get().now += CTimeValue( seconds ); }
+
+	virtual void ResetTimer()                                          { now.SetValue( 0 ); }
+	virtual void UpdateOnFrameStart()                                  {}
+	virtual float GetCurrTime( ETimer which ) const                    { return now.GetSeconds(); }
+	virtual CTimeValue GetFrameStartTime( ETimer which ) const         { return now; }
+	virtual CTimeValue GetAsyncTime() const                            { return now; }
+	virtual float GetAsyncCurTime()                                    { return now.GetSeconds(); }
+	virtual float GetFrameTime( ETimer which ) const                   { return 0.0f; }
+	virtual float GetRealFrameTime() const                             { return 0.0f; }
+	virtual float GetTimeScale() const                                 { return 1.0f; }
+	virtual void SetTimeScale( float s )                               {}
+	virtual void EnableTimer( const bool bEnable )                     {}
+	virtual bool IsTimerEnabled() const                                { return true; }
+	virtual float GetFrameRate()                                       { return 0.0f; }
+	virtual float GetProfileFrameBlending( float * pfBlendTime, int * piBlendMode ) { return 0.0f; }
+	virtual void Serialize( TSerialize ser )                           {}
+	virtual bool PauseTimer( ETimer which, bool bPause )               { return false; }
+	virtual bool IsTimerPaused( ETimer which )                         { return false; }
+	virtual bool SetTimer( ETimer which, float timeInSeconds )         { now.SetSeconds( timeInSeconds ); return true; }
+	virtual void SecondsToDateUTC( time_t time, struct tm & outDateUTC ) {}
+	virtual time_t DateToSecondsUTC( struct tm & timePtr )             { return 0; }
+
+  protected:
+
+	CTimeValue now;
+
+};
+
+#endif // FAKE_TIMER_INCLUDED
@@ -0,0 +1,285 @@
+//================================================================================
+// File:    Code/Tests/FlatHashMapTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of FlatHashMap against std::map and a lookup benchmark
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "Benchmark.h"
+
+#include <FlatHashMap.h>
+#include <VectorMap.h>
+#include <CryName.h>
+#include <map>
+#include <cstdio>
+#if defined(_MSC_VER)
+#include <unordered_map>       // std::tr1 of VS2008 SP1
+#else
+#include <tr1/unordered_map>
+#endif
+
+
+//----------------------------------------------------------------------------------------------------
+typedef FlatHashMap<uint, uint> TestMap;
+typedef std::map<uint, uint> RefMap;
+
+/* deterministic pseudo-random numbers, the same sequence on every run */
+static uint randomState = 1;
+static uint nextRandom()
+{
+	randomState = randomState * 1664525u + 1013904223u;
+	return randomState >> 8;
+}
+
+/* every key hashes into the same group, so every lookup has to probe past the other keys */
+struct CollidingHash {
+	size_t operator()( uint key ) const { return 0; }
+};
+typedef FlatHashMap<uint, uint, CollidingHash> CollidingMap;
+
+/* compares size, lookups and a full iteration */
+template <class Map>
+static bool equalsReference( const Map & map, const RefMap & ref )
+{
+	if (map.size() != ref.size())
+		return false;
+	uint numIterated = 0;
+	for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it, ++numIterated) {
+		RefMap::const_iterator refIt = ref.find( it->first );
+		if (refIt == ref.end() || refIt->second != it->second)
+			return false;
+	}
+	if (numIterated != ref.size())
+		return false;
+	for (RefMap::const_iterator refIt = ref.begin(); refIt != ref.end(); ++refIt) {
+		typename Map::const_iterator it = map.find( refIt->first );
+		if (it == map.end() || it->second != refIt->second)
+			return false;
+	}
+	return true;
+}
+
+/* random inserts and erases from a small key range, so that erased keys come back often */
+template <class Map>
+static bool randomOpsMatchReference( uint numOps, uint keyRange )
+{
+	Map map;
+	RefMap ref;
+	randomState = 1;
+	for (uint i = 0; i < numOps; i++) {
+		uint key = nextRandom() % keyRange;
+		uint op = nextRandom() % 4;
+		if (op == 0) {
+			if (map.erase( key ) != ref.erase( key ))
+				return false;
+		} else if (op == 1) {
+			bool inserted = map.insert( std::make_pair( key, i ) ).second;
+			if (inserted != ref.insert( std::make_pair( key, i ) ).second)
+				return false;
+		} else if (op == 2) {
+			map[key] = i;
+			ref[key] = i;
+		} else if (map.count( key ) != ref.count( key )) {
+			return false;
+		}
+		if (i % 97 == 0 && !equalsReference( map, ref ))
+			return false;
+	}
+	return equalsReference( map, ref );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(FlatHashMap_randomOpsMatchStdMap)
+{
+	CHECK( randomOpsMatchReference<TestMap>( 20000, 300 ) );
+	CHECK( randomOpsMatchReference<TestMap>( 20000, 5000 ) );
+}
+
+UNIT_TEST(FlatHashMap_collidingKeysMatchStdMap)
+{
+	// 100 keys in one probe sequence spanning several groups, erases leave deleted slots in full groups
+	CHECK( randomOpsMatchReference<CollidingMap>( 5000, 100 ) );
+}
+
+UNIT_TEST(FlatHashMap_eraseInFullGroupKeepsProbing)
+{
+	CollidingMap map;
+	for (uint key = 0; key < 40; key++)
+		map[key] = key;
+	uint capacity = map.capacity();
+
+	// the first group is full, so the erased slots become tombstones and the keys behind stay reachable
+	for (uint key = 0; key < 10; key++)
+		CHECK_EQUAL( 1u, map.erase( key ) );
+	for (uint key = 10; key < 40; key++)
+		CHECK( map.find( key ) != map.end() );
+	CHECK( map.find( 5 ) == map.end() );
+
+	// tombstones are reused without growing
+	for (uint key = 100; key < 110; key++)
+		map[key] = key;
+	CHECK_EQUAL( capacity, map.capacity() );
+	CHECK_EQUAL( 40u, map.size() );
+}
+
+UNIT_TEST(FlatHashMap_churnDoesNotGrow)
+{
+	// a constant number of elements with changing keys, tombstones must be cleaned up in place,
+	// the table can grow once, when it's more than half full, but not with every cleanup
+	TestMap map;
+	for (uint key = 0; key < 50; key++)
+		map[key] = key;
+	uint initialCapacity = map.capacity(), capacity = 0;
+	for (uint key = 50; key < 20050; key++) {
+		map.erase( key - 50 );
+		map[key] = key;
+		if (key == 1050)
+			capacity = map.capacity();
+	}
+	CHECK_EQUAL( 50u, map.size() );
+	CHECK_EQUAL( capacity, map.capacity() );
+	CHECK( map.capacity() <= 2 * initialCapacity );
+	for (uint key = 20000; key < 20050; key++)
+		CHECK( map.count( key ) == 1 );
+}
+
+UNIT_TEST(FlatHashMap_rehashKeepsElements)
+{
+	TestMap map;
+	RefMap ref;
+	uint lastCapacity = 0, numRehashes = 0;
+	for (uint i = 0; i < 5000; i++) {
+		uint key = i * 7919u;
+		map[key] = i;
+		ref[key] = i;
+		if (map.capacity() != lastCapacity) {
+			lastCapacity = map.capacity();
+			numRehashes++;
+			CHECK( equalsReference( map, ref ) );
+		}
+		// the load factor is at most 7/8
+		CHECK( map.size() * 8 <= map.capacity() * 7 );
+	}
+	CHECK( numRehashes > 5 );
+	CHECK( equalsReference( map, ref ) );
+
+	map.reserve( 20000 );
+	CHECK( map.capacity() - map.capacity() / 8 >= 20000 );
+	CHECK( equalsReference( map, ref ) );
+}
+
+UNIT_TEST(FlatHashMap_copyClearAndEraseWhileIterating)
+{
+	TestMap map;
+	for (uint key = 0; key < 1000; key++)
+		map[key] = key;
+
+	TestMap copy( map );
+	TestMap assigned;
+	assigned = map;
+
+	// the std::map way of erasing the current element
+	for (TestMap::iterator it = map.begin(); it != map.end(); ) {
+		if (it->first % 2)
+			map.erase( it++ );
+		else
+			++it;
+	}
+	CHECK_EQUAL( 500u, map.size() );
+	for (uint key = 0; key < 1000; key++)
+		CHECK_EQUAL( (key % 2) ? 0u : 1u, map.count( key ) );
+
+	CHECK_EQUAL( 1000u, copy.size() );
+	CHECK_EQUAL( 1000u, assigned.size() );
+	CHECK( copy.find( 999 ) != copy.end() && copy.find( 999 )->second == 999 );
+
+	copy.clear();
+	CHECK( copy.empty() );
+	CHECK( copy.begin() == copy.end() );
+	CHECK( copy.find( 1 ) == copy.end() );
+	copy[1] = 2;
+	CHECK_EQUAL( 2u, copy[1] );
+}
+
+//----------------------------------------------------------------------------------------------------
+static const uint BENCH_KEYS = 4096;
+static const uint BENCH_ROUNDS = 50;
+
+template <class Map, class Key>
+static float benchmarkLookups( const std::vector<Key> & keys, const std::vector<Key> & lookups, uint & sum )
+{
+	Map map;
+	for (uint i = 0; i < keys.size(); i++)
+		map[keys[i]] = i;
+
+	Stopwatch watch;
+	for (uint round = 0; round < BENCH_ROUNDS; round++) {
+		for (uint i = 0; i < lookups.size(); i++) {
+			typename Map::const_iterator it = map.find( lookups[(i * 7) % lookups.size()] );
+			if (it != map.end())
+				sum += it->second;
+		}
+	}
+	return watch.elapsedMs();
+}
+
+/* the hash of FlatHashMap and of std::tr1::unordered_map are separate, so that each one gets its usual one */
+template <class Key, class FlatHash, class UnorderedHash>
+static void benchmarkMaps( const char * keyName, const std::vector<Key> & keys, const std::vector<Key> & lookups )
+{
+	uint flatSum = 0, mapSum = 0, vectorSum = 0, unorderedSum = 0;
+	float flatMs = benchmarkLookups< FlatHashMap<Key, uint, FlatHash> >( keys, lookups, flatSum );
+	float mapMs = benchmarkLookups< std::map<Key, uint> >( keys, lookups, mapSum );
+	float vectorMs = benchmarkLookups< VectorMap<Key, uint> >( keys, lookups, vectorSum );
+	float unorderedMs = benchmarkLookups< std::tr1::unordered_map<Key, uint, UnorderedHash> >( keys, lookups, unorderedSum );
+	CHECK_EQUAL( mapSum, flatSum );
+	CHECK_EQUAL( mapSum, vectorSum );
+	CHECK_EQUAL( mapSum, unorderedSum );
+	printf( "FlatHashMap_benchmark: %s keys, %u lookups, FlatHashMap %.2f ms, std::map %.2f ms, VectorMap %.2f ms, tr1::unordered_map %.2f ms\n",
+	        keyName, BENCH_ROUNDS * (uint)lookups.size(), flatMs, mapMs, vectorMs, unorderedMs );
+}
+
+/* not a pass/fail test of the speed, it prints the times for comparing builds, the check only
+   verifies, that all maps found the same values; entity ids are sequential, like in the game,
+   class and material names are interned CCryNames; half of the lookups miss */
+UNIT_TEST(FlatHashMap_benchmark)
+{
+	std::vector<uint> ids, idLookups;
+	for (uint i = 0; i < 2 * BENCH_KEYS; i++) {
+		if (i % 2 == 0)
+			ids.push_back( 0x10000 + i );
+		idLookups.push_back( 0x10000 + i );
+	}
+	benchmarkMaps< uint, stl::flat_hash<uint>, std::tr1::hash<uint> >( "EntityId", ids, idLookups );
+
+	std::vector<CCryName> names, nameLookups;
+	char name [32];
+	for (uint i = 0; i < 2 * BENCH_KEYS; i++) {
+		sprintf( name, "bench_name_%u", i );
+		if (i % 2 == 0)
+			names.push_back( CCryName( name ) );
+		nameLookups.push_back( CCryName( name ) );
+	}
+	benchmarkMaps< CCryName, stl::flat_hash_cryname<CCryName>, stl::flat_hash_cryname<CCryName> >( "CCryName", names, nameLookups );
+}
@@ -0,0 +1,167 @@
+//================================================================================
+// File:    Code/Tests/GameplayRecorderTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the gameplay recorder file and its conversion
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/GameplayRecorder.h"
+
+#include <cstdio>
+#include <string>
+
+
+//----------------------------------------------------------------------------------------------------
+static const char * const RECORD_FILE = "GameplayRecorderTest.cfgr";
+static const char * const CSV_FILE = "GameplayRecorderTest.csv";
+static const char * const EVENTS_FILE = "GameplayRecorderTest.csv.events.csv";
+static const char * const XML_FILE = "GameplayRecorderTest.xml";
+
+static std::string readFile( const char * name )
+{
+	std::string content;
+	FILE * file = fopen( name, "rb" );
+	if (!file)
+		return content;
+	char buffer [4096];
+	size_t read;
+	while ((read = fread( buffer, 1, sizeof(buffer), file )) > 0)
+		content.append( buffer, read );
+	fclose( file );
+	return content;
+}
+
+static uint countLines( const std::string & content )
+{
+	uint lines = 0;
+	for (size_t i = 0; i < content.size(); i++)
+		if (content[i] == '\n')
+			lines++;
+	return lines;
+}
+
+static bool contains( const std::string & content, const char * part )
+{
+	return content.find( part ) != std::string::npos;
+}
+
+static void removeFiles()
+{
+	remove( RECORD_FILE );
+	remove( CSV_FILE );
+	remove( EVENTS_FILE );
+	remove( XML_FILE );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(GameplayRecorder_roundTrip)
+{
+	GameplayRecorder::startFile( RECORD_FILE );
+	// strings get ids from 1 in the order of their first use
+	GameplayRecorder::recordEvent( GameplayRecorder::eItemPickedUp, 42, "SCAR", 1.5f );
+	GameplayRecorder::recordEvent( GameplayRecorder::eEnteredVehicle, 42, "Tank \"A&B\"" );
+	GameplayRecorder::recordEvent( GameplayRecorder::eReload, 42, "SCAR" );
+
+	GameplayRecorder::Value values [GameplayRecorder::NUM_COLUMNS];
+	for (uint c = 0; c < GameplayRecorder::NUM_COLUMNS; c++)
+		values[c].u = 0;
+	values[GameplayRecorder::eFrame].u = 3;
+	values[GameplayRecorder::eTime].f = 0.25f;
+	values[GameplayRecorder::eEntityId].u = 42;
+	values[GameplayRecorder::eTeam].u = 300;          // saturates to a byte
+	values[GameplayRecorder::ePosX].f = -1.5f;
+	values[GameplayRecorder::eHealth].u = 100;
+	values[GameplayRecorder::eWeapon].u = 1;
+	values[GameplayRecorder::eSuitEnergy].f = 0.0f;
+	values[GameplayRecorder::eSuitMode].u = 0;
+	values[GameplayRecorder::eVehicle].u = 2;
+	values[GameplayRecorder::eVehicleDamage].f = 0.0f;
+	values[GameplayRecorder::eAIAlertness].f = 0.0f;
+	CHECK( GameplayRecorder::recordRow( values ) );
+
+	GameplayRecorder::finishFile();
+	CHECK( !GameplayRecorder::recordRow( values ) );
+	GameplayRecorder::stopWriter();
+	CHECK_EQUAL( 0u, GameplayRecorder::getDroppedRecords() );
+
+	CHECK( GameplayRecorder::convert( RECORD_FILE, CSV_FILE ) );
+	std::string frames = readFile( CSV_FILE );
+	CHECK_EQUAL( 2u, countLines( frames ) );
+	CHECK( frames.compare( 0, 21, "\"frame\",\"time\",\"entit" ) == 0 );
+	CHECK( contains( frames, "\n3,0.25,42,0,255,-1.5,0,0,100,0,0,\"SCAR\",0,0,0,0,\"Tank \"\"A&B\"\"\",0,0,0,0,0,0,0\n" ) );
+
+	std::string events = readFile( EVENTS_FILE );
+	CHECK_EQUAL( 4u, countLines( events ) );
+	CHECK( contains( events, "\n0,0,42,\"itemPickedUp\",\"SCAR\",1.5\n" ) );
+	CHECK( contains( events, "\n0,0,42,\"enteredVehicle\",\"Tank \"\"A&B\"\"\",0\n" ) );
+	CHECK( contains( events, "\n0,0,42,\"reload\",\"SCAR\",0\n" ) );
+
+	CHECK( GameplayRecorder::convert( RECORD_FILE, XML_FILE ) );
+	std::string xml = readFile( XML_FILE );
+	CHECK( contains( xml, "<Worksheet ss:Name=\"frames\">" ) );
+	CHECK( contains( xml, "<Worksheet ss:Name=\"events\">" ) );
+	CHECK( contains( xml, "<Data ss:Type=\"String\">Tank \"A&amp;B\"</Data>" ) );
+	CHECK( contains( xml, "</Workbook>\n" ) );
+	CHECK( readFile( "GameplayRecorderTest.xml.events.tmp" ).empty() );
+
+	removeFiles();
+}
+
+UNIT_TEST(GameplayRecorder_stringLimit)
+{
+	GameplayRecorder::startFile( RECORD_FILE );
+
+	// ids 1 to 0xFFFE, the writer may fall behind, then the same event is tried again
+	char name [16];
+	for (uint i = 1; i < 0xFFFF; i++) {
+		sprintf( name, "s%u", i );
+		uint dropped = GameplayRecorder::getDroppedRecords();
+		GameplayRecorder::recordEvent( GameplayRecorder::eItemPickedUp, i, name );
+		while (GameplayRecorder::getDroppedRecords() != dropped) {
+			Sleep( 1 );
+			dropped = GameplayRecorder::getDroppedRecords();
+			GameplayRecorder::recordEvent( GameplayRecorder::eItemPickedUp, i, name );
+		}
+	}
+	uint dropped = GameplayRecorder::getDroppedRecords();
+
+	// no more strings fit, such events are dropped without leaving anything in the file
+	GameplayRecorder::recordEvent( GameplayRecorder::eItemPickedUp, 1, "oneTooMany" );
+	CHECK_EQUAL( dropped + 1, GameplayRecorder::getDroppedRecords() );
+	GameplayRecorder::recordEvent( GameplayRecorder::eItemPickedUp, 1, "oneTooMany" );
+	CHECK_EQUAL( dropped + 2, GameplayRecorder::getDroppedRecords() );
+	// the known strings still work
+	GameplayRecorder::recordEvent( GameplayRecorder::eItemDropped, 2, "s65534" );
+	CHECK_EQUAL( dropped + 2, GameplayRecorder::getDroppedRecords() );
+
+	GameplayRecorder::stopWriter();
+
+	CHECK( GameplayRecorder::convert( RECORD_FILE, CSV_FILE ) );
+	std::string events = readFile( EVENTS_FILE );
+	CHECK_EQUAL( 1u + 0xFFFE + 1u, countLines( events ) );
+	CHECK( contains( events, "\n0,0,65534,\"itemPickedUp\",\"s65534\",0\n" ) );
+	CHECK( contains( events, "\n0,0,2,\"itemDropped\",\"s65534\",0\n" ) );
+	CHECK( !contains( events, "oneTooMany" ) );
+
+	removeFiles();
+}
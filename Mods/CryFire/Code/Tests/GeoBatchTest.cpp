@@ -0,0 +1,284 @@
+//================================================================================
+// File:    Code/Tests/GeoBatchTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the batch geometry kernels of Cry_GeoBatch.h
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "Benchmark.h"
+
+#include <Cry_GeoBatch.h>
+
+
+//----------------------------------------------------------------------------------------------------
+/* enough shapes for 5 blocks of 4 and a remainder of 3, so that with GEOBATCH_SSE the first 20 go
+   through the SSE loop, while a batch of one shape always goes through the scalar loop */
+static const int NUM_SHAPES = 23;
+
+static uint randomState = 1;
+static float nextRandom( float min, float max )
+{
+	randomState = randomState * 1664525u + 1013904223u;
+	return min + (max - min) * (float)(randomState >> 8) / (float)(1 << 24);
+}
+
+static Vec3 randomPoint( float range )
+{
+	float x = nextRandom( -range, range );
+	float y = nextRandom( -range, range );
+	float z = nextRandom( -range, range );
+	return Vec3( x, y, z );
+}
+
+/* both loops do the same operations in the same order, the tolerance is only for x87 builds,
+   which can keep intermediate results in higher precision */
+static bool nearlyEqual( float a, float b )
+{
+	return fabsf( a - b ) <= 1e-5f * max( 1.0f, max( fabsf( a ), fabsf( b ) ) );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(GeoBatch_pointPointSimdMatchesScalar)
+{
+	randomState = 1;
+	SBatchPoints points;
+	for (int i = 0; i < NUM_SHAPES; i++)
+		points.Add( randomPoint( 100.0f ) );
+	Vec3 from = randomPoint( 100.0f );
+
+	float distSq [NUM_SHAPES];
+	BatchPointPointDistSq( from, points, distSq );
+	for (int i = 0; i < NUM_SHAPES; i++) {
+		SBatchPoints single;
+		single.Add( points.Get( i ) );
+		float singleDistSq;
+		BatchPointPointDistSq( from, single, &singleDistSq );
+		CHECK( nearlyEqual( singleDistSq, distSq[i] ) );
+		CHECK( nearlyEqual( (points.Get( i ) - from).GetLengthSquared(), distSq[i] ) );
+	}
+}
+
+UNIT_TEST(GeoBatch_pointAABBSimdMatchesScalar)
+{
+	randomState = 2;
+	std::vector<AABB> boxes;
+	SBatchAABBs batch;
+	for (int i = 0; i < NUM_SHAPES; i++) {
+		Vec3 center = randomPoint( 50.0f );
+		Vec3 extent( nextRandom( 0.5f, 10.0f ), nextRandom( 0.5f, 10.0f ), nextRandom( 0.5f, 10.0f ) );
+		boxes.push_back( AABB( center - extent, center + extent ) );
+		batch.Add( boxes.back() );
+	}
+	// one point inside the first box
+	Vec3 points [] = { boxes[0].GetCenter(), randomPoint( 60.0f ), randomPoint( 60.0f ) };
+
+	for (int p = 0; p < 3; p++) {
+		float distSq [NUM_SHAPES];
+		BatchPointAABBDistSq( points[p], batch, distSq );
+		if (p == 0)
+			CHECK_EQUAL( 0.0f, distSq[0] );
+		for (int i = 0; i < NUM_SHAPES; i++) {
+			SBatchAABBs single;
+			single.Add( boxes[i] );
+			float singleDistSq;
+			BatchPointAABBDistSq( points[p], single, &singleDistSq );
+			CHECK( nearlyEqual( singleDistSq, distSq[i] ) );
+			CHECK( nearlyEqual( boxes[i].GetDistanceSqr( points[p] ), distSq[i] ) );
+		}
+	}
+}
+
+UNIT_TEST(GeoBatch_pointSegmentSimdMatchesScalar)
+{
+	randomState = 3;
+	SBatchPoints points;
+	for (int i = 0; i < NUM_SHAPES; i++)
+		points.Add( randomPoint( 100.0f ) );
+	Lineseg segments [] = {
+		Lineseg( randomPoint( 50.0f ), randomPoint( 50.0f ) ),
+		Lineseg( Vec3( 1, 2, 3 ), Vec3( 1, 2, 3 ) ),   // degenerate, the distance to its start
+	};
+
+	for (int s = 0; s < 2; s++) {
+		float distSq [NUM_SHAPES], t [NUM_SHAPES];
+		BatchPointSegmentDistSq( points, segments[s], distSq, t );
+		for (int i = 0; i < NUM_SHAPES; i++) {
+			SBatchPoints single;
+			single.Add( points.Get( i ) );
+			float singleDistSq, singleT;
+			BatchPointSegmentDistSq( single, segments[s], &singleDistSq, &singleT );
+			CHECK( nearlyEqual( singleDistSq, distSq[i] ) );
+			CHECK( nearlyEqual( singleT, t[i] ) );
+
+			float refT;
+			float refDistSq = Distance::Point_LinesegSq( points.Get( i ), segments[s], refT );
+			CHECK( fabsf( refDistSq - distSq[i] ) <= 1e-3f * max( 1.0f, refDistSq ) );
+			CHECK( t[i] >= 0.0f && t[i] <= 1.0f );
+		}
+	}
+}
+
+UNIT_TEST(GeoBatch_sphereFrustumSimdMatchesScalar)
+{
+	randomState = 4;
+	CCamera camera;
+	camera.SetFrustum( 800, 600, DEG2RAD( 60.0f ), 0.25f, 1000.0f );
+	camera.SetMatrix( Matrix34::CreateRotationXYZ( Ang3( 0.1f, 0.0f, 0.7f ), Vec3( 5, 5, 2 ) ) );
+
+	SBatchSpheres batch;
+	std::vector<Sphere> spheres;
+	for (int i = 0; i < NUM_SHAPES * 4; i++) {
+		spheres.push_back( Sphere( randomPoint( 200.0f ), nextRandom( 0.1f, 20.0f ) ) );
+		batch.Add( spheres.back() );
+	}
+
+	uint8 visible [NUM_SHAPES * 4];
+	int numVisible = BatchSphereFrustum( camera, batch, visible );
+	int numCounted = 0;
+	for (int i = 0; i < NUM_SHAPES * 4; i++) {
+		SBatchSpheres single;
+		single.Add( spheres[i] );
+		uint8 singleVisible;
+		int singleNumVisible = BatchSphereFrustum( camera, single, &singleVisible );
+		CHECK_EQUAL( (int)singleVisible, singleNumVisible );
+		CHECK_EQUAL( singleVisible, visible[i] );
+		CHECK_EQUAL( camera.IsSphereVisible_F( spheres[i] ) ? 1 : 0, (int)visible[i] );
+		numCounted += visible[i];
+	}
+	CHECK_EQUAL( numCounted, numVisible );
+	// the random spheres are around the camera, so both results must occur
+	CHECK( numVisible > 0 && numVisible < NUM_SHAPES * 4 );
+}
+
+UNIT_TEST(GeoBatch_emptyBatches)
+{
+	SBatchPoints points;
+	SBatchAABBs boxes;
+	SBatchSpheres spheres;
+	CCamera camera;
+	BatchPointPointDistSq( Vec3( 0, 0, 0 ), points, NULL );
+	BatchPointAABBDistSq( Vec3( 0, 0, 0 ), boxes, NULL );
+	BatchPointSegmentDistSq( points, Lineseg( Vec3( 0, 0, 0 ), Vec3( 1, 0, 0 ) ), NULL );
+	CHECK_EQUAL( 0, BatchSphereFrustum( camera, spheres, NULL ) );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* the batch kernels against the loops they replace, a scene of the size a turret or an explosion
+   typically tests, repeated often enough to be measurable */
+static const int BENCH_SHAPES = 64;
+static const int BENCH_REPEATS = 20000;
+
+UNIT_TEST(GeoBatch_benchmark)
+{
+	BenchmarkRandom random( 5 );
+	SBatchPoints points;
+	std::vector<Vec3> pointList;
+	SBatchAABBs boxes;
+	std::vector<AABB> boxList;
+	SBatchSpheres spheres;
+	std::vector<Sphere> sphereList;
+	for (int i = 0; i < BENCH_SHAPES; i++) {
+		Vec3 center( random.range( -200.0f, 200.0f ), random.range( -200.0f, 200.0f ), random.range( -20.0f, 20.0f ) );
+		Vec3 extent( random.range( 0.5f, 5.0f ), random.range( 0.5f, 5.0f ), random.range( 0.5f, 5.0f ) );
+		pointList.push_back( center );
+		points.Add( center );
+		boxList.push_back( AABB( center - extent, center + extent ) );
+		boxes.Add( boxList.back() );
+		sphereList.push_back( Sphere( center, extent.GetLength() ) );
+		spheres.Add( sphereList.back() );
+	}
+	Vec3 from( 3, 4, 1 );
+	Lineseg segment( from, Vec3( 150, -80, 10 ) );
+	CCamera camera;
+	camera.SetFrustum( 800, 600, DEG2RAD( 60.0f ), 0.25f, 1000.0f );
+	camera.SetMatrix( Matrix34::CreateRotationXYZ( Ang3( 0.0f, 0.0f, 0.7f ), from ) );
+
+	float distSq [BENCH_SHAPES], t [BENCH_SHAPES];
+	uint8 visible [BENCH_SHAPES];
+	float batchSum = 0.0f, scalarSum = 0.0f;
+	int batchVisible = 0, scalarVisible = 0;
+
+	Stopwatch watch;
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		BatchPointPointDistSq( from, points, distSq );
+		batchSum += distSq[r % BENCH_SHAPES];
+	}
+	float pointBatchMs = watch.elapsedMs();
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		for (int i = 0; i < BENCH_SHAPES; i++)
+			distSq[i] = (pointList[i] - from).GetLengthSquared();
+		scalarSum += distSq[r % BENCH_SHAPES];
+	}
+	float pointScalarMs = watch.elapsedMs();
+	CHECK( nearlyEqual( scalarSum, batchSum ) );
+
+	batchSum = scalarSum = 0.0f;
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		BatchPointAABBDistSq( from, boxes, distSq );
+		batchSum += distSq[r % BENCH_SHAPES];
+	}
+	float boxBatchMs = watch.elapsedMs();
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		for (int i = 0; i < BENCH_SHAPES; i++)
+			distSq[i] = boxList[i].GetDistanceSqr( from );
+		scalarSum += distSq[r % BENCH_SHAPES];
+	}
+	float boxScalarMs = watch.elapsedMs();
+	CHECK( nearlyEqual( scalarSum, batchSum ) );
+
+	batchSum = scalarSum = 0.0f;
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		BatchPointSegmentDistSq( points, segment, distSq, t );
+		batchSum += distSq[r % BENCH_SHAPES];
+	}
+	float segmentBatchMs = watch.elapsedMs();
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++) {
+		for (int i = 0; i < BENCH_SHAPES; i++)
+			distSq[i] = Distance::Point_LinesegSq( pointList[i], segment, t[i] );
+		scalarSum += distSq[r % BENCH_SHAPES];
+	}
+	float segmentScalarMs = watch.elapsedMs();
+	// Point_LinesegSq computes the same distance in a different order
+	CHECK( fabsf( scalarSum - batchSum ) <= 1e-3f * max( 1.0f, scalarSum ) );
+
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++)
+		batchVisible += BatchSphereFrustum( camera, spheres, visible );
+	float frustumBatchMs = watch.elapsedMs();
+	watch.restart();
+	for (int r = 0; r < BENCH_REPEATS; r++)
+		for (int i = 0; i < BENCH_SHAPES; i++)
+			scalarVisible += camera.IsSphereVisible_F( sphereList[i] ) ? 1 : 0;
+	float frustumScalarMs = watch.elapsedMs();
+	CHECK_EQUAL( scalarVisible, batchVisible );
+
+	printf( "GeoBatch_benchmark: %d shapes x %d, batch/scalar ms: point %.2f/%.2f, aabb %.2f/%.2f, segment %.2f/%.2f, frustum %.2f/%.2f\n",
+	        BENCH_SHAPES, BENCH_REPEATS, pointBatchMs, pointScalarMs, boxBatchMs, boxScalarMs,
+	        segmentBatchMs, segmentScalarMs, frustumBatchMs, frustumScalarMs );
+}
@@ -0,0 +1,228 @@
+//================================================================================
+// File:    Code/Tests/HitTypesTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the hit type ids looked up by interned names
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "Benchmark.h"
+
+#include "CryFire/HitTypes.h"
+
+#include <map>
+#include <cstdio>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(HitTypes_registerAndLookup)
+{
+	HitTypes hitTypes;
+	CHECK_EQUAL( 1, hitTypes.registerType( "normal" ) );
+	CHECK_EQUAL( 2, hitTypes.registerType( "melee" ) );
+	CHECK_EQUAL( 1, hitTypes.registerType( "normal" ) );
+	CHECK_EQUAL( 2u, hitTypes.getCount() );
+
+	// a copy at another address is the same name
+	char copy [16];
+	strcpy( copy, "melee" );
+	CHECK_EQUAL( 2, hitTypes.getId( copy ) );
+	CHECK_EQUAL( 2, hitTypes.getId( CCryName( "melee" ) ) );
+	CHECK( strcmp( hitTypes.getName( 2 ), "melee" ) == 0 );
+
+	CHECK_EQUAL( 0, hitTypes.getId( "never_interned_hit_type" ) );
+	CHECK_EQUAL( 0, hitTypes.getId( (const char *)NULL ) );
+	CHECK( hitTypes.getName( 3 ) == NULL );
+	CHECK( hitTypes.getName( 0 ) == NULL );
+}
+
+UNIT_TEST(HitTypes_caseSensitiveLikeStringCompare)
+{
+	// the name table ignores case, the ids must not
+	HitTypes hitTypes;
+	CHECK_EQUAL( 1, hitTypes.registerType( "frost" ) );
+	CHECK_EQUAL( 0, hitTypes.getId( "Frost" ) );
+	CHECK_EQUAL( 0, hitTypes.getId( "FROST" ) );
+
+	CHECK_EQUAL( 2, hitTypes.registerType( "Frost" ) );
+	CHECK_EQUAL( 1, hitTypes.getId( "frost" ) );
+	CHECK_EQUAL( 2, hitTypes.getId( "Frost" ) );
+	CHECK( strcmp( hitTypes.getName( 2 ), "Frost" ) == 0 );
+}
+
+UNIT_TEST(HitTypes_addressCacheForgetsUnknownTypes)
+{
+	HitTypes hitTypes;
+	static const char * const punish = "punish";
+	CHECK_EQUAL( 0, hitTypes.getIdByAddress( punish ) );
+
+	// registering clears the remembered 0
+	int id = hitTypes.registerType( "punish" );
+	CHECK( id != 0 );
+	CHECK_EQUAL( id, hitTypes.getIdByAddress( punish ) );
+	CHECK_EQUAL( id, hitTypes.getIdByAddress( punish ) );
+}
+
+UNIT_TEST(HitTypes_resetStartsFromOne)
+{
+	HitTypes hitTypes;
+	hitTypes.registerType( "normal" );
+	hitTypes.registerType( "fire" );
+	CHECK_EQUAL( 2, hitTypes.getIdByAddress( "fire" ) );
+
+	hitTypes.reset();
+	CHECK_EQUAL( 0u, hitTypes.getCount() );
+	CHECK_EQUAL( 0, hitTypes.getId( "fire" ) );
+	CHECK_EQUAL( 0, hitTypes.getIdByAddress( "fire" ) );
+	CHECK_EQUAL( 1, hitTypes.registerType( "fire" ) );
+}
+
+UNIT_TEST(HitTypes_manyTypes)
+{
+	HitTypes hitTypes;
+	char name [32];
+	for (int i = 0; i < 300; i++) {
+		sprintf( name, "hit_type_%d", i );
+		CHECK_EQUAL( i + 1, hitTypes.registerType( name ) );
+	}
+	for (int i = 0; i < 300; i++) {
+		sprintf( name, "hit_type_%d", i );
+		CHECK_EQUAL( i + 1, hitTypes.getId( name ) );
+		CHECK( strcmp( hitTypes.getName( i + 1 ), name ) == 0 );
+	}
+}
+
+//----------------------------------------------------------------------------------------------------
+static const uint BENCH_LOOKUPS = 200000;
+static const int BENCH_MATERIALS = 120;
+
+/* hit types registered by the Crysis game rules, the ones of weapons come first */
+static const char * const benchHitTypes [] = {
+	"normal", "bullet", "gaussbullet", "melee", "frost", "fire", "tac", "avmine", "moacbullet",
+	"trooperbullet", "aacannon", "emp", "repair", "lockpick", "collision", "event", "punish", "fall", "heal", "electricity"
+};
+static const uint NUM_BENCH_HIT_TYPES = sizeof(benchHitTypes) / sizeof(benchHitTypes[0]);
+
+static const char * const benchClasses [] = {
+	"SCAR", "FY71", "SMG", "Shotgun", "DSG1", "GaussRifle", "Hurricane", "LAW", "SOCOM", "TACGun",
+	"AlienMount", "AVMine", "Claymore", "C4", "Binoculars", "Fists", "OffHand", "Detonator", "RadarKit", "LockpickKit"
+};
+static const uint NUM_BENCH_CLASSES = sizeof(benchClasses) / sizeof(benchClasses[0]);
+
+/* CGameRules::GetHitTypeId before the index, compares every registered name */
+static int scanHitTypes( const FlatHashMap<int, string> & types, const char * type )
+{
+	for (FlatHashMap<int, string>::const_iterator it = types.begin(); it != types.end(); ++it)
+		if (it->second == type)
+			return it->first;
+	return 0;
+}
+
+/* CGameRules::GetHitMaterialIdFromSurfaceId before the index, hit material id -> surface id, scanned by value */
+static int scanHitMaterials( const std::map<int, int> & materials, int surfaceId )
+{
+	for (std::map<int, int>::const_iterator it = materials.begin(); it != materials.end(); ++it)
+		if (it->second == surfaceId)
+			return it->first;
+	return 0;
+}
+
+/* prints the old string compares and scans against the lookups used on the per-hit and per-shot paths now:
+   hit type of a fire mode (an interned string) and hit material of a bullet impact (a surface id);
+   shared params of a weapon class are looked up by a class name, which would have to be interned for every
+   lookup, so they stay keyed by string; the check only verifies, that all variants found the same ids */
+UNIT_TEST(HitTypes_benchmark)
+{
+	HitTypes hitTypes;
+	FlatHashMap<int, string> oldHitTypes;
+	for (uint i = 0; i < NUM_BENCH_HIT_TYPES; i++)
+		oldHitTypes[hitTypes.registerType( benchHitTypes[i] )] = benchHitTypes[i];
+
+	int oldSum = 0, newSum = 0;
+	Stopwatch watch;
+	for (uint i = 0; i < BENCH_LOOKUPS; i++)
+		oldSum += scanHitTypes( oldHitTypes, benchHitTypes[(i * 7) % NUM_BENCH_HIT_TYPES] );
+	float oldTypeMs = watch.elapsedMs();
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++)
+		newSum += hitTypes.getIdByAddress( benchHitTypes[(i * 7) % NUM_BENCH_HIT_TYPES] );
+	float newTypeMs = watch.elapsedMs();
+	CHECK_EQUAL( oldSum, newSum );
+
+	// hit materials are registered in the order of the surface types, their ids differ
+	std::map<int, int> oldMaterials;
+	FlatHashMap<int, int> materialIds;
+	for (int i = 1; i <= BENCH_MATERIALS; i++) {
+		oldMaterials[i] = 1000 + i * 3;
+		materialIds[1000 + i * 3] = i;
+	}
+	oldSum = newSum = 0;
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++)
+		oldSum += scanHitMaterials( oldMaterials, 1000 + (i % (BENCH_MATERIALS + 10)) * 3 );
+	float oldMaterialMs = watch.elapsedMs();
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++) {
+		FlatHashMap<int, int>::const_iterator it = materialIds.find( 1000 + (i % (BENCH_MATERIALS + 10)) * 3 );
+		newSum += it != materialIds.end() ? it->second : 0;
+	}
+	float newMaterialMs = watch.elapsedMs();
+	CHECK_EQUAL( oldSum, newSum );
+
+	// CItemSharedParamsList::GetSharedParams: the original std::map, the FlatHashMap it uses now and interned names
+	std::map<string, int> oldParams;
+	FlatHashMap<string, int, stl::flat_hash_strcmp<string> > params;
+	FlatHashMap<CCryName, int, stl::flat_hash_cryname<CCryName> > internedParams;
+	for (uint i = 0; i < NUM_BENCH_CLASSES; i++) {
+		oldParams[benchClasses[i]] = i + 1;
+		params[benchClasses[i]] = i + 1;
+		internedParams[CCryName( benchClasses[i] )] = i + 1;
+	}
+	oldSum = newSum = 0;
+	int internedSum = 0;
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++) {
+		std::map<string, int>::const_iterator it = oldParams.find( CONST_TEMP_STRING( benchClasses[(i * 7) % NUM_BENCH_CLASSES] ) );
+		oldSum += it != oldParams.end() ? it->second : 0;
+	}
+	float oldParamsMs = watch.elapsedMs();
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++) {
+		FlatHashMap<string, int, stl::flat_hash_strcmp<string> >::const_iterator it = params.find( CONST_TEMP_STRING( benchClasses[(i * 7) % NUM_BENCH_CLASSES] ) );
+		newSum += it != params.end() ? it->second : 0;
+	}
+	float newParamsMs = watch.elapsedMs();
+	watch.restart();
+	for (uint i = 0; i < BENCH_LOOKUPS; i++) {
+		FlatHashMap<CCryName, int, stl::flat_hash_cryname<CCryName> >::const_iterator it = internedParams.find( CCryName( benchClasses[(i * 7) % NUM_BENCH_CLASSES], true ) );
+		internedSum += it != internedParams.end() ? it->second : 0;
+	}
+	float internedParamsMs = watch.elapsedMs();
+	CHECK_EQUAL( oldSum, newSum );
+	CHECK_EQUAL( oldSum, internedSum );
+
+	printf( "HitTypes_benchmark: %u lookups each, hit type scan %.2f ms, by address %.2f ms; hit material scan %.2f ms, index %.2f ms; "
+	        "shared params std::map %.2f ms, FlatHashMap %.2f ms, interned %.2f ms\n",
+	        BENCH_LOOKUPS, oldTypeMs, newTypeMs, oldMaterialMs, newMaterialMs, oldParamsMs, newParamsMs, internedParamsMs );
+}
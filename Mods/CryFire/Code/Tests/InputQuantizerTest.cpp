@@ -0,0 +1,147 @@
+//================================================================================
+// File:    Code/Tests/InputQuantizerTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the player input quantization
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/InputQuantizer.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static SQuantizedInput quantize( const SSerializedPlayerInput & input )
+{
+	SQuantizedInput quantized;
+	quantized.quantize( input, 7, 12, 11 );
+	return quantized;
+}
+
+static Vec3 lookAt( float yaw, float pitch )
+{
+	return Vec3( -sinf(yaw) * cosf(pitch), cosf(yaw) * cosf(pitch), sinf(pitch) );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(InputQuantizer_zeroMovementStaysZero)
+{
+	SSerializedPlayerInput input;
+	SQuantizedInput quantized = quantize( input );
+	CHECK_EQUAL( 0, quantized.move[0] );
+	CHECK_EQUAL( 0, quantized.move[1] );
+	CHECK_EQUAL( 0, quantized.move[2] );
+
+	input.deltaMovement = Vec3( 1.0f, -1.0f, 5.0f );
+	quantized = quantize( input );
+	CHECK_EQUAL( 63, quantized.move[0] );
+	CHECK_EQUAL( -63, quantized.move[1] );
+	CHECK_EQUAL( 63, quantized.move[2] );
+}
+
+UNIT_TEST(InputQuantizer_changeBelowStepIsEqual)
+{
+	SSerializedPlayerInput input;
+	input.deltaMovement = Vec3( 0.5f, 0.0f, 0.0f );
+	input.lookDirection = lookAt( 1.0f, 0.2f );
+	SQuantizedInput first = quantize( input );
+
+	SSerializedPlayerInput moved = input;
+	moved.deltaMovement.x += 0.005f;
+	moved.lookDirection = lookAt( 1.0f + 0.0005f, 0.2f + 0.0005f );
+	CHECK( quantize( moved ) == first );
+
+	moved.deltaMovement.x = input.deltaMovement.x + 0.02f;
+	CHECK( quantize( moved ) != first );
+
+	moved = input;
+	moved.lookDirection = lookAt( 1.0f + 0.002f, 0.2f );
+	CHECK( quantize( moved ) != first );
+
+	moved = input;
+	moved.lookDirection = lookAt( 1.0f, 0.2f + 0.002f );
+	CHECK( quantize( moved ) != first );
+}
+
+UNIT_TEST(InputQuantizer_buttonsAndStanceAlwaysCount)
+{
+	SSerializedPlayerInput input;
+	SQuantizedInput first = quantize( input );
+
+	SSerializedPlayerInput changed = input;
+	changed.sprint = true;
+	CHECK( quantize( changed ) != first );
+	changed = input;
+	changed.leanl = true;
+	CHECK( quantize( changed ) != first );
+	changed = input;
+	changed.leanr = true;
+	CHECK( quantize( changed ) != first );
+	changed = input;
+	changed.stance = STANCE_CROUCH;
+	CHECK( quantize( changed ) != first );
+}
+
+UNIT_TEST(InputQuantizer_yawWrapsAround)
+{
+	SSerializedPlayerInput a, b;
+	a.lookDirection = lookAt( gf_PI - 0.00001f, 0.0f );
+	b.lookDirection = lookAt( -gf_PI + 0.00001f, 0.0f );
+	CHECK( quantize( a ) == quantize( b ) );
+}
+
+/* comparing against the last sent state, slow turning crosses the steps just like fast turning */
+UNIT_TEST(InputQuantizer_slowTurningIsSent)
+{
+	const float yawStep = 2.0f * gf_PI / 4096.0f;
+
+	SSerializedPlayerInput input;
+	SQuantizedInput lastSent = quantize( input );
+	uint numSent = 0;
+	for (int i = 1; i <= 1000; i++)
+	{
+		input.lookDirection = lookAt( i * yawStep * 0.1f, 0.0f );
+		SQuantizedInput quantized = quantize( input );
+		if (quantized != lastSent)
+		{
+			lastSent = quantized;
+			numSent++;
+		}
+	}
+	CHECK( numSent >= 99 && numSent <= 101 );
+}
+
+UNIT_TEST(InputQuantizer_bitsAreClamped)
+{
+	SSerializedPlayerInput input;
+	input.deltaMovement = Vec3( 1.0f, 0.0f, 0.0f );
+	input.lookDirection = lookAt( 0.0f, gf_PI * 0.5f );
+
+	SQuantizedInput low, high;
+	low.quantize( input, 0, 0, 0 );
+	high.quantize( input, 100, 100, 100 );
+	CHECK_EQUAL( 1, low.move[0] );         // 2 bits
+	CHECK_EQUAL( 15, low.pitch );          // 4 bits
+	CHECK_EQUAL( 127, high.move[0] );      // 8 bits
+	CHECK_EQUAL( 65535, high.pitch );      // 16 bits
+}
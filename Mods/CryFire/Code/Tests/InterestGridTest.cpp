@@ -0,0 +1,231 @@
+//================================================================================
+// File:    Code/Tests/InterestGridTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the interest tiers of the relevancy grid
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "Benchmark.h"
+
+#include "CryFire/InterestGrid.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+//----------------------------------------------------------------------------------------------------
+static const float RADIUS = 100.0f;
+static const Vec3 NORTH( 0.0f, 1.0f, 0.0f );
+static const Vec3 SOUTH( 0.0f, -1.0f, 0.0f );
+
+static bool contains( const std::vector<int> & channels, int chnlId )
+{
+	return std::find( channels.begin(), channels.end(), chnlId ) != channels.end();
+}
+
+/* both ways of asking must agree for known channels */
+static bool interested( const InterestGrid & grid, int chnlId, const Vec3 & pos, int team )
+{
+	std::vector<int> channels;
+	grid.getInterested( pos, team, channels );
+	bool fromSet = contains( channels, chnlId );
+	bool direct = grid.isInterested( chnlId, pos, team );
+	CHECK_EQUAL( direct, fromSet );
+	return direct;
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(InterestGrid_nearIsInterestingInAllDirections)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 1, Vec3( 1000, 1000, 0 ), NORTH, 1 );
+
+	CHECK( interested( grid, 1, Vec3( 1000, 1090, 0 ), 2 ) );
+	CHECK( interested( grid, 1, Vec3( 1000, 910, 0 ), 2 ) );
+	CHECK( interested( grid, 1, Vec3( 1070, 1070, 0 ), 0 ) );
+	CHECK( !interested( grid, 1, Vec3( 1000, 890, 0 ), 2 ) );
+	CHECK( !interested( grid, 1, Vec3( 890, 1000, 0 ), 0 ) );
+}
+
+UNIT_TEST(InterestGrid_viewConeReachesTwoRadii)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 1, Vec3( 1000, 1000, 0 ), NORTH, 1 );
+
+	CHECK( interested( grid, 1, Vec3( 1000, 1190, 0 ), 2 ) );
+	CHECK( interested( grid, 1, Vec3( 1100, 1150, 0 ), 2 ) );    // 34 degrees off
+	CHECK( !interested( grid, 1, Vec3( 1150, 1100, 0 ), 2 ) );   // 56 degrees off
+	CHECK( !interested( grid, 1, Vec3( 1000, 1210, 0 ), 2 ) );
+	CHECK( !interested( grid, 1, Vec3( 1000, 810, 0 ), 2 ) );    // behind
+}
+
+UNIT_TEST(InterestGrid_teamIsInterestingEverywhere)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 1, Vec3( 1000, 1000, 0 ), NORTH, 1 );
+	grid.addObserver( 2, Vec3( 3000, 3000, 0 ), SOUTH, 2 );
+
+	CHECK( interested( grid, 1, Vec3( 5000, 5000, 0 ), 1 ) );
+	CHECK( !interested( grid, 2, Vec3( 5000, 5000, 0 ), 1 ) );
+	// team 0 means no team, it doesn't match observers without a team
+	grid.addObserver( 3, Vec3( 0, 0, 0 ), NORTH, 0 );
+	CHECK( !interested( grid, 3, Vec3( 5000, 5000, 0 ), 0 ) );
+}
+
+UNIT_TEST(InterestGrid_unknownChannelsGetEverything)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 1, Vec3( 1000, 1000, 0 ), NORTH, 1 );
+
+	CHECK( !grid.isKnown( 7 ) );
+	CHECK( grid.isInterested( 7, Vec3( 5000, 5000, 0 ), 2 ) );
+
+	grid.removeObserver( 1 );
+	CHECK( !grid.isKnown( 1 ) );
+	CHECK( grid.isInterested( 1, Vec3( 5000, 5000, 0 ), 2 ) );
+	std::vector<int> channels;
+	grid.getInterested( Vec3( 1000, 1000, 0 ), 1, channels );
+	CHECK( channels.empty() );
+}
+
+UNIT_TEST(InterestGrid_cellsAcrossZeroAndSetIsSorted)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 5, Vec3( -10, -10, 0 ), NORTH, 0 );
+	grid.addObserver( 3, Vec3( 10, 10, 0 ), SOUTH, 1 );
+	grid.addObserver( 4, Vec3( -150, 5, 0 ), NORTH, 1 );
+	grid.addObserver( 9, Vec3( 2000, 2000, 0 ), NORTH, 0 );
+	CHECK_EQUAL( 4u, grid.getObserverCount() );
+
+	std::vector<int> channels;
+	grid.getInterested( Vec3( 0, 0, 0 ), 0, channels );
+	CHECK_EQUAL( 2u, (uint)channels.size() );
+	CHECK( channels.size() == 2 && channels[0] == 3 && channels[1] == 5 );
+
+	// team members are added once, even if they are also close
+	grid.getInterested( Vec3( 0, 0, 0 ), 1, channels );
+	CHECK( channels.size() == 3 && channels[0] == 3 && channels[1] == 4 && channels[2] == 5 );
+}
+
+UNIT_TEST(InterestGrid_resetForgetsObservers)
+{
+	InterestGrid grid;
+	grid.reset( RADIUS );
+	grid.addObserver( 1, Vec3( 0, 0, 0 ), NORTH, 1 );
+	grid.reset( 50.0f );
+	CHECK( grid.isEmpty() );
+	CHECK_EQUAL( 0u, grid.getCellCount() );
+	CHECK_EQUAL( 50.0f, grid.getCellSize() );
+}
+
+//----------------------------------------------------------------------------------------------------
+static const uint SIM_PLAYERS = 32;
+static const uint SIM_OBJECTS = 150;        // vehicles, buildings and other minimap entities
+static const float SIM_MAP_SIZE = 4000.0f;
+static const float SIM_STEP = 0.5f;         // Relevancy::UPDATE_INTERVAL
+static const uint SIM_STEPS = 120;
+
+struct SimEntity {
+	Vec3 pos;
+	Vec3 target;
+	int team;
+};
+
+static void pickTarget( SimEntity & player, BenchmarkRandom & random )
+{
+	player.target = Vec3( random.range( 0.0f, SIM_MAP_SIZE ), random.range( 0.0f, SIM_MAP_SIZE ), 0.0f );
+}
+
+/* synthetic Power Struggle round: two teams start in their bases in opposite corners of the map and run
+   (or drive) towards random points, the grid is rebuilt every half a second like Relevancy does it,
+   and every player and object asks who is interested in it; prints how long the grid and asking every
+   observer directly take and how many of the updates would be sent instead of all of them */
+UNIT_TEST(InterestGrid_benchmark)
+{
+	BenchmarkRandom random;
+	std::vector<SimEntity> players( SIM_PLAYERS );
+	std::vector<SimEntity> objects( SIM_OBJECTS );
+	for (uint i = 0; i < SIM_PLAYERS; i++) {
+		players[i].team = 1 + i % 2;
+		float base = players[i].team == 1 ? 400.0f : SIM_MAP_SIZE - 400.0f;
+		players[i].pos = Vec3( base + random.range( -100.0f, 100.0f ), base + random.range( -100.0f, 100.0f ), 0.0f );
+		pickTarget( players[i], random );
+	}
+	for (uint i = 0; i < SIM_OBJECTS; i++) {
+		objects[i].pos = Vec3( random.range( 0.0f, SIM_MAP_SIZE ), random.range( 0.0f, SIM_MAP_SIZE ), 0.0f );
+		objects[i].team = random.next() % 3;
+	}
+
+	InterestGrid grid;
+	std::vector<int> channels;
+	std::vector< std::vector<int> > sets( SIM_PLAYERS + SIM_OBJECTS );
+	uint numSent = 0, numUpdates = 0, numMismatches = 0;
+	float gridMs = 0.0f, directMs = 0.0f;
+
+	for (uint step = 0; step < SIM_STEPS; step++) {
+		for (uint i = 0; i < SIM_PLAYERS; i++) {
+			SimEntity & player = players[i];
+			float speed = i % 4 == 0 ? 20.0f : 7.0f;   // every fourth one is in a vehicle
+			Vec3 toTarget = player.target - player.pos;
+			if (toTarget.GetLength() < speed * SIM_STEP)
+				pickTarget( player, random );
+			else
+				player.pos += toTarget.GetNormalized() * speed * SIM_STEP;
+		}
+
+		Stopwatch watch;
+		grid.reset( 200.0f );
+		for (uint i = 0; i < SIM_PLAYERS; i++)
+			grid.addObserver( i + 1, players[i].pos, (players[i].target - players[i].pos).GetNormalizedSafe( NORTH ), players[i].team );
+		for (uint e = 0; e < sets.size(); e++) {
+			const SimEntity & entity = e < SIM_PLAYERS ? players[e] : objects[e - SIM_PLAYERS];
+			grid.getInterested( entity.pos, entity.team, sets[e] );
+		}
+		gridMs += watch.elapsedMs();
+
+		watch.restart();
+		for (uint e = 0; e < sets.size(); e++) {
+			const SimEntity & entity = e < SIM_PLAYERS ? players[e] : objects[e - SIM_PLAYERS];
+			channels.clear();
+			for (uint i = 0; i < SIM_PLAYERS; i++)
+				if (grid.isInterested( i + 1, entity.pos, entity.team ))
+					channels.push_back( i + 1 );
+			if (channels != sets[e])
+				numMismatches++;
+			numSent += channels.size();
+			numUpdates += SIM_PLAYERS;
+		}
+		directMs += watch.elapsedMs();
+	}
+
+	CHECK_EQUAL( 0u, numMismatches );
+	printf( "InterestGrid_benchmark: %u players, %u objects, %u refreshes, grid %.2f ms, every observer %.2f ms, %u of %u updates sent (%.0f %%)\n",
+	        SIM_PLAYERS, SIM_OBJECTS, SIM_STEPS, gridMs, directMs, numSent, numUpdates, 100.0f * numSent / numUpdates );
+}
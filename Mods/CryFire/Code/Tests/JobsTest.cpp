@@ -0,0 +1,249 @@
+//================================================================================
+// File:    Code/Tests/JobsTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the dependencies, postponing and worker threads of the frame jobs
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "Benchmark.h"
+
+#include "CryFire/Jobs.h"
+
+#include <cstring>
+#include <cstdio>
+
+
+//----------------------------------------------------------------------------------------------------
+static const uint MAX_TEST_JOBS = 16;
+
+static volatile LONG counter = 0;
+static LONG order [MAX_TEST_JOBS];      // when the job ran, 0 = not yet
+static DWORD threadOf [MAX_TEST_JOBS];
+static uint numSlowRuns = 0;
+
+static void recordJob( void * arg )
+{
+	uint idx = (uint)(size_t)arg;
+	order[idx] = InterlockedIncrement( &counter );
+	threadOf[idx] = GetCurrentThreadId();
+}
+
+static void slowJob( void * arg )
+{
+	Stopwatch watch;
+	while (watch.elapsedMs() < 3.0f) {}
+	numSlowRuns++;
+}
+
+static Jobs::jobId addRecord( uint idx, uint flags = 0 )
+{
+	return Jobs::add( "record", recordJob, (void *)(size_t)idx, flags );
+}
+
+static void startTest()
+{
+	Jobs::reset();
+	counter = 0;
+	memset( order, 0, sizeof(order) );
+	memset( threadOf, 0, sizeof(threadOf) );
+	numSlowRuns = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(Jobs_dependenciesRunInOrder)
+{
+	startTest();
+	// added in reverse, so that the order of adding doesn't help
+	Jobs::jobId d = addRecord( 3 );
+	Jobs::jobId c = addRecord( 2 );
+	Jobs::jobId b = addRecord( 1 );
+	Jobs::jobId a = addRecord( 0 );
+	Jobs::addDependency( d, b );
+	Jobs::addDependency( d, c );
+	Jobs::addDependency( b, a );
+	Jobs::addDependency( c, a );
+
+	Jobs::beginFrame( false, 0.0f );
+	Jobs::endFrame();
+
+	CHECK( order[0] != 0 && order[1] != 0 && order[2] != 0 && order[3] != 0 );
+	CHECK( order[0] < order[1] && order[0] < order[2] );
+	CHECK( order[3] > order[1] && order[3] > order[2] );
+
+	// nothing is left for the next frame
+	Jobs::beginFrame( false, 0.0f );
+	Jobs::endFrame();
+	CHECK_EQUAL( 4, (int)counter );
+}
+
+UNIT_TEST(Jobs_sameJobIsAddedOnce)
+{
+	startTest();
+	Jobs::jobId a = addRecord( 0 );
+	CHECK_EQUAL( a, addRecord( 0 ) );
+	CHECK( addRecord( 1 ) != a );
+
+	Jobs::beginFrame( false, 0.0f );
+	CHECK_EQUAL( Jobs::NO_JOB, addRecord( 2 ) );
+	Jobs::endFrame();
+	CHECK_EQUAL( 2, (int)counter );
+	CHECK_EQUAL( 0, order[2] );
+}
+
+UNIT_TEST(Jobs_deferrableIsPostponedWithDependents)
+{
+	startTest();
+	Jobs::jobId slow = Jobs::add( "slow", slowJob, NULL );
+	Jobs::jobId deferrable = addRecord( 0, Jobs::eDeferrable );
+	Jobs::jobId dependent = addRecord( 1 );
+	Jobs::addDependency( deferrable, slow );
+	Jobs::addDependency( dependent, deferrable );
+
+	Jobs::beginFrame( false, 1.0f );
+	Jobs::endFrame();
+	CHECK_EQUAL( 1u, numSlowRuns );
+	CHECK_EQUAL( 0, order[0] );
+	CHECK_EQUAL( 0, order[1] );
+
+	// adding it again in the next frame finds the postponed one
+	CHECK_EQUAL( 0, addRecord( 0, Jobs::eDeferrable ) );
+	Jobs::beginFrame( false, 1.0f );
+	Jobs::endFrame();
+	CHECK_EQUAL( 1u, numSlowRuns );
+	CHECK( order[0] != 0 && order[0] < order[1] );
+}
+
+UNIT_TEST(Jobs_workersRunTheGraph)
+{
+	startTest();
+	Jobs::initialize( 3 );
+	DWORD mainThread = GetCurrentThreadId();
+
+	for (uint frame = 0; frame < 50; frame++) {
+		counter = 0;
+		memset( order, 0, sizeof(order) );
+
+		// two chains joined by a main thread job, plus independent ones
+		Jobs::jobId prev1 = Jobs::NO_JOB, prev2 = Jobs::NO_JOB;
+		for (uint i = 0; i < 4; i++) {
+			Jobs::jobId job1 = addRecord( i );
+			Jobs::jobId job2 = addRecord( 4 + i );
+			Jobs::addDependency( job1, prev1 );
+			Jobs::addDependency( job2, prev2 );
+			prev1 = job1;
+			prev2 = job2;
+		}
+		Jobs::jobId join = addRecord( 8, Jobs::eMainThread );
+		Jobs::addDependency( join, prev1 );
+		Jobs::addDependency( join, prev2 );
+		for (uint i = 9; i < MAX_TEST_JOBS; i++)
+			addRecord( i );
+
+		Jobs::beginFrame( true, 0.0f );
+		Jobs::endFrame();
+
+		CHECK_EQUAL( (LONG)MAX_TEST_JOBS, counter );
+		for (uint i = 1; i < 4; i++) {
+			CHECK( order[i - 1] < order[i] );
+			CHECK( order[4 + i - 1] < order[4 + i] );
+		}
+		CHECK( order[8] > order[3] && order[8] > order[7] );
+		CHECK( threadOf[8] == mainThread );
+	}
+
+	Jobs::terminate();
+}
+
+//----------------------------------------------------------------------------------------------------
+static const uint LOAD_CHAINS = 4;
+static const uint LOAD_CHAIN_LENGTH = 3;
+static const uint LOAD_SINGLES = 8;
+static const uint LOAD_JOBS = LOAD_CHAINS * LOAD_CHAIN_LENGTH + LOAD_SINGLES;
+static const uint LOAD_ITERATIONS = 100000;   // roughly half a millisecond of work
+static const uint LOAD_FRAMES = 30;
+
+static float loadResults [LOAD_JOBS + 1];     // the last one belongs to the main thread job
+
+/* deterministic floating point work, a job of a chain continues from the result of the previous one */
+static void loadJob( void * arg )
+{
+	uint idx = (uint)(size_t)arg;
+	float value = idx % LOAD_CHAIN_LENGTH && idx < LOAD_CHAINS * LOAD_CHAIN_LENGTH ? loadResults[idx - 1] : (float)idx;
+	for (uint i = 0; i < LOAD_ITERATIONS; i++)
+		value = value * 0.999f + sqrtf( (float)(i & 255) );
+	loadResults[idx] = value;
+}
+
+static void joinJob( void * arg )
+{
+	float sum = 0.0f;
+	for (uint c = 0; c < LOAD_CHAINS; c++)
+		sum += loadResults[c * LOAD_CHAIN_LENGTH + LOAD_CHAIN_LENGTH - 1];
+	loadResults[LOAD_JOBS] = sum;
+}
+
+/* a frame shaped like the game's: chains of jobs which depend on each other (update, then decay, ...),
+   independent ones, and a main thread job which collects the results of the chains */
+static float runLoadFrames( bool useWorkers )
+{
+	Stopwatch watch;
+	for (uint frame = 0; frame < LOAD_FRAMES; frame++) {
+		Jobs::jobId join = Jobs::add( "join", joinJob, NULL, Jobs::eMainThread );
+		for (uint c = 0; c < LOAD_CHAINS; c++) {
+			Jobs::jobId prev = Jobs::NO_JOB;
+			for (uint i = 0; i < LOAD_CHAIN_LENGTH; i++) {
+				Jobs::jobId job = Jobs::add( "chain", loadJob, (void *)(size_t)(c * LOAD_CHAIN_LENGTH + i) );
+				Jobs::addDependency( job, prev );
+				prev = job;
+			}
+			Jobs::addDependency( join, prev );
+		}
+		for (uint i = LOAD_CHAINS * LOAD_CHAIN_LENGTH; i < LOAD_JOBS; i++)
+			Jobs::add( "single", loadJob, (void *)(size_t)i );
+
+		Jobs::beginFrame( useWorkers, 0.0f );
+		Jobs::endFrame();
+	}
+	return watch.elapsedMs();
+}
+
+/* prints the time of the same graph run serially in endFrame and on 3 workers,
+   the check only verifies, that both computed the same results */
+UNIT_TEST(Jobs_benchmark)
+{
+	startTest();
+	memset( loadResults, 0, sizeof(loadResults) );
+	float serialMs = runLoadFrames( false );
+	float serialResults [LOAD_JOBS + 1];
+	memcpy( serialResults, loadResults, sizeof(loadResults) );
+
+	memset( loadResults, 0, sizeof(loadResults) );
+	Jobs::initialize( 3 );
+	float workersMs = runLoadFrames( true );
+	Jobs::terminate();
+
+	CHECK( memcmp( serialResults, loadResults, sizeof(loadResults) ) == 0 );
+	printf( "Jobs_benchmark: %u frames of %u jobs, serial %.2f ms, 3 workers %.2f ms\n", LOAD_FRAMES, LOAD_JOBS + 1, serialMs, workersMs );
+}
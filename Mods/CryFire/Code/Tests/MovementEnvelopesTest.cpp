@@ -0,0 +1,194 @@
+//================================================================================
+// File:    Code/Tests/MovementEnvelopesTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the movement envelopes on recorded traces in MovementTraces
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "Benchmark.h"
+
+#include "CryFire/MovementEnvelopes.h"
+
+#include <string>
+
+
+//----------------------------------------------------------------------------------------------------
+// the defaults of cf_movecheck_tolerance, cf_movecheck_slack and cf_movecheck_impulse
+static const float TOLERANCE = 1.2f;
+static const float SLACK = 2.0f;
+static const float IMPULSE = 6.0f;
+
+/* the traces are in Tests/MovementTraces, the tests run in Tests, they can be tried with cf_checkmovementtrace too */
+static MovementEnvelopes::TraceSummary replay( const char * name, float impulse = IMPULSE )
+{
+	MovementEnvelopes::TraceSummary summary;
+	std::string fileName = std::string( "MovementTraces/" ) + name;
+	bool read = MovementEnvelopes::replayTrace( fileName.c_str(), TOLERANCE, SLACK, impulse, summary );
+	CHECK( read );
+	CHECK( summary.samples > 0 );
+	return summary;
+}
+
+static uint countViolations( const MovementEnvelopes::TraceSummary & summary )
+{
+	return summary.violations[MovementEnvelopes::eMinor] + summary.violations[MovementEnvelopes::eMajor]
+	     + summary.violations[MovementEnvelopes::eTeleport];
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(MovementEnvelopes_honestTraces)
+{
+	CHECK_EQUAL( 0u, countViolations( replay( "run.csv" ) ) );
+	// the allowed speed drops before the player slows down
+	CHECK_EQUAL( 0u, countViolations( replay( "sprintRelease.csv" ) ) );
+	CHECK_EQUAL( 0u, countViolations( replay( "energyDrain.csv" ) ) );
+	CHECK_EQUAL( 0u, countViolations( replay( "knockback.csv" ) ) );
+}
+
+UNIT_TEST(MovementEnvelopes_knockbackNeedsTheImpulse)
+{
+	MovementEnvelopes::TraceSummary summary = replay( "knockback.csv", 0.0f );
+	CHECK_EQUAL( 1u, countViolations( summary ) );
+	CHECK_EQUAL( 1u, summary.violations[MovementEnvelopes::eMinor] );
+}
+
+UNIT_TEST(MovementEnvelopes_cheatTraces)
+{
+	MovementEnvelopes::TraceSummary summary = replay( "speedHack.csv" );
+	CHECK( summary.violations[MovementEnvelopes::eMajor] >= 2 );
+	CHECK_EQUAL( 0u, summary.violations[MovementEnvelopes::eTeleport] );
+
+	// the window starts again after the jump, so it's reported only once
+	summary = replay( "teleport.csv" );
+	CHECK_EQUAL( 1u, summary.violations[MovementEnvelopes::eTeleport] );
+	CHECK_EQUAL( 1u, countViolations( summary ) );
+}
+
+UNIT_TEST(MovementEnvelopes_missingTrace)
+{
+	MovementEnvelopes::TraceSummary summary;
+	CHECK( !MovementEnvelopes::replayTrace( "MovementTraces/doesNotExist.csv", TOLERANCE, SLACK, IMPULSE, summary ) );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* one step of the slots 0 and 1, slot 0 stands, slot 1 moves by step1, returns the severity of slot 1 */
+static MovementEnvelopes::ESeverity step( MovementEnvelopes & envelopes, float & x1, float step1 )
+{
+	MovementEnvelopes::Result results [MovementEnvelopes::MAX_SLOTS];
+	x1 += step1;
+	envelopes.setSample( 0, 0.0f, 0.0f, 5.0f, 0.1f );
+	envelopes.setSample( 1, x1, 0.0f, 5.0f, 0.1f );
+	envelopes.evaluate( TOLERANCE, SLACK, results );
+	CHECK_EQUAL( MovementEnvelopes::eNone, results[0].severity );
+	return results[1].severity;
+}
+
+UNIT_TEST(MovementEnvelopes_slotsAreSeparate)
+{
+	MovementEnvelopes * envelopes = new MovementEnvelopes;
+	CHECK_EQUAL( 0, envelopes->addSlot() );
+	CHECK_EQUAL( 1, envelopes->addSlot() );
+
+	float x1 = 0.0f;
+	for (uint i = 0; i < MovementEnvelopes::RING; i++)
+		CHECK_EQUAL( MovementEnvelopes::eNone, step( *envelopes, x1, 0.5f ) );
+	CHECK_EQUAL( MovementEnvelopes::eTeleport, step( *envelopes, x1, 50.0f ) );
+
+	// a slot without a sample is freed in the next evaluation
+	MovementEnvelopes::Result results [MovementEnvelopes::MAX_SLOTS];
+	envelopes->setSample( 0, 0.0f, 0.0f, 5.0f, 0.1f );
+	envelopes->evaluate( TOLERANCE, SLACK, results );
+	CHECK( envelopes->isUsed( 0 ) );
+	CHECK( !envelopes->isUsed( 1 ) );
+	CHECK_EQUAL( 1, envelopes->addSlot() );
+
+	delete envelopes;
+}
+
+UNIT_TEST(MovementEnvelopes_pushesAreLimited)
+{
+	MovementEnvelopes * envelopes = new MovementEnvelopes;
+	envelopes->addSlot();
+	envelopes->addSlot();
+
+	float x1 = 0.0f;
+	for (uint i = 0; i < MovementEnvelopes::RING; i++)
+		CHECK_EQUAL( MovementEnvelopes::eNone, step( *envelopes, x1, 0.5f ) );
+
+	// a second of 5 m/s allows 8 m, three pushes 18 m more, no matter how many bullets hit
+	for (uint i = 0; i < 100; i++)
+		envelopes->addImpulse( 1, IMPULSE );
+	CHECK_EQUAL( MovementEnvelopes::eNone, step( *envelopes, x1, 20.0f ) );
+	CHECK( step( *envelopes, x1, 10.0f ) != MovementEnvelopes::eNone );
+
+	// and they are forgotten after two windows
+	envelopes->addImpulse( 1, IMPULSE );
+	for (uint i = 0; i < MovementEnvelopes::PUSH_STEPS; i++)
+		CHECK_EQUAL( MovementEnvelopes::eNone, step( *envelopes, x1, 0.5f ) );
+	CHECK( step( *envelopes, x1, 8.0f ) != MovementEnvelopes::eNone );
+
+	delete envelopes;
+}
+
+//----------------------------------------------------------------------------------------------------
+/* a full 32 player server checked 10 times per second for 10 minutes, every player runs in a circle
+   at a speed of their own, the last one jumps forward every 30 s */
+static const uint BENCH_PLAYERS = 32;
+static const uint BENCH_STEPS = 6000;
+
+UNIT_TEST(MovementEnvelopes_benchmark)
+{
+	MovementEnvelopes * envelopes = new MovementEnvelopes;
+	BenchmarkRandom random( 7 );
+	float speeds [BENCH_PLAYERS], angles [BENCH_PLAYERS];
+	for (uint p = 0; p < BENCH_PLAYERS; p++) {
+		CHECK_EQUAL( (int)p, envelopes->addSlot() );
+		speeds[p] = random.range( 1.0f, 7.0f );
+		angles[p] = random.range( 0.0f, 6.28f );
+	}
+
+	MovementEnvelopes::Result results [MovementEnvelopes::MAX_SLOTS];
+	uint honestViolations = 0, cheaterViolations = 0;
+	float evaluateMs = 0.0f;
+	for (uint i = 0; i < BENCH_STEPS; i++) {
+		for (uint p = 0; p < BENCH_PLAYERS; p++) {
+			// a circle of 30 m radius, so the maximum speed of 7 m/s is never exceeded
+			angles[p] += speeds[p] * 0.1f / 30.0f;
+			float jump = p == BENCH_PLAYERS - 1 && i % 300 == 299 ? 40.0f : 0.0f;
+			envelopes->setSample( p, (30.0f + jump) * cosf( angles[p] ), 30.0f * sinf( angles[p] ), 7.0f, 0.1f );
+		}
+		Stopwatch watch;
+		envelopes->evaluate( TOLERANCE, SLACK, results );
+		evaluateMs += watch.elapsedMs();
+		for (uint p = 0; p < BENCH_PLAYERS; p++)
+			if (results[p].severity != MovementEnvelopes::eNone)
+				(p == BENCH_PLAYERS - 1 ? cheaterViolations : honestViolations)++;
+	}
+
+	CHECK_EQUAL( 0u, honestViolations );
+	// every jump is reported, the way back too, when it ends up in the window which starts at the jump
+	CHECK( cheaterViolations >= BENCH_STEPS / 300 );
+	printf( "MovementEnvelopes_benchmark: %u players, %u steps, evaluate %.2f ms in total, %.2f us per step, %u violations\n",
+	        BENCH_PLAYERS, BENCH_STEPS, evaluateMs, evaluateMs * 1000.0f / BENCH_STEPS, cheaterViolations );
+
+	delete envelopes;
+}
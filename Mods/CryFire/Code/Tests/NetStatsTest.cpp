@@ -0,0 +1,154 @@
+//================================================================================
+// File:    Code/Tests/NetStatsTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the rolling windows and channel attribution of the network statistics
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/NetStats.h"
+
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(RollingCounter_windows)
+{
+	RollingCounter counter;
+
+	counter.add( 5 );
+	CHECK_EQUAL( 0u, counter.lastSecond() );   // the current second isn't finished yet
+	CHECK_EQUAL( 5u, counter.allTime() );
+
+	counter.shift();
+	CHECK_EQUAL( 5u, counter.lastSecond() );
+	CHECK_EQUAL( 5u, counter.lastMinute() );
+
+	counter.add( 3 );
+	counter.shift();
+	CHECK_EQUAL( 3u, counter.lastSecond() );
+	CHECK_EQUAL( 8u, counter.lastMinute() );
+
+	counter.shift();
+	CHECK_EQUAL( 0u, counter.lastSecond() );
+	CHECK_EQUAL( 8u, counter.lastMinute() );
+
+	// the 5 was shifted in 60 seconds ago, the 3 a second later
+	for (uint i = 3; i < RollingCounter::NUM_SLOTS; i++)
+		counter.shift();
+	CHECK_EQUAL( 8u, counter.lastMinute() );
+	counter.shift();
+	CHECK_EQUAL( 3u, counter.lastMinute() );
+	counter.shift();
+	CHECK_EQUAL( 0u, counter.lastMinute() );
+	CHECK_EQUAL( 8u, counter.allTime() );
+}
+
+UNIT_TEST(NetStats_updateShiftsOncePerSecond)
+{
+	NetStats::reset();
+	NetStats::onClientConnect( 1 );
+	uint rmi = NetStats::registerRMI( "TestShift" );
+	RollingCounter received;
+
+	NetStats::onRMIReceived( rmi, 1 );
+	NetStats::onUpdate( 0.6f );
+	NetStats::getCounter( 1, NetStats::eRMIReceived, received );
+	CHECK_EQUAL( 0u, received.lastSecond() );
+
+	NetStats::onUpdate( 0.6f );
+	NetStats::getCounter( 1, NetStats::eRMIReceived, received );
+	CHECK_EQUAL( 1u, received.lastSecond() );
+
+	// 0.2 s carried over, so the next second ends after 0.8 s
+	NetStats::onRMIReceived( rmi, 1 );
+	NetStats::onUpdate( 0.7f );
+	NetStats::getCounter( 1, NetStats::eRMIReceived, received );
+	CHECK_EQUAL( 1u, received.lastSecond() );
+	NetStats::onUpdate( 0.1f );
+	NetStats::getCounter( 1, NetStats::eRMIReceived, received );
+	CHECK_EQUAL( 1u, received.lastSecond() );
+	CHECK_EQUAL( 2u, received.lastMinute() );
+
+	// a long freeze shifts only once
+	NetStats::onUpdate( 5.0f );
+	NetStats::getCounter( 1, NetStats::eRMIReceived, received );
+	CHECK_EQUAL( 0u, received.lastSecond() );
+	CHECK_EQUAL( 2u, received.lastMinute() );
+}
+
+UNIT_TEST(NetStats_aspectsCountedForReceivingChannels)
+{
+	NetStats::reset();
+	RollingCounter bytes;
+
+	NetStats::onAspectSerialized( 0x10, 10 );
+	CHECK( !NetStats::getCounter( 1, NetStats::eAspectBytesEstimate, bytes ) );   // nobody connected yet
+
+	NetStats::onClientConnect( 1 );
+	NetStats::onClientConnect( 2 );
+	NetStats::onClientConnect( 3 );
+	NetStats::onAspectSerialized( 0x10, 10, 2 );   // input of player 2 is relayed only to the others
+	NetStats::onAspectSerialized( 0x20, 4 );
+
+	CHECK( NetStats::getCounter( 1, NetStats::eAspectBytesEstimate, bytes ) );
+	CHECK_EQUAL( 14u, bytes.allTime() );
+	NetStats::getCounter( 2, NetStats::eAspectBytesEstimate, bytes );
+	CHECK_EQUAL( 4u, bytes.allTime() );
+	NetStats::getCounter( 3, NetStats::eAspectWrites, bytes );
+	CHECK_EQUAL( 2u, bytes.allTime() );
+
+	NetStats::onClientDisconnect( 3 );
+	NetStats::onAspectSerialized( 0x20, 4 );
+	CHECK( !NetStats::getCounter( 3, NetStats::eAspectWrites, bytes ) );
+	NetStats::getCounter( 1, NetStats::eAspectWrites, bytes );
+	CHECK_EQUAL( 3u, bytes.allTime() );
+}
+
+UNIT_TEST(NetStats_rejectsCountedPerRMI)
+{
+	NetStats::reset();
+	uint rename = NetStats::registerRMI( "TestRename" );
+	uint chat = NetStats::registerRMI( "TestChat" );
+	CHECK_EQUAL( rename, NetStats::registerRMI( "TestRename" ) );
+	CHECK( rename != chat );
+
+	NetStats::onClientConnect( 1 );
+	NetStats::onClientConnect( 2 );
+	for (uint i = 0; i < 3; i++)
+		NetStats::onRMIReceived( rename, 1 );
+	NetStats::onRMIRejected( rename, 1 );
+	NetStats::onRMIReceived( chat, 1 );
+	NetStats::onRMIReceived( chat, 2 );
+
+	RollingCounter received, rejected;
+	CHECK( NetStats::getRMICounters( 1, "TestRename", received, rejected ) );
+	CHECK_EQUAL( 3u, received.allTime() );
+	CHECK_EQUAL( 1u, rejected.allTime() );
+	CHECK( NetStats::getRMICounters( 1, "TestChat", received, rejected ) );
+	CHECK_EQUAL( 1u, received.allTime() );
+	CHECK_EQUAL( 0u, rejected.allTime() );
+	CHECK( !NetStats::getRMICounters( 2, "TestRename", received, rejected ) );
+
+	NetStats::getCounter( 1, NetStats::eRMIRejected, rejected );
+	CHECK_EQUAL( 1u, rejected.allTime() );
+	NetStats::getCounter( 2, NetStats::eRMIRejected, rejected );
+	CHECK_EQUAL( 0u, rejected.allTime() );
+}
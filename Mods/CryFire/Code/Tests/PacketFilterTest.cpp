@@ -0,0 +1,185 @@
+//================================================================================
+// File:    Code/Tests/PacketFilterTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the token buckets of the packet pre-filter
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "UnitTest.h"
+
+#include "CryFire/PacketFilter.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static const uint IP_A = 0x0A000001;   // 10.0.0.1
+static const uint IP_B = 0x0A000002;
+
+static bool sendPacket( uint IPv4, char type, uint now )
+{
+	byte data [8] = { (byte)type, 0, 0, 0, 0, 0, 0, 0 };
+	return PacketFilter::onPacket( IPv4, data, sizeof(data), now );
+}
+
+/* sends packets at the same time until one is dropped, returns how many passed */
+static uint sendUntilDropped( uint IPv4, char type, uint now, uint max = 100 )
+{
+	uint numPassed = 0;
+	while (numPassed < max && sendPacket( IPv4, type, now ))
+		numPassed++;
+	return numPassed;
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(PacketFilter_burstThenRate)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 1, 10 );
+
+	CHECK_EQUAL( 10u, sendUntilDropped( IP_A, '\x3C', 1000 ) );
+	CHECK( !sendPacket( IP_A, '\x3C', 1999 ) );
+	CHECK( sendPacket( IP_A, '\x3C', 2000 ) );
+	CHECK( !sendPacket( IP_A, '\x3C', 2000 ) );
+	CHECK_EQUAL( 3u, sendUntilDropped( IP_A, '\x3C', 5000 ) );
+}
+
+UNIT_TEST(PacketFilter_refillIsCappedByBurst)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 1, 5 );
+
+	CHECK_EQUAL( 5u, sendUntilDropped( IP_A, '\x3C', 1000 ) );
+	CHECK_EQUAL( 5u, sendUntilDropped( IP_A, '\x3C', 31000 ) );
+}
+
+UNIT_TEST(PacketFilter_classesAndAddressesAreSeparate)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 1, 2 );
+	PacketFilter::setLimit( PacketFilter::eOther, 1, 3 );
+
+	CHECK_EQUAL( 2u, sendUntilDropped( IP_A, '\x3C', 1000 ) );
+	CHECK_EQUAL( 3u, sendUntilDropped( IP_A, 'x', 1000 ) );
+	CHECK_EQUAL( 2u, sendUntilDropped( IP_B, '\x3C', 1000 ) );
+
+	PacketFilter::Stats stats;
+	PacketFilter::getStats( stats );
+	CHECK_EQUAL( 4u, stats.passed[PacketFilter::eConnect] );
+	CHECK_EQUAL( 2u, stats.dropped[PacketFilter::eConnect] );
+	CHECK_EQUAL( 2u, stats.floodSources );
+}
+
+UNIT_TEST(PacketFilter_hugeBurstDoesNotWrap)
+{
+	PacketFilter::initialize();
+	// 4294968 * 1000 would wrap around to 704, less than one token
+	PacketFilter::setLimit( PacketFilter::eConnect, 1, 4294968 );
+
+	CHECK( sendPacket( IP_A, '\x3C', 1000 ) );
+}
+
+UNIT_TEST(PacketFilter_hugeRateDoesNotWrap)
+{
+	PacketFilter::initialize();
+	// 60000 ms * 71583 would wrap around to 12704, only 12 tokens after a full minute
+	PacketFilter::setLimit( PacketFilter::eOther, 71583, 20 );
+
+	CHECK_EQUAL( 20u, sendUntilDropped( IP_A, 'x', 1000 ) );
+	CHECK_EQUAL( 20u, sendUntilDropped( IP_A, 'x', 61000 ) );
+}
+
+UNIT_TEST(PacketFilter_formatStringIsDefused)
+{
+	PacketFilter::initialize();
+
+	byte data [] = { '\x3E', '\x19', '%', 's', '%', 's', '%', 'n' };
+	CHECK( PacketFilter::onPacket( IP_A, data, sizeof(data), 1000 ) );
+	CHECK_EQUAL( '_', data[2] );
+	CHECK_EQUAL( '_', data[4] );
+	CHECK_EQUAL( '_', data[6] );
+
+	PacketFilter::Stats stats;
+	PacketFilter::getStats( stats );
+	CHECK_EQUAL( 1u, stats.crashAttempts );
+}
+
+/* one connect packet from each of count addresses starting at firstIP, the time increases by 1 ms per address */
+static void sendFromMany( uint firstIP, uint count, uint startTime )
+{
+	for (uint i = 0; i < count; i++)
+		sendPacket( firstIP + i, '\x3C', startTime + i );
+}
+
+UNIT_TEST(PacketFilter_fullTableEvictsLeastRecentlySeen)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 0, 3 );   // no refill, only a new entry gets tokens again
+
+	CHECK_EQUAL( 3u, sendUntilDropped( IP_A, '\x3C', 1000 ) );
+	sendFromMany( 0x0B000000, 4 * PacketFilter::TABLE_SIZE, 1001 );
+
+	PacketFilter::Stats stats;
+	PacketFilter::getStats( stats, 1001 + 4 * PacketFilter::TABLE_SIZE );
+	CHECK( stats.evictions > 0 );
+	CHECK_EQUAL( PacketFilter::TABLE_SIZE, stats.activeEntries );
+	// the flooding address was seen first, so it was replaced and starts with a full bucket again
+	CHECK_EQUAL( 3u, sendUntilDropped( IP_A, '\x3C', 1001 + 4 * PacketFilter::TABLE_SIZE ) );
+}
+
+UNIT_TEST(PacketFilter_recentlySeenEntrySurvivesEviction)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 0, 3 );
+
+	// the flooding address keeps sending while the others come, so it's never the least recently seen
+	CHECK_EQUAL( 3u, sendUntilDropped( IP_A, '\x3C', 1000 ) );
+	for (uint i = 0; i < 4 * PacketFilter::TABLE_SIZE; i++) {
+		sendPacket( 0x0B000000 + i, '\x3C', 1001 + i );
+		CHECK( !sendPacket( IP_A, '\x3C', 1001 + i ) );
+	}
+}
+
+UNIT_TEST(PacketFilter_idleEntriesExpire)
+{
+	PacketFilter::initialize();
+	sendFromMany( 0x0B000000, 500, 1000 );
+
+	PacketFilter::Stats stats;
+	PacketFilter::getStats( stats, 1500 );
+	CHECK_EQUAL( 500u, stats.activeEntries );
+	PacketFilter::getStats( stats, 1499 + PacketFilter::ENTRY_TTL );
+	CHECK_EQUAL( 1u, stats.activeEntries );   // only the last one is still within the TTL
+	PacketFilter::getStats( stats, 1500 + PacketFilter::ENTRY_TTL );
+	CHECK_EQUAL( 0u, stats.activeEntries );
+
+	// expired entries are free slots, the next addresses take them without evicting anybody
+	sendFromMany( 0x0C000000, PacketFilter::TABLE_SIZE / 2, 2000 + PacketFilter::ENTRY_TTL );
+	PacketFilter::getStats( stats, 2000 + PacketFilter::ENTRY_TTL + PacketFilter::TABLE_SIZE / 2 );
+	CHECK_EQUAL( 0u, stats.evictions );
+	CHECK_EQUAL( PacketFilter::TABLE_SIZE / 2, stats.activeEntries );
+}
+
+UNIT_TEST(PacketFilter_idleBucketRefillStopsAtTTL)
+{
+	PacketFilter::initialize();
+	PacketFilter::setLimit( PacketFilter::eConnect, 1, 1000 );
+
+	CHECK_EQUAL( 1000u, sendUntilDropped( IP_A, '\x3C', 1000, 2000 ) );
+	// two TTLs of silence refill only one TTL of tokens, an expired entry isn't a bigger bucket
+	CHECK_EQUAL( PacketFilter::ENTRY_TTL / 1000, sendUntilDropped( IP_A, '\x3C', 1000 + 2 * PacketFilter::ENTRY_TTL, 2000 ) );
+}
@@ -0,0 +1,177 @@
+//================================================================================
+// File:    Code/Tests/RayQueueTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the order and budget of the deferred ray queue
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "FakeTimer.h"
+
+#include "CryFire/RayQueue.h"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------------------------------
+static const EntityId REMOVED_ID = 13;
+
+static std::vector<uint> tracedTags;
+static std::vector<uint> finishedTags;
+
+/* hits entity with the id of the tag, nothing for tag 0 */
+static void fakeTrace( const RayQueue::Request & request, RayQueue::Result & result )
+{
+	tracedTags.push_back( request.tag );
+	result.hit = request.tag != 0;
+	result.hitEntityId = request.tag;
+	result.pos = request.origin + request.dir;
+	result.normal.zero();
+	result.dist = request.dir.GetLength();
+}
+
+static bool fakeExists( EntityId entityId )
+{
+	return entityId != REMOVED_ID;
+}
+
+static void onResult( const RayQueue::Request & request, const RayQueue::Result & result )
+{
+	finishedTags.push_back( request.tag );
+}
+
+static void submit( uint tag, EntityId ownerId = 0, RayQueue::Callback callback = onResult )
+{
+	static const uint caller = RayQueue::registerCaller( "Test" );
+
+	RayQueue::Request request;
+	request.origin = Vec3( 0, 0, 0 );
+	request.dir = Vec3( 0, 10, 0 );
+	request.objTypes = 0;
+	request.flags = 0;
+	request.skipIds[0] = request.skipIds[1] = 0;
+	request.ownerId = ownerId;
+	request.tag = tag;
+	request.caller = caller;
+	request.callback = callback;
+	RayQueue::submit( request );
+}
+
+static void update( uint budget = ~0u )
+{
+	RayQueue::onUpdate( budget, fakeTrace, fakeExists );
+}
+
+static void startTest()
+{
+	RayQueue::reset();
+	tracedTags.clear();
+	finishedTags.clear();
+	FakeTimer::setTime( 1.0f );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(RayQueue_tracedInNextFrameInOrder)
+{
+	startTest();
+	submit( 1 );
+	submit( 2 );
+	submit( 3 );
+
+	update();
+	CHECK( finishedTags.empty() );
+
+	FakeTimer::advance( 0.03f );
+	update();
+	CHECK( finishedTags.size() == 3 && finishedTags[0] == 1 && finishedTags[1] == 2 && finishedTags[2] == 3 );
+}
+
+UNIT_TEST(RayQueue_budgetCarriesOver)
+{
+	startTest();
+	for (uint i = 1; i <= 5; i++)
+		submit( i );
+	FakeTimer::advance( 0.03f );
+	submit( 6 );
+
+	update( 2 );
+	CHECK_EQUAL( 2u, (uint)finishedTags.size() );
+	update( 2 );
+	CHECK_EQUAL( 4u, (uint)finishedTags.size() );
+	update( 2 );   // 6 was submitted in this frame
+	CHECK_EQUAL( 5u, (uint)finishedTags.size() );
+
+	FakeTimer::advance( 0.03f );
+	update( 2 );
+	CHECK( finishedTags.size() == 6 && finishedTags[5] == 6 );
+}
+
+static void resubmitOnce( const RayQueue::Request & request, const RayQueue::Result & result )
+{
+	finishedTags.push_back( request.tag );
+	if (request.tag == 1)
+		submit( 2, 0, resubmitOnce );
+}
+
+UNIT_TEST(RayQueue_callbackSubmitsWaitForNextFrame)
+{
+	startTest();
+	submit( 1, 0, resubmitOnce );
+	FakeTimer::advance( 0.03f );
+	update();
+	CHECK( finishedTags.size() == 1 && finishedTags[0] == 1 );
+
+	FakeTimer::advance( 0.03f );
+	update();
+	CHECK( finishedTags.size() == 2 && finishedTags[1] == 2 );
+}
+
+UNIT_TEST(RayQueue_removedOwnerIsDropped)
+{
+	startTest();
+	submit( 1, REMOVED_ID );
+	submit( 2, REMOVED_ID + 1 );
+	FakeTimer::advance( 0.03f );
+	update( 1 );   // dropped requests don't count to the budget
+	CHECK( tracedTags.size() == 1 && tracedTags[0] == 2 );
+	CHECK( finishedTags.size() == 1 && finishedTags[0] == 2 );
+}
+
+UNIT_TEST(RayQueue_resetDropsPending)
+{
+	startTest();
+	submit( 1 );
+	RayQueue::reset();
+	FakeTimer::advance( 0.03f );
+	update();
+	CHECK( finishedTags.empty() );
+}
+
+UNIT_TEST(RayQueue_callersAreRegisteredOnce)
+{
+	uint a = RayQueue::registerCaller( "TestA" );
+	uint b = RayQueue::registerCaller( "TestB" );
+	CHECK( a != b );
+	CHECK_EQUAL( a, RayQueue::registerCaller( "TestA" ) );
+	CHECK_EQUAL( b, RayQueue::registerCaller( "TestB" ) );
+}
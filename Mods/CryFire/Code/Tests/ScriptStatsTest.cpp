@@ -0,0 +1,116 @@
+//================================================================================
+// File:    Code/Tests/ScriptStatsTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the write-on-change cache of actor stats in script tables
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "FakeTimer.h"
+#include "FakeScriptTable.h"
+
+#include "CryFire/ScriptStats.h"
+
+
+//----------------------------------------------------------------------------------------------------
+/* one frame of CActor::UpdateScriptStats */
+static void writeFrame( ScriptStats & stats, IScriptTable * table, float time, int stance, bool inAir, float speed )
+{
+	FakeTimer::setTime( time );
+	stats.begin( table );
+	stats.set( "stance", stance );
+	stats.set( "inAir", inAir );
+	stats.set( "flatSpeed", speed );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(ScriptStats_writesOnlyChangedValues)
+{
+	FakeScriptTable table;
+	ScriptStats stats;
+
+	writeFrame( stats, &table, 100.0f, 1, false, 2.0f );
+	CHECK_EQUAL( 3u, table.numWrites );
+
+	writeFrame( stats, &table, 100.1f, 1, false, 2.0f );
+	CHECK_EQUAL( 3u, table.numWrites );
+
+	writeFrame( stats, &table, 100.2f, 2, false, 2.5f );
+	CHECK_EQUAL( 5u, table.numWrites );
+	CHECK_EQUAL( 2.0f, table.getNumber( "stance" ) );
+	CHECK_EQUAL( 2.5f, table.getNumber( "flatSpeed" ) );
+}
+
+UNIT_TEST(ScriptStats_invalidateRepairsScriptWrite)
+{
+	FakeScriptTable table;
+	ScriptStats stats;
+	writeFrame( stats, &table, 200.0f, 1, false, 2.0f );
+
+	// the script reset its stats, the cache still thinks the table holds the last values
+	table.scriptWrite( "inAir", true );
+	writeFrame( stats, &table, 200.1f, 1, false, 2.0f );
+	CHECK_EQUAL( true, table.getBool( "inAir" ) );
+
+	// what the actor does on ENTITY_EVENT_RESET and on revive
+	stats.invalidate();
+	writeFrame( stats, &table, 200.2f, 1, false, 2.0f );
+	CHECK_EQUAL( false, table.getBool( "inAir" ) );
+	CHECK_EQUAL( 6u, table.numWrites );
+}
+
+UNIT_TEST(ScriptStats_refreshRepairsScriptWrite)
+{
+	FakeScriptTable table;
+	ScriptStats stats;
+	writeFrame( stats, &table, 300.0f, 1, false, 2.0f );
+
+	table.scriptWrite( "flatSpeed", 0.0f );
+	writeFrame( stats, &table, 300.0f + ScriptStats::REFRESH_INTERVAL * 0.5f, 1, false, 2.0f );
+	CHECK_EQUAL( 0.0f, table.getNumber( "flatSpeed" ) );
+
+	writeFrame( stats, &table, 300.0f + ScriptStats::REFRESH_INTERVAL, 1, false, 2.0f );
+	CHECK_EQUAL( 2.0f, table.getNumber( "flatSpeed" ) );
+	CHECK_EQUAL( 6u, table.numWrites );
+
+	// time going back after a level load refreshes too
+	writeFrame( stats, &table, 10.0f, 1, false, 2.0f );
+	CHECK_EQUAL( 9u, table.numWrites );
+}
+
+UNIT_TEST(ScriptStats_newTableGetsEverything)
+{
+	FakeScriptTable oldTable, newTable;
+	ScriptStats stats;
+	writeFrame( stats, &oldTable, 400.0f, 1, false, 2.0f );
+
+	// reloaded script, the actor looks up a new table
+	writeFrame( stats, &newTable, 400.1f, 1, false, 2.0f );
+	CHECK_EQUAL( 3u, newTable.numWrites );
+	CHECK_EQUAL( 1.0f, newTable.getNumber( "stance" ) );
+
+	// values set only sometimes are found out of order
+	FakeTimer::setTime( 400.2f );
+	stats.begin( &newTable );
+	stats.set( "stance", 1 );
+	stats.set( "flatSpeed", 2.0f );
+	CHECK_EQUAL( 3u, newTable.numWrites );
+}
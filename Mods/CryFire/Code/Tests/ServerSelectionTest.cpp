@@ -0,0 +1,220 @@
+//================================================================================
+// File:    Code/Tests/ServerSelectionTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the lobby server filter and of the quick game score
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/ServerSelection.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static ServerSelection::Filter noFilter()
+{
+	ServerSelection::Filter filter;
+	memset( &filter, 0, sizeof(filter) );
+	filter.on = true;
+	filter.gameMode = "";
+	filter.mapName = "";
+	return filter;
+}
+
+/* a server which passes every filter */
+static ServerSelection::LobbyServer goodServer()
+{
+	ServerSelection::LobbyServer server;
+	server.gameType = "PowerStruggle";
+	server.mapName = "Multiplayer/PS/Mesa";
+	server.ping = 50;
+	server.numPlayers = 10;
+	server.maxPlayers = 32;
+	server.isPrivate = false;
+	server.antiCheat = true;
+	server.friendlyFire = true;
+	server.gamepadsOnly = true;
+	server.voiceComm = false;
+	server.dedicated = true;
+	server.dx10 = true;
+	return server;
+}
+
+UNIT_TEST(ServerSelection_filterOffShowsAll)
+{
+	ServerSelection::Filter filter = noFilter();
+	filter.on = false;
+	filter.gameMode = "InstantAction";
+	filter.notPrivate = true;
+	ServerSelection::LobbyServer server = goodServer();
+	server.isPrivate = true;
+	CHECK( ServerSelection::passesFilter( filter, server ) );
+	filter.on = true;
+	CHECK( !ServerSelection::passesFilter( filter, server ) );
+}
+
+UNIT_TEST(ServerSelection_filterCriteria)
+{
+	ServerSelection::LobbyServer good = goodServer();
+	ServerSelection::Filter all = noFilter();
+	all.gameMode = "PowerStruggle";
+	all.mapName = "mesa";
+	all.maxPing = 100;
+	all.notFull = all.notEmpty = all.notPrivate = all.antiCheat = all.friendlyFire = true;
+	all.gamepadsOnly = all.noVoiceComms = all.dedicated = all.dx10 = true;
+	CHECK( ServerSelection::passesFilter( all, good ) );
+
+	ServerSelection::LobbyServer bad [11];
+	for (int i = 0; i < 11; i++)
+		bad[i] = good;
+	bad[0].gameType = "InstantAction";
+	bad[1].mapName = "Multiplayer/PS/Beach";
+	bad[2].ping = 101;
+	bad[3].numPlayers = 32;
+	bad[4].numPlayers = 0;
+	bad[5].isPrivate = true;
+	bad[6].antiCheat = false;
+	bad[7].friendlyFire = false;
+	bad[8].gamepadsOnly = false;
+	bad[9].voiceComm = true;
+	bad[10].dedicated = false;
+	for (int i = 0; i < 11; i++) {
+		CHECK( !ServerSelection::passesFilter( all, bad[i] ) );
+		CHECK( ServerSelection::passesFilter( noFilter(), bad[i] ) );
+	}
+	ServerSelection::LobbyServer dx9 = good;
+	dx9.dx10 = false;
+	CHECK( !ServerSelection::passesFilter( all, dx9 ) );
+}
+
+UNIT_TEST(ServerSelection_filterMapNameAndPing)
+{
+	ServerSelection::LobbyServer server = goodServer();
+	ServerSelection::Filter filter = noFilter();
+
+	// a lowercase part anywhere in the map name, whatever its case
+	const char * matching [] = { "mesa", "multiplayer/ps/mesa", "ps/m", "a" };
+	for (int i = 0; i < 4; i++) {
+		filter.mapName = matching[i];
+		CHECK( ServerSelection::passesFilter( filter, server ) );
+	}
+	const char * other [] = { "Mesa", "mesas", "beach", "multiplayer/ia" };
+	for (int i = 0; i < 4; i++) {
+		filter.mapName = other[i];
+		CHECK( !ServerSelection::passesFilter( filter, server ) );
+	}
+
+	// 0 is any ping, the limit itself passes
+	filter = noFilter();
+	server.ping = 5000;
+	CHECK( ServerSelection::passesFilter( filter, server ) );
+	filter.maxPing = 5000;
+	CHECK( ServerSelection::passesFilter( filter, server ) );
+	filter.maxPing = 4999;
+	CHECK( !ServerSelection::passesFilter( filter, server ) );
+}
+
+//----------------------------------------------------------------------------------------------------
+static ServerSelection::QuickGamePreferences preferences()
+{
+	ServerSelection::QuickGamePreferences preferences;
+	preferences.ping1 = 100;
+	preferences.ping2 = 200;
+	preferences.preferCountry = true;
+	preferences.country = "CZ";
+	preferences.preferFavorites = true;
+	return preferences;
+}
+
+/* the best server possible */
+static ServerSelection::QuickGameServer bestServer()
+{
+	ServerSelection::QuickGameServer server;
+	server.players = 20;
+	server.maxPlayers = 32;
+	server.ping = 30;
+	server.country = "DE";
+	server.favorite = true;
+	server.mapMatch = true;
+	return server;
+}
+
+/* the worst server, which meets the criteria before the first one, in the order of quickGameScore */
+static const int NUM_CRITERIA = 6;
+static ServerSelection::QuickGameServer failingFrom( int first )
+{
+	ServerSelection::QuickGameServer server = bestServer();
+	server.mapMatch = first > 0;
+	server.favorite = first > 1;
+	server.ping = first > 5 ? 100 : first > 2 ? 200 : 100000;
+	server.country = first > 3 ? "DE" : "CZ";
+	server.players = first > 4 ? 16 : 0;
+	return server;
+}
+
+static int score( const ServerSelection::QuickGameServer & server )
+{
+	return ServerSelection::quickGameScore( server, preferences() );
+}
+
+UNIT_TEST(ServerSelection_quickGameScore)
+{
+	ServerSelection::QuickGameServer best = bestServer();
+	CHECK_EQUAL( ((128 - 20) << 10) + 30, score( best ) );
+
+	// more players are better than a lower ping
+	ServerSelection::QuickGameServer morePlayers = best, lowerPing = best;
+	morePlayers.players = 21;
+	morePlayers.ping = 90;
+	lowerPing.ping = 10;
+	CHECK( score( morePlayers ) < score( lowerPing ) );
+	// the counts are clamped
+	ServerSelection::QuickGameServer huge = best;
+	huge.players = 500;
+	huge.maxPlayers = 1000;
+	huge.ping = 100000;
+	CHECK_EQUAL( (1 << 10) + 1023 + (1 << 20) + (1 << 23), score( huge ) );
+
+	// every criterion outweighs all the ones after it put together
+	ServerSelection::QuickGameServer criteria [NUM_CRITERIA];
+	for (int i = 0; i < NUM_CRITERIA; i++)
+		criteria[i] = best;
+	criteria[0].mapMatch = false;
+	criteria[1].favorite = false;
+	criteria[2].ping = 201;
+	criteria[3].country = "CZ";
+	criteria[4].players = 15;
+	criteria[5].ping = 101;
+	for (int i = 0; i < NUM_CRITERIA; i++)
+		CHECK( score( criteria[i] ) > score( failingFrom( i + 1 ) ) );
+}
+
+UNIT_TEST(ServerSelection_quickGameScoreWithoutPreferences)
+{
+	ServerSelection::QuickGamePreferences noPreferences = preferences();
+	noPreferences.preferCountry = false;
+	noPreferences.preferFavorites = false;
+	ServerSelection::QuickGameServer server = bestServer();
+	server.country = "CZ";
+	server.favorite = false;
+	CHECK_EQUAL( ((128 - 20) << 10) + 30, ServerSelection::quickGameScore( server, noPreferences ) );
+	CHECK( ServerSelection::quickGameScore( server, preferences() ) > ServerSelection::quickGameScore( bestServer(), preferences() ) );
+}
@@ -0,0 +1,153 @@
+//================================================================================
+// File:    Code/Tests/SlotIndexTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the server browser slots, found by id and reused when freed
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/SlotIndex.h"
+
+
+//----------------------------------------------------------------------------------------------------
+/* orders slots by a key per slot, like SMPServerList::SSort orders servers by the sorted column */
+struct KeyLess {
+	const std::vector<int> & keys;
+	KeyLess( const std::vector<int> & keys ) : keys( keys ) {}
+	bool operator()( int i, int j ) const { return keys[i] < keys[j]; }
+};
+
+static std::vector<int> makeList( int a, int b, int c )
+{
+	std::vector<int> list;
+	list.push_back( a );
+	list.push_back( b );
+	list.push_back( c );
+	return list;
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(SlotIndex_findsById)
+{
+	SlotIndex slots;
+	CHECK_EQUAL( 0, slots.add( 100 ) );
+	CHECK_EQUAL( 1, slots.add( 200 ) );
+	CHECK_EQUAL( 2, slots.add( 300 ) );
+	CHECK_EQUAL( 1, slots.add( 200 ) );   // already there
+	CHECK_EQUAL( 3u, slots.getSize() );
+
+	CHECK_EQUAL( 0, slots.find( 100 ) );
+	CHECK_EQUAL( 2, slots.find( 300 ) );
+	CHECK_EQUAL( SlotIndex::NONE, slots.find( 400 ) );
+	CHECK_EQUAL( SlotIndex::NONE, slots.remove( 400 ) );
+}
+
+UNIT_TEST(SlotIndex_freedSlotIsReused)
+{
+	SlotIndex slots;
+	slots.add( 100 );
+	slots.add( 200 );
+	slots.add( 300 );
+
+	CHECK_EQUAL( 1, slots.remove( 200 ) );
+	CHECK( slots.isFree( 1 ) );
+	CHECK_EQUAL( SlotIndex::NONE, slots.find( 200 ) );
+	// the other servers keep their slots
+	CHECK_EQUAL( 0, slots.find( 100 ) );
+	CHECK_EQUAL( 2, slots.find( 300 ) );
+
+	CHECK_EQUAL( 1, slots.add( 400 ) );
+	CHECK( !slots.isFree( 1 ) );
+	CHECK_EQUAL( 3u, slots.getSize() );
+	CHECK_EQUAL( 3, slots.add( 500 ) );
+
+	// a removed id can come back, in whichever slot is free
+	slots.remove( 100 );
+	CHECK_EQUAL( 0, slots.add( 200 ) );
+	CHECK_EQUAL( 0, slots.find( 200 ) );
+	CHECK_EQUAL( 1, slots.find( 400 ) );
+}
+
+UNIT_TEST(SlotIndex_changesAreCollectedOnce)
+{
+	SlotIndex slots;
+	slots.add( 100 );
+	slots.add( 200 );
+
+	slots.markChanged( 1 );
+	slots.markChanged( 0 );
+	slots.markChanged( 1 );
+	CHECK_EQUAL( 2u, slots.getChanged().size() );
+	CHECK_EQUAL( 1, slots.getChanged()[0] );
+	CHECK_EQUAL( 0, slots.getChanged()[1] );
+
+	slots.clearChanges();
+	CHECK( slots.getChanged().empty() );
+	slots.markChanged( 1 );
+	CHECK_EQUAL( 1u, slots.getChanged().size() );
+
+	slots.clear();
+	CHECK_EQUAL( 0u, slots.getSize() );
+	CHECK( slots.getChanged().empty() );
+	CHECK_EQUAL( SlotIndex::NONE, slots.find( 100 ) );
+}
+
+UNIT_TEST(SlotIndex_sortIsCheckedAroundChanges)
+{
+	SlotIndex slots;
+	slots.add( 100 );
+	slots.add( 200 );
+	slots.add( 300 );
+	slots.add( 400 );   // not in the list, filtered out
+
+	std::vector<int> keys;   // pings
+	keys.push_back( 50 );
+	keys.push_back( 20 );
+	keys.push_back( 80 );
+	keys.push_back( 10 );
+	std::vector<int> list = makeList( 1, 0, 2 );
+	std::vector<int> positions;
+	slots.getPositions( list, positions );
+	CHECK_EQUAL( 1, positions[0] );
+	CHECK_EQUAL( 0, positions[1] );
+	CHECK_EQUAL( SlotIndex::NONE, positions[3] );
+
+	// the ping changed, but the server stays between its neighbours
+	keys[0] = 60;
+	slots.markChanged( 0 );
+	CHECK( slots.isStillSorted( list, positions, KeyLess( keys ) ) );
+
+	// a server out of the list can't break the order
+	keys[3] = 999;
+	slots.markChanged( 3 );
+	CHECK( slots.isStillSorted( list, positions, KeyLess( keys ) ) );
+
+	// and now it moved past the next one
+	keys[0] = 90;
+	CHECK( !slots.isStillSorted( list, positions, KeyLess( keys ) ) );
+	keys[0] = 10;
+	CHECK( !slots.isStillSorted( list, positions, KeyLess( keys ) ) );
+
+	// unchanged servers are not compared
+	slots.clearChanges();
+	CHECK( slots.isStillSorted( list, positions, KeyLess( keys ) ) );
+}
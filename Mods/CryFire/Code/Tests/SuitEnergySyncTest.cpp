@@ -0,0 +1,179 @@
+//================================================================================
+// File:    Code/Tests/SuitEnergySyncTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the quantized network updates of the suit energy
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "Benchmark.h"
+
+#include "CryFire/SuitEnergySync.h"
+#include "Player.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static const float MAX_ENERGY = 200.0f;
+static const float STEP = 1.0f;
+
+UNIT_TEST(SuitEnergySync_firstValueIsSent)
+{
+	SuitEnergySync sync( MAX_ENERGY, STEP );
+	CHECK( sync.update( 150.0f ) );
+	CHECK_EQUAL( 150.0f, sync.getSent() );
+	CHECK( !sync.update( 150.0f ) );
+}
+
+UNIT_TEST(SuitEnergySync_smallChangesWaitForTheStep)
+{
+	SuitEnergySync sync( MAX_ENERGY, STEP );
+	sync.setSent( 100.0f );
+
+	// a slow drain is compared with the sent value, not with the previous one
+	CHECK( !sync.update( 99.7f ) );
+	CHECK( !sync.update( 99.4f ) );
+	CHECK( !sync.update( 99.1f ) );
+	CHECK( sync.update( 98.8f ) );
+	CHECK_EQUAL( 98.8f, sync.getSent() );
+
+	CHECK( !sync.update( 99.5f ) );
+	CHECK( sync.update( 99.8f ) );
+	CHECK( !sync.update( 98.9f ) );
+}
+
+UNIT_TEST(SuitEnergySync_limitsAreAlwaysSent)
+{
+	SuitEnergySync sync( MAX_ENERGY, STEP );
+	sync.setSent( 199.5f );
+	CHECK( sync.update( MAX_ENERGY ) );
+	CHECK( !sync.update( MAX_ENERGY ) );
+	CHECK( !sync.update( 199.9f ) );
+
+	sync.setSent( 0.5f );
+	CHECK( sync.update( 0.0f ) );
+	CHECK_EQUAL( 0.0f, sync.getSent() );
+	CHECK( !sync.update( 0.0f ) );
+	CHECK( !sync.update( 0.2f ) );
+}
+
+UNIT_TEST(SuitEnergySync_clientsAreNeverOffByTheStep)
+{
+	// a drain and a recharge of random looking speeds, whatever clients got last is within the step
+	SuitEnergySync sync( MAX_ENERGY, STEP );
+	float energy = MAX_ENERGY;
+	uint marks = 0, frames = 0;
+	for (uint i = 0; i < 4000; i++, frames++) {
+		float delta = (float)((i * 7919) % 13) * 0.05f;
+		energy = (i / 1000) % 2 == 0 ? max( energy - delta, 0.0f ) : min( energy + delta, MAX_ENERGY );
+		if (sync.update( energy ))
+			marks++;
+		CHECK( fabsf( energy - sync.getSent() ) < STEP );
+	}
+	CHECK( marks < frames / 2 );
+}
+
+//----------------------------------------------------------------------------------------------------
+/* The energy bookkeeping of CNanoSuit::Update for 64 suits on a dedicated server, before and after.
+   The old one copied SPlayerStats every frame and marked the aspect on every change of the energy,
+   the new one reads the stats through a reference, skips full suits with nothing running like
+   CNanoSuit::IsIdle and marks the aspect through SuitEnergySync. The cloak, the slots and the health
+   regeneration need the engine and aren't simulated. */
+static const uint BENCH_SUITS = 64;
+static const uint BENCH_FRAMES = 3000;   // 100 s at 30 fps
+static const float BENCH_FRAME_TIME = 1.0f / 30.0f;
+static const float SPRINT_DRAIN = 20.0f;   // per second
+static const float RECHARGE_DELAY = 1.0f;
+
+struct BenchSuit {
+	float energy;
+	float lastEnergy;
+	float rechargeDelay;
+	bool wasSprinting;
+	SuitEnergySync net;
+	uint marks;
+	BenchSuit() : energy(MAX_ENERGY), lastEnergy(MAX_ENERGY), rechargeDelay(0.0f), wasSprinting(false), net(MAX_ENERGY, STEP), marks(0) {}
+};
+
+static void stepEnergy( BenchSuit & suit, const SPlayerStats & stats )
+{
+	if (stats.bSprinting) {
+		suit.energy = max( suit.energy - SPRINT_DRAIN * BENCH_FRAME_TIME, 0.0f );
+		suit.rechargeDelay = RECHARGE_DELAY;
+	} else if (suit.rechargeDelay > 0.0f) {
+		suit.rechargeDelay -= BENCH_FRAME_TIME;
+	} else {
+		suit.energy = min( suit.energy + MAX_ENERGY / 20.0f * BENCH_FRAME_TIME, MAX_ENERGY );
+	}
+	suit.wasSprinting = stats.bSprinting;
+}
+
+/* half of the players sprint now and then, the others stand or walk */
+static void updateStats( std::vector<SPlayerStats> & stats, uint frame )
+{
+	for (uint i = 0; i < BENCH_SUITS; i++)
+		stats[i].bSprinting = i % 2 == 0 && (frame / 150 + i / 2) % 4 == 0;
+}
+
+static float runSuits( std::vector<BenchSuit> & suits, bool skipIdle )
+{
+	std::vector<SPlayerStats> stats( BENCH_SUITS );
+	Stopwatch watch;
+	for (uint frame = 0; frame < BENCH_FRAMES; frame++) {
+		updateStats( stats, frame );
+		for (uint i = 0; i < BENCH_SUITS; i++) {
+			BenchSuit & suit = suits[i];
+			if (skipIdle) {
+				const SPlayerStats & playerStats = stats[i];
+				if (suit.energy >= MAX_ENERGY && suit.lastEnergy == suit.energy && !playerStats.bSprinting
+				 && !suit.wasSprinting && suit.rechargeDelay <= 0.0f)
+					continue;
+				stepEnergy( suit, playerStats );
+				if (suit.energy != suit.lastEnergy && suit.net.update( suit.energy ))
+					suit.marks++;
+			} else {
+				const SPlayerStats playerStats = stats[i];
+				stepEnergy( suit, playerStats );
+				if (suit.energy != suit.lastEnergy)
+					suit.marks++;
+			}
+			suit.lastEnergy = suit.energy;
+		}
+	}
+	return watch.elapsedMs();
+}
+
+UNIT_TEST(SuitEnergySync_benchmark)
+{
+	std::vector<BenchSuit> everyFrame( BENCH_SUITS ), skipIdle( BENCH_SUITS );
+	float everyFrameMs = runSuits( everyFrame, false );
+	float skipIdleMs = runSuits( skipIdle, true );
+
+	uint everyFrameMarks = 0, skipIdleMarks = 0;
+	for (uint i = 0; i < BENCH_SUITS; i++) {
+		// skipping idle suits must not change the energy
+		CHECK_EQUAL( everyFrame[i].energy, skipIdle[i].energy );
+		everyFrameMarks += everyFrame[i].marks;
+		skipIdleMarks += skipIdle[i].marks;
+	}
+	CHECK( skipIdleMarks < everyFrameMarks );
+	printf( "SuitEnergySync_benchmark: %u suits, %u frames, stats copy and every change %.2f ms %u marks, idle skip and quantized %.2f ms %u marks\n",
+	        BENCH_SUITS, BENCH_FRAMES, everyFrameMs, everyFrameMarks, skipIdleMs, skipIdleMarks );
+}
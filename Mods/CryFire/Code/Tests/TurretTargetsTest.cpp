@@ -0,0 +1,318 @@
+//================================================================================
+// File:    Code/Tests/TurretTargetsTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the candidates and visibility results shared by gun turrets
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+#include "FakeTimer.h"
+#include "Benchmark.h"
+
+#include "CryFire/TurretTargets.h"
+
+#include <cstdio>
+
+
+//----------------------------------------------------------------------------------------------------
+static const EntityId TURRET_ID = 100;
+static TurretTargets::Candidates actors;
+static uint numTraced = 0;
+
+static void addActor( EntityId entityId, const Vec3 & pos )
+{
+	TurretTargets::Candidate candidate;
+	candidate.entityId = entityId;
+	candidate.pos = pos;
+	actors.push_back( candidate );
+}
+
+static void fakeGather( TurretTargets::Candidates & candidates )
+{
+	candidates = actors;
+}
+
+/* nothing is in the way of any ray */
+static void traceNothing( const RayQueue::Request & request, RayQueue::Result & result )
+{
+	numTraced++;
+	result.hit = false;
+	result.hitEntityId = 0;
+	result.pos = request.origin + request.dir;
+	result.normal.zero();
+	result.dist = request.dir.GetLength();
+}
+
+static bool allExist( EntityId entityId )
+{
+	return true;
+}
+
+static void nextFrame()
+{
+	FakeTimer::advance( 0.03f );
+	RayQueue::onUpdate( ~0u, traceNothing, allExist );
+}
+
+static void startTest()
+{
+	actors.clear();
+	numTraced = 0;
+	RayQueue::reset();
+	FakeTimer::setTime( 1.0f );
+	TurretTargets::setGatherFunc( fakeGather );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(TurretTargets_candidatesAreGatheredOncePerFrame)
+{
+	startTest();
+	addActor( 1, Vec3( 10, 0, 0 ) );
+	addActor( 2, Vec3( 0, 20, 0 ) );
+	CHECK_EQUAL( 2u, (uint)TurretTargets::getCandidates().size() );
+
+	addActor( 3, Vec3( 0, 0, 30 ) );
+	CHECK_EQUAL( 2u, (uint)TurretTargets::getCandidates().size() );
+
+	nextFrame();
+	const TurretTargets::Candidates & candidates = TurretTargets::getCandidates();
+	CHECK_EQUAL( 3u, (uint)candidates.size() );
+	CHECK_EQUAL( 3u, candidates[2].entityId );
+}
+
+UNIT_TEST(TurretTargets_searchesAreSpreadOverFrames)
+{
+	startTest();
+	for (uint i = 0; i < TurretTargets::MAX_SEARCHES_PER_FRAME; i++)
+		CHECK( TurretTargets::allowSearch() );
+	CHECK( !TurretTargets::allowSearch() );
+
+	nextFrame();
+	CHECK( TurretTargets::allowSearch() );
+}
+
+UNIT_TEST(TurretTargets_storedResultExpires)
+{
+	startTest();
+	bool shootable = false;
+	CHECK( !TurretTargets::getCachedShootable( TURRET_ID, 1, shootable ) );
+
+	TurretTargets::storeShootable( TURRET_ID, 1, true );
+	CHECK( TurretTargets::getCachedShootable( TURRET_ID, 1, shootable ) );
+	CHECK( shootable );
+	CHECK( !TurretTargets::getCachedShootable( TURRET_ID + 1, 1, shootable ) );
+
+	FakeTimer::advance( TurretTargets::RAY_CACHE_TTL + 0.01f );
+	CHECK( !TurretTargets::getCachedShootable( TURRET_ID, 1, shootable ) );
+}
+
+UNIT_TEST(TurretTargets_requestReturnsLastKnownResult)
+{
+	startTest();
+	addActor( 2, Vec3( 0, 20, 0 ) );
+	Vec3 firePos( 0, 0, 1 );
+
+	// nothing known yet, the ray is traced in the next frame
+	CHECK( !TurretTargets::requestShootable( TURRET_ID, 2, firePos, Vec3( 0, 20, 1 ) ) );
+	CHECK( !TurretTargets::requestShootable( TURRET_ID, 2, firePos, Vec3( 0, 20, 1 ) ) );
+	nextFrame();
+	CHECK_EQUAL( 1u, numTraced );
+
+	CHECK( TurretTargets::requestShootable( TURRET_ID, 2, firePos, Vec3( 0, 20, 1 ) ) );
+	bool shootable = false;
+	CHECK( TurretTargets::getCachedShootable( TURRET_ID, 2, shootable ) && shootable );
+
+	// a request lost by a reset of the queue is submitted again after a second
+	RayQueue::reset();
+	nextFrame();
+	CHECK( TurretTargets::requestShootable( TURRET_ID, 2, firePos, Vec3( 0, 20, 1 ) ) );
+	nextFrame();
+	CHECK_EQUAL( 1u, numTraced );
+	FakeTimer::advance( 1.0f );
+	TurretTargets::requestShootable( TURRET_ID, 2, firePos, Vec3( 0, 20, 1 ) );
+	nextFrame();
+	CHECK_EQUAL( 2u, numTraced );
+}
+
+//----------------------------------------------------------------------------------------------------
+static const uint BENCH_TURRETS = 20;
+static const uint BENCH_TARGETS = 64;
+static const uint BENCH_OBSTACLES = 40;
+static const uint BENCH_FRAMES = 300;            // 10 seconds
+static const float BENCH_FRAME_TIME = 1.0f / 30.0f;
+static const float BENCH_RANGE = 120.0f;
+static const float BENCH_SEARCH_TIME = 0.5f;     // update_target_time of the turrets
+
+struct BenchTurret {
+	EntityId id;
+	Vec3 pos;
+	float searchTimer;
+	EntityId target;
+};
+
+struct BenchScene {
+	std::vector<BenchTurret> turrets;
+	std::vector<AABB> obstacles;
+	uint rays;
+	uint framesWithTarget;
+};
+
+/* low walls hide the center of an actor but not the head, buildings hide both */
+static BenchScene createScene()
+{
+	BenchmarkRandom random;
+	BenchScene scene;
+	scene.rays = 0;
+	scene.framesWithTarget = 0;
+	for (uint i = 0; i < BENCH_TURRETS; i++) {
+		BenchTurret turret;
+		turret.id = TURRET_ID + i;
+		float baseX = i % 2 ? 600.0f : 0.0f;
+		float angle = gf_PI2 * (i / 2) / (BENCH_TURRETS / 2);
+		turret.pos = Vec3( baseX + 40.0f * cosf( angle ), 40.0f * sinf( angle ), 3.0f );
+		turret.searchTimer = random.range( 0.0f, BENCH_SEARCH_TIME );
+		turret.target = 0;
+		scene.turrets.push_back( turret );
+	}
+	for (uint i = 0; i < BENCH_OBSTACLES; i++) {
+		Vec3 center( random.range( -150.0f, 750.0f ), random.range( -150.0f, 150.0f ), 0.0f );
+		float height = i % 4 == 0 ? 8.0f : 1.2f;
+		scene.obstacles.push_back( AABB( center - Vec3( 4.0f, 4.0f, 0.0f ), center + Vec3( 4.0f, 4.0f, height ) ) );
+	}
+	actors.clear();
+	for (uint i = 0; i < BENCH_TARGETS; i++)
+		addActor( 1 + i, Vec3( random.range( -150.0f, 750.0f ), random.range( -150.0f, 150.0f ), 0.0f ) );
+	return scene;
+}
+
+static void moveTargets( BenchmarkRandom & random )
+{
+	for (uint i = 0; i < actors.size(); i++)
+		actors[i].pos += Vec3( random.range( -0.2f, 0.2f ), random.range( -0.2f, 0.2f ), 0.0f );
+}
+
+static bool rayIsFree( BenchScene & scene, const Vec3 & from, const Vec3 & to )
+{
+	scene.rays++;
+	Vec3 dir = to - from;
+	for (uint i = 0; i < scene.obstacles.size(); i++) {
+		const AABB & box = scene.obstacles[i];
+		float tMin = 0.0f, tMax = 1.0f;
+		for (int axis = 0; axis < 3 && tMin <= tMax; axis++) {
+			if (fabsf( dir[axis] ) < 1e-6f) {
+				if (from[axis] < box.min[axis] || from[axis] > box.max[axis])
+					tMin = 2.0f;
+				continue;
+			}
+			float t1 = (box.min[axis] - from[axis]) / dir[axis];
+			float t2 = (box.max[axis] - from[axis]) / dir[axis];
+			tMin = max( tMin, min( t1, t2 ) );
+			tMax = min( tMax, max( t1, t2 ) );
+		}
+		if (tMin <= tMax)
+			return false;
+	}
+	return true;
+}
+
+/* CGunTurret::IsTargetShootable, the center ray with the fallback to the eyes */
+static bool traceShootable( BenchScene & scene, const BenchTurret & turret, const Vec3 & targetPos )
+{
+	return rayIsFree( scene, turret.pos, targetPos + Vec3( 0, 0, 1.0f ) )
+	    || rayIsFree( scene, turret.pos, targetPos + Vec3( 0, 0, 1.7f ) );
+}
+
+static bool isShootable( BenchScene & scene, const BenchTurret & turret, const TurretTargets::Candidate & target, bool shared )
+{
+	if (!shared)
+		return traceShootable( scene, turret, target.pos );
+	bool shootable = false;
+	if (TurretTargets::getCachedShootable( turret.id, target.entityId, shootable ))
+		return shootable;
+	shootable = traceShootable( scene, turret, target.pos );
+	TurretTargets::storeShootable( turret.id, target.entityId, shootable );
+	return shootable;
+}
+
+/* CGunTurret::Update and GetClosestTarget, the old way walks all actors and traces every ray itself */
+static void updateTurrets( BenchScene & scene, bool shared )
+{
+	const TurretTargets::Candidates & candidates = shared ? TurretTargets::getCandidates() : actors;
+	for (uint t = 0; t < scene.turrets.size(); t++) {
+		BenchTurret & turret = scene.turrets[t];
+		if (turret.target) {
+			const TurretTargets::Candidate & target = candidates[turret.target - 1];   // ids are indexes + 1
+			if (target.pos.GetDistance( turret.pos ) > BENCH_RANGE || !isShootable( scene, turret, target, shared ))
+				turret.target = 0;
+			else
+				scene.framesWithTarget++;
+		}
+
+		turret.searchTimer += BENCH_FRAME_TIME;
+		if (turret.searchTimer < BENCH_SEARCH_TIME || (shared && !TurretTargets::allowSearch()))
+			continue;
+		turret.searchTimer = 0.0f;
+
+		float closest = BENCH_RANGE;
+		turret.target = 0;
+		for (uint i = 0; i < candidates.size(); i++) {
+			float dist = candidates[i].pos.GetDistance( turret.pos );
+			if (dist < closest && isShootable( scene, turret, candidates[i], shared )) {
+				closest = dist;
+				turret.target = candidates[i].entityId;
+			}
+		}
+	}
+}
+
+static float runScene( BenchScene & scene, bool shared )
+{
+	BenchmarkRandom random( 7 );
+	Stopwatch watch;
+	for (uint frame = 0; frame < BENCH_FRAMES; frame++) {
+		FakeTimer::advance( BENCH_FRAME_TIME );
+		moveTargets( random );
+		updateTurrets( scene, shared );
+	}
+	return watch.elapsedMs();
+}
+
+/* 20 turrets in two bases, 64 actors walking around them, low walls and buildings between them,
+   prints the rays and time of every turret tracing its own rays against the shared list with the cache
+   (the synchronous path, which is used without cf_rayqueue), the check only verifies that the turrets
+   still find targets about as often and that fewer rays are cast */
+UNIT_TEST(TurretTargets_benchmark)
+{
+	startTest();
+	BenchScene direct = createScene();
+	float directMs = runScene( direct, false );
+
+	startTest();
+	BenchScene shared = createScene();
+	float sharedMs = runScene( shared, true );
+
+	CHECK( shared.rays < direct.rays );
+	CHECK( shared.framesWithTarget * 10 > direct.framesWithTarget * 9 );
+	printf( "TurretTargets_benchmark: %u turrets, %u targets, %u frames, every turret %u rays %.2f ms, shared %u rays %.2f ms, frames with target %u/%u\n",
+	        BENCH_TURRETS, BENCH_TARGETS, BENCH_FRAMES, direct.rays, directMs, shared.rays, sharedMs, direct.framesWithTarget, shared.framesWithTarget );
+}
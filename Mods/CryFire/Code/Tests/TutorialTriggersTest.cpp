@@ -0,0 +1,170 @@
+//================================================================================
+// File:    Code/Tests/TutorialTriggersTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the trigger grid and the event chaining of the MP tutorial
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "CryFire/TriggerGrid.h"
+#include "CryFire/EventChain.h"
+
+
+//----------------------------------------------------------------------------------------------------
+static bool listsTrigger( const TriggerGrid & grid, const Vec3 & pos, int trigger )
+{
+	const std::vector<int> & triggers = grid.getTriggers( grid.getCell( pos ) );
+	return std::find( triggers.begin(), triggers.end(), trigger ) != triggers.end();
+}
+
+/* remembers the order of the triggered events, every one can be triggered once,
+   like CMPTutorial lets only the events in eMS_Checking wait for display */
+struct RecordEvents {
+	std::vector<bool> triggered;
+	std::vector<int> order;
+	RecordEvents( uint count ) : triggered( count, false ) {}
+	bool operator()( int event )
+	{
+		if (triggered[event])
+			return false;
+		triggered[event] = true;
+		order.push_back( event );
+		return true;
+	}
+};
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(TriggerGrid_radiusOverlapsCells)
+{
+	TriggerGrid grid( 32.0f );
+	grid.add( 0, Vec3( 100, 100, 0 ), 10.0f );    // cells 2..3 on both axes
+	grid.add( 1, Vec3( 500, 500, 0 ), 220.0f );   // a base, cells 8..22
+
+	CHECK( listsTrigger( grid, Vec3( 100, 100, 50 ), 0 ) );
+	CHECK( listsTrigger( grid, Vec3( 91, 109, 0 ), 0 ) );
+	CHECK( listsTrigger( grid, Vec3( 64, 64, 0 ), 0 ) );
+	CHECK( listsTrigger( grid, Vec3( 127, 127, 0 ), 0 ) );
+	CHECK( !listsTrigger( grid, Vec3( 128, 100, 0 ), 0 ) );
+	CHECK( !listsTrigger( grid, Vec3( 100, 63, 0 ), 0 ) );
+
+	CHECK( listsTrigger( grid, Vec3( 281, 719, 0 ), 1 ) );
+	CHECK( listsTrigger( grid, Vec3( 500, 500, 0 ), 1 ) );
+	CHECK( !listsTrigger( grid, Vec3( 500, 500, 0 ), 0 ) );
+	CHECK( !listsTrigger( grid, Vec3( 500, 250, 0 ), 1 ) );
+}
+
+UNIT_TEST(TriggerGrid_emptyAndNegativeCells)
+{
+	TriggerGrid grid( 32.0f );
+	grid.add( 0, Vec3( -5, -5, 0 ), 2.0f );
+
+	CHECK( grid.hasTriggers( grid.getCell( Vec3( -1, -31, 0 ) ) ) );
+	CHECK( !grid.hasTriggers( grid.getCell( Vec3( 1, -1, 0 ) ) ) );
+	CHECK( !grid.hasTriggers( grid.getCell( Vec3( -1, 1, 0 ) ) ) );
+	CHECK( grid.getTriggers( grid.getCell( Vec3( 1000, 1000, 0 ) ) ).empty() );
+	// the cell next to the border on the other side of the axis isn't the same
+	CHECK( grid.getCell( Vec3( -0.5f, 0, 0 ) ) != grid.getCell( Vec3( 0.5f, 0, 0 ) ) );
+
+	grid.clear();
+	CHECK( !grid.hasTriggers( grid.getCell( Vec3( -5, -5, 0 ) ) ) );
+}
+
+UNIT_TEST(TriggerGrid_keepsTheOrderOfAdding)
+{
+	TriggerGrid grid( 32.0f );
+	grid.add( 0, Vec3( 10, 10, 0 ), 5.0f );
+	grid.add( 1, Vec3( 20, 20, 0 ), 5.0f );
+	grid.add( 2, Vec3( 15, 15, 0 ), 5.0f );
+
+	const std::vector<int> & triggers = grid.getTriggers( grid.getCell( Vec3( 16, 16, 0 ) ) );
+	CHECK_EQUAL( 3u, triggers.size() );
+	CHECK_EQUAL( 0, triggers[0] );
+	CHECK_EQUAL( 1, triggers[1] );
+	CHECK_EQUAL( 2, triggers[2] );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(EventChain_followersAreTriggered)
+{
+	enum { START, CONTINUE, BARRACKS, CLOSE_MAP, SWINGOMETER, KILLED, COUNT };
+	EventChain chain( COUNT );
+	chain.setAfter( CONTINUE, START );
+	chain.setAfter( BARRACKS, CONTINUE );
+	chain.setAfter( SWINGOMETER, CLOSE_MAP );
+	CHECK_EQUAL( (int)EventChain::NONE, chain.getAfter( KILLED ) );
+
+	RecordEvents events( COUNT );
+	CHECK( chain.trigger( START, events ) );
+	CHECK_EQUAL( 3u, events.order.size() );
+	CHECK_EQUAL( (int)START, events.order[0] );
+	CHECK_EQUAL( (int)CONTINUE, events.order[1] );
+	CHECK_EQUAL( (int)BARRACKS, events.order[2] );
+	CHECK( !events.triggered[SWINGOMETER] );
+
+	// a triggered event isn't triggered again, nor are its followers
+	CHECK( !chain.trigger( START, events ) );
+	CHECK_EQUAL( 3u, events.order.size() );
+
+	CHECK( chain.trigger( CLOSE_MAP, events ) );
+	CHECK( events.triggered[SWINGOMETER] );
+	CHECK( chain.trigger( KILLED, events ) );
+	CHECK_EQUAL( 6u, events.order.size() );
+}
+
+UNIT_TEST(EventChain_followerTriggeredOnItsOwn)
+{
+	enum { START, CONTINUE, BARRACKS, COUNT };
+	EventChain chain( COUNT );
+	chain.setAfter( CONTINUE, START );
+	chain.setAfter( BARRACKS, CONTINUE );
+
+	// the middle event was triggered by its own condition, so it doesn't pass the chain on
+	RecordEvents events( COUNT );
+	CHECK( chain.trigger( CONTINUE, events ) );
+	CHECK( events.triggered[BARRACKS] );
+	CHECK( chain.trigger( START, events ) );
+	CHECK_EQUAL( 3u, events.order.size() );
+	CHECK_EQUAL( (int)START, events.order[2] );
+
+	// and an event made independent (after="" in the XML) isn't triggered by the chain
+	chain.setAfter( BARRACKS, EventChain::NONE );
+	RecordEvents events2( COUNT );
+	chain.trigger( START, events2 );
+	CHECK( events2.triggered[CONTINUE] );
+	CHECK( !events2.triggered[BARRACKS] );
+}
+
+UNIT_TEST(EventChain_cycleEnds)
+{
+	enum { A, B, C, COUNT };
+	EventChain chain( COUNT );
+	chain.setAfter( A, C );
+	chain.setAfter( B, A );
+	chain.setAfter( C, B );
+
+	RecordEvents events( COUNT );
+	CHECK( chain.trigger( B, events ) );
+	CHECK_EQUAL( 3u, events.order.size() );
+	CHECK_EQUAL( (int)B, events.order[0] );
+	CHECK_EQUAL( (int)C, events.order[1] );
+	CHECK_EQUAL( (int)A, events.order[2] );
+}
@@ -0,0 +1,70 @@
+//================================================================================
+// File:    Code/Tests/UnitTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Minimal headless unit test harness
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+#include "UnitTest.h"
+
+#include <cstdio>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------------------------------
+UnitTest *  UnitTest::first = NULL;
+bool        UnitTest::failed = false;
+
+//----------------------------------------------------------------------------------------------------
+UnitTest::UnitTest( const char * name, TestFunc func )
+ : name( name ), func( func ), next( first )
+{
+	first = this;
+}
+
+void UnitTest::fail( const char * file, int line, const char * expr )
+{
+	printf( "%s(%d): check failed: %s\n", file, line, expr );
+	failed = true;
+}
+
+int UnitTest::runAll( const char * filter )
+{
+	int numRun = 0, numFailed = 0;
+	for (UnitTest * test = first; test; test = test->next) {
+		if (filter && !strstr( test->name, filter ))
+			continue;
+		failed = false;
+		test->func();
+		numRun++;
+		if (failed) {
+			printf( "FAILED %s\n", test->name );
+			numFailed++;
+		}
+	}
+	printf( "%d tests, %d failed\n", numRun, numFailed );
+	return numFailed;
+}
+
+//----------------------------------------------------------------------------------------------------
+/* CryFireTests [name filter] */
+int main( int argc, char ** argv )
+{
+	return UnitTest::runAll( argc > 1 ? argv[1] : NULL );
+}
@@ -0,0 +1,67 @@
+//================================================================================
+// File:    Code/Tests/UnitTest.h
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Minimal headless unit test harness, see UnitTest.cpp
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+#ifndef UNIT_TEST_INCLUDED
+#define UNIT_TEST_INCLUDED
+
+
+typedef unsigned int uint;
+
+
+//----------------------------------------------------------------------------------------------------
+/* Tests register themselves from static constructors, UnitTest.cpp runs all of them and returns
+   the number of failed ones, so the post-build step of CryFireTests fails, when any of them fails. */
+class UnitTest {
+
+  public:
+
+	typedef void (* TestFunc)();
+
+	UnitTest( const char * name, TestFunc func );
+
+	static int runAll( const char * filter );
+	static void fail( const char * file, int line, const char * expr );
+
+  protected:
+
+	const char * name;
+	TestFunc     func;
+	UnitTest *   next;
+
+	static UnitTest * first;
+	static bool       failed;   // of the currently running test
+
+};
+
+#define UNIT_TEST(name) \
+	static void name(); \
+	static UnitTest name##_registration( #name, name ); \
+	static void name()
+
+#define CHECK(expr) \
+	do { if (!(expr)) UnitTest::fail( __FILE__, __LINE__, #expr ); } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+	do { if (!((expected) == (actual))) UnitTest::fail( __FILE__, __LINE__, #actual " == " #expected ); } while (0)
+
+
+#endif // UNIT_TEST_INCLUDED
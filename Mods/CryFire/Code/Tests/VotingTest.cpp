@@ -0,0 +1,195 @@
+//================================================================================
+// File:    Code/Tests/VotingTest.cpp
+//                 ____                       ____
+// Project: SSM  /\  _ `\                    /\  _`\   __
+//               \ \ \/\_\    _  __   __  __ \ \ \_/  /\_\    _  __     ___
+//                \ \ \/_/_  /\`'__\ /\ \/\ \ \ \  _\ \/_/   /\`'__\  /' __`\
+//                 \ \ \_\ \ \ \ \_/ \ \ \_\ \ \ \ \/   /\`\ \ \ \_/ /\  \__/
+//                  \ \____/  \ \_\   \/`____ \ \ \_\   \ \_\ \ \_\  \ \_____\
+//                   \/___/    \/_/    `/___/\ \ \/_/    \/_/  \/_/   \/____ /
+//                                        /\___/
+//                                        \/__/
+// Created on:  19.10.2026
+// Last edited: 19.10.2026
+//--------------------------------------------------------------------------------
+// Description: Tests of the voter bitset, the cooldown table and the vote types of CVotingSystem
+//--------------------------------------------------------------------------------
+// Authors:     Patrick Glatt (HipHipHurra)
+//              Jan Broz (Youda008)
+//================================================================================
+
+
+
+
+
+
+#include "StdAfx.h"
+
+#include "UnitTest.h"
+
+#include "Voting.h"
+
+
+//----------------------------------------------------------------------------------------------------
+/* a full server, channel ids 1..32 span two words of the voter bitset */
+static const int NUM_VOTERS = 32;
+
+/* the built-in types take the ratio and the cooldown from cvars, which the tests don't have */
+static int registerType( CVotingSystem & voting, const char * name, float ratio, int cooldown, EVotingState state = eVS_consoleCmd )
+{
+	SVoteType type;
+	type.name = name;
+	type.state = state;
+	type.ratio = ratio;
+	type.cooldown = cooldown;
+	return voting.RegisterType( type );
+}
+
+static CTimeValue seconds( float s )
+{
+	return CTimeValue( s );
+}
+
+//----------------------------------------------------------------------------------------------------
+UNIT_TEST(Voting_everyVoterCountsOnce)
+{
+	CVotingSystem voting;
+	int type = registerType( voting, "test", 0.5f, 0 );
+	voting.SetVoterCount( NUM_VOTERS );
+	voting.SetTeamVoterCount( 1, NUM_VOTERS / 2 );
+	CHECK( voting.StartVoting( 1, seconds( 10 ), type, 0, "subject", 1 ) );
+
+	// odd channels vote yes, the first half is in team 1
+	for (int id = 1; id <= NUM_VOTERS; id++) {
+		CHECK( voting.CanVote( id ) );
+		voting.Vote( id, id <= NUM_VOTERS / 2 ? 1 : 2, id % 2 == 1 );
+		CHECK( !voting.CanVote( id ) );
+	}
+	// second votes are ignored
+	for (int id = 1; id <= NUM_VOTERS; id++)
+		voting.Vote( id, 1, true );
+
+	CHECK_EQUAL( NUM_VOTERS / 2, voting.GetNumVotes() );
+	CHECK_EQUAL( NUM_VOTERS / 2, voting.GetNumNoVotes() );
+	CHECK_EQUAL( NUM_VOTERS / 4, voting.GetNumTeamVotes() );
+	CHECK_EQUAL( 16, voting.GetRequiredVotes() );
+	CHECK_EQUAL( 8, voting.GetRequiredTeamVotes() );
+
+	// the bits around the word boundary belong to different channels
+	CHECK( voting.CanVote( 33 ) );
+	CHECK( voting.CanVote( 64 ) );
+	CHECK( !voting.CanVote( 0 ) );
+	CHECK( !voting.CanVote( -1 ) );
+}
+
+UNIT_TEST(Voting_newVotingClearsVoters)
+{
+	CVotingSystem voting;
+	int type = registerType( voting, "test", 0.5f, 0 );
+	voting.SetVoterCount( NUM_VOTERS );
+	CHECK( voting.StartVoting( 5, seconds( 10 ), type, 0, "first", 0 ) );
+	for (int id = 1; id <= NUM_VOTERS; id++)
+		voting.Vote( id, 0, true );
+	CHECK_EQUAL( NUM_VOTERS, voting.GetNumVotes() );
+
+	// only one voting at a time
+	CHECK( !voting.StartVoting( 6, seconds( 11 ), type, 0, "second", 0 ) );
+
+	voting.EndVoting();
+	CHECK( !voting.IsInProgress() );
+	CHECK_EQUAL( 0, voting.GetRequiredVotes() );
+	CHECK( voting.StartVoting( 6, seconds( 12 ), type, 0, "second", 0 ) );
+	CHECK_EQUAL( 0, voting.GetNumVotes() );
+	for (int id = 1; id <= NUM_VOTERS; id++)
+		CHECK( voting.CanVote( id ) );
+	CHECK( voting.GetSubject() == "second" );
+	CHECK_EQUAL( 6, voting.GetInitiator() );
+}
+
+UNIT_TEST(Voting_cooldownOfEveryInitiator)
+{
+	CVotingSystem voting;
+	int type = registerType( voting, "test", 0.5f, 30 );
+	for (int id = 1; id <= NUM_VOTERS; id++) {
+		CHECK( voting.StartVoting( id, seconds( (float)id ), type, 0, "", 0 ) );
+		voting.EndVoting();
+	}
+
+	CTimeValue start;
+	for (int id = 1; id <= NUM_VOTERS; id++) {
+		CHECK( voting.GetCooldownTime( id, start ) );
+		CHECK( start == seconds( (float)id ) );
+		CHECK( voting.IsCoolingDown( id, type, seconds( (float)id + 30 ) ) );
+		CHECK( !voting.IsCoolingDown( id, type, seconds( (float)id + 31 ) ) );
+	}
+	CHECK( !voting.GetCooldownTime( NUM_VOTERS + 1, start ) );
+
+	// another voting of the same channel reuses its slot
+	CHECK( voting.StartVoting( 3, seconds( 100 ), type, 0, "", 0 ) );
+	voting.EndVoting();
+	CHECK( voting.GetCooldownTime( 3, start ) );
+	CHECK( start == seconds( 100 ) );
+
+	voting.Reset();
+	for (int id = 1; id <= NUM_VOTERS; id++)
+		CHECK( !voting.GetCooldownTime( id, start ) );
+}
+
+UNIT_TEST(Voting_cooldownForgetsTheOldestInProbeRange)
+{
+	CVotingSystem voting;
+	int type = registerType( voting, "test", 0.5f, 30 );
+	for (int id = 1; id <= NUM_VOTERS; id++) {
+		voting.StartVoting( id, seconds( (float)id ), type, 0, "", 0 );
+		voting.EndVoting();
+	}
+
+	// channel 65 maps to the slot of channel 1 and every slot in its probe range is taken
+	const int colliding = 1 + CVotingSystem::COOLDOWN_SLOTS;
+	CHECK( voting.StartVoting( colliding, seconds( 50 ), type, 0, "", 0 ) );
+	voting.EndVoting();
+
+	CTimeValue start;
+	CHECK( voting.GetCooldownTime( colliding, start ) );
+	CHECK( start == seconds( 50 ) );
+	CHECK( !voting.GetCooldownTime( 1, start ) );
+	for (int id = 2; id <= NUM_VOTERS; id++)
+		CHECK( voting.GetCooldownTime( id, start ) );
+}
+
+UNIT_TEST(Voting_typeRegistry)
+{
+	CVotingSystem voting;
+	// the built-in types are registered in the order of EVotingState
+	for (int st = eVS_none + 1; st < eVS_last; st++)
+		CHECK_EQUAL( (int)st, (int)voting.GetVoteType( voting.GetTypeOf( (EVotingState)st ) ).state );
+	CHECK_EQUAL( -1, voting.GetTypeOf( eVS_none ) );
+	CHECK_EQUAL( voting.GetTypeOf( eVS_kick ), voting.FindType( "KICK" ) );
+	CHECK_EQUAL( -1, voting.FindType( "unknown" ) );
+
+	// replacing keeps the index
+	int kick = voting.FindType( "kick" );
+	CHECK_EQUAL( kick, registerType( voting, "Kick", 0.75f, 10, eVS_kick ) );
+	CHECK_EQUAL( 0.75f, voting.GetVoteType( kick ).ratio );
+
+	int numBuiltin = eVS_last - 1;
+	for (int i = numBuiltin; i < CVotingSystem::MAX_VOTE_TYPES; i++) {
+		char name [16];
+		sprintf( name, "custom%d", i );
+		CHECK_EQUAL( i, registerType( voting, name, 0.5f, 0 ) );
+	}
+	CHECK_EQUAL( -1, registerType( voting, "one_too_many", 0.5f, 0 ) );
+	CHECK_EQUAL( -1, voting.FindType( "one_too_many" ) );
+	// but the existing ones can still be replaced
+	CHECK_EQUAL( numBuiltin, registerType( voting, "custom4", 1.0f, 0 ) );
+
+	// a voting needs a registered type
+	CHECK( !voting.StartVoting( 1, seconds( 1 ), -1, 0, "", 0 ) );
+	CHECK( !voting.StartVoting( 1, seconds( 1 ), CVotingSystem::MAX_VOTE_TYPES, 0, "", 0 ) );
+	CHECK( voting.StartVoting( 1, seconds( 1 ), kick, 7, "", 0 ) );
+	CHECK_EQUAL( eVS_kick, voting.GetType() );
+	CHECK_EQUAL( 7u, voting.GetEntityId() );
+
+	voting.SetVoterCount( NUM_VOTERS );
+	CHECK_EQUAL( 24, voting.GetRequiredVotes() );   // 0.75 of 32
+}
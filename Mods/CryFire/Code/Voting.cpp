@@ -4,47 +4,141 @@ Copyright (C), Crytek Studios, 2001-2006.
 -------------------------------------------------------------------------
 $Id$
 $DateTime$
-Description: 
+Description:
 
 -------------------------------------------------------------------------
 History:
 - 4:23:2007   : Created by Stas Spivakov
+- !!CryFire: rebuilt, see Voting.h
 
 *************************************************************************/
 
 #include "StdAfx.h"
 #include "Voting.h"
+#include "GameCVars.h"
+#include "CryFire/AsyncTasks.h"
 
-CVotingSystem::CVotingSystem():
-m_state(eVS_none),
-m_id(0)
+#include <ctime>
+
+struct SVoteLogLine
 {
+  std::string fileName;
+  std::string line;
+};
+
+static void* AppendVoteLog(void* arg)
+{
+  SVoteLogLine* pLine = (SVoteLogLine*)arg;
+  if(FILE* file = fopen(pLine->fileName.c_str(), "a"))
+  {
+    fputs(pLine->line.c_str(), file);
+    fclose(file);
+  }
+  delete pLine;
+  return NULL;
+}
 
+CVotingSystem::CVotingSystem():
+m_type(-1),
+m_id(0),
+m_team(0),
+m_initiator(0),
+m_teamVotes(0),
+m_numVotes(0),
+m_numNoVotes(0),
+m_numVoters(0),
+m_numTypes(0)
+{
+  memset(m_teamVoters, 0, sizeof(m_teamVoters));
+  memset(m_cooldowns, 0, sizeof(m_cooldowns));
+  RegisterBuiltinTypes();
 }
 
 CVotingSystem::~CVotingSystem()
 {
+  ReleaseTypes();
+}
+
+void  CVotingSystem::RegisterBuiltinTypes()
+{
+  // indices must match GetTypeOf
+  static const char* names[eVS_last-1] = { "kick", "nextmap", "map", "command" };
+  for(int st=eVS_none+1; st<eVS_last; ++st)
+  {
+    SVoteType type;
+    type.name = names[st-1];
+    type.state = (EVotingState)st;
+    RegisterType(type);
+  }
+}
+
+void  CVotingSystem::ReleaseTypes()
+{
+  for(int i=0;i<m_numTypes;++i)
+    if(m_types[i].handler)
+    {
+      gEnv->pScriptSystem->ReleaseFunc(m_types[i].handler);
+      m_types[i].handler = 0;
+    }
+}
+
+int   CVotingSystem::RegisterType(const SVoteType& type)
+{
+  int i = FindType(type.name.c_str());
+  if(i < 0)
+  {
+    if(m_numTypes == MAX_VOTE_TYPES)
+      return -1;
+    i = m_numTypes++;
+  }
+  else if(m_types[i].handler && m_types[i].handler != type.handler)
+    gEnv->pScriptSystem->ReleaseFunc(m_types[i].handler);
 
+  m_types[i] = type;
+  return i;
 }
 
-bool  CVotingSystem::StartVoting(int id, const CTimeValue& start, EVotingState st, EntityId eid, const char* subj, int team)
+int   CVotingSystem::FindType(const char* name)const
 {
-  if(st == eVS_none)
+  for(int i=0;i<m_numTypes;++i)
+    if(!stricmp(m_types[i].name.c_str(), name))
+      return i;
+  return -1;
+}
+
+bool  CVotingSystem::StartVoting(int id, const CTimeValue& start, int type, EntityId eid, const char* subj, int team)
+{
+  if(type < 0 || type >= m_numTypes)
     return false;
   if(IsInProgress())
     return false;
-  SVoting v;
-  v.initiator = id;
-  v.startTime = start;
-  m_votings.push_back(v);
-  m_votes.resize(0);
+
+  // remember the start for the cooldown, reuse the slot of this channel or the oldest one
+  int slot = -1;
+  for(int p=0;p<COOLDOWN_PROBE;++p)
+  {
+    int i = (id+p)%COOLDOWN_SLOTS;
+    if(m_cooldowns[i].channelId == id || !m_cooldowns[i].channelId)
+    {
+      slot = i;
+      break;
+    }
+    if(slot < 0 || m_cooldowns[i].startTime < m_cooldowns[slot].startTime)
+      slot = i;
+  }
+  m_cooldowns[slot].channelId = id;
+  m_cooldowns[slot].startTime = start;
+
+  std::fill(m_voted.begin(), m_voted.end(), 0);
 	m_numVotes = 0;
+  m_numNoVotes = 0;
   m_teamVotes = 0;
 
 	m_subject = subj?subj:"";
-  m_state = st;
+  m_type = type;
   m_id = eid;
   m_team = team;
+  m_initiator = id;
 
   m_startTime = start;
   return true;
@@ -52,29 +146,42 @@ bool  CVotingSystem::StartVoting(int id, const CTimeValue& start, EVotingState s
 
 void  CVotingSystem::EndVoting()
 {
-  m_votes.resize(0);
   m_subject.resize(0);
   m_team = 0;
 	m_numVotes = 0;
+  m_numNoVotes = 0;
   m_teamVotes = 0;
-  m_state = eVS_none;
+  m_type = -1;
   m_id = 0;
+  m_initiator = 0;
 }
 
-bool  CVotingSystem::GetCooldownTime(int id, CTimeValue& v)
+bool  CVotingSystem::GetCooldownTime(int id, CTimeValue& v)const
 {
-  for(int i=m_votings.size()-1;i>=0;--i)
-    if(m_votings[i].initiator==id)
+  for(int p=0;p<COOLDOWN_PROBE;++p)
+  {
+    const SCooldown& cooldown = m_cooldowns[(id+p)%COOLDOWN_SLOTS];
+    if(cooldown.channelId == id)
     {
-      v = m_votings[i].startTime;
+      v = cooldown.startTime;
       return true;
     }
+  }
   return false;
 }
 
+bool  CVotingSystem::IsCoolingDown(int id, int type, const CTimeValue& now)const
+{
+  CTimeValue st;
+  if(!GetCooldownTime(id, st))
+    return false;
+  int cooldown = m_types[type].cooldown >= 0 ? m_types[type].cooldown : g_pGameCVars->sv_votingCooldown;
+  return (now-st).GetSeconds() <= cooldown;
+}
+
 bool  CVotingSystem::IsInProgress()const
 {
-  return m_state!=eVS_none;
+  return m_type >= 0;
 }
 
 int   CVotingSystem::GetNumVotes()const
@@ -82,6 +189,11 @@ int   CVotingSystem::GetNumVotes()const
   return m_numVotes;
 }
 
+int   CVotingSystem::GetNumNoVotes()const
+{
+  return m_numNoVotes;
+}
+
 int   CVotingSystem::GetTeam()const
 {
   return m_team;
@@ -92,6 +204,37 @@ int   CVotingSystem::GetNumTeamVotes()const
   return m_teamVotes;
 }
 
+void  CVotingSystem::SetVoterCount(int count)
+{
+  m_numVoters = count;
+}
+
+void  CVotingSystem::SetTeamVoterCount(int team, int count)
+{
+  if(team > 0 && team <= MAX_TEAMS)
+    m_teamVoters[team] = count;
+}
+
+float CVotingSystem::GetRatio(float ratio)const
+{
+  return ratio >= 0.0f ? ratio : g_pGameCVars->sv_votingRatio;
+}
+
+int   CVotingSystem::GetRequiredVotes()const
+{
+  if(!IsInProgress())
+    return 0;
+  return int(ceilf(m_numVoters*GetRatio(m_types[m_type].ratio)));
+}
+
+int   CVotingSystem::GetRequiredTeamVotes()const
+{
+  if(!IsInProgress() || m_team <= 0 || m_team > MAX_TEAMS)
+    return 0;
+  const SVoteType& type = m_types[m_type];
+  return int(ceilf(m_teamVoters[m_team]*GetRatio(type.teamRatio >= 0.0f ? type.teamRatio : type.ratio)));
+}
+
 const string& CVotingSystem::GetSubject()const
 {
   return m_subject;
@@ -104,7 +247,17 @@ EntityId CVotingSystem::GetEntityId()const
 
 EVotingState CVotingSystem::GetType()const
 {
-  return m_state;
+  return IsInProgress() ? m_types[m_type].state : eVS_none;
+}
+
+const SVoteType* CVotingSystem::GetVoteType()const
+{
+  return IsInProgress() ? &m_types[m_type] : 0;
+}
+
+int   CVotingSystem::GetInitiator()const
+{
+  return m_initiator;
 }
 
 CTimeValue CVotingSystem::GetVotingTime()const
@@ -115,28 +268,57 @@ CTimeValue CVotingSystem::GetVotingTime()const
 void  CVotingSystem::Reset()
 {
   EndVoting();
-  m_votings.resize(0);
+  memset(m_cooldowns, 0, sizeof(m_cooldowns));
+}
+
+void  CVotingSystem::LogResult(bool success, const char* initiatorName)const
+{
+  const char* fileName = g_pGameCVars->cf_votelog_file->GetString();
+  if(!IsInProgress() || !fileName || !fileName[0])
+    return;
+
+  // one voting per line, tab separated, the subject comes from a client
+  string subject = m_subject;
+  for(size_t i=0;i<subject.size();++i)
+    if((unsigned char)subject[i] < ' ')
+      subject.replace(i, 1, 1, ' ');
+
+  char line[512];
+  _snprintf(line, sizeof(line), "%u\t%s\t%s\t%s\t%d\t%d\t%d\t%s\n", (unsigned)time(NULL), m_types[m_type].name.c_str(),
+    initiatorName?initiatorName:"", subject.c_str(), m_numVotes, m_numNoVotes, GetRequiredVotes(), success?"passed":"failed");
+  line[sizeof(line)-1] = 0;
+
+  SVoteLogLine* pLine = new SVoteLogLine;
+  pLine->fileName = fileName;
+  pLine->line = line;
+  AsyncTasks::addTask(AppendVoteLog, pLine);
 }
 
 //clients can vote
 void  CVotingSystem::Vote(int id, int team, bool yes)
 {
-  if(CanVote(id))
-  {
-    m_votes.push_back(id);
-		if(yes)
-		{
-			++m_numVotes;
-			if(m_team == team)
-				++m_teamVotes;
-		}
-  }
+  if(!CanVote(id))
+    return;
+
+  uint32 word = uint32(id)>>5;
+  if(word >= m_voted.size())
+    m_voted.resize(word+1, 0);
+  m_voted[word] |= 1u<<(id&31);
+
+	if(yes)
+	{
+		++m_numVotes;
+		if(m_team == team)
+			++m_teamVotes;
+	}
+  else
+    ++m_numNoVotes;
 }
 
 bool  CVotingSystem::CanVote(int id)const
 {
-  for(int i=0;i<m_votes.size(); ++i)
-    if(m_votes[i] == id)
-      return false;
-  return true;
-}
\ No newline at end of file
+  if(id <= 0)
+    return false;
+  uint32 word = uint32(id)>>5;
+  return word >= m_voted.size() || !(m_voted[word] & (1u<<(id&31)));
+}
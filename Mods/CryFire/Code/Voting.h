@@ -4,11 +4,13 @@ Copyright (C), Crytek Studios, 2001-2007.
 -------------------------------------------------------------------------
 $Id$
 $DateTime$
-Description: 
+Description:
 
 -------------------------------------------------------------------------
 History:
 - 4:23:2007   : Created by Stas Spivakov
+- !!CryFire: rebuilt - voters are tracked in a bitset by channel, cooldowns
+  in a fixed table, voter counts are cached and vote types are registered
 
 *************************************************************************/
 
@@ -17,6 +19,8 @@ History:
 
 #pragma once
 
+#include <IScriptSystem.h>
+
 // Summary
 //  Types for the different vote states
 enum EVotingState
@@ -35,51 +39,110 @@ struct SVotingParams
 
 };
 
+// Summary
+//  A kind of voting, the built-in ones are registered for every EVotingState,
+//  scripts can add their own, which are decided by a Lua handler
+struct SVoteType
+{
+  string          name;
+  EVotingState    state;      // what the clients are shown, custom types are shown as console command votes
+  float           ratio;      // part of all players needed, < 0 = sv_voting_ratio
+  float           teamRatio;  // part of the team needed in team votes, < 0 = same as ratio
+  int             cooldown;   // seconds before the initiator can start another voting, < 0 = sv_voting_cooldown
+  HSCRIPTFUNCTION handler;    // handler(subject, initiatorId) called on success, custom types only
+
+  SVoteType(): state(eVS_none), ratio(-1.0f), teamRatio(-1.0f), cooldown(-1), handler(0) {}
+};
+
 class CVotingSystem
 {
-  struct SVoting//once it is initiated
+public:
+  enum
   {
-    int         initiator;
-    CTimeValue  startTime;
+    MAX_TEAMS = 8,             // team ids above this don't have team votes
+    MAX_VOTE_TYPES = 16,
+    COOLDOWN_SLOTS = 64,       // channels remembered for the cooldown, the oldest one is forgotten
+    COOLDOWN_PROBE = 8,
   };
-public:
+
   CVotingSystem();
   ~CVotingSystem();
-  bool  StartVoting(int id, const CTimeValue& start, EVotingState st, EntityId eid, const char* subj, int team);
+
+  // returns index of the type, the existing one is replaced, -1 if there are too many types
+  int   RegisterType(const SVoteType& type);
+  int   FindType(const char* name)const;
+  int   GetTypeOf(EVotingState st)const { return st > eVS_none && st < eVS_last ? st - 1 : -1; }
+  const SVoteType& GetVoteType(int type)const { return m_types[type]; }
+
+  // id is the initiator's channel
+  bool  StartVoting(int id, const CTimeValue& start, int type, EntityId eid, const char* subj, int team);
   void  EndVoting();
-  bool  GetCooldownTime(int id, CTimeValue& v);
-  
+  bool  GetCooldownTime(int id, CTimeValue& v)const;
+  bool  IsCoolingDown(int id, int type, const CTimeValue& now)const;
+
   bool  IsInProgress()const;
   int   GetNumVotes()const;
+  int   GetNumNoVotes()const;
   int   GetNumTeamVotes()const;
 
   int   GetTeam()const;
   int   GetTeamVotes()const;
 
+  // the voters are counted by the game rules on join, leave and team change
+  void  SetVoterCount(int count);
+  void  SetTeamVoterCount(int team, int count);
+  int   GetRequiredVotes()const;
+  int   GetRequiredTeamVotes()const;
+
   const string& GetSubject()const;
   EntityId GetEntityId()const;
   EVotingState GetType()const;
-  
+  const SVoteType* GetVoteType()const;
+  int   GetInitiator()const;
+
   CTimeValue GetVotingTime()const;
 
   void  Reset();
 
-  //clients can vote
+  // appends the result of the current voting to cf_votelog_file, the file is written by the async tasks thread
+  void  LogResult(bool success, const char* initiatorName)const;
+
+  //clients can vote, id is the voter's channel
   void  Vote(int id, int team, bool yes);
   bool  CanVote(int id)const;
+
 private:
+  struct SCooldown
+  {
+    int         channelId;    // 0 = free slot
+    CTimeValue  startTime;
+  };
+
+  void  ReleaseTypes();
+  void  RegisterBuiltinTypes();
+  float GetRatio(float ratio)const;
+
   CTimeValue            m_startTime;
-  
-  EVotingState          m_state;
+
+  int                   m_type;         // -1 = none
   string                m_subject;
   EntityId              m_id;
   int                   m_team;
+  int                   m_initiator;
 
-  std::vector<int>      m_votes;
+  std::vector<uint32>   m_voted;        // bit per channel id
   int                   m_teamVotes;
 	int										m_numVotes;
+  int                   m_numNoVotes;
+
+  int                   m_numVoters;
+  int                   m_teamVoters[MAX_TEAMS+1];
+
+  SVoteType             m_types[MAX_VOTE_TYPES];
+  int                   m_numTypes;
+
   //recent voting
-  std::vector<SVoting>  m_votings;
+  SCooldown             m_cooldowns[COOLDOWN_SLOTS];
 };
 
-#endif // #ifndef __VOTING_H__
\ No newline at end of file
+#endif // #ifndef __VOTING_H__
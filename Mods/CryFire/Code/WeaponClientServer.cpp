@@ -16,6 +16,9 @@
 #include "Game.h"
 #include "GameRules.h"
 
+// !!CryFire - added: network traffic accounting
+#include "CryFire/NetStats.h"
+
 /*
 #define CHECK_OWNER_REQUEST()	\
 	{ \
@@ -34,12 +37,16 @@
 	} \
 */
 
+// !!CryFire - modded: counts rejected requests
 #define CHECK_OWNER_REQUEST()	\
 	{ \
 		uint16 channelId=m_pGameFramework->GetGameChannelId(pNetChannel);	\
 		IActor *pOwnerActor=GetOwnerActor(); \
 		if (pOwnerActor && pOwnerActor->GetChannelId()!=channelId && !IsDemoPlayback()) \
+		{ \
+			CF_REJECT_RMI(); \
 			return true; \
+		} \
 	}
 
 //------------------------------------------------------------------------
@@ -309,6 +316,8 @@ void CWeapon::SendEndReload()
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestStartFire)
 {
+	CF_COUNT_RMI("RequestStartFire");
+
 	CHECK_OWNER_REQUEST();
 
 	GetGameObject()->InvokeRMI(CWeapon::ClStartFire(), params, eRMI_ToOtherClients|eRMI_NoLocalCalls, 
@@ -327,6 +336,8 @@ IMPLEMENT_RMI(CWeapon, SvRequestStartFire)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestStopFire)
 {
+	CF_COUNT_RMI("RequestStopFire");
+
 	CHECK_OWNER_REQUEST();
 
 	GetGameObject()->InvokeRMI(CWeapon::ClStopFire(), params, eRMI_ToOtherClients|eRMI_NoLocalCalls, 
@@ -361,6 +372,8 @@ IMPLEMENT_RMI(CWeapon, ClStopFire)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestShoot)
 {
+	CF_COUNT_RMI("RequestShoot");
+
 	CHECK_OWNER_REQUEST();
 
 	bool ok=true;
@@ -421,6 +434,8 @@ IMPLEMENT_RMI(CWeapon, SvRequestShoot)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestShootEx)
 {
+	CF_COUNT_RMI("RequestShootEx");
+
 	CHECK_OWNER_REQUEST();
 
 	bool ok=true;
@@ -482,6 +497,8 @@ IMPLEMENT_RMI(CWeapon, ClShootX)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestStartMeleeAttack)
 {
+	CF_COUNT_RMI("RequestStartMeleeAttack");
+
 	CHECK_OWNER_REQUEST();
 
 	GetGameObject()->InvokeRMI(CWeapon::ClStartMeleeAttack(), params, eRMI_ToOtherClients, 
@@ -508,6 +525,8 @@ IMPLEMENT_RMI(CWeapon, ClStartMeleeAttack)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestMeleeAttack)
 {
+	CF_COUNT_RMI("RequestMeleeAttack");
+
 	CHECK_OWNER_REQUEST();
 
 	bool ok=true;
@@ -549,6 +568,8 @@ IMPLEMENT_RMI(CWeapon, ClMeleeAttack)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestZoom)
 {
+	CF_COUNT_RMI("RequestZoom");
+
 	CHECK_OWNER_REQUEST();
 
 	bool ok=true;
@@ -588,6 +609,8 @@ IMPLEMENT_RMI(CWeapon, ClZoom)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestFireMode)
 {
+	CF_COUNT_RMI("RequestFireMode");
+
 	CHECK_OWNER_REQUEST();
 
 	SetCurrentFireMode(params.id);
@@ -606,6 +629,8 @@ IMPLEMENT_RMI(CWeapon, ClSetFireMode)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestReload)
 {
+	CF_COUNT_RMI("RequestReload");
+
 	CHECK_OWNER_REQUEST();
 	
 	bool ok=true;
@@ -655,6 +680,8 @@ IMPLEMENT_RMI(CWeapon, ClEndReload)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestCancelReload)
 {
+	CF_COUNT_RMI("RequestCancelReload");
+
 	CHECK_OWNER_REQUEST();
 
 	if(m_fm)
@@ -697,6 +724,8 @@ IMPLEMENT_RMI(CWeapon, ClUnlock)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestLock)
 {
+	CF_COUNT_RMI("RequestLock");
+
 	CHECK_OWNER_REQUEST();
 
 	if (m_fm)
@@ -710,6 +739,8 @@ IMPLEMENT_RMI(CWeapon, SvRequestLock)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestUnlock)
 {
+	CF_COUNT_RMI("RequestUnlock");
+
 	CHECK_OWNER_REQUEST();
 
 	if (m_fm)
@@ -723,6 +754,8 @@ IMPLEMENT_RMI(CWeapon, SvRequestUnlock)
 //------------------------------------------------------------------------
 IMPLEMENT_RMI(CWeapon, SvRequestWeaponRaised)
 {
+	CF_COUNT_RMI("RequestWeaponRaised");
+
 	CHECK_OWNER_REQUEST();
 
 	GetGameObject()->InvokeRMI(CWeapon::ClWeaponRaised(), params, eRMI_ToAllClients);
@@ -18,6 +18,7 @@ History:
 #include "IGameObject.h"
 #include "Actor.h"
 #include "WeaponSystem.h"
+#include "CryFire/Telemetry.h"	// !!CryFire - added
 
 #include "Projectile.h"
 #include "Bullet.h"
@@ -148,6 +149,8 @@ CWeaponSystem::~CWeaponSystem()
 //------------------------------------------------------------------------
 void CWeaponSystem::Update(float frameTime)
 {
+	CF_TELEMETRY_SCOPE("WeaponSystem.Update");	// !!CryFire - added
+
 	m_tracerManager.Update(frameTime);
 	CheckEnvironmentChanges();
 }
@@ -739,11 +742,12 @@ void CWeaponSystem::GetMemoryStatistics(ICrySizer * s)
 	
 	{
 		SIZER_SUBCOMPONENT_NAME(s, "Projectiles");
-		int nSize = m_projectiles.size() * sizeof(TProjectileMap::value_type);
+		//-- !!CryFire - modded: slots are counted by the table, the map itself only once
+		m_projectiles.GetMemoryUsage(s);
 		for (TProjectileMap::iterator iter = m_projectiles.begin(); iter != m_projectiles.end(); ++iter)
 		{
-			nSize += iter->second->GetMemorySize();
+			s->AddObject(iter->second, iter->second->GetMemorySize());
 		}
-		s->AddObject(&m_projectiles,nSize);
+		//------------------------------------------------------------------
 	}
 }
@@ -26,6 +26,7 @@ History:
 #include "Item.h"
 #include "TracerManager.h"
 #include "VectorMap.h"
+#include "FlatHashMap.h"	// !!CryFire - added
 #include "AmmoParams.h"
 
 class CGame;
@@ -58,7 +59,7 @@ class CWeaponSystem : public ILevelSystemListener
 	typedef std::map<string, IFireMode		*(*)()>								TFireModeRegistry;
 	typedef std::map<string, IZoomMode		*(*)()>								TZoomModeRegistry;
 	typedef std::map<string, IGameObjectExtensionCreatorBase *>	TProjectileRegistry;
-	typedef std::map<EntityId, CProjectile *>										TProjectileMap;
+	typedef FlatHashMap<EntityId, CProjectile *>									TProjectileMap;	// !!CryFire - modded
 	typedef VectorMap<IEntityClass*, SAmmoTypeDesc>							TAmmoTypeParams;
 	typedef std::vector<string>																	TFolderList;
 	typedef std::vector<IEntity*>																TIEntityVector;